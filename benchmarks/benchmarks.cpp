@@ -0,0 +1,466 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Benchmark suite measuring block creation, matrix-vector multiplications,
+// Lanczos steps, matrix construction and time evolution. Results are written
+// as JSON, such that performance can be compared between commits.
+//
+// Usage: benchmarks [options]
+//   --models spinhalf,tj,electron     models to run
+//   --variants plain,conserved,symmetric,sublattice,distributed
+//                                     sublattice variants sublattice2 to
+//                                     sublattice5 use 2 to 5 sublattices, a
+//                                     suffix _dense the dense index,
+//                                     symmetric_fermi_lookup evaluates fermi
+//                                     signs on the fly
+//   --operations block,mvm,lanczos_step,matrix,time_evolution
+//   --nsites N                        number of sites for all models
+//   --nsites-matrix N                 number of sites for matrix construction
+//   --repetitions R                   number of repetitions (default 3)
+//   --output FILE                     JSON output file (default stdout)
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <sys/resource.h>
+
+#include <xdiag/all.hpp>
+#include <xdiag/config.hpp>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace xdiag;
+
+struct BenchmarkCase {
+  std::string model;
+  std::string variant;
+  int64_t nsites;
+  int64_t nsites_matrix;
+  std::function<Block(int64_t)> block;
+  std::function<OpSum(int64_t)> ops;
+};
+
+struct BenchmarkResult {
+  std::string model;
+  std::string variant;
+  std::string operation;
+  int64_t nsites;
+  int64_t dim;
+  int64_t repetitions;
+  double time_min;
+  double time_mean;
+  double mvm_per_s = 0.;
+  double elements_per_s = 0.;
+  double gb_per_s = 0.;
+  int64_t peak_rss_kb;
+};
+
+static int mpi_rank() {
+#ifdef XDIAG_USE_MPI
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  return rank;
+#else
+  return 0;
+#endif
+}
+
+static int mpi_size() {
+#ifdef XDIAG_USE_MPI
+  int size;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  return size;
+#else
+  return 1;
+#endif
+}
+
+static int nthreads() {
+#ifdef _OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+static void barrier() {
+#ifdef XDIAG_USE_MPI
+  MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}
+
+// Peak resident set size in kB, maximized over MPI processes
+static int64_t peak_rss_kb() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  int64_t rss = usage.ru_maxrss / 1024;
+#else
+  int64_t rss = usage.ru_maxrss;
+#endif
+#ifdef XDIAG_USE_MPI
+  int64_t rss_max;
+  MPI_Allreduce(&rss, &rss_max, 1, MPI_INT64_T, MPI_MAX, MPI_COMM_WORLD);
+  return rss_max;
+#else
+  return rss;
+#endif
+}
+
+// Returns the minimum and mean wall time of f over several repetitions
+static std::pair<double, double> measure(std::function<void()> const &f,
+                                         int64_t repetitions) {
+  double tmin = std::numeric_limits<double>::max();
+  double tsum = 0.;
+  for (int64_t r = 0; r < repetitions; ++r) {
+    barrier();
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    barrier();
+    auto t1 = std::chrono::steady_clock::now();
+    double t = std::chrono::duration<double>(t1 - t0).count();
+    tmin = std::min(tmin, t);
+    tsum += t;
+  }
+  return {tmin, tsum / repetitions};
+}
+
+// Label of a site of a chain whose sites are enumerated sublattice by
+// sublattice, as required by the sublattice backends
+static int64_t sublattice_site(int64_t site, int64_t nsites, int n_sublat) {
+  return (site % n_sublat) * (nsites / n_sublat) + site / n_sublat;
+}
+
+static Representation translation_irrep(int64_t nsites, int n_sublat = 1) {
+  std::vector<Permutation> perms;
+  for (int64_t sym = 0; sym < nsites; ++sym) {
+    std::vector<int64_t> p(nsites);
+    for (int64_t site = 0; site < nsites; ++site) {
+      p[sublattice_site(site, nsites, n_sublat)] =
+          sublattice_site((site + sym) % nsites, nsites, n_sublat);
+    }
+    perms.push_back(Permutation(p));
+  }
+  return Representation(PermutationGroup(perms));
+}
+
+static OpSum heisenberg_chain_sublattice(int64_t nsites, int n_sublat) {
+  OpSum ops;
+  for (int64_t s = 0; s < nsites; ++s) {
+    ops += "J" * Op("SdotS", {sublattice_site(s, nsites, n_sublat),
+                              sublattice_site((s + 1) % nsites, nsites,
+                                              n_sublat)});
+  }
+  ops["J"] = 1.0;
+  return ops;
+}
+
+static OpSum heisenberg_chain(int64_t nsites) {
+  return heisenberg_chain_sublattice(nsites, 1);
+}
+
+static OpSum tj_chain(int64_t nsites) {
+  OpSum ops;
+  for (int64_t s = 0; s < nsites; ++s) {
+    ops += "T" * Op("Hop", {s, (s + 1) % nsites});
+    ops += "J" * Op("tJSdotS", {s, (s + 1) % nsites});
+  }
+  ops["T"] = 1.0;
+  ops["J"] = 0.4;
+  return ops;
+}
+
+static OpSum hubbard_chain(int64_t nsites) {
+  OpSum ops;
+  for (int64_t s = 0; s < nsites; ++s) {
+    ops += "T" * Op("Hop", {s, (s + 1) % nsites});
+  }
+  ops += "U" * Op("HubbardU");
+  ops["T"] = 1.0;
+  ops["U"] = 4.0;
+  return ops;
+}
+
+static std::vector<BenchmarkCase> benchmark_cases() {
+  std::vector<BenchmarkCase> cases;
+  // clang-format off
+  cases.push_back({"spinhalf", "plain", 18, 10,
+      [](int64_t n) { return Spinhalf(n); }, heisenberg_chain});
+  cases.push_back({"spinhalf", "conserved", 20, 12,
+      [](int64_t n) { return Spinhalf(n, n / 2); }, heisenberg_chain});
+  cases.push_back({"spinhalf", "symmetric", 24, 12,
+      [](int64_t n) { return Spinhalf(n, n / 2, translation_irrep(n)); },
+      heisenberg_chain});
+  // Sublattice backends with 1 to 5 sublattices, each with the hash map and
+  // the dense index of the representatives
+  for (int n_sublat = 1; n_sublat <= 5; ++n_sublat) {
+    for (std::string index : {"", "_dense"}) {
+      std::string variant = (n_sublat == 1)
+          ? "sublattice" + index
+          : fmt::format("sublattice{}{}", n_sublat, index);
+      std::string backend = fmt::format("{}sublattice{}", n_sublat, index);
+      cases.push_back({"spinhalf", variant, (n_sublat == 5) ? 25 : 24,
+          (n_sublat == 5) ? 10 : 12,
+          [=](int64_t n) {
+            return Spinhalf(n, n / 2, translation_irrep(n, n_sublat),
+                            backend); },
+          [=](int64_t n) { return heisenberg_chain_sublattice(n, n_sublat); }});
+    }
+  }
+  cases.push_back({"tj", "conserved", 14, 8,
+      [](int64_t n) { return tJ(n, n / 2 - 1, n / 2 - 1); }, tj_chain});
+  cases.push_back({"tj", "symmetric", 16, 8,
+      [](int64_t n) {
+        return tJ(n, n / 2 - 1, n / 2 - 1, translation_irrep(n)); },
+      tj_chain});
+  cases.push_back({"tj", "symmetric_fermi_lookup", 16, 8,
+      [](int64_t n) {
+        return tJ(n, n / 2 - 1, n / 2 - 1, translation_irrep(n),
+                  "auto_fermi_lookup"); },
+      tj_chain});
+  cases.push_back({"electron", "plain", 8, 4,
+      [](int64_t n) { return Electron(n); }, hubbard_chain});
+  cases.push_back({"electron", "conserved", 12, 6,
+      [](int64_t n) { return Electron(n, n / 2, n / 2); }, hubbard_chain});
+  cases.push_back({"electron", "symmetric", 12, 6,
+      [](int64_t n) {
+        return Electron(n, n / 2, n / 2, translation_irrep(n)); },
+      hubbard_chain});
+  cases.push_back({"electron", "symmetric_fermi_lookup", 12, 6,
+      [](int64_t n) {
+        return Electron(n, n / 2, n / 2, translation_irrep(n),
+                        "auto_fermi_lookup"); },
+      hubbard_chain});
+#ifdef XDIAG_USE_MPI
+  cases.push_back({"spinhalf", "distributed", 24, 0,
+      [](int64_t n) { return SpinhalfDistributed(n, n / 2); },
+      heisenberg_chain});
+  cases.push_back({"tj", "distributed", 16, 0,
+      [](int64_t n) { return tJDistributed(n, n / 2 - 1, n / 2 - 1); },
+      tj_chain});
+  cases.push_back({"electron", "distributed", 12, 0,
+      [](int64_t n) { return ElectronDistributed(n, n / 2, n / 2); },
+      hubbard_chain});
+#endif
+  // clang-format on
+  return cases;
+}
+
+static std::vector<BenchmarkResult> run(BenchmarkCase const &bcase,
+                                        std::vector<std::string> const &opers,
+                                        int64_t repetitions) {
+  std::vector<BenchmarkResult> results;
+  auto has = [&](std::string const &op) {
+    return std::find(opers.begin(), opers.end(), op) != opers.end();
+  };
+  auto result = [&](std::string const &operation, int64_t nsites,
+                    int64_t dim, std::pair<double, double> times) {
+    BenchmarkResult r;
+    r.model = bcase.model;
+    r.variant = bcase.variant;
+    r.operation = operation;
+    r.nsites = nsites;
+    r.dim = dim;
+    r.repetitions = repetitions;
+    r.time_min = times.first;
+    r.time_mean = times.second;
+    r.peak_rss_kb = peak_rss_kb();
+    return r;
+  };
+
+  int64_t nsites = bcase.nsites;
+  auto ops = bcase.ops(nsites);
+  Block block;
+  auto tblock = measure([&]() { block = bcase.block(nsites); }, repetitions);
+  int64_t dim = xdiag::dim(block);
+  if (has("block")) {
+    results.push_back(result("block", nsites, dim, tblock));
+  }
+
+  bool real = isreal(ops) && isreal(block);
+  double coeff_bytes = real ? sizeof(double) : sizeof(complex);
+  State v(block, real);
+  fill(v, RandomState(42));
+
+  if (has("mvm")) {
+    State w(block, real);
+    auto times = measure([&]() { apply(ops, v, w); }, repetitions);
+    auto r = result("mvm", nsites, dim, times);
+    r.mvm_per_s = 1.0 / r.time_min;
+    r.gb_per_s = 2.0 * dim * coeff_bytes / r.time_min / 1e9;
+    results.push_back(r);
+  }
+
+  if (has("lanczos_step")) {
+    int64_t nsteps = 5;
+    auto times = measure(
+        [&]() { eigvals_lanczos(ops, v, 1, 1e-12, nsteps); }, repetitions);
+    auto r = result("lanczos_step", nsites, dim, times);
+    r.time_min /= nsteps;
+    r.time_mean /= nsteps;
+    r.mvm_per_s = 1.0 / r.time_min;
+    // every step reads and writes three Lanczos vectors
+    r.gb_per_s = 6.0 * dim * coeff_bytes / r.time_min / 1e9;
+    results.push_back(r);
+  }
+
+  if (has("time_evolution")) {
+    auto times = measure([&]() { time_evolve(ops, v, 0.1); }, repetitions);
+    results.push_back(result("time_evolution", nsites, dim, times));
+  }
+
+  if (has("matrix") && (bcase.nsites_matrix > 0)) {
+    int64_t nsites_matrix = bcase.nsites_matrix;
+    auto ops_matrix = bcase.ops(nsites_matrix);
+    auto block_matrix = bcase.block(nsites_matrix);
+    int64_t nnz = 0;
+    auto times = measure(
+        [&]() {
+          if (isreal(ops_matrix) && isreal(block_matrix)) {
+            arma::mat m = matrix(ops_matrix, block_matrix);
+            nnz = arma::accu(m != 0.0);
+          } else {
+            arma::cx_mat m = matrixC(ops_matrix, block_matrix);
+            nnz = arma::accu(m != complex(0.0));
+          }
+        },
+        repetitions);
+    auto r = result("matrix", nsites_matrix, xdiag::dim(block_matrix), times);
+    r.elements_per_s = nnz / r.time_min;
+    results.push_back(r);
+  }
+  return results;
+}
+
+static std::string to_json(std::vector<BenchmarkResult> const &results) {
+  std::stringstream ss;
+  ss << "{\n";
+  ss << fmt::format("  \"xdiag_version\": \"{}\",\n", XDIAG_VERSION);
+  ss << fmt::format("  \"git_hash\": \"{}\",\n", git_hash());
+  ss << fmt::format("  \"hostname\": \"{}\",\n", XDIAG_HOSTNAME);
+  ss << fmt::format("  \"nthreads\": {},\n", nthreads());
+  ss << fmt::format("  \"mpi_size\": {},\n", mpi_size());
+  ss << "  \"benchmarks\": [";
+  for (int64_t i = 0; i < (int64_t)results.size(); ++i) {
+    auto const &r = results[i];
+    ss << (i == 0 ? "\n" : ",\n");
+    ss << "    {";
+    ss << fmt::format("\"model\": \"{}\", \"variant\": \"{}\", "
+                      "\"operation\": \"{}\", ",
+                      r.model, r.variant, r.operation);
+    ss << fmt::format("\"nsites\": {}, \"dim\": {}, \"repetitions\": {}, ",
+                      r.nsites, r.dim, r.repetitions);
+    ss << fmt::format("\"time_min\": {:.6e}, \"time_mean\": {:.6e}, ",
+                      r.time_min, r.time_mean);
+    ss << fmt::format("\"mvm_per_s\": {:.6e}, \"elements_per_s\": {:.6e}, ",
+                      r.mvm_per_s, r.elements_per_s);
+    ss << fmt::format("\"gb_per_s\": {:.6e}, \"peak_rss_kb\": {}", r.gb_per_s,
+                      r.peak_rss_kb);
+    ss << "}";
+  }
+  ss << "\n  ]\n}\n";
+  return ss.str();
+}
+
+static std::vector<std::string> split_list(std::string const &str) {
+  std::vector<std::string> list;
+  std::stringstream ss(str);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    list.push_back(item);
+  }
+  return list;
+}
+
+int main(int argc, char *argv[]) try {
+#ifdef XDIAG_USE_MPI
+  MPI_Init(&argc, &argv);
+#endif
+  std::vector<std::string> models = {"spinhalf", "tj", "electron"};
+  std::vector<std::string> variants = {
+      "plain", "conserved", "symmetric", "symmetric_fermi_lookup",
+      "sublattice", "sublattice_dense", "sublattice2", "sublattice2_dense",
+      "sublattice3", "sublattice3_dense", "sublattice4", "sublattice4_dense",
+      "sublattice5", "sublattice5_dense", "distributed"};
+  std::vector<std::string> opers = {"block", "mvm", "lanczos_step", "matrix",
+                                    "time_evolution"};
+  int64_t nsites = 0;
+  int64_t nsites_matrix = 0;
+  int64_t repetitions = 3;
+  std::string output;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (i + 1 == argc) {
+      throw std::invalid_argument(
+          fmt::format("Missing value for argument \"{}\"", arg));
+    }
+    std::string value = argv[++i];
+    if (arg == "--models") {
+      models = split_list(value);
+    } else if (arg == "--variants") {
+      variants = split_list(value);
+    } else if (arg == "--operations") {
+      opers = split_list(value);
+    } else if (arg == "--nsites") {
+      nsites = std::stoll(value);
+    } else if (arg == "--nsites-matrix") {
+      nsites_matrix = std::stoll(value);
+    } else if (arg == "--repetitions") {
+      repetitions = std::stoll(value);
+    } else if (arg == "--output") {
+      output = value;
+    } else {
+      throw std::invalid_argument(
+          fmt::format("Unknown argument \"{}\"", arg));
+    }
+  }
+
+  auto contains = [](std::vector<std::string> const &list,
+                     std::string const &item) {
+    return std::find(list.begin(), list.end(), item) != list.end();
+  };
+
+  std::vector<BenchmarkResult> results;
+  for (auto bcase : benchmark_cases()) {
+    if (!contains(models, bcase.model) || !contains(variants, bcase.variant)) {
+      continue;
+    }
+    if (nsites > 0) {
+      bcase.nsites = nsites;
+    }
+    if ((nsites_matrix > 0) && (bcase.nsites_matrix > 0)) {
+      bcase.nsites_matrix = nsites_matrix;
+    }
+    Log("Running benchmark: {} {}", bcase.model, bcase.variant);
+    auto res = run(bcase, opers, repetitions);
+    results.insert(results.end(), res.begin(), res.end());
+  }
+
+  if (mpi_rank() == 0) {
+    std::string json = to_json(results);
+    if (output.empty()) {
+      std::cout << json;
+    } else {
+      std::ofstream out(output);
+      out << json;
+    }
+  }
+#ifdef XDIAG_USE_MPI
+  MPI_Finalize();
+#endif
+  return EXIT_SUCCESS;
+} catch (Error const &e) {
+  error_trace(e);
+  return EXIT_FAILURE;
+} catch (std::exception const &e) {
+  std::cerr << e.what() << std::endl;
+  return EXIT_FAILURE;
+}
@@ -10,6 +10,8 @@ set(XDIAG_SOURCES
   utils/scalar.cpp
   utils/vector.cpp
   utils/matrix.cpp
+  utils/allocator.cpp
+  utils/profile.cpp
 
   bits/bitops.cpp
   
@@ -17,11 +19,16 @@ set(XDIAG_SOURCES
   algebra/algebra.cpp
   algebra/matrix.cpp
   algebra/apply.cpp
+  algebra/apply_sparse.cpp
+  algebra/apply_symmetrized.cpp
+  algebra/linear_operator.cpp
+  algebra/diagonal_cache.cpp
   algebra/isapprox.cpp
 
   io/read.cpp
   io/file_toml.cpp
   io/file_h5.cpp
+  io/state_h5.cpp
   io/toml/file_toml_handler.cpp
   io/toml/value.cpp
   io/toml/std_vector.cpp
@@ -32,6 +39,7 @@ set(XDIAG_SOURCES
   io/hdf5/file_h5_subview.cpp
   io/hdf5/utils.cpp
   io/hdf5/write.cpp
+  io/hdf5/read.cpp
   io/hdf5/types.cpp
   
   combinatorics/binomial.cpp
@@ -45,6 +53,9 @@ set(XDIAG_SOURCES
   combinatorics/lin_table.cpp
   combinatorics/fermi_table.cpp
 
+  basis/backend_selection.cpp
+  basis/basis_cache.cpp
+  basis/spinflip_projection.cpp
   basis/spinhalf/basis_spinhalf.cpp
   basis/spinhalf/basis_sz.cpp
   basis/spinhalf/basis_no_sz.cpp
@@ -94,6 +105,8 @@ set(XDIAG_SOURCES
   operators/logic/hc.cpp
   operators/logic/isapprox.cpp
   operators/logic/permute.cpp
+  operators/logic/particlehole.cpp
+  operators/logic/spinflip.cpp
   operators/logic/qns.cpp
   operators/logic/non_branching_op.cpp
   operators/logic/order.cpp
@@ -103,6 +116,7 @@ set(XDIAG_SOURCES
   states/product_state.cpp
   states/random_state.cpp
   states/state.cpp
+  states/sparse_state.cpp
   states/fill.cpp
   states/create_state.cpp
   
@@ -113,7 +127,10 @@ set(XDIAG_SOURCES
   algorithms/lanczos/tmatrix.cpp
   algorithms/lanczos/eigvals_lanczos.cpp
   algorithms/lanczos/eigs_lanczos.cpp
+  algorithms/lanczos/eigs_lanczos_mixed.cpp
+  algorithms/lanczos/lanczos_checkpoint.cpp
   algorithms/sparse_diag.cpp
+  algorithms/entanglement.cpp
   algorithms/arnoldi/arnoldi_to_disk.cpp
   algorithms/gram_schmidt/gram_schmidt.cpp
   algorithms/gram_schmidt/orthogonalize.cpp
@@ -135,12 +152,15 @@ set(XDIAG_DISTRIBUTED_SOURCES
   parallel/mpi/cdot_distributed.cpp
   parallel/mpi/timing_mpi.cpp
   parallel/mpi/buffer.cpp
+  parallel/mpi/partition.cpp
 
   basis/spinhalf_distributed/basis_spinhalf_distributed.cpp
   basis/spinhalf_distributed/basis_sz.cpp
+  basis/spinhalf_distributed/basis_symmetric_sz.cpp
   basis/spinhalf_distributed/transpose.cpp
   basis/spinhalf_distributed/apply/dispatch_apply.cpp
   basis/spinhalf_distributed/apply/apply_terms.cpp
+  basis/spinhalf_distributed/apply/apply_terms_symmetric.cpp
   
   basis/tj_distributed/basis_tj_distributed.cpp
   basis/tj_distributed/basis_np.cpp
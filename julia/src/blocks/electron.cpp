@@ -21,6 +21,10 @@ void define_electron(jlcxx::Module &mod) {
       .constructor<int64_t, int64_t, int64_t, std::string>()
       .constructor<int64_t, Representation, std::string>()
       .constructor<int64_t, int64_t, int64_t, Representation, std::string>()
+      .constructor<int64_t, int64_t, int64_t, Representation, int64_t,
+                   std::string>()
+      .constructor<int64_t, int64_t, int64_t, Representation, int64_t,
+                   int64_t, std::vector<int64_t> const &, std::string>()
       .method("nsites",
               [](Electron const &s) { JULIA_XDIAG_CALL_RETURN(s.nsites()) })
       .method("isreal",
@@ -21,6 +21,7 @@ void define_spinhalf(jlcxx::Module &mod) {
       .constructor<int64_t, int64_t, std::string>()
       .constructor<int64_t, Representation, std::string>()
       .constructor<int64_t, int64_t, Representation, std::string>()
+      .constructor<int64_t, int64_t, Representation, int64_t, std::string>()
       .method("nsites",
               [](Spinhalf const &s) { JULIA_XDIAG_CALL_RETURN(s.nsites()) })
       .method("isreal",
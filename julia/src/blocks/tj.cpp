@@ -19,6 +19,8 @@ void define_tj(jlcxx::Module &mod) {
       .constructor<>()
       .constructor<int64_t, int64_t, int64_t, std::string>()
       .constructor<int64_t, int64_t, int64_t, Representation, std::string>()
+      .constructor<int64_t, int64_t, int64_t, Representation, int64_t,
+                   std::string>()
       .method("nsites", [](tJ const &s) { JULIA_XDIAG_CALL_RETURN(s.nsites()) })
       .method("isreal", [](tJ const &s) { JULIA_XDIAG_CALL_RETURN(s.isreal()) })
       .method("dim", [](tJ const &s) { JULIA_XDIAG_CALL_RETURN(s.dim()) })
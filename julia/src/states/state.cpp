@@ -22,6 +22,8 @@ void define_state(jlcxx::Module &mod) {
               [](State const &s) { JULIA_XDIAG_CALL_RETURN(s.nsites()) })
       .method("isreal",
               [](State const &s) { JULIA_XDIAG_CALL_RETURN(s.isreal()) })
+      .method("isview",
+              [](State const &s) { JULIA_XDIAG_CALL_RETURN(s.isview()) })
       .method("real", [](State const &s) { JULIA_XDIAG_CALL_RETURN(s.real()) })
       .method("imag", [](State const &s) { JULIA_XDIAG_CALL_RETURN(s.imag()) })
       .method("make_complex",
@@ -50,6 +52,26 @@ void define_state(jlcxx::Module &mod) {
         JULIA_XDIAG_CALL_RETURN(s.matrixC(copy))
       });
 
+  // Views on Julia arrays, such that xdiag operates on them without copying
+  mod.method("state_view", [](Spinhalf const &b, double *ptr, int64_t ncols) {
+    JULIA_XDIAG_CALL_RETURN(state_view(b, ptr, ncols))
+  });
+  mod.method("state_view", [](Spinhalf const &b, complex *ptr, int64_t ncols) {
+    JULIA_XDIAG_CALL_RETURN(state_view(b, ptr, ncols))
+  });
+  mod.method("state_view", [](tJ const &b, double *ptr, int64_t ncols) {
+    JULIA_XDIAG_CALL_RETURN(state_view(b, ptr, ncols))
+  });
+  mod.method("state_view", [](tJ const &b, complex *ptr, int64_t ncols) {
+    JULIA_XDIAG_CALL_RETURN(state_view(b, ptr, ncols))
+  });
+  mod.method("state_view", [](Electron const &b, double *ptr, int64_t ncols) {
+    JULIA_XDIAG_CALL_RETURN(state_view(b, ptr, ncols))
+  });
+  mod.method("state_view", [](Electron const &b, complex *ptr, int64_t ncols) {
+    JULIA_XDIAG_CALL_RETURN(state_view(b, ptr, ncols))
+  });
+
   mod.method("to_string", [](State const &s) { return to_string(s); });
   mod.method("isapprox",
              [](State const &v, State const &w, double rtol, double atol) {
@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <random>
+#include <vector>
+
+#include <xdiag/common.hpp>
+#include <xdiag/extern/armadillo/armadillo>
+
+#ifdef XDIAG_USE_MPI
+#include <mpi.h>
+#endif
+
+namespace xdiag::testcases {
+
+// Minimal Lanczos solver using reverse communication in the style of ARPACK,
+// i.e. it never sees the operator. Each call of iterate either requests a
+// product by returning 1 and setting ipntr to the 1-based offsets of the
+// input and output vector in workd, or signals convergence by returning 99.
+// The vectors are the local slices of distributed vectors if distributed.
+template <typename coeff_t> class StubLanczos {
+public:
+  StubLanczos(int64_t n, int64_t niter, bool distributed = false)
+      : n_(n), niter_(niter), distributed_(distributed), workd_(2 * n),
+        vprev_(n, 0.) {
+    int rank = 0;
+#ifdef XDIAG_USE_MPI
+    if (distributed_) {
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    }
+#endif
+    std::mt19937 gen(42 + rank);
+    std::normal_distribution<double> dist(0., 1.);
+    for (int64_t i = 0; i < n_; ++i) {
+      workd_[i] = dist(gen);
+    }
+    double nrm = std::sqrt(std::real(dot(workd_.data(), workd_.data())));
+    for (int64_t i = 0; i < n_; ++i) {
+      workd_[i] /= nrm;
+    }
+  }
+
+  coeff_t *workd() { return workd_.data(); }
+
+  template <typename int_t> int64_t iterate(int_t *ipntr) {
+    coeff_t *v = workd_.data();
+    coeff_t *w = workd_.data() + n_;
+    if (started_) {
+      double alpha = std::real(dot(v, w));
+      for (int64_t i = 0; i < n_; ++i) {
+        w[i] -= alpha * v[i] + beta_ * vprev_[i];
+      }
+      beta_ = std::sqrt(std::real(dot(w, w)));
+      alphas_.push_back(alpha);
+      if (((int64_t)alphas_.size() == niter_) || (beta_ < 1e-12)) {
+        return 99;
+      }
+      betas_.push_back(beta_);
+      for (int64_t i = 0; i < n_; ++i) {
+        vprev_[i] = v[i];
+        v[i] = w[i] / beta_;
+      }
+    }
+    started_ = true;
+    ipntr[0] = 1;
+    ipntr[1] = n_ + 1;
+    return 1;
+  }
+
+  double eigval0() const {
+    arma::vec alphas(alphas_);
+    arma::mat tmat = arma::diagmat(alphas);
+    if (alphas_.size() > 1) {
+      arma::vec betas(betas_);
+      tmat += arma::diagmat(betas, 1) + arma::diagmat(betas, -1);
+    }
+    return arma::eig_sym(tmat)(0);
+  }
+
+private:
+  int64_t n_;
+  int64_t niter_;
+  bool distributed_;
+  std::vector<coeff_t> workd_;
+  std::vector<coeff_t> vprev_;
+  bool started_ = false;
+  double beta_ = 0.;
+  std::vector<double> alphas_;
+  std::vector<double> betas_;
+
+  coeff_t dot(coeff_t const *x, coeff_t const *y) const {
+    coeff_t res = 0.;
+    for (int64_t i = 0; i < n_; ++i) {
+      if constexpr (std::is_same<coeff_t, complex>::value) {
+        res += std::conj(x[i]) * y[i];
+      } else {
+        res += x[i] * y[i];
+      }
+    }
+#ifdef XDIAG_USE_MPI
+    if (distributed_) {
+      coeff_t res_all = 0.;
+      if constexpr (std::is_same<coeff_t, complex>::value) {
+        MPI_Allreduce(&res, &res_all, 1, MPI_CXX_DOUBLE_COMPLEX, MPI_SUM,
+                      MPI_COMM_WORLD);
+      } else {
+        MPI_Allreduce(&res, &res_all, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+      }
+      res = res_all;
+    }
+#endif
+    return res;
+  }
+};
+
+} // namespace xdiag::testcases
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../catch.hpp"
+
+#include "../blocks/electron/testcases_electron.hpp"
+#include <xdiag/algebra/algebra.hpp>
+#include <xdiag/algebra/apply.hpp>
+#include <xdiag/algebra/apply_symmetrized.hpp>
+#include <xdiag/operators/logic/symmetrize.hpp>
+#include <xdiag/states/fill.hpp>
+#include <xdiag/states/random_state.hpp>
+#include <xdiag/utils/logger.hpp>
+
+using namespace xdiag;
+
+template <typename block_t>
+static void test_apply_symmetrized(OpSum const &ops, block_t const &block,
+                                   std::vector<Representation> const &irreps) {
+  auto v = State(block, isreal(block));
+  fill(v, RandomState(1234));
+  for (auto const &irrep : irreps) {
+    auto ops_sym = symmetrize(ops, irrep);
+
+    // Symmetrized operators which do not transform according to a
+    // representation cannot be applied either way
+    State w2;
+    try {
+      w2 = apply(ops_sym, v);
+    } catch (Error const &) {
+      REQUIRE(!isreal(irrep));
+      REQUIRE_THROWS(apply_symmetrized(ops, irrep, v));
+      REQUIRE_THROWS(innerC_symmetrized(ops, irrep, v));
+      continue;
+    }
+    auto w1 = apply_symmetrized(ops, irrep, v);
+    REQUIRE(isvalid(w1) == isvalid(w2));
+    if (isvalid(w1)) {
+      REQUIRE(w1.block() == w2.block());
+      REQUIRE(isapprox(w1, w2));
+    }
+
+    complex e1 = innerC_symmetrized(ops, irrep, v);
+    if (isvalid(w2) && (w2.block() == v.block())) {
+      REQUIRE(std::abs(e1 - innerC(ops_sym, v)) < 1e-12);
+    } else {
+      REQUIRE(std::abs(e1) < 1e-12);
+    }
+  }
+}
+
+TEST_CASE("apply_symmetrized", "[algebra]") try {
+  Log("Testing apply_symmetrized");
+  for (int64_t nsites = 3; nsites <= 6; ++nsites) {
+    auto irreps = testcases::electron::get_cyclic_group_irreps(nsites);
+    OpSum sops = 1.0 * Op("SzSz", {0, 1}) + 0.5 * Op("Exchange", {0, 2});
+    OpSum tops = 1.0 * Op("Hop", {0, 1}) + 0.3 * Op("tJSzSz", {0, 2});
+    OpSum hops = 1.0 * Op("Hop", {0, 1}) + 0.3 * Op("Nupdn", 0);
+    for (auto const &irrep : irreps) {
+      test_apply_symmetrized(sops, Spinhalf(nsites, nsites / 2, irrep),
+                             irreps);
+      test_apply_symmetrized(OpSum(Op("S+", 0)),
+                             Spinhalf(nsites, nsites / 2, irrep), irreps);
+      test_apply_symmetrized(tops, tJ(nsites, 1, 1, irrep), irreps);
+      test_apply_symmetrized(hops, Electron(nsites, 2, 1, irrep), irreps);
+      test_apply_symmetrized(OpSum(Op("Cdagup", 1)),
+                             Electron(nsites, 1, 1, irrep), irreps);
+    }
+  }
+
+  // States without a representation are rejected
+  auto v = State(Spinhalf(4, 2));
+  auto irrep = testcases::electron::get_cyclic_group_irreps(4)[0];
+  REQUIRE_THROWS(apply_symmetrized(Op("SzSz", {0, 1}), irrep, v));
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../catch.hpp"
+
+#include "../blocks/electron/testcases_electron.hpp"
+#include "../blocks/spinhalf/testcases_spinhalf.hpp"
+#include "../blocks/tj/testcases_tj.hpp"
+
+#include <xdiag/algebra/algebra.hpp>
+#include <xdiag/algebra/apply.hpp>
+#include <xdiag/algebra/diagonal_cache.hpp>
+#include <xdiag/algebra/isapprox.hpp>
+#include <xdiag/algebra/matrix.hpp>
+#include <xdiag/algorithms/lanczos/eigs_lanczos.hpp>
+#include <xdiag/algorithms/lanczos/eigvals_lanczos.hpp>
+#include <xdiag/algorithms/sparse_diag.hpp>
+#include <xdiag/algorithms/time_evolution/evolve_lanczos.hpp>
+#include <xdiag/states/fill.hpp>
+#include <xdiag/states/random_state.hpp>
+#include <xdiag/utils/logger.hpp>
+
+using namespace xdiag;
+
+template <typename coeff_t>
+static void test_diagonal_cache(OpSum const &ops, Block const &block) {
+  auto cache = DiagonalCache(ops, block, true);
+  REQUIRE(cache.cached());
+  REQUIRE(cache.diagonal_ops().size() > 0);
+
+  // The diagonal terms only contribute to the diagonal of the matrix
+  auto const &dops = cache.diagonal_ops();
+  if (cache.isreal()) {
+    arma::mat H = matrix(dops, block);
+    REQUIRE(isapprox(arma::mat(arma::diagmat(H)), H));
+    REQUIRE(isapprox(arma::vec(H.diag()), cache.diagonal()));
+  } else {
+    arma::cx_mat H = matrixC(dops, block);
+    REQUIRE(isapprox(arma::cx_mat(arma::diagmat(H)), H));
+    REQUIRE(isapprox(arma::cx_vec(H.diag()), cache.diagonalC()));
+  }
+
+  int64_t n = size(block);
+  arma::Col<coeff_t> v(n, arma::fill::randn);
+  arma::Col<coeff_t> w1(n, arma::fill::zeros);
+  arma::Col<coeff_t> w2(n, arma::fill::zeros);
+  apply(ops, block, v, block, w1);
+  cache.apply(v, w2);
+  REQUIRE(isapprox(w1, w2));
+
+  arma::Mat<coeff_t> V(n, 3, arma::fill::randn);
+  arma::Mat<coeff_t> W1(n, 3, arma::fill::zeros);
+  arma::Mat<coeff_t> W2(n, 3, arma::fill::zeros);
+  apply(ops, block, V, block, W1);
+  cache.apply(V, W2);
+  REQUIRE(isapprox(W1, W2));
+}
+
+TEST_CASE("diagonal_cache", "[algebra]") try {
+  using xdiag::testcases::electron::get_cyclic_group_irreps;
+  Log("Testing DiagonalCache");
+
+  int64_t nsites = 10;
+  auto ops = testcases::spinhalf::HBchain(nsites, 1.0, 0.3);
+  ops += 0.2 * Op("Sz", 2);
+  ops += 0.1 * Op("Id");
+  test_diagonal_cache<double>(ops, Spinhalf(nsites, nsites / 2));
+  test_diagonal_cache<complex>(ops, Spinhalf(nsites));
+  auto irreps = get_cyclic_group_irreps(nsites);
+  auto ops_sym = testcases::spinhalf::HBchain(nsites, 1.0, 0.3);
+  test_diagonal_cache<complex>(ops_sym,
+                               Spinhalf(nsites, nsites / 2, irreps[3]));
+
+  nsites = 6;
+  ops = testcases::tj::tJchain(nsites, 1.0, 0.4);
+  test_diagonal_cache<double>(ops, tJ(nsites, 2, 2));
+  ops = testcases::electron::get_linear_chain(nsites, 1.0, 4.0);
+  test_diagonal_cache<complex>(ops, Electron(nsites, 3, 2));
+
+  // Purely off-diagonal operators are applied as usual
+  auto cache = DiagonalCache(OpSum(Op("Exchange", {0, 1})),
+                             Spinhalf(nsites, nsites / 2), true);
+  REQUIRE(!cache.cached());
+
+  // Drivers give the same results with the diagonal cache
+  nsites = 12;
+  ops = testcases::spinhalf::HBchain(nsites, 1.0, 0.3);
+  auto block = Spinhalf(nsites, nsites / 2);
+  double e0 = eigval0(ops, block);
+  auto r = eigvals_lanczos(ops, block, 1, 1e-12, 1000, 1e-7, 42, true);
+  REQUIRE(isapprox(e0, r.eigenvalues(0)));
+  auto rv = eigs_lanczos(ops, block, 1, 1e-12, 1000, 1e-7, 42, true);
+  REQUIRE(isapprox(e0, rv.eigenvalues(0)));
+  REQUIRE(isapprox(e0, inner(ops, rv.eigenvectors), 1e-8, 1e-8));
+
+  auto psi = State(block);
+  fill(psi, RandomState(42));
+  auto phi = evolve_lanczos(ops, psi, 0.3).state;
+  auto phic =
+      evolve_lanczos(ops, psi, 0.3, 1e-12, 0., false, 1000, 1e-7, true).state;
+  REQUIRE(isapprox(phi, phic));
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
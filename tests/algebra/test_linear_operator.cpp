@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../catch.hpp"
+
+#include "../blocks/electron/testcases_electron.hpp"
+#include "../blocks/spinhalf/testcases_spinhalf.hpp"
+#include "../blocks/tj/testcases_tj.hpp"
+#include "stub_solver.hpp"
+
+#include <xdiag/algebra/linear_operator.hpp>
+#include <xdiag/algebra/matrix.hpp>
+#include <xdiag/algorithms/sparse_diag.hpp>
+#include <xdiag/utils/logger.hpp>
+
+using namespace xdiag;
+
+// Mock of primme_params, which holds the operator in its member matrix
+struct MockParams {
+  void *matrix;
+};
+
+template <typename coeff_t>
+static void test_linear_operator(OpSum const &ops, Block const &block) {
+  auto op = LinearOperator(ops, block);
+  int64_t n = op.local_size();
+  REQUIRE(op.dim() == dim(block));
+  REQUIRE(n == dim(block));
+  REQUIRE(op.ishermitian());
+
+  // Compare apply and apply_block to the dense matrix
+  arma::Mat<coeff_t> H;
+  if constexpr (std::is_same<coeff_t, double>::value) {
+    H = matrix(ops, block);
+  } else {
+    H = matrixC(ops, block);
+  }
+  int64_t k = 3;
+  int64_t ld = n + 2;
+  arma::Mat<coeff_t> X(ld, k, arma::fill::randn);
+  arma::Mat<coeff_t> Y(ld, k, arma::fill::zeros);
+  op.apply(X.colptr(0), Y.colptr(0));
+  REQUIRE(arma::norm(Y.col(0).head(n) - H * X.col(0).head(n)) < 1e-10);
+
+  op.apply_block(X.memptr(), Y.memptr(), k, ld, ld);
+  arma::Mat<coeff_t> HX = H * X.head_rows(n);
+  REQUIRE(arma::norm(Y.head_rows(n) - HX) < 1e-10);
+
+  arma::Mat<coeff_t> Xc = X.head_rows(n);
+  arma::Mat<coeff_t> Yc(n, k, arma::fill::zeros);
+  op.apply_block(Xc.memptr(), Yc.memptr(), k);
+  REQUIRE(arma::norm(Yc - HX) < 1e-10);
+
+  // PRIMME-style callback
+  Y.zeros();
+  int64_t ldx = ld;
+  int64_t ldy = ld;
+  int block_size = k;
+  int ierr = -1;
+  MockParams params{&op};
+  matvec_callback<coeff_t>(X.memptr(), &ldx, Y.memptr(), &ldy, &block_size,
+                           &params, &ierr);
+  REQUIRE(ierr == 0);
+  REQUIRE(arma::norm(Y.head_rows(n) - HX) < 1e-10);
+
+  // ARPACK-style reverse communication driving a stub Lanczos solver, with
+  // the integer types of standard and ILP64 builds of ARPACK
+  double e0 = eigval0(ops, block);
+  auto solver = testcases::StubLanczos<coeff_t>(n, std::min<int64_t>(n, 80));
+  int64_t ipntr[2];
+  while (solver.iterate(ipntr) == 1) {
+    apply_arpack(op, ipntr, solver.workd());
+  }
+  REQUIRE(isapprox(solver.eigval0(), e0, 1e-8, 1e-8));
+
+  auto solver32 = testcases::StubLanczos<coeff_t>(n, std::min<int64_t>(n, 80));
+  int32_t ipntr32[2];
+  while (solver32.iterate(ipntr32) == 1) {
+    apply_arpack(op, ipntr32, solver32.workd());
+  }
+  REQUIRE(isapprox(solver32.eigval0(), e0, 1e-8, 1e-8));
+}
+
+TEST_CASE("linear_operator", "[algebra]") try {
+  using xdiag::testcases::electron::get_cyclic_group_irreps;
+  Log("Testing LinearOperator");
+
+  int64_t nsites = 10;
+  auto ops = testcases::spinhalf::HBchain(nsites, 1.0, 0.3);
+  test_linear_operator<double>(ops, Spinhalf(nsites, nsites / 2));
+  test_linear_operator<complex>(ops, Spinhalf(nsites, nsites / 2));
+  auto irreps = get_cyclic_group_irreps(nsites);
+  test_linear_operator<complex>(ops, Spinhalf(nsites, nsites / 2, irreps[3]));
+
+  nsites = 6;
+  ops = testcases::electron::get_linear_chain(nsites, 1.0, 4.0);
+  test_linear_operator<double>(ops, Electron(nsites, 3, 3));
+  test_linear_operator<complex>(testcases::tj::tJchain(nsites, 1.0, 0.4),
+                                tJ(nsites, 2, 2));
+
+  // Complex operators cannot be applied to real vectors
+  auto block = Spinhalf(nsites, nsites / 2);
+  auto opsc = OpSum("J" * Op("Exchange", {0, 1}));
+  opsc["J"] = complex(0.3, 0.2);
+  auto op = LinearOperator(opsc, block);
+  REQUIRE(!op.isreal());
+  arma::vec x(op.local_size(), arma::fill::randn);
+  arma::vec y(op.local_size());
+  REQUIRE_THROWS(op.apply(x.memptr(), y.memptr()));
+  int64_t ld = op.local_size();
+  int block_size = 1;
+  int ierr = 0;
+  MockParams params{&op};
+  matvec_callback<double>(x.memptr(), &ld, y.memptr(), &ld, &block_size,
+                          &params, &ierr);
+  REQUIRE(ierr != 0);
+
+  // Operators need to map the block onto itself
+  REQUIRE_THROWS(LinearOperator(OpSum(Op("S+", 0)), block));
+  REQUIRE(!LinearOperator(OpSum(Op("Sz", 0)) * complex(0., 1.), block)
+               .ishermitian());
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../catch.hpp"
+
+#include <mpi.h>
+
+#include "../blocks/electron/testcases_electron.hpp"
+#include "../blocks/spinhalf/testcases_spinhalf.hpp"
+#include "../blocks/tj/testcases_tj.hpp"
+#include "stub_solver.hpp"
+
+#include <xdiag/algebra/apply.hpp>
+#include <xdiag/algebra/isapprox.hpp>
+#include <xdiag/algebra/linear_operator.hpp>
+#include <xdiag/algorithms/sparse_diag.hpp>
+#include <xdiag/states/fill.hpp>
+#include <xdiag/states/random_state.hpp>
+#include <xdiag/utils/logger.hpp>
+
+using namespace xdiag;
+
+template <typename coeff_t>
+static void test_linear_operator(OpSum const &ops, Block const &block) {
+  auto op = LinearOperator(ops, block);
+  int64_t n = op.local_size();
+  REQUIRE(op.isdistributed());
+  REQUIRE(op.dim() == dim(block));
+  REQUIRE(n == size(block));
+
+  // Each process passes its local slice
+  bool real = std::is_same<coeff_t, double>::value;
+  auto v = State(block, real, 2);
+  fill(v, RandomState(42, false), 0);
+  fill(v, RandomState(43, false), 1);
+  arma::Mat<coeff_t> X;
+  if constexpr (std::is_same<coeff_t, double>::value) {
+    X = v.matrix();
+  } else {
+    X = v.matrixC();
+  }
+  arma::Mat<coeff_t> Y(n, 2, arma::fill::zeros);
+  op.apply_block(X.memptr(), Y.memptr(), 2);
+  for (int64_t col = 0; col < 2; ++col) {
+    auto w = apply(ops, v.col(col));
+    REQUIRE(isapprox(w, State(block, arma::Mat<coeff_t>(Y.col(col)))));
+  }
+
+  int64_t niter = std::min<int64_t>(dim(block), 80);
+  auto solver = testcases::StubLanczos<coeff_t>(n, niter, true);
+  int64_t ipntr[2];
+  while (solver.iterate(ipntr) == 1) {
+    apply_arpack(op, ipntr, solver.workd());
+  }
+  double e0 = eigval0(ops, block);
+  REQUIRE(isapprox(solver.eigval0(), e0, 1e-8, 1e-8));
+}
+
+TEST_CASE("linear_operator_distributed", "[algebra]") try {
+  Log("Testing LinearOperator on distributed blocks");
+
+  int64_t nsites = 12;
+  auto ops = testcases::spinhalf::HBchain(nsites, 1.0, 0.3);
+  test_linear_operator<double>(ops, SpinhalfDistributed(nsites, nsites / 2));
+  test_linear_operator<complex>(ops, SpinhalfDistributed(nsites, nsites / 2));
+
+  nsites = 6;
+  ops = testcases::tj::tJchain(nsites, 1.0, 0.4);
+  test_linear_operator<double>(ops, tJDistributed(nsites, 2, 2));
+  ops = testcases::electron::get_linear_chain(nsites, 1.0, 4.0);
+  test_linear_operator<complex>(ops, ElectronDistributed(nsites, 3, 3));
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../catch.hpp"
+
+#include <algorithm>
+
+#include <xdiag/algebra/apply.hpp>
+#include <xdiag/blocks/spinhalf.hpp>
+#include <xdiag/states/fill.hpp>
+#include <xdiag/states/random_state.hpp>
+#include <xdiag/utils/profile.hpp>
+
+using namespace xdiag;
+
+TEST_CASE("profile", "[algebra]") try {
+  Log("Test profile");
+  int64_t nsites = 8;
+  OpSum ops;
+  for (int64_t s = 0; s < nsites; ++s) {
+    ops += "J" * Op("SdotS", {s, (s + 1) % nsites});
+  }
+  ops["J"] = 1.0;
+
+  auto block = Spinhalf(nsites, nsites / 2);
+  auto v = State(block);
+  fill(v, RandomState(42));
+  auto w = State(block);
+
+  profile_reset();
+  apply(ops, v, w);
+  apply(ops, v, w);
+  auto entries = profile_entries();
+  REQUIRE(profile_table().size() > 0);
+  REQUIRE(profile_json().size() > 0);
+
+  if (profile_enabled()) {
+    auto it = std::find_if(entries.begin(), entries.end(), [](auto const &e) {
+      return e.name == "Spinhalf/Exchange";
+    });
+    REQUIRE(it != entries.end());
+    REQUIRE(it->ncalls == 2 * nsites);
+    REQUIRE(it->time >= 0.);
+
+    // Every bond flips two antiparallel spins of the remaining nsites - 2
+    // sites with nsites / 2 - 1 up spins
+    REQUIRE(it->nelements == 2 * nsites * 2 * 20);
+    REQUIRE(it->ninvalid == 0);
+  } else {
+    REQUIRE(entries.size() == 0);
+  }
+
+  profile_reset();
+  if (profile_enabled()) {
+    REQUIRE(profile_entries().size() == 0);
+  }
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
+
+#ifdef XDIAG_USE_PROFILING
+static ProfileEntry profile_entry(std::string const &name) {
+  auto entries = profile_entries();
+  auto it = std::find_if(entries.begin(), entries.end(),
+                         [&](auto const &e) { return e.name == name; });
+  REQUIRE(it != entries.end());
+  return *it;
+}
+
+TEST_CASE("profile_counters", "[algebra]") try {
+  Log("Test profile_counters");
+  profile_reset();
+
+  // Counts of all threads are collected, also if the number of threads
+  // changes between parallel regions
+  int64_t n = 1000;
+  for (int nthreads : {1, 4, 2}) {
+    profile::Scope scope("Test", "counters");
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads)
+#endif
+    for (int64_t i = 0; i < n; ++i) {
+      profile::count_element();
+      if (i % 10 == 0) {
+        profile::count_invalid();
+      }
+      profile::count_atomics(2);
+    }
+    profile::count_bytes(8);
+  }
+  auto entry = profile_entry("Test/counters");
+  REQUIRE(entry.ncalls == 3);
+  REQUIRE(entry.nelements == 3 * n);
+  REQUIRE(entry.ninvalid == 3 * n / 10);
+  REQUIRE(entry.natomics == 3 * 2 * n);
+  REQUIRE(entry.nbytes == 3 * 8);
+
+  // Counts outside of a Scope are discarded, nested Scopes are attributed to
+  // the outermost one
+  profile::count_element();
+  {
+    profile::Scope outer("Test", "outer");
+    profile::count_element();
+    {
+      profile::Scope inner("Test", "inner");
+      profile::count_element();
+    }
+    profile::count_element();
+  }
+  entry = profile_entry("Test/outer");
+  REQUIRE(entry.ncalls == 1);
+  REQUIRE(entry.nelements == 3);
+  auto entries = profile_entries();
+  REQUIRE(std::none_of(entries.begin(), entries.end(), [](auto const &e) {
+    return e.name == "Test/inner";
+  }));
+  profile_reset();
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
+#endif
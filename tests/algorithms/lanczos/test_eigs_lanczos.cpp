@@ -14,6 +14,9 @@
 #include <xdiag/algorithms/lanczos/eigs_lanczos.hpp>
 
 #include <xdiag/algebra/isapprox.hpp>
+#include <xdiag/operators/logic/real.hpp>
+#include <xdiag/states/fill.hpp>
+#include <xdiag/states/random_state.hpp>
 
 using namespace xdiag;
 
@@ -94,4 +97,25 @@ TEST_CASE("eigs_lanczos", "[lanczos]") {
       }
     }
   printf("Done.\n");
+
+  printf("lanczos_eigenvector_start test ...\n");
+  // Starting from a block regenerates the random initial state for the
+  // second run, starting from a State leaves the State intact
+  for (auto ops : {freefermion_alltoall(nsites),
+                   freefermion_alltoall_complex_updn(nsites)}) {
+    ops["U"] = 5.0;
+    auto block = Electron(nsites, 2, 3);
+    bool real = isreal(ops);
+    State psi0(block, real);
+    fill(psi0, RandomState(42));
+    State psi0_copy = psi0;
+    auto res_block = eigs_lanczos(ops, block, max_num_eigenvalue);
+    auto res_state = eigs_lanczos(ops, psi0, max_num_eigenvalue);
+    REQUIRE(res_block.niterations == res_state.niterations);
+    REQUIRE(isapprox(res_block.eigenvalues, res_state.eigenvalues));
+    REQUIRE(isapprox(res_block.eigenvectors.matrixC(),
+                     res_state.eigenvectors.matrixC()));
+    REQUIRE(isapprox(psi0.vectorC(), psi0_copy.vectorC()));
+  }
+  printf("Done.\n");
 }
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../../catch.hpp"
+
+#include "../../blocks/electron/testcases_electron.hpp"
+#include "../../blocks/spinhalf/testcases_spinhalf.hpp"
+#include "../../blocks/tj/testcases_tj.hpp"
+
+#include <xdiag/algebra/algebra.hpp>
+#include <xdiag/algebra/apply.hpp>
+#include <xdiag/algebra/isapprox.hpp>
+#include <xdiag/algorithms/lanczos/eigs_lanczos_mixed.hpp>
+#include <xdiag/algorithms/sparse_diag.hpp>
+
+using namespace xdiag;
+
+template <typename coeff_t>
+static void test_apply_single(OpSum const &ops, Block const &block) {
+  using single_t = std::conditional_t<std::is_same<coeff_t, double>::value,
+                                      float, std::complex<float>>;
+  arma::Col<coeff_t> v(size(block), arma::fill::randn);
+  arma::Col<coeff_t> w(size(block), arma::fill::zeros);
+  arma::Col<single_t> vs = arma::conv_to<arma::Col<single_t>>::from(v);
+  arma::Col<single_t> ws(size(block), arma::fill::zeros);
+  apply(ops, block, v, block, w);
+  apply(ops, block, vs, block, ws);
+  arma::Col<coeff_t> wd = arma::conv_to<arma::Col<coeff_t>>::from(ws);
+  REQUIRE(arma::norm(w - wd) < 1e-5 * arma::norm(w));
+  REQUIRE(std::abs(dot(block, vs, ws) - dot(block, v, w)) <
+          1e-5 * arma::norm(v) * arma::norm(w));
+}
+
+TEST_CASE("eigs_lanczos_mixed", "[lanczos]") try {
+  Log("testing single precision apply");
+  int64_t nsites = 8;
+  auto ops_spinhalf = testcases::spinhalf::HBchain(nsites, 1.0, 0.3);
+  auto irreps = testcases::electron::get_cyclic_group_irreps(nsites);
+  test_apply_single<double>(ops_spinhalf, Spinhalf(nsites, nsites / 2));
+  test_apply_single<double>(ops_spinhalf,
+                            Spinhalf(nsites, nsites / 2, irreps[0]));
+  test_apply_single<complex>(ops_spinhalf,
+                             Spinhalf(nsites, nsites / 2, irreps[1]));
+
+  auto ops_tj = testcases::tj::tJchain(6, 1.0, 0.4);
+  auto irreps6 = testcases::electron::get_cyclic_group_irreps(6);
+  test_apply_single<double>(ops_tj, tJ(6, 2, 2));
+  test_apply_single<complex>(ops_tj, tJ(6, 2, 2, irreps6[1]));
+
+  auto ops_electron = testcases::electron::freefermion_alltoall(6);
+  ops_electron["U"] = 5.0;
+  test_apply_single<double>(ops_electron, Electron(6, 3, 2));
+  test_apply_single<complex>(ops_electron, Electron(6, 3, 2, irreps6[1]));
+
+  Log("testing mixed precision Lanczos");
+  for (auto const &irrep : irreps) {
+    auto block = Spinhalf(nsites, nsites / 2, irrep);
+    auto r = eigvals_lanczos(ops_spinhalf, block, 2);
+    auto rm = eigvals_lanczos_mixed(ops_spinhalf, block, 2);
+    REQUIRE(isapprox(r.eigenvalues(0), rm.eigenvalues(0)));
+    REQUIRE(isapprox(r.eigenvalues(1), rm.eigenvalues(1)));
+
+    auto [e0, gs] = eig0(ops_spinhalf, block);
+    auto rv = eigs_lanczos_mixed(ops_spinhalf, block);
+    auto v = rv.eigenvectors.col(0);
+    REQUIRE(isapprox(rv.eigenvalues(0), e0));
+    REQUIRE(isapprox(norm(v), 1.0));
+    REQUIRE(isapprox(std::abs(dotC(v, gs)), 1.0, 1e-8));
+  }
+
+  auto block = Electron(6, 3, 2);
+  auto r = eigvals_lanczos(ops_electron, block);
+  auto rm = eigvals_lanczos_mixed(ops_electron, block);
+  REQUIRE(isapprox(r.eigenvalues(0), rm.eigenvalues(0)));
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../../catch.hpp"
+
+#include <cstdio>
+
+#include "../../blocks/electron/testcases_electron.hpp"
+#include "../../blocks/spinhalf/testcases_spinhalf.hpp"
+
+#include <xdiag/algebra/algebra.hpp>
+#include <xdiag/algorithms/lanczos/eigs_lanczos.hpp>
+#include <xdiag/algorithms/lanczos/eigvals_lanczos.hpp>
+#include <xdiag/algorithms/lanczos/lanczos_checkpoint.hpp>
+#include <xdiag/algorithms/time_evolution/evolve_lanczos.hpp>
+#include <xdiag/algorithms/time_evolution/time_evolve.hpp>
+#include <xdiag/states/fill.hpp>
+#include <xdiag/states/random_state.hpp>
+#include <xdiag/utils/logger.hpp>
+
+#ifdef XDIAG_USE_HDF5
+
+using namespace xdiag;
+
+// Overwrites a field of the checkpoint of the calling process
+template <typename T>
+static void set_field(std::string const &filename, std::string const &field,
+                      T const &value) {
+  FileH5 file(lanczos::checkpoint_filename(filename), "a");
+  file[field] = value;
+}
+
+template <typename T>
+static T get_field(std::string const &filename, std::string const &field) {
+  FileH5 file(lanczos::checkpoint_filename(filename), "r");
+  return file[field].as<T>();
+}
+
+static void test_lanczos_checkpoint(OpSum const &ops, Spinhalf const &block) {
+  std::string filename = "test_lanczos_checkpoint.h5";
+  int64_t neigvals = 2;
+  int64_t interval = 5;
+
+  auto r = eigvals_lanczos(ops, block, neigvals);
+  auto rc =
+      eigvals_lanczos_checkpoint(ops, block, filename, interval, neigvals);
+  REQUIRE(rc.niterations == r.niterations);
+  REQUIRE(arma::norm(rc.eigenvalues - r.eigenvalues) < 1e-10);
+
+  // A run killed after nstop iterations is emulated by stopping at
+  // max_iterations = nstop. Its last checkpoint only differs from the one of
+  // an uninterrupted run in the stored maximal number of iterations.
+  int64_t nstop = interval * (r.niterations / (2 * interval));
+  REQUIRE(nstop > 0);
+  auto ri = eigvals_lanczos_checkpoint(ops, block, filename, interval,
+                                       neigvals, 1e-12, nstop);
+  REQUIRE(ri.niterations == nstop);
+  REQUIRE(ri.criterion == "maxiterations");
+  REQUIRE(get_field<int64_t>(filename, "lanczos/iteration") == nstop);
+  set_field(filename, "parameters/max_iterations", (int64_t)1000);
+  auto rr = eigvals_lanczos_resume(ops, block, filename, interval);
+  REQUIRE(rr.niterations == r.niterations);
+  REQUIRE(rr.criterion == r.criterion);
+  REQUIRE(arma::norm(rr.eigenvalues - r.eigenvalues) < 1e-10);
+
+  // Eigenvector computation interrupted during the first run
+  auto e = eigs_lanczos(ops, block, neigvals);
+  eigvals_lanczos_checkpoint(ops, block, filename, interval, neigvals, 1e-12,
+                             nstop);
+  set_field(filename, "parameters/max_iterations", (int64_t)1000);
+  auto er = eigs_lanczos_resume(ops, block, filename, interval);
+  REQUIRE(er.niterations == e.niterations);
+  REQUIRE(arma::norm(er.eigenvalues - e.eigenvalues) < 1e-10);
+  REQUIRE(isapprox(er.eigenvectors, e.eigenvectors, 1e-8, 1e-8));
+
+  // Eigenvector computation interrupted during the second run. If the
+  // number of iterations is not a multiple of the interval, the last
+  // checkpoint of the second run lies before its end, as it would after a
+  // crash.
+  int64_t interval2 = (e.niterations % 7 != 0) ? 7 : 6;
+  auto ec = eigs_lanczos_checkpoint(ops, block, filename, interval2, neigvals);
+  REQUIRE(isapprox(ec.eigenvectors, e.eigenvectors, 1e-8, 1e-8));
+  REQUIRE(get_field<int64_t>(filename, "phase") == 2);
+  int64_t iteration = get_field<int64_t>(filename, "lanczos/iteration");
+  REQUIRE(iteration > 0);
+  REQUIRE(iteration < e.niterations);
+  er = eigs_lanczos_resume(ops, block, filename, interval2);
+  REQUIRE(arma::norm(er.eigenvalues - e.eigenvalues) < 1e-10);
+  REQUIRE(isapprox(er.eigenvectors, e.eigenvectors, 1e-8, 1e-8));
+  std::remove(lanczos::checkpoint_filename(filename).c_str());
+}
+
+static void test_evolve_checkpoint(OpSum const &ops, Spinhalf const &block) {
+  std::string filename = "test_evolve_checkpoint.h5";
+  State psi0(block, isreal(block));
+  fill(psi0, RandomState(1234));
+  psi0 /= norm(psi0);
+
+  double time = 0.8;
+  auto psi = time_evolve(ops, psi0, time);
+  auto psic = time_evolve_checkpoint(ops, psi0, time, filename, 4);
+  REQUIRE(isapprox(psi, psic, 1e-8, 1e-8));
+
+  // Evolution killed after two of four steps, emulated by evolving half of
+  // the time in two steps of the same length
+  time_evolve_checkpoint(ops, psi0, time / 2, filename, 2);
+  set_field(filename, "evolution/nsteps", (int64_t)4);
+  set_field(filename, "evolution/time_final", time);
+  auto psir = time_evolve_resume(ops, block, filename);
+  REQUIRE(isapprox(psic, psir, 1e-10, 1e-10));
+  std::remove(lanczos::checkpoint_filename(filename).c_str());
+
+  // Imaginary time evolution keeps real states real
+  double tau = -0.5;
+  auto r = evolve_lanczos(ops, psi0, tau, 1e-12, 0., true);
+  auto rc = evolve_lanczos_checkpoint(ops, psi0, tau, filename, 4, 1e-12, 0.,
+                                      true);
+  REQUIRE(isreal(rc.state) == isreal(r.state));
+  REQUIRE(isapprox(r.state, rc.state, 1e-8, 1e-8));
+  evolve_lanczos_checkpoint(ops, psi0, tau / 2, filename, 2, 1e-12, 0., true);
+  set_field(filename, "evolution/nsteps", (int64_t)4);
+  set_field(filename, "evolution/tau", complex(tau));
+  auto rr = evolve_lanczos_resume(ops, block, filename);
+  REQUIRE(isreal(rr.state) == isreal(rc.state));
+  REQUIRE(isapprox(rc.state, rr.state, 1e-10, 1e-10));
+  std::remove(lanczos::checkpoint_filename(filename).c_str());
+}
+
+TEST_CASE("lanczos_checkpoint", "[lanczos]") try {
+  using xdiag::testcases::electron::get_cyclic_group_irreps;
+  Log("Testing Lanczos checkpoints");
+  int64_t nsites = 10;
+  auto ops = testcases::spinhalf::HBchain(nsites, 1.0, 0.3);
+
+  auto block = Spinhalf(nsites, nsites / 2);
+  test_lanczos_checkpoint(ops, block);
+  test_evolve_checkpoint(ops, block);
+
+  // Complex Lanczos vectors
+  auto irreps = get_cyclic_group_irreps(nsites);
+  auto block_complex = Spinhalf(nsites, nsites / 2, irreps[1]);
+  REQUIRE(!isreal(block_complex));
+  test_lanczos_checkpoint(ops, block_complex);
+  test_evolve_checkpoint(ops, block_complex);
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
+
+#endif
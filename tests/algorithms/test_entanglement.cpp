@@ -0,0 +1,323 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../catch.hpp"
+
+#include <xdiag/algebra/algebra.hpp>
+#include <xdiag/algebra/isapprox.hpp>
+#include <xdiag/algebra/matrix.hpp>
+#include <xdiag/algorithms/entanglement.hpp>
+#include <xdiag/bits/bitops.hpp>
+#include <xdiag/blocks/electron.hpp>
+#include <xdiag/blocks/spinhalf.hpp>
+#include <xdiag/blocks/tj.hpp>
+#include <xdiag/utils/logger.hpp>
+
+#include "../blocks/electron/testcases_electron.hpp"
+#include "../blocks/spinhalf/testcases_spinhalf.hpp"
+#include "../blocks/tj/testcases_tj.hpp"
+
+using namespace xdiag;
+
+// Reduced density matrix by explicitly tracing out B from the full vector
+static arma::cx_mat rdm_naive(arma::cx_vec const &psi, int64_t nsites,
+                              std::vector<int64_t> const &sites_A) {
+  uint64_t mask_A = 0;
+  for (auto s : sites_A) {
+    mask_A |= (uint64_t)1 << s;
+  }
+  uint64_t mask_B = (((uint64_t)1 << nsites) - 1) ^ mask_A;
+  int64_t dim_A = (int64_t)1 << sites_A.size();
+  int64_t dim_B = (int64_t)1 << (nsites - sites_A.size());
+  arma::cx_mat rho(dim_A, dim_A, arma::fill::zeros);
+  for (uint64_t a1 = 0; a1 < (uint64_t)dim_A; ++a1) {
+    for (uint64_t a2 = 0; a2 < (uint64_t)dim_A; ++a2) {
+      for (uint64_t b = 0; b < (uint64_t)dim_B; ++b) {
+        uint64_t s1 = bits::deposit(a1, mask_A) | bits::deposit(b, mask_B);
+        uint64_t s2 = bits::deposit(a2, mask_A) | bits::deposit(b, mask_B);
+        rho(a1, a2) += psi(s1) * std::conj(psi(s2));
+      }
+    }
+  }
+  return rho;
+}
+
+// Ground state by full diagonalization, such that states on different blocks
+// agree to machine precision
+template <class block_t>
+static std::pair<double, State> exact_ground_state(OpSum const &ops,
+                                                   block_t const &block) {
+  arma::cx_mat H = matrixC(ops, block);
+  arma::vec evals;
+  arma::cx_mat evecs;
+  arma::eig_sym(evals, evecs, H);
+  return {evals(0), State(block, arma::cx_vec(evecs.col(0)))};
+}
+
+// Entanglement spectrum of a Slater determinant of the lowest nup up and ndn
+// dn orbitals of the hopping matrix h, obtained from the eigenvalues nu of
+// the correlation matrix restricted to A
+static arma::vec slater_spectrum(arma::mat const &h, int64_t nup, int64_t ndn,
+                                 std::vector<int64_t> const &sites_A) {
+  arma::vec energies;
+  arma::mat orbitals;
+  arma::eig_sym(energies, orbitals, h);
+  arma::uvec rows(sites_A.size());
+  for (int64_t i = 0; i < (int64_t)sites_A.size(); ++i) {
+    rows(i) = sites_A[i];
+  }
+  int64_t n_A = sites_A.size();
+  auto spectrum_species = [&](int64_t n) {
+    arma::mat occupied = orbitals.cols(0, n - 1);
+    arma::mat C = occupied.rows(rows) * occupied.rows(rows).t();
+    arma::vec nu = arma::eig_sym(C);
+    arma::vec spectrum((int64_t)1 << n_A, arma::fill::ones);
+    for (int64_t config = 0; config < ((int64_t)1 << n_A); ++config) {
+      for (int64_t k = 0; k < n_A; ++k) {
+        spectrum(config) *= ((config >> k) & 1) ? nu(k) : 1.0 - nu(k);
+      }
+    }
+    return spectrum;
+  };
+  arma::vec spectrum = arma::vectorise(spectrum_species(nup) *
+                                       spectrum_species(ndn).t());
+  return arma::sort(spectrum, "descend");
+}
+
+// Checks that the reduced density matrices of two ground states agree
+static void check_rho(State const &gs1, State const &gs2,
+                      std::vector<std::vector<int64_t>> const &subsystems) {
+  for (auto sites_A : subsystems) {
+    arma::cx_mat rho1 = reduced_density_matrixC(gs1, sites_A);
+    arma::cx_mat rho2 = reduced_density_matrixC(gs2, sites_A);
+    REQUIRE(std::abs(arma::trace(rho1) - 1.0) < 1e-12);
+    REQUIRE(arma::norm(rho1 - rho1.t()) < 1e-12);
+    REQUIRE(arma::norm(rho1 - rho2) < 1e-10);
+  }
+}
+
+TEST_CASE("entanglement", "[algorithms]") {
+  using namespace xdiag::testcases::spinhalf;
+  using xdiag::testcases::electron::get_cyclic_group_irreps;
+
+  Log("entanglement: comparing reduced density matrices");
+  int64_t nsites = 8;
+  auto ops = HBchain(nsites, 1.0, 0.2);
+  std::vector<std::vector<int64_t>> subsystems = {
+      {0}, {0, 1}, {2, 3, 4}, {1, 4, 6}, {0, 1, 2, 3}, {7, 2, 5, 0, 3}};
+
+  auto [e0, gs] = exact_ground_state(ops, Spinhalf(nsites));
+  auto [e0_sz, gs_sz] = exact_ground_state(ops, Spinhalf(nsites, nsites / 2));
+  REQUIRE(isapprox(e0, e0_sz));
+  arma::cx_vec psi = gs.vectorC();
+
+  for (auto sites_A : subsystems) {
+    auto sorted = sites_A;
+    std::sort(sorted.begin(), sorted.end());
+    arma::cx_mat rho = rdm_naive(psi, nsites, sorted);
+    arma::cx_mat rho_nosz = reduced_density_matrixC(gs, sites_A);
+    arma::cx_mat rho_sz = reduced_density_matrixC(gs_sz, sites_A);
+    REQUIRE(arma::norm(rho - rho_nosz) < 1e-12);
+    REQUIRE(arma::norm(rho - rho_sz) < 1e-12);
+    REQUIRE(std::abs(arma::trace(rho_sz) - 1.0) < 1e-12);
+
+    arma::vec spectrum = entanglement_spectrum(gs_sz, sites_A);
+    arma::vec evals = arma::sort(arma::eig_sym(rho), "descend");
+    REQUIRE(arma::norm(spectrum - evals) < 1e-12);
+
+    double entropy = entanglement_entropy(gs_sz, sites_A);
+    double entropy_naive = 0.;
+    for (double lambda : evals) {
+      if (lambda > 1e-14) {
+        entropy_naive -= lambda * std::log(lambda);
+      }
+    }
+    REQUIRE(std::abs(entropy - entropy_naive) < 1e-10);
+  }
+
+  Log("entanglement: symmetric blocks");
+  auto irreps = get_cyclic_group_irreps(nsites);
+  double e0_sym = 1e12;
+  State gs_sym;
+  for (auto irrep : irreps) {
+    auto block = Spinhalf(nsites, nsites / 2, irrep);
+    auto [e, g] = exact_ground_state(ops, block);
+    if (e < e0_sym) {
+      e0_sym = e;
+      gs_sym = g;
+    }
+
+    // Entanglement of momentum eigenstates is translationally invariant
+    double s0 = entanglement_entropy(g, {0, 1, 2});
+    double s1 = entanglement_entropy(g, {1, 2, 3});
+    double s2 = entanglement_entropy(g, {5, 6, 7});
+    REQUIRE(std::abs(s0 - s1) < 1e-10);
+    REQUIRE(std::abs(s0 - s2) < 1e-10);
+    arma::cx_mat rho = reduced_density_matrixC(g, {0, 1, 2});
+    REQUIRE(std::abs(arma::trace(rho) - 1.0) < 1e-12);
+  }
+  REQUIRE(isapprox(e0, e0_sym));
+  for (auto sites_A : subsystems) {
+    arma::cx_mat rho = reduced_density_matrixC(gs_sz, sites_A);
+    arma::cx_mat rho_sym = reduced_density_matrixC(gs_sym, sites_A);
+    REQUIRE(arma::norm(rho - rho_sym) < 1e-12);
+  }
+}
+
+TEST_CASE("entanglement_fermions", "[algorithms]") {
+  using xdiag::testcases::electron::get_cyclic_group_irreps;
+  int64_t nsites = 6;
+  std::vector<std::vector<int64_t>> subsystems = {
+      {0}, {0, 1}, {0, 1, 2}, {1, 4, 5}, {0, 2, 4}, {5, 0, 3}, {3, 1, 2, 4}};
+
+  Log("entanglement: free fermions");
+  // Open chain with non-degenerate orbitals, such that the ground state at
+  // half filling is unique
+  OpSum ops_free;
+  arma::mat h(nsites, nsites, arma::fill::zeros);
+  for (int64_t s = 0; s < nsites - 1; ++s) {
+    double t = 1.0 + 0.1 * s;
+    ops_free += t * Op("Hop", {s, s + 1});
+    h(s, s + 1) = h(s + 1, s) = -t;
+  }
+  int64_t n = nsites / 2;
+  auto [e0, gs] = exact_ground_state(ops_free, Electron(nsites, n, n));
+  auto [e0_nonp, gs_nonp] = exact_ground_state(ops_free, Electron(nsites));
+  REQUIRE(isapprox(e0, e0_nonp));
+  for (auto sites_A : subsystems) {
+    auto sorted = sites_A;
+    std::sort(sorted.begin(), sorted.end());
+    arma::vec spectrum = slater_spectrum(h, n, n, sorted);
+    REQUIRE(arma::norm(entanglement_spectrum(gs, sites_A) - spectrum) <
+            1e-10);
+    REQUIRE(arma::norm(entanglement_spectrum(gs_nonp, sites_A) - spectrum) <
+            1e-10);
+  }
+  check_rho(gs, gs_nonp, subsystems);
+
+  Log("entanglement: Hubbard model on symmetric blocks");
+  // Hubbard ring at half filling and at quarter filling with a flux, such
+  // that the ground state has a complex momentum
+  auto irreps = get_cyclic_group_irreps(nsites);
+  std::vector<int64_t> bipartition = {0, 1, 0, 1, 0, 1};
+  std::vector<std::pair<double, int64_t>> fluxes_fillings = {{0.0, n},
+                                                             {0.2, n - 1}};
+  for (auto [phi, nf] : fluxes_fillings) {
+    OpSum ops;
+    for (int64_t s = 0; s < nsites; ++s) {
+      ops += complex(std::cos(phi), std::sin(phi)) *
+             Op("Hop", {s, (s + 1) % nsites});
+    }
+    ops += 4.0 * Op("HubbardU");
+    auto block = Electron(nsites, nf, nf);
+    arma::vec evals = arma::eig_sym(matrixC(ops, block));
+    REQUIRE(evals(1) - evals(0) > 1e-6);
+    auto [e0, gs] = exact_ground_state(ops, block);
+
+    double e0_sym = 1e12;
+    State gs_sym;
+    Representation irrep_sym;
+    for (auto irrep : irreps) {
+      auto [e, g] = exact_ground_state(ops, Electron(nsites, nf, nf, irrep));
+      if (e < e0_sym) {
+        e0_sym = e;
+        gs_sym = g;
+        irrep_sym = irrep;
+      }
+    }
+    REQUIRE(isapprox(e0, e0_sym));
+    REQUIRE(irrep_sym.isreal() == (phi == 0.0));
+    check_rho(gs_sym, gs, subsystems);
+
+    // Blocks projected by the spin flip and particle-hole symmetries
+    if (phi == 0.0) {
+      double e0_proj = 1e12;
+      State gs_proj;
+      for (auto irrep : irreps) {
+        for (int64_t spinflip : {1, -1}) {
+          for (int64_t particlehole : {1, -1}) {
+            auto block_proj = Electron(nsites, n, n, irrep, spinflip,
+                                       particlehole, bipartition);
+            if (block_proj.size() == 0) {
+              continue;
+            }
+            auto [e, g] = exact_ground_state(ops, block_proj);
+            if (e < e0_proj) {
+              e0_proj = e;
+              gs_proj = g;
+            }
+          }
+        }
+      }
+      REQUIRE(isapprox(e0, e0_proj));
+      check_rho(gs_proj, gs, subsystems);
+    }
+  }
+
+  Log("entanglement: tJ model");
+  auto ops_tj = testcases::tj::tJchain(nsites, 1.0, 0.4);
+  auto block_tj = tJ(nsites, 2, 2);
+  arma::vec evals = arma::eig_sym(matrixC(ops_tj, block_tj));
+  REQUIRE(evals(1) - evals(0) > 1e-6);
+  auto [e0_tj, gs_tj] = exact_ground_state(ops_tj, block_tj);
+
+  // The tJ state embedded into the Electron block without double occupancies
+  auto block_el = Electron(nsites, 2, 2);
+  arma::cx_vec psi_tj = gs_tj.vectorC();
+  arma::cx_vec psi_el(block_el.size(), arma::fill::zeros);
+  int64_t idx = 0;
+  for (auto pstate : block_tj) {
+    psi_el(block_el.index(pstate)) = psi_tj(idx);
+    ++idx;
+  }
+  auto gs_el = State(block_el, psi_el);
+  for (auto sites_A : subsystems) {
+    int64_t n_A = sites_A.size();
+    arma::cx_mat rho_tj = reduced_density_matrixC(gs_tj, sites_A);
+    arma::cx_mat rho_el = reduced_density_matrixC(gs_el, sites_A);
+    REQUIRE(std::abs(arma::trace(rho_tj) - 1.0) < 1e-12);
+
+    // labels of the configurations without double occupancies
+    std::vector<arma::uword> rows_tj, rows_el;
+    for (int64_t config = 0; config < std::pow(4, n_A); ++config) {
+      int64_t label_tj = 0;
+      int64_t power = 1;
+      bool doublon = false;
+      for (int64_t i = 0, c = config; i < n_A; ++i, c /= 4) {
+        doublon |= (c % 4 == 3);
+        label_tj += (c % 4) * power;
+        power *= 3;
+      }
+      if (!doublon) {
+        rows_tj.push_back(label_tj);
+        rows_el.push_back(config);
+      }
+    }
+    arma::uvec r_tj(rows_tj), r_el(rows_el);
+    REQUIRE(arma::norm(rho_tj.submat(r_tj, r_tj) - rho_el.submat(r_el, r_el)) <
+            1e-12);
+    REQUIRE(arma::norm(entanglement_spectrum(gs_tj, sites_A) -
+                       entanglement_spectrum(gs_el, sites_A).head(
+                           std::pow(3, n_A))) < 1e-12);
+  }
+
+  // Symmetric tJ blocks with and without spin flip
+  std::vector<std::vector<int64_t>> spinflip_sets = {{0}, {1, -1}};
+  for (auto spinflips : spinflip_sets) {
+    double e0_sym = 1e12;
+    State gs_sym;
+    for (auto irrep : irreps) {
+      for (int64_t spinflip : spinflips) {
+        auto [e, g] =
+            exact_ground_state(ops_tj, tJ(nsites, 2, 2, irrep, spinflip));
+        if (e < e0_sym) {
+          e0_sym = e;
+          gs_sym = g;
+        }
+      }
+    }
+    REQUIRE(isapprox(e0_tj, e0_sym));
+    check_rho(gs_sym, gs_tj, subsystems);
+  }
+}
@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../../catch.hpp"
+
+#include <cstdio>
+
+#include <xdiag/algebra/matrix.hpp>
+#include <xdiag/basis/basis_cache.hpp>
+#include <xdiag/blocks/spinhalf.hpp>
+#include <xdiag/utils/logger.hpp>
+
+#include "../../blocks/electron/testcases_electron.hpp"
+#include "../../blocks/spinhalf/testcases_spinhalf.hpp"
+
+using namespace xdiag;
+
+static Spinhalf create(int64_t nsites, std::optional<int64_t> nup,
+                       Representation const &irrep, std::string backend) {
+  return nup ? Spinhalf(nsites, *nup, irrep, backend)
+             : Spinhalf(nsites, irrep, backend);
+}
+
+TEST_CASE("spinhalf_basis_cache", "[spinhalf]") try {
+  using xdiag::testcases::electron::get_cyclic_group_irreps;
+  Log("spinhalf_basis_cache");
+
+  std::string directory = basis_cache_directory();
+  set_basis_cache_directory(".");
+
+  int64_t nsites = 6;
+  auto ops = testcases::spinhalf::HBchain(nsites, 1.0, 0.3);
+  std::vector<std::optional<int64_t>> nups = {std::nullopt};
+  for (int64_t nup = 0; nup <= nsites; ++nup) {
+    nups.push_back(nup);
+  }
+
+  for (auto irrep : get_cyclic_group_irreps(nsites)) {
+    for (std::string backend : {"auto", "32bit", "64bit", "1sublattice"}) {
+      for (auto nup : nups) {
+        if (!nup && (backend == "1sublattice")) {
+          continue;
+        }
+        // The first block is computed and written, the second one is read
+        int64_t hits = basis::cache_hits();
+        auto block = create(nsites, nup, irrep, backend);
+        REQUIRE(basis::cache_hits() == hits);
+        auto block_cached = create(nsites, nup, irrep, backend);
+        REQUIRE(basis::cache_hits() == hits + 1);
+        REQUIRE(block == block_cached);
+        REQUIRE(block.dim() == block_cached.dim());
+        int64_t idx = 0;
+        for (auto pstate : block_cached) {
+          REQUIRE(block.index(pstate) == idx);
+          ++idx;
+        }
+        if (block.dim() > 0) {
+          arma::cx_mat m = matrixC(ops, block);
+          arma::cx_mat m_cached = matrixC(ops, block_cached);
+          REQUIRE(arma::norm(m - m_cached) < 1e-12);
+        }
+        // For "auto", the file is keyed by the chosen backend
+        for (std::string b : {"32bit", "64bit", "1sublattice"}) {
+          std::remove(
+              basis::cache_filename(basis::cache_key(block, b)).c_str());
+        }
+      }
+    }
+  }
+
+  // A file with the key of a block, but different characters in its header
+  // is not read
+  auto irrep = get_cyclic_group_irreps(nsites)[1];
+  auto block = Spinhalf(nsites, nsites / 2, irrep, "32bit");
+  auto header = basis::cache_header(block, "32bit");
+  header.characters_real[1] += 1.0;
+  std::string filename = basis::cache_filename(header.key);
+  basis::write_cache(filename, header, [](std::ostream &) {});
+  int64_t hits = basis::cache_hits();
+  auto block_recomputed = Spinhalf(nsites, nsites / 2, irrep, "32bit");
+  REQUIRE(basis::cache_hits() == hits);
+  REQUIRE(block_recomputed.dim() == block.dim());
+  auto block_read = Spinhalf(nsites, nsites / 2, irrep, "32bit");
+  REQUIRE(basis::cache_hits() == hits + 1);
+  REQUIRE(block_read.dim() == block.dim());
+  std::remove(filename.c_str());
+
+  set_basis_cache_directory(directory);
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
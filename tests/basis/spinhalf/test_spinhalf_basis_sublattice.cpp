@@ -82,6 +82,27 @@ void compare_indices_no_sz(Basis1 const &basis1, Basis2 const &basis2) {
   }
 }
 
+template <class bit_t, int n_sublat>
+void test_dense_index(std::string const &lfile,
+                      std::vector<std::string> const &irrep_names) {
+  using basis_t = basis::spinhalf::BasisSublattice<bit_t, n_sublat>;
+  auto fl = FileToml(lfile);
+  for (auto irrep_name : irrep_names) {
+    auto irrep = read_representation(fl, irrep_name);
+    auto idxng = basis_t(irrep);
+    auto idxng_dense = basis_t(irrep, true);
+    REQUIRE(!idxng.dense_index());
+    REQUIRE(idxng_dense.dense_index());
+    REQUIRE(idxng_dense.index_memory() > 0);
+    compare_indices_no_sz<bit_t, basis_t, basis_t>(idxng, idxng_dense);
+    for (int nup = 0; nup <= idxng.nsites(); ++nup) {
+      auto idxng = basis_t(nup, irrep);
+      auto idxng_dense = basis_t(nup, irrep, true);
+      compare_indices_sz<bit_t, basis_t, basis_t>(idxng, idxng_dense, nup);
+    }
+  }
+}
+
 template <class bit_t> void test_spinhalf_basis_sublattice() {
   using basis_no_sz_t = basis::spinhalf::BasisSymmetricNoSz<bit_t>;
   using basis_sz_t = basis::spinhalf::BasisSymmetricSz<bit_t>;
@@ -246,11 +267,36 @@ template <class bit_t> void test_spinhalf_basis_sublattice() {
   }
 }
 
+template <class bit_t> void test_spinhalf_basis_sublattice_dense_index() {
+  Log("basis_spinhalf_sublattice: dense index");
+  test_dense_index<bit_t, 1>(
+      XDIAG_DIRECTORY "/misc/data/square.8.heisenberg.2sl.toml",
+      {"Gamma.D4.A1", "Gamma.D4.E", "M.D4.B2", "X.D2.A2"});
+  test_dense_index<bit_t, 2>(
+      XDIAG_DIRECTORY "/misc/data/square.8.heisenberg.2sl.toml",
+      {"Gamma.D4.A1", "Gamma.D4.E", "M.D4.B2", "X.D2.A2"});
+  test_dense_index<bit_t, 3>(
+      XDIAG_DIRECTORY "/misc/data/square.9.heisenberg.3sl.toml",
+      {"Gamma.D2.A1", "Gamma.D2.B2", "Delta.C1.A", "Sigma1.D1.B"});
+  test_dense_index<bit_t, 3>(
+      XDIAG_DIRECTORY
+      "/misc/data/triangular.9.Jz1Jz2Jx1Jx2D1.sublattices.tsl.toml",
+      {"Gamma.D6.A1", "Gamma.D6.E2", "K.D3.A2", "Y.D1.B"});
+  test_dense_index<bit_t, 4>(
+      XDIAG_DIRECTORY "/misc/data/square.8.heisenberg.4sl.toml",
+      {"Gamma.D4.A1", "Gamma.D4.E", "M.D4.B2", "X.D2.A2"});
+  test_dense_index<bit_t, 5>(
+      XDIAG_DIRECTORY "/misc/data/square.10.heisenberg.5sl.toml",
+      {"Gamma.C2.A", "Delta1.C1.A", "X.C2.B", "Z3.C1.A"});
+}
+
 TEST_CASE("basis_spinhalf_sublattice", "[symmetries]") {
   Log("Test basis_spinhalf_sublattice");
   Log("uint32_t");
   test_spinhalf_basis_sublattice<uint32_t>();
   Log("uint64_t");
   test_spinhalf_basis_sublattice<uint64_t>();
+  test_spinhalf_basis_sublattice_dense_index<uint32_t>();
+  test_spinhalf_basis_sublattice_dense_index<uint64_t>();
   Log("Done");
 }
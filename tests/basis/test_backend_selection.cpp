@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../catch.hpp"
+
+#include <xdiag/basis/backend_selection.hpp>
+#include <xdiag/blocks/spinhalf.hpp>
+#include <xdiag/io/file_toml.hpp>
+#include <xdiag/io/read.hpp>
+#include <xdiag/utils/logger.hpp>
+
+#include "../blocks/electron/testcases_electron.hpp"
+
+using namespace xdiag;
+
+// Restores the memory limit when leaving the scope, also if a check fails
+struct MemoryLimitGuard {
+  int64_t limit = memory_limit();
+  ~MemoryLimitGuard() { set_memory_limit(limit); }
+};
+
+TEST_CASE("backend_selection", "[basis]") try {
+  using basis::BackendEstimate;
+  using basis::choose_backend;
+  using xdiag::testcases::electron::get_cyclic_group_irreps;
+  Log("backend_selection");
+
+  std::vector<BackendEstimate> estimates = {
+      {"a", 100, 1.0}, {"b", 10, 5.0}, {"c", 10, 3.0}, {"d", 20, 3.0}};
+  REQUIRE(choose_backend(estimates, 0) == "a");
+  REQUIRE(choose_backend(estimates, 100) == "a");
+  REQUIRE(choose_backend(estimates, 50) == "c");
+  REQUIRE(choose_backend(estimates, 5) == "b");
+
+  using basis::split_backend_suffix;
+  auto [base, dense] = split_backend_suffix("2sublattice_dense", "_dense");
+  REQUIRE(base == "2sublattice");
+  REQUIRE(dense);
+  std::tie(base, dense) = split_backend_suffix("32bit", "_fermi_lookup");
+  REQUIRE(base == "32bit");
+  REQUIRE(!dense);
+  std::tie(base, dense) = split_backend_suffix("_dense", "_dense");
+  REQUIRE(base == "_dense");
+  REQUIRE(!dense);
+
+  // The translations of a chain are only stable for a single sublattice, and
+  // the lookup tables are chosen without a memory limit
+  int64_t nsites = 8;
+  auto irrep = get_cyclic_group_irreps(nsites)[1];
+  estimates = basis::backend_estimates_spinhalf(nsites, nsites / 2, irrep, 0);
+  for (auto const &e : estimates) {
+    REQUIRE(e.memory > 0);
+    REQUIRE(((e.backend == "32bit") || (e.backend == "1sublattice") ||
+             (e.backend == "1sublattice_dense")));
+  }
+  REQUIRE(choose_backend(estimates, 0) == "32bit");
+
+  // Fermi signs are evaluated on the fly if the tables do not fit
+  nsites = 16;
+  irrep = get_cyclic_group_irreps(nsites)[0];
+  for (auto es : {basis::backend_estimates_tj(nsites, 4, 4, irrep),
+                  basis::backend_estimates_electron(nsites, 4, 4, irrep),
+                  basis::backend_estimates_electron(nsites, std::nullopt,
+                                                    std::nullopt, irrep)}) {
+    REQUIRE(es.size() == 2);
+    REQUIRE(es[0].backend == "32bit");
+    REQUIRE(es[1].backend == "32bit_fermi_lookup");
+    REQUIRE(es[1].memory < es[0].memory);
+    REQUIRE(choose_backend(es, 0) == "32bit");
+    REQUIRE(choose_backend(es, es[1].memory) == "32bit_fermi_lookup");
+  }
+
+  // On the 3x3 triangular lattice the 3 sublattice backend needs less memory
+  // than the lookup tables away from the fully polarized sectors, and is
+  // chosen under a small memory limit
+  nsites = 9;
+  std::string lfile = XDIAG_DIRECTORY
+      "/misc/data/triangular.9.Jz1Jz2Jx1Jx2D1.sublattices.tsl.toml";
+  auto fl = FileToml(lfile);
+  irrep = read_representation(fl, "Gamma.D6.A1");
+  estimates = basis::backend_estimates_spinhalf(nsites, 4, irrep, 0);
+  REQUIRE(choose_backend(estimates, 0) == "32bit");
+  REQUIRE(choose_backend(estimates, 1) == "3sublattice_dense");
+
+  MemoryLimitGuard guard;
+  set_memory_limit(1);
+  REQUIRE(memory_limit() == 1);
+  for (int64_t nup = 2; nup <= nsites - 2; ++nup) {
+    auto block = Spinhalf(nsites, nup, irrep);
+    REQUIRE(block == Spinhalf(nsites, nup, irrep, "3sublattice_dense"));
+    REQUIRE(block.size() == Spinhalf(nsites, nup, irrep, "32bit").size());
+  }
+  REQUIRE_THROWS(set_memory_limit(-1));
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
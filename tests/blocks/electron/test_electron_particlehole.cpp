@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../../catch.hpp"
+
+#include "../electron/testcases_electron.hpp"
+
+#include <xdiag/algebra/apply.hpp>
+#include <xdiag/algebra/matrix.hpp>
+#include <xdiag/operators/logic/block.hpp>
+#include <xdiag/operators/logic/isapprox.hpp>
+#include <xdiag/operators/logic/particlehole.hpp>
+#include <xdiag/operators/logic/qns.hpp>
+#include <xdiag/utils/logger.hpp>
+
+using namespace xdiag;
+
+static arma::vec eigenvalues(OpSum const &ops, Electron const &block) {
+  arma::cx_mat H = matrixC(ops, block);
+  REQUIRE(arma::norm(H - H.t()) < 1e-10);
+  arma::vec eigs;
+  arma::eig_sym(eigs, H);
+  return eigs;
+}
+
+static std::vector<int64_t> alternating(int64_t nsites) {
+  std::vector<int64_t> bipartition(nsites);
+  for (int64_t i = 0; i < nsites; ++i) {
+    bipartition[i] = i % 2;
+  }
+  return bipartition;
+}
+
+// The blocks with particle-hole parity +1 and -1, optionally combined with
+// the spin flip, together reproduce the spectrum of the half filled block
+static void test_particlehole_spectra(OpSum const &ops, int64_t nsites) {
+  auto irreps = testcases::electron::get_cyclic_group_irreps(nsites);
+  auto bipartition = alternating(nsites);
+  int64_t n = nsites / 2;
+  for (auto const &irrep : irreps) {
+    auto block = Electron(nsites, n, n, irrep);
+    arma::vec eigs = eigenvalues(ops, block);
+
+    for (int64_t spinflip : {0, 1, -1}) {
+      auto block_even =
+          Electron(nsites, n, n, irrep, spinflip, 1, bipartition);
+      auto block_odd =
+          Electron(nsites, n, n, irrep, spinflip, -1, bipartition);
+      REQUIRE(block_even != block_odd);
+      REQUIRE(block_even != block);
+      if (spinflip == 0) {
+        REQUIRE(block_even.size() + block_odd.size() == block.size());
+      }
+      arma::vec eigs_ph = arma::join_cols(eigenvalues(ops, block_even),
+                                          eigenvalues(ops, block_odd));
+      if (spinflip != 0) {
+        auto block_flip = Electron(nsites, n, n, irrep, -spinflip);
+        arma::vec eigs_flip = eigenvalues(ops, block_flip);
+        eigs_ph = arma::join_cols(eigs_ph, eigs_flip);
+      }
+      eigs_ph = arma::sort(eigs_ph);
+      REQUIRE(eigs.n_elem == eigs_ph.n_elem);
+      REQUIRE(arma::norm(eigs - eigs_ph) < 1e-8);
+
+      for (auto const &b : {block_even, block_odd}) {
+        // apply agrees with the matrix
+        arma::cx_mat H = matrixC(ops, b);
+        arma::cx_vec v(b.size(), arma::fill::randn);
+        arma::cx_vec w(b.size(), arma::fill::zeros);
+        apply(ops, b, v, b, w);
+        REQUIRE(arma::norm(H * v - w) < 1e-10);
+
+        // iteration yields one product state per basis state
+        int64_t idx = 0;
+        for (auto pstate : b) {
+          REQUIRE(b.index(pstate) == idx);
+          ++idx;
+        }
+        REQUIRE(idx == b.size());
+      }
+    }
+  }
+}
+
+TEST_CASE("electron_particlehole", "[electron]") try {
+  Log("Testing particle-hole symmetry of Electron blocks");
+  for (int64_t nsites : {2, 4, 6}) {
+    auto ops = testcases::electron::get_linear_chain(nsites, 1.0, 5.0);
+    for (int64_t s = 0; s < nsites; ++s) {
+      ops += 0.4 * Op("SdotS", {s, (s + 1) % nsites});
+    }
+    test_particlehole_spectra(ops, nsites);
+  }
+
+  // The particle-hole parity of the block of an operator
+  int64_t nsites = 4;
+  auto irrep = testcases::electron::get_cyclic_group_irreps(nsites)[0];
+  auto bipartition = alternating(nsites);
+  auto block_even = Electron(nsites, 2, 2, irrep, 0, 1, bipartition);
+  auto block_odd = Electron(nsites, 2, 2, irrep, 0, -1, bipartition);
+  OpSum sz;
+  for (int64_t i = 0; i < nsites; ++i) {
+    sz += Op("Sz", i);
+  }
+  auto H = testcases::electron::get_linear_chain(nsites, 1.0, 5.0);
+  REQUIRE(*block(sz, block_even).particlehole() == -1);
+  REQUIRE(*block(H, block_even).particlehole() == 1);
+  REQUIRE(blocks_match(sz, block_even, block_odd));
+  REQUIRE(!blocks_match(H, block_even, block_odd));
+
+  // hoppings within a sublattice break the particle-hole symmetry
+  OpSum H_nnn = H;
+  for (int64_t s = 0; s < nsites; ++s) {
+    H_nnn += 0.3 * Op("Hop", {s, (s + 2) % nsites});
+  }
+  REQUIRE(!particlehole_parity(H_nnn, bipartition));
+  REQUIRE_THROWS(block(H_nnn, block_even));
+
+  REQUIRE_THROWS(Electron(nsites, 2, 1, irrep, 0, 1, bipartition));
+  REQUIRE_THROWS(Electron(nsites, 1, 1, irrep, 0, 1, bipartition));
+  REQUIRE_THROWS(Electron(nsites, 2, 2, irrep, 0, 2, bipartition));
+  REQUIRE_THROWS(Electron(nsites, 2, 2, irrep, 0, 1, {0, 1, 0}));
+  REQUIRE_THROWS(Electron(nsites, 2, 2, irrep, 0, 1, {0, 1, 0, 2}));
+  REQUIRE_THROWS(Electron(nsites, 2, 2, irrep, 0, 1, {0, 0, 1, 1}));
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
+
+TEST_CASE("electron_particlehole_operators", "[operators]") try {
+  Log("Testing particle-hole transformation of fermionic operators");
+  std::vector<int64_t> bipartition = {0, 1, 0, 1};
+  REQUIRE(isapprox(particlehole(OpSum(Op("Nup", 1)), bipartition),
+                   OpSum(Op("Id")) - Op("Nup", 1)));
+  REQUIRE(isapprox(particlehole(OpSum(Op("Hop", {0, 1})), bipartition),
+                   OpSum(Op("Hop", {0, 1}))));
+  REQUIRE(isapprox(particlehole(OpSum(Op("Hop", {0, 2})), bipartition),
+                   -1.0 * Op("Hop", {0, 2})));
+  REQUIRE(isapprox(particlehole(OpSum(Op("Sz", 3)), bipartition),
+                   -1.0 * Op("Sz", 3)));
+  REQUIRE_THROWS(particlehole(OpSum(Op("Cdagup", 0)), bipartition));
+  REQUIRE_THROWS(particlehole(OpSum(Op("Nup", 4)), bipartition));
+
+  auto H = testcases::electron::get_linear_chain(4, 1.0, 5.0);
+  REQUIRE(*particlehole_parity(H, bipartition) == 1);
+  REQUIRE(!particlehole_parity(OpSum(Op("Ntot", 0)), bipartition));
+  REQUIRE(!particlehole_parity(
+      OpSum(complex(1.0, 0.3) * Op("Hop", {0, 1})), bipartition));
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
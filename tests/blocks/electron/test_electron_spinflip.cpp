@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../../catch.hpp"
+
+#include "../electron/testcases_electron.hpp"
+
+#include <xdiag/algebra/apply.hpp>
+#include <xdiag/algebra/matrix.hpp>
+#include <xdiag/operators/logic/block.hpp>
+#include <xdiag/operators/logic/isapprox.hpp>
+#include <xdiag/operators/logic/qns.hpp>
+#include <xdiag/operators/logic/spinflip.hpp>
+#include <xdiag/utils/logger.hpp>
+
+using namespace xdiag;
+
+static arma::vec eigenvalues(OpSum const &ops, Electron const &block) {
+  arma::cx_mat H = matrixC(ops, block);
+  REQUIRE(arma::norm(H - H.t()) < 1e-10);
+  arma::vec eigs;
+  arma::eig_sym(eigs, H);
+  return eigs;
+}
+
+// The blocks with spin flip parity +1 and -1 together reproduce the
+// spectrum of the block without spin flip symmetry
+static void test_spinflip_spectra(OpSum const &ops, int64_t nsites) {
+  auto irreps = testcases::electron::get_cyclic_group_irreps(nsites);
+  for (int64_t n = 0; n <= nsites; ++n) {
+    for (auto const &irrep : irreps) {
+      auto block = Electron(nsites, n, n, irrep);
+      auto block_even = Electron(nsites, n, n, irrep, 1);
+      auto block_odd = Electron(nsites, n, n, irrep, -1);
+      REQUIRE(block_even.size() + block_odd.size() == block.size());
+      REQUIRE(block_even != block_odd);
+      REQUIRE(block_even != block);
+
+      arma::vec eigs = eigenvalues(ops, block);
+      arma::vec eigs_even = eigenvalues(ops, block_even);
+      arma::vec eigs_odd = eigenvalues(ops, block_odd);
+      arma::vec eigs_flip = arma::sort(arma::join_cols(eigs_even, eigs_odd));
+      REQUIRE(eigs.n_elem == eigs_flip.n_elem);
+      REQUIRE(arma::norm(eigs - eigs_flip) < 1e-8);
+
+      for (auto const &b : {block_even, block_odd}) {
+        // apply agrees with the matrix
+        arma::cx_mat H = matrixC(ops, b);
+        arma::cx_vec v(b.size(), arma::fill::randn);
+        arma::cx_vec w(b.size(), arma::fill::zeros);
+        apply(ops, b, v, b, w);
+        REQUIRE(arma::norm(H * v - w) < 1e-10);
+
+        // iteration yields one product state per basis state
+        int64_t idx = 0;
+        for (auto pstate : b) {
+          REQUIRE(b.index(pstate) == idx);
+          ++idx;
+        }
+        REQUIRE(idx == b.size());
+      }
+    }
+  }
+}
+
+TEST_CASE("electron_spinflip", "[electron]") try {
+  Log("Testing spin flip symmetry of Electron blocks");
+  for (int64_t nsites = 3; nsites <= 6; ++nsites) {
+    auto ops = testcases::electron::get_linear_chain(nsites, 1.0, 5.0);
+    for (int64_t s = 0; s < nsites; ++s) {
+      ops += 0.4 * Op("SdotS", {s, (s + 1) % nsites});
+    }
+    test_spinflip_spectra(ops, nsites);
+
+    // complex hoppings of both spin species are spin flip symmetric
+    OpSum ops_complex;
+    for (int64_t s = 0; s < nsites; ++s) {
+      ops_complex += complex(1.0, 0.3) * Op("Hop", {s, (s + 1) % nsites});
+    }
+    ops_complex += 3.0 * Op("HubbardU");
+    test_spinflip_spectra(ops_complex, nsites);
+  }
+
+  // The spin flip parity of the block of an operator
+  int64_t nsites = 4;
+  auto irrep = testcases::electron::get_cyclic_group_irreps(nsites)[0];
+  auto block_even = Electron(nsites, 2, 2, irrep, 1);
+  auto block_odd = Electron(nsites, 2, 2, irrep, -1);
+  OpSum sz;
+  for (int64_t i = 0; i < nsites; ++i) {
+    sz += Op("Sz", i);
+  }
+  auto H = testcases::electron::get_linear_chain(nsites, 1.0, 5.0);
+  REQUIRE(*block(sz, block_even).spinflip() == -1);
+  REQUIRE(*block(H, block_even).spinflip() == 1);
+  REQUIRE(blocks_match(sz, block_even, block_odd));
+  REQUIRE(!blocks_match(H, block_even, block_odd));
+
+  REQUIRE_THROWS(Electron(nsites, 2, 1, irrep, 1));
+  REQUIRE_THROWS(Electron(nsites, 2, 2, irrep, 2));
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
+
+TEST_CASE("electron_spinflip_operators", "[operators]") try {
+  Log("Testing spin flip of fermionic operators");
+  REQUIRE(isapprox(spinflip(OpSum(Op("Hopup", {0, 1}))),
+                   OpSum(Op("Hopdn", {0, 1}))));
+  REQUIRE(isapprox(spinflip(OpSum(Op("Cdagdn", 2))), OpSum(Op("Cdagup", 2))));
+  REQUIRE(isapprox(spinflip(OpSum(Op("Nup", 1))), OpSum(Op("Ndn", 1))));
+  REQUIRE(isapprox(spinflip(OpSum(Op("HubbardU"))), OpSum(Op("HubbardU"))));
+  auto H = testcases::electron::get_linear_chain(4, 1.0, 5.0);
+  REQUIRE(*spinflip_parity(H) == 1);
+  REQUIRE(!spinflip_parity(OpSum(Op("Hopup", {0, 1}))));
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
@@ -37,6 +37,10 @@ void test_electron_symmetric_spectra_no_np(
 
       REQUIRE(H_no_np.is_hermitian(1e-8));
 
+      auto block_lookup = Electron(nsites, irrep, "auto_fermi_lookup");
+      auto H_lookup = matrixC(opsum, block_lookup, block_lookup);
+      REQUIRE(arma::norm(H_no_np - H_lookup) < 1e-12);
+
       arma::vec eigs_no_np;
       arma::eig_sym(eigs_no_np, H_no_np);
 
@@ -104,6 +108,12 @@ void test_electron_symmetric_spectra(OpSum opsum, int64_t nsites,
             auto H_sym = matrixC(opsum, electron, electron);
             REQUIRE(arma::norm(H_sym - H_sym.t()) < 1e-12);
 
+            // Fermi signs evaluated on the fly agree with the tables
+            auto electron_lookup =
+                Electron(nsites, nup, ndn, irrep, "auto_fermi_lookup");
+            auto H_lookup = matrixC(opsum, electron_lookup, electron_lookup);
+            REQUIRE(arma::norm(H_sym - H_lookup) < 1e-12);
+
             // REQUIRE(H_sym.is_hermitian(1e-7));
             arma::vec eigs_sym_k;
             arma::eig_sym(eigs_sym_k, H_sym);
@@ -48,28 +48,30 @@ TEST_CASE("electron_distributed_apply", "[electron_distributed]") try {
   int N = 4;
 
   // Play-around test
-  for (int nup = 0; nup <= N; ++nup) {
-    for (int ndn = 0; ndn <= N; ++ndn) {
-      auto block = ElectronDistributed(N, nup, ndn);
-      OpSum ops;
-      for (int i = 0; i < N; ++i) {
-        ops += "Jz" * Op("SzSz", {i, (i + 1) % N});
-        ops += "Jx" * Op("Exchange", {i, (i + 1) % N});
-        ops += "TDN" * Op("Hopdn", {i, (i + 1) % N});
-        ops += "TUP" * Op("Hopup", {i, (i + 1) % N});
+  for (std::string partition : {"hash", "balanced"}) {
+    for (int nup = 0; nup <= N; ++nup) {
+      for (int ndn = 0; ndn <= N; ++ndn) {
+        auto block = ElectronDistributed(N, nup, ndn, "auto", partition);
+        OpSum ops;
+        for (int i = 0; i < N; ++i) {
+          ops += "Jz" * Op("SzSz", {i, (i + 1) % N});
+          ops += "Jx" * Op("Exchange", {i, (i + 1) % N});
+          ops += "TDN" * Op("Hopdn", {i, (i + 1) % N});
+          ops += "TUP" * Op("Hopup", {i, (i + 1) % N});
+        }
+        ops["Jz"] = 1.32;
+        ops["Jx"] = complex(.432, .576);
+        ops["TDN"] = complex(-0.1432, .3576);
+        ops["TUP"] = complex(-0.4321, .5763); // 2.104;
+
+        ops += 8.34 * Op("HubbardU");
+
+        double e0 = eigval0(ops, block);
+        auto block2 = Electron(N, nup, ndn);
+        double e02 = eigval0(ops, block2);
+        // Log("{} {} {:.12f} {:.12f}", nup, ndn, e0, e02);
+        REQUIRE(isapprox(e0, e02));
       }
-      ops["Jz"] = 1.32;
-      ops["Jx"] = complex(.432, .576);
-      ops["TDN"] = complex(-0.1432, .3576);
-      ops["TUP"] = complex(-0.4321, .5763); // 2.104;
-
-      ops += 8.34 * Op("HubbardU");
-
-      double e0 = eigval0(ops, block);
-      auto block2 = Electron(N, nup, ndn);
-      double e02 = eigval0(ops, block2);
-      // Log("{} {} {:.12f} {:.12f}", nup, ndn, e0, e02);
-      REQUIRE(isapprox(e0, e02));
     }
   }
 
@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../../catch.hpp"
+
+#include "../electron/testcases_electron.hpp"
+#include "../spinhalf/testcases_spinhalf.hpp"
+
+#include <xdiag/algebra/algebra.hpp>
+#include <xdiag/algebra/apply.hpp>
+#include <xdiag/algebra/isapprox.hpp>
+#include <xdiag/algebra/matrix.hpp>
+#include <xdiag/io/file_toml.hpp>
+#include <xdiag/io/read.hpp>
+#include <xdiag/operators/logic/block.hpp>
+#include <xdiag/operators/logic/isapprox.hpp>
+#include <xdiag/operators/logic/qns.hpp>
+#include <xdiag/operators/logic/spinflip.hpp>
+#include <xdiag/states/fill.hpp>
+#include <xdiag/states/random_state.hpp>
+#include <xdiag/utils/logger.hpp>
+
+using namespace xdiag;
+
+static arma::vec eigenvalues(OpSum const &ops, Spinhalf const &block) {
+  arma::cx_mat H = matrixC(ops, block);
+  REQUIRE(arma::norm(H - H.t()) < 1e-10);
+  arma::vec eigs;
+  arma::eig_sym(eigs, H);
+  return eigs;
+}
+
+// The blocks with spin flip parity +1 and -1 together reproduce the
+// spectrum of the block without spin flip symmetry
+static void test_spinflip_spectra(OpSum const &ops,
+                                  std::vector<Representation> const &irreps,
+                                  std::string backend) {
+  for (auto const &irrep : irreps) {
+    int64_t nsites = irrep.group().nsites();
+    int64_t nup = nsites / 2;
+    auto block = Spinhalf(nsites, nup, irrep, backend);
+    auto block_even = Spinhalf(nsites, nup, irrep, 1, backend);
+    auto block_odd = Spinhalf(nsites, nup, irrep, -1, backend);
+    REQUIRE(block_even.size() + block_odd.size() == block.size());
+    REQUIRE(*block_even.spinflip() == 1);
+    REQUIRE(*block_odd.spinflip() == -1);
+    REQUIRE(block_even != block_odd);
+    REQUIRE(block_even != block);
+
+    arma::vec eigs = eigenvalues(ops, block);
+    arma::vec eigs_even = eigenvalues(ops, block_even);
+    arma::vec eigs_odd = eigenvalues(ops, block_odd);
+    arma::vec eigs_flip = arma::sort(arma::join_cols(eigs_even, eigs_odd));
+    REQUIRE(eigs.n_elem == eigs_flip.n_elem);
+    REQUIRE(arma::norm(eigs - eigs_flip) < 1e-8);
+
+    // apply agrees with the matrix
+    if (block_even.size() > 0) {
+      auto H = matrixC(ops, block_even);
+      auto psi = State(block_even, false);
+      fill(psi, RandomState(42));
+      auto phi = apply(ops, psi);
+      REQUIRE(arma::norm(H * psi.vectorC() - phi.vectorC()) < 1e-10);
+    }
+  }
+}
+
+TEST_CASE("spinhalf_spinflip", "[spinhalf]") try {
+  Log("Testing spin flip symmetry of Spinhalf blocks");
+  for (int64_t nsites = 4; nsites <= 10; nsites += 2) {
+    auto ops = testcases::spinhalf::HBchain(nsites, 1.0, 0.4);
+    auto irreps = testcases::electron::get_cyclic_group_irreps(nsites);
+    test_spinflip_spectra(ops, irreps, "auto");
+    test_spinflip_spectra(ops, irreps, "64bit");
+    test_spinflip_spectra(ops, irreps, "1sublattice");
+  }
+
+  std::string lfile =
+      XDIAG_DIRECTORY "/misc/data/square.8.heisenberg.2sl.toml";
+  auto fl = FileToml(lfile);
+  auto ops = read_opsum(fl, "Interactions");
+  ops["J"] = 1.0;
+  std::vector<Representation> irreps;
+  for (auto name : {"Gamma.D4.A1", "Gamma.D4.B2", "M.D4.A1", "M.D4.E",
+                    "Sigma.D1.B", "X.D2.A2"}) {
+    irreps.push_back(read_representation(fl, name));
+  }
+  test_spinflip_spectra(ops, irreps, "auto");
+  test_spinflip_spectra(ops, irreps, "2sublattice");
+  test_spinflip_spectra(ops, irreps, "2sublattice_dense");
+
+  // The spin flip parity of the block of an operator
+  int64_t nsites = 8;
+  auto irrep = testcases::electron::get_cyclic_group_irreps(nsites)[0];
+  auto block_even = Spinhalf(nsites, nsites / 2, irrep, 1);
+  OpSum sz;
+  for (int64_t i = 0; i < nsites; ++i) {
+    sz += Op("Sz", i);
+  }
+  REQUIRE(*block(sz, block_even).spinflip() == -1);
+  auto H = testcases::spinhalf::HBchain(nsites, 1.0);
+  REQUIRE(*block(H, block_even).spinflip() == 1);
+  auto block_odd = Spinhalf(nsites, nsites / 2, irrep, -1);
+  REQUIRE(blocks_match(sz, block_even, block_odd));
+  REQUIRE(!blocks_match(H, block_even, block_odd));
+
+  REQUIRE_THROWS(Spinhalf(nsites, nsites / 2 - 1, irrep, 1));
+  REQUIRE_THROWS(Spinhalf(nsites, nsites / 2, irrep, 2));
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
+
+TEST_CASE("spinflip", "[operators]") try {
+  Log("Testing spin flip of operators");
+  REQUIRE(isapprox(spinflip(OpSum(Op("Sz", 0))), -1.0 * Op("Sz", 0)));
+  REQUIRE(isapprox(spinflip(OpSum(Op("S+", 1))), OpSum(Op("S-", 1))));
+  REQUIRE(isapprox(spinflip(OpSum(Op("SdotS", {0, 1}))),
+                   OpSum(Op("SdotS", {0, 1}))));
+  REQUIRE(isapprox(spinflip(complex(1.0, 2.0) * Op("Exchange", {0, 1})),
+                   complex(1.0, -2.0) * Op("Exchange", {0, 1})));
+
+  // Matrices act on the flipped local configurations
+  arma::mat m(4, 4, arma::fill::randu);
+  arma::mat mf = m(arma::uvec{3, 2, 1, 0}, arma::uvec{3, 2, 1, 0});
+  REQUIRE(isapprox(spinflip(OpSum(Op("Matrix", {0, 1}, m))),
+                   OpSum(Op("Matrix", {0, 1}, mf))));
+
+  REQUIRE(*spinflip_parity(testcases::spinhalf::HBchain(6, 1.0, 0.3)) == 1);
+  REQUIRE(*spinflip_parity(OpSum(Op("Sz", 0))) == -1);
+  REQUIRE(!spinflip_parity(OpSum(Op("S+", 0))));
+  REQUIRE(isapprox(spinflip(OpSum(Op("Hop", {0, 1}))),
+                   OpSum(Op("Hop", {0, 1}))));
+  REQUIRE(isapprox(spinflip(OpSum(Op("Hopup", {0, 1}))),
+                   OpSum(Op("Hopdn", {0, 1}))));
+  REQUIRE_THROWS(spinflip(OpSum(Op("Hop", 0))));
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
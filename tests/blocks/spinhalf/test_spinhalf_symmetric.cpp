@@ -83,6 +83,8 @@ TEST_CASE("spinhalf_symmetric", "[spinhalf]") {
     for (auto [name, mult] : rep_name_mult) {
       auto irrep = read_representation(fl, name);
       auto block = Spinhalf(nsites, nup, irrep);
+      auto block_dense = Spinhalf(nsites, nup, irrep, "3sublattice_dense");
+      REQUIRE(block.size() == block_dense.size());
       int64_t dim = block.size() * mult;
       sum_dim_up += dim;
       sum_dim += dim;
@@ -90,4 +92,9 @@ TEST_CASE("spinhalf_symmetric", "[spinhalf]") {
     REQUIRE(sum_dim_up == binomial(nsites, nup));
   }
   REQUIRE(sum_dim == (int64_t)pow(2, nsites));
+
+  // The dense index is only available for the sublattice backends
+  auto irrep = read_representation(fl, "Gamma.D6.A1");
+  REQUIRE_THROWS(Spinhalf(nsites, nsites / 2, irrep, "auto_dense"));
+  REQUIRE_THROWS(Spinhalf(nsites, nsites / 2, irrep, "3sublattice_sparse"));
 }
@@ -35,10 +35,10 @@ static void test_onsite(std::string op1, std::string op12) {
   }
 }
 
-static void test_e0_nompi(int N, OpSum ops) {
+static void test_e0_nompi(int N, OpSum ops, std::string partition = "hash") {
   for (int nup = 0; nup <= N; ++nup) {
     auto block = Spinhalf(N, nup);
-    auto block_mpi = SpinhalfDistributed(N, nup);
+    auto block_mpi = SpinhalfDistributed(N, nup, "auto", partition);
 
     auto H = matrix(ops, block);
     REQUIRE(H.is_hermitian(1e-7));
@@ -101,12 +101,13 @@ static void test_sz_sp_sm_energy(int N, OpSum const &ops) {
   }
 }
 
-static void test_sz_sp_sm_commutators(int nsites) {
+static void test_sz_sp_sm_commutators(int nsites,
+                                      std::string partition = "hash") {
   for (int nup = 1; nup < nsites - 1; ++nup) {
     // Log("N: {}, nup: {}", nsites, nup);
-    auto block = SpinhalfDistributed(nsites, nup);
-    auto block_p = SpinhalfDistributed(nsites, nup + 1);
-    auto block_m = SpinhalfDistributed(nsites, nup - 1);
+    auto block = SpinhalfDistributed(nsites, nup, "auto", partition);
+    auto block_p = SpinhalfDistributed(nsites, nup + 1, "auto", partition);
+    auto block_m = SpinhalfDistributed(nsites, nup - 1, "auto", partition);
 
     for (int i = 0; i < nsites; ++i)
       for (int j = 0; j < nsites; ++j) {
@@ -200,6 +201,13 @@ TEST_CASE("spinhalf_distributed_apply", "[spinhalf_distributed]") try {
     test_sz_sp_sm_commutators(N);
   }
 
+  Log("SpinhalfDistributed: balanced partition tests, N=2,..,8");
+  for (int N = 2; N <= 8; ++N) {
+    test_e0_nompi(N, HBchain(N, 1.0), "balanced");
+    test_e0_nompi(N, HB_alltoall(N), "balanced");
+    test_sz_sp_sm_commutators(N, "balanced");
+  }
+
   test_onsite("Sz", "SzSz");
 
   for (int nsites = 2; nsites < 6; ++nsites) {
@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../../catch.hpp"
+#include <mpi.h>
+
+#include <xdiag/algebra/algebra.hpp>
+#include <xdiag/algebra/apply.hpp>
+#include <xdiag/algebra/isapprox.hpp>
+#include <xdiag/algorithms/sparse_diag.hpp>
+#include <xdiag/blocks/spinhalf.hpp>
+#include <xdiag/blocks/spinhalf_distributed.hpp>
+#include <xdiag/io/file_toml.hpp>
+#include <xdiag/io/read.hpp>
+#include <xdiag/utils/logger.hpp>
+
+#include "../electron/testcases_electron.hpp"
+#include "../spinhalf/testcases_spinhalf.hpp"
+
+using namespace xdiag;
+
+static void test_e0_symmetric(int64_t nsites, OpSum const &ops,
+                              std::vector<Representation> const &irreps,
+                              std::string backend = "auto") {
+  for (int64_t nup = 0; nup <= nsites; ++nup) {
+    for (auto const &irrep : irreps) {
+      auto block = Spinhalf(nsites, nup, irrep);
+      auto block_mpi = SpinhalfDistributed(nsites, nup, irrep, backend);
+      REQUIRE(block.dim() == block_mpi.dim());
+      if (block.dim() == 0) {
+        continue;
+      }
+      double e0 = eigval0(ops, block);
+      double e0_mpi = eigval0(ops, block_mpi);
+      // Log("N: {}, nup: {}, e0: {:+.10f}, e0 mpi: {:+.10f}", nsites, nup, e0,
+      //     e0_mpi);
+      REQUIRE(isapprox(e0, e0_mpi));
+    }
+  }
+}
+
+static void test_raise_symmetric(int64_t nsites, OpSum const &ops,
+                                 Representation const &irrep) {
+  OpSum sp;
+  for (int64_t i = 0; i < nsites; ++i) {
+    sp += Op("S+", i);
+  }
+  for (int64_t nup = 0; nup < nsites; ++nup) {
+    auto block = Spinhalf(nsites, nup, irrep);
+    auto block_mpi = SpinhalfDistributed(nsites, nup, irrep);
+    if (block.dim() == 0) {
+      continue;
+    }
+    auto [e0, gs] = eig0(ops, block);
+    auto [e0_mpi, gs_mpi] = eig0(ops, block_mpi);
+    REQUIRE(isapprox(e0, e0_mpi));
+
+    auto sp_gs = apply(sp, gs);
+    auto sp_gs_mpi = apply(sp, gs_mpi);
+    REQUIRE(sp_gs_mpi.block() == Block(SpinhalfDistributed(
+                                     nsites, nup + 1, irrep)));
+    REQUIRE(isapprox(norm(sp_gs), norm(sp_gs_mpi)));
+  }
+}
+
+TEST_CASE("spinhalf_distributed_symmetric", "[spinhalf_distributed]") {
+  using namespace xdiag::testcases::spinhalf;
+  using xdiag::testcases::electron::get_cyclic_group_irreps;
+
+  for (int64_t nsites = 3; nsites < 9; ++nsites) {
+    Log("spinhalf_distributed_symmetric: HB chain, N: {}", nsites);
+    auto irreps = get_cyclic_group_irreps(nsites);
+    auto ops = HBchain(nsites, 1.0, 0.3);
+    test_e0_symmetric(nsites, ops, irreps);
+    test_e0_symmetric(nsites, ops, irreps, "1sublattice");
+    test_raise_symmetric(nsites, ops, irreps[0]);
+  }
+
+  Log("spinhalf_distributed_symmetric: Triangular 3x3");
+  std::string lfile = XDIAG_DIRECTORY
+      "/misc/data/triangular.9.Jz1Jz2Jx1Jx2D1.sublattices.tsl.toml";
+  auto fl = FileToml(lfile);
+  auto ops = fl["Interactions"].as<OpSum>();
+  ops["Jz1"] = 1.00;
+  ops["Jz2"] = 0.23;
+  ops["Jx1"] = 0.76;
+  ops["Jx2"] = 0.46;
+  std::vector<Representation> irreps;
+  for (std::string name : {"Gamma.D6.A1", "Gamma.D6.E1", "K.D3.A2", "Y.D1.B"}) {
+    irreps.push_back(read_representation(fl, name));
+  }
+  test_e0_symmetric(9, ops, irreps);
+  test_e0_symmetric(9, ops, irreps, "3sublattice");
+}
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../../catch.hpp"
+
+#include "../electron/testcases_electron.hpp"
+#include "../tj/testcases_tj.hpp"
+
+#include <xdiag/algebra/apply.hpp>
+#include <xdiag/algebra/matrix.hpp>
+#include <xdiag/operators/logic/block.hpp>
+#include <xdiag/utils/logger.hpp>
+
+using namespace xdiag;
+
+static arma::vec eigenvalues(OpSum const &ops, tJ const &block) {
+  arma::cx_mat H = matrixC(ops, block);
+  REQUIRE(arma::norm(H - H.t()) < 1e-10);
+  arma::vec eigs;
+  arma::eig_sym(eigs, H);
+  return eigs;
+}
+
+TEST_CASE("tj_spinflip", "[tj]") try {
+  Log("Testing spin flip symmetry of tJ blocks");
+  for (int64_t nsites = 3; nsites <= 8; ++nsites) {
+    auto ops = testcases::tj::tJchain(nsites, 1.0, 0.4);
+    auto irreps = testcases::electron::get_cyclic_group_irreps(nsites);
+    for (int64_t n = 0; 2 * n <= nsites; ++n) {
+      for (auto const &irrep : irreps) {
+        auto block = tJ(nsites, n, n, irrep);
+        auto block_even = tJ(nsites, n, n, irrep, 1);
+        auto block_odd = tJ(nsites, n, n, irrep, -1);
+        REQUIRE(block_even.size() + block_odd.size() == block.size());
+
+        // The blocks with spin flip parity +1 and -1 together reproduce the
+        // spectrum of the block without spin flip symmetry
+        arma::vec eigs = eigenvalues(ops, block);
+        arma::vec eigs_even = eigenvalues(ops, block_even);
+        arma::vec eigs_odd = eigenvalues(ops, block_odd);
+        arma::vec eigs_flip =
+            arma::sort(arma::join_cols(eigs_even, eigs_odd));
+        REQUIRE(eigs.n_elem == eigs_flip.n_elem);
+        REQUIRE(arma::norm(eigs - eigs_flip) < 1e-8);
+
+        for (auto const &b : {block_even, block_odd}) {
+          arma::cx_mat H = matrixC(ops, b);
+          arma::cx_vec v(b.size(), arma::fill::randn);
+          arma::cx_vec w(b.size(), arma::fill::zeros);
+          apply(ops, b, v, b, w);
+          REQUIRE(arma::norm(H * v - w) < 1e-10);
+
+          int64_t idx = 0;
+          for (auto pstate : b) {
+            REQUIRE(b.index(pstate) == idx);
+            ++idx;
+          }
+          REQUIRE(idx == b.size());
+        }
+      }
+    }
+  }
+
+  int64_t nsites = 6;
+  auto irrep = testcases::electron::get_cyclic_group_irreps(nsites)[0];
+  auto block_even = tJ(nsites, 2, 2, irrep, 1);
+  OpSum sz;
+  for (int64_t i = 0; i < nsites; ++i) {
+    sz += Op("Sz", i);
+  }
+  REQUIRE(*block(sz, block_even).spinflip() == -1);
+  REQUIRE(*block(testcases::tj::tJchain(nsites, 1.0, 0.4), block_even)
+               .spinflip() == 1);
+  REQUIRE_THROWS(tJ(nsites, 2, 1, irrep, 1));
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
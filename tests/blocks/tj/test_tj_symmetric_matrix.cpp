@@ -52,6 +52,11 @@ void test_spectra_tj_symmetric(OpSum ops, int64_t nsites,
 
             REQUIRE(arma::norm(H_sym - H_sym.t()) < 1e-12);
 
+            // Fermi signs evaluated on the fly agree with the tables
+            auto tj_lookup = tJ(nsites, nup, ndn, irrep, "auto_fermi_lookup");
+            auto H_lookup = matrixC(ops, tj_lookup, tj_lookup);
+            REQUIRE(arma::norm(H_sym - H_lookup) < 1e-12);
+
             arma::vec eigs_sym_k;
             arma::eig_sym(eigs_sym_k, H_sym);
 
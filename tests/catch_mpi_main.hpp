@@ -9,7 +9,8 @@
 
 int main(int argc, char *argv[])
 {
-    MPI_Init(&argc, &argv);
+    int provided;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
     int result = Catch::Session().run(argc, argv);
     MPI_Finalize();
     return result;
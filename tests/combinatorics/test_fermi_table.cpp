@@ -43,10 +43,18 @@ void test_fermi_bool_table(PermutationGroup const &group) {
               fermi_bool_of_permutation(state, group[sym]));
     }
   }
+
+  auto fermi_lookup = combinatorics::FermiSignLookup<bit_t>(group);
+  for (int sym = 0; sym < n_symmetries; ++sym) {
+    for (bit_t state : Subsets<bit_t>(nsites)) {
+      REQUIRE(fermi_lookup.sign(sym, state) ==
+              fermi_bool_of_permutation(state, group[sym]));
+    }
+  }
 }
 TEST_CASE("fermi_table", "[symmetries]") {
   xdiag::Log("Test fermi_table");
-  int max_N = 6;
+  int max_N = 8;
 
   for (int nsites = 1; nsites <= max_N; ++nsites) {
     Log("chain N={}", nsites);
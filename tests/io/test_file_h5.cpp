@@ -4,6 +4,8 @@
 
 #include "../catch.hpp"
 
+#include <cstdio>
+
 #include <xdiag/extern/armadillo/armadillo>
 #include <xdiag/common.hpp>
 #include <xdiag/io/file_h5.hpp>
@@ -58,6 +60,33 @@ TEST_CASE("fiile_h5_slicing", "[io][hdf5]"){
 
 }
 
+TEST_CASE("file_h5_read", "[io][hdf5]") {
+  using namespace xdiag;
 
-#endif
+  std::string filename = "test_file_h5_read.h5";
+  auto vec = arma::vec(7, arma::fill::randn);
+  auto cx_mat = arma::cx_mat(3, 5, arma::fill::randn);
+  std::vector<int64_t> std_vec = {1, 2, 3, 42};
+  {
+    auto fl = FileH5(filename, "w!");
+    fl["val"] = (int64_t)12;
+    fl["z"] = complex(1.0, -2.0);
+    fl["a/b/vec"] = vec;
+    fl["a/c/cx_mat"] = cx_mat;
+    fl["std_vec"] = std_vec;
+  }
+
+  auto fl = FileH5(filename, "r");
+  REQUIRE(fl["val"].as<int64_t>() == 12);
+  REQUIRE(fl["z"].as<complex>() == complex(1.0, -2.0));
+  REQUIRE(arma::norm(fl["a/b/vec"].as<arma::vec>() - vec) == 0.);
+  REQUIRE(arma::norm(fl["a/c/cx_mat"].as<arma::cx_mat>() - cx_mat) == 0.);
+  REQUIRE(fl["std_vec"].as<std::vector<int64_t>>() == std_vec);
+  REQUIRE(fl.has("a/b/vec"));
+  REQUIRE(!fl.has("a/d/vec"));
+  REQUIRE_THROWS(fl["a/b/vec"].as<arma::mat>());
+  fl.close();
+  std::remove(filename.c_str());
+}
 
+#endif
@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../catch.hpp"
+
+#include <cstdio>
+
+#include "../blocks/electron/testcases_electron.hpp"
+
+#include <xdiag/algebra/isapprox.hpp>
+#include <xdiag/io/state_h5.hpp>
+#include <xdiag/states/fill.hpp>
+#include <xdiag/states/random_state.hpp>
+#include <xdiag/utils/logger.hpp>
+
+#ifdef XDIAG_USE_HDF5
+
+using namespace xdiag;
+
+static void test_write_read(Block const &block, bool real, int64_t ncols,
+                            int64_t compression) {
+  std::string filename = "test_state_h5.h5";
+  State psi(block, real, ncols);
+  for (int64_t col = 0; col < ncols; ++col) {
+    fill(psi, RandomState(42 + col, false), col);
+  }
+  write_state_h5(filename, "psi", psi, compression);
+  write_state_h5(filename, "group/psi", psi, compression);
+  auto psi_read = read_state_h5(filename, "psi", block);
+  REQUIRE(isreal(psi_read) == real);
+  REQUIRE(psi_read.ncols() == ncols);
+  REQUIRE(isapprox(psi, psi_read));
+  psi_read = read_state_h5(filename, "group/psi", block);
+  REQUIRE(isapprox(psi, psi_read));
+
+  // Fields cannot be overwritten
+  REQUIRE_THROWS(write_state_h5(filename, "psi", psi));
+  std::remove(filename.c_str());
+}
+
+TEST_CASE("state_h5", "[io]") try {
+  using xdiag::testcases::electron::get_cyclic_group_irreps;
+  Log("Testing reading and writing States to HDF5");
+  int64_t nsites = 6;
+  auto irreps = get_cyclic_group_irreps(nsites);
+
+  test_write_read(Spinhalf(nsites, 3), true, 1, 0);
+  test_write_read(Spinhalf(nsites), false, 3, 6);
+  test_write_read(Spinhalf(nsites, 3, irreps[1]), false, 1, 0);
+  test_write_read(tJ(nsites, 2, 2), true, 2, 1);
+  test_write_read(Electron(nsites, 3, 2, irreps[2]), false, 2, 0);
+
+  // The block needs to agree with the block the State has been written on
+  std::string filename = "test_state_h5_mismatch.h5";
+  State psi(Spinhalf(nsites, 3));
+  fill(psi, RandomState(42));
+  write_state_h5(filename, "psi", psi);
+  REQUIRE_THROWS(read_state_h5(filename, "psi", Spinhalf(nsites, 2)));
+  REQUIRE_THROWS(read_state_h5(filename, "psi", tJ(nsites, 3, 0)));
+  REQUIRE_THROWS(read_state_h5(filename, "phi", Spinhalf(nsites, 3)));
+  REQUIRE_THROWS(write_state_h5(filename, "phi", psi, 10));
+  std::remove(filename.c_str());
+
+  // Irreps of opposite momenta have the same dimension, but a State of one
+  // cannot be read on the other
+  auto block_k1 = Spinhalf(nsites, 3, irreps[1]);
+  auto block_k5 = Spinhalf(nsites, 3, irreps[5]);
+  REQUIRE(block_k1.dim() == block_k5.dim());
+  State phi(block_k1, false);
+  fill(phi, RandomState(42));
+  write_state_h5(filename, "phi", phi);
+  REQUIRE_NOTHROW(read_state_h5(filename, "phi", block_k1));
+  REQUIRE_THROWS(read_state_h5(filename, "phi", block_k5));
+  std::remove(filename.c_str());
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
+
+#endif
@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../catch.hpp"
+
+#include <cstdio>
+#include <mpi.h>
+
+#include "../blocks/electron/testcases_electron.hpp"
+#include "../blocks/spinhalf/testcases_spinhalf.hpp"
+#include "../blocks/tj/testcases_tj.hpp"
+
+#include <xdiag/algebra/algebra.hpp>
+#include <xdiag/algebra/isapprox.hpp>
+#include <xdiag/io/state_h5.hpp>
+#include <xdiag/states/fill.hpp>
+#include <xdiag/states/random_state.hpp>
+#include <xdiag/utils/logger.hpp>
+
+#ifdef XDIAG_USE_HDF5
+
+using namespace xdiag;
+
+static void remove_file(std::string const &filename) {
+  MPI_Barrier(MPI_COMM_WORLD);
+  int mpi_rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+  if (mpi_rank == 0) {
+    std::remove(filename.c_str());
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+// Writes a State on block and reads it back on block_read, which may
+// distribute the configurations differently among the processes
+static void test_write_read(Block const &block, Block const &block_read,
+                            OpSum const &ops, bool real, int64_t ncols,
+                            int64_t compression) {
+  std::string filename = "test_state_h5_distributed.h5";
+  State psi(block, real, ncols);
+  for (int64_t col = 0; col < ncols; ++col) {
+    fill(psi, RandomState(42 + col, false), col);
+  }
+  write_state_h5(filename, "psi", psi, compression);
+  auto psi_read = read_state_h5(filename, "psi", block_read);
+  REQUIRE(isreal(psi_read) == real);
+  REQUIRE(psi_read.ncols() == ncols);
+  if (block == block_read) {
+    REQUIRE(isapprox(psi, psi_read));
+  }
+  for (int64_t col = 0; col < ncols; ++col) {
+    auto v = psi.col(col);
+    auto w = psi_read.col(col);
+    REQUIRE(isapprox(norm(v), norm(w)));
+    REQUIRE(isapprox(innerC(ops, v), innerC(ops, w)));
+  }
+  remove_file(filename);
+}
+
+TEST_CASE("state_h5_distributed", "[io]") try {
+  using xdiag::testcases::electron::get_cyclic_group_irreps;
+  Log("Testing reading and writing distributed States to HDF5");
+
+  int64_t nsites = 10;
+  auto ops = testcases::spinhalf::HBchain(nsites, 1.0, 0.3);
+  auto block = SpinhalfDistributed(nsites, nsites / 2);
+  test_write_read(block, block, ops, true, 1, 0);
+  test_write_read(block, block, ops, false, 2, 4);
+  auto block_balanced =
+      SpinhalfDistributed(nsites, nsites / 2, "auto", "balanced");
+  test_write_read(block, block_balanced, ops, true, 2, 0);
+  test_write_read(block_balanced, block, ops, false, 1, 1);
+
+  auto irreps = get_cyclic_group_irreps(nsites);
+  auto block_sym = SpinhalfDistributed(nsites, nsites / 2, irreps[1]);
+  test_write_read(block_sym, block_sym, ops, false, 1, 0);
+
+  nsites = 6;
+  ops = testcases::electron::get_linear_chain(nsites, 1.0, 4.0);
+  test_write_read(ElectronDistributed(nsites, 3, 2),
+                  ElectronDistributed(nsites, 3, 2), ops, true, 2, 0);
+  ops = testcases::tj::tJchain(nsites, 1.0, 0.4);
+  test_write_read(tJDistributed(nsites, 2, 3), tJDistributed(nsites, 2, 3),
+                  ops, false, 1, 0);
+
+  // The block needs to agree with the block the State has been written on
+  std::string filename = "test_state_h5_distributed_mismatch.h5";
+  State psi(block);
+  fill(psi, RandomState(42));
+  write_state_h5(filename, "psi", psi);
+  REQUIRE_THROWS(
+      read_state_h5(filename, "psi", SpinhalfDistributed(nsites, 2)));
+  REQUIRE_THROWS(read_state_h5(filename, "psi", Spinhalf(10, 5)));
+  remove_file(filename);
+
+  // Irreps of opposite momenta have the same dimension
+  auto block_k9 = SpinhalfDistributed(10, 5, irreps[9]);
+  REQUIRE(block_sym.dim() == block_k9.dim());
+  State phi(block_sym, false);
+  fill(phi, RandomState(42));
+  write_state_h5(filename, "phi", phi);
+  REQUIRE_THROWS(read_state_h5(filename, "phi", block_k9));
+  remove_file(filename);
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
+
+#endif
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../../catch.hpp"
+
+#include "../../blocks/electron/testcases_electron.hpp"
+#include <xdiag/algebra/matrix.hpp>
+#include <xdiag/operators/logic/compilation.hpp>
+#include <xdiag/operators/logic/isapprox.hpp>
+#include <xdiag/operators/logic/symmetrize.hpp>
+#include <xdiag/utils/logger.hpp>
+
+using namespace xdiag;
+using namespace xdiag::operators;
+
+TEST_CASE("compilation", "[operators]") try {
+  Log("Testing merging of terms in compilation");
+
+  // Duplicates created by expanding SdotS are merged
+  OpSum ops = 1.0 * Op("SdotS", {0, 1}) + 0.5 * Op("SzSz", {0, 1}) +
+              0.5 * Op("SzSz", {1, 0});
+  OpSum opsc = compile_spinhalf(ops);
+  REQUIRE(opsc.size() == 2);
+  REQUIRE(isapprox(opsc,
+                   2.0 * Op("SzSz", {0, 1}) + 1.0 * Op("Exchange", {0, 1})));
+
+  // Terms which cancel are removed
+  ops = 1.0 * Op("Hop", {0, 1}) - 1.0 * Op("Hopup", {0, 1});
+  opsc = compile_tj(ops);
+  REQUIRE(opsc.size() == 1);
+  REQUIRE(isapprox(opsc, OpSum(Op("Hopdn", {0, 1}))));
+
+  ops = 1.0 * Op("Sz", 2) + 0.5 * Op("Ndn", 2);
+  opsc = compile_electron(ops);
+  REQUIRE(isapprox(opsc, OpSum(0.5 * Op("Nup", 2))));
+
+  // Identical matrices are merged
+  arma::mat m(4, 4, arma::fill::randu);
+  ops = 1.0 * Op("Matrix", {0, 1}, m) + 1.0 * Op("Matrix", {0, 1}, m);
+  REQUIRE(merge_terms(ops).size() == 1);
+  REQUIRE(isapprox(merge_terms(ops), 2.0 * Op("Matrix", {0, 1}, m)));
+
+  // Symmetrized operators with coinciding terms
+  for (int64_t nsites = 4; nsites <= 8; nsites += 2) {
+    auto irreps = testcases::electron::get_cyclic_group_irreps(nsites);
+    auto group = irreps[0].group();
+    ops = symmetrize(Op("SdotS", {0, nsites / 2}), group);
+    opsc = compile_spinhalf(ops);
+    REQUIRE(opsc.size() == nsites);
+
+    auto block = Spinhalf(nsites, nsites / 2);
+    arma::mat H = matrix(ops, block);
+    arma::mat Hc = matrix(opsc, block);
+    REQUIRE(arma::norm(H - Hc) < 1e-12);
+  }
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
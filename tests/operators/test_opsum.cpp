@@ -45,4 +45,27 @@ TEST_CASE("opsum", "[operators]") {
   ops2 += b * Op("SdotS", {5, 1});
 
   REQUIRE(ops.plain() == ops2);
+
+  // The cached plain form is updated when the OpSum changes
+  ops["J2"] = a;
+  REQUIRE(ops.plain().terms()[6].first == Coupling(a));
+  ops += "J1" * Op("SzSz", {0, 3});
+  REQUIRE(ops.plain().size() == 13);
+  ops *= 2.0;
+  REQUIRE(ops.plain().terms()[12].first == Coupling(2.0 * a));
+
+  // Common constants must agree when adding OpSums
+  OpSum ops3 = "J1" * Op("SzSz", {1, 4});
+  ops3["J1"] = 3.0;
+  REQUIRE_THROWS(ops + ops3);
+  ops3["J1"] = a;
+  REQUIRE((ops + ops3).size() == 14);
+
+  OpSum ops4;
+  ops4.reserve(1000);
+  for (int64_t i = 0; i < 1000; ++i) {
+    ops4 += Op("Sz", i);
+  }
+  REQUIRE(ops4.size() == 1000);
+  REQUIRE(ops4.plain() == ops4);
 }
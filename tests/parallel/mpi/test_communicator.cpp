@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <mpi.h>
+
+#include <tests/catch.hpp>
+#include <xdiag/parallel/mpi/communicator.hpp>
+#include <xdiag/utils/logger.hpp>
+
+using namespace xdiag;
+
+template <class coeff_t> void test_communicator(int n_partners) {
+  int mpi_rank, mpi_size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+
+  // Every process sends (rank + 1) values to the next n_partners processes
+  std::vector<int64_t> n_values_i_send(mpi_size, 0);
+  for (int p = 1; p <= std::min(n_partners, mpi_size); ++p) {
+    n_values_i_send[(mpi_rank + p) % mpi_size] = mpi_rank + 1;
+  }
+
+  auto comm = mpi::Communicator(n_values_i_send);
+  auto comm_nb = mpi::Communicator(n_values_i_send, true);
+  REQUIRE(!comm.neighborhood());
+
+  // Neighborhood collectives are only used if at most half of the processes
+  // are partners
+  int n_neighbors = std::min(n_partners, mpi_size);
+  REQUIRE(comm_nb.neighborhood() == (2 * n_neighbors <= mpi_size));
+  REQUIRE(comm_nb.send_buffer_size() == comm.send_buffer_size());
+  REQUIRE(comm_nb.recv_buffer_size() == comm.recv_buffer_size());
+
+  std::vector<coeff_t> send(comm.send_buffer_size());
+  for (int64_t i = 0; i < (int64_t)send.size(); ++i) {
+    send[i] = (coeff_t)(1000 * mpi_rank + i);
+  }
+  std::vector<coeff_t> recv(comm.recv_buffer_size());
+  std::vector<coeff_t> recv_nb(comm.recv_buffer_size());
+  comm.all_to_all(send.data(), recv.data());
+  comm_nb.all_to_all(send.data(), recv_nb.data());
+  REQUIRE(recv == recv_nb);
+}
+
+TEST_CASE("communicator", "[mpi]") {
+  Log("communicator test");
+  for (int n_partners = 1; n_partners <= 4; ++n_partners) {
+    test_communicator<double>(n_partners);
+    test_communicator<complex>(n_partners);
+    test_communicator<uint64_t>(n_partners);
+  }
+}
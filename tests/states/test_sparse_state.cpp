@@ -0,0 +1,168 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../catch.hpp"
+
+#include "../blocks/electron/testcases_electron.hpp"
+#include "../blocks/spinhalf/testcases_spinhalf.hpp"
+
+#include <xdiag/algebra/algebra.hpp>
+#include <xdiag/algebra/apply.hpp>
+#include <xdiag/algebra/apply_sparse.hpp>
+#include <xdiag/algebra/isapprox.hpp>
+#include <xdiag/algorithms/time_evolution/evolve_lanczos.hpp>
+#include <xdiag/algorithms/time_evolution/time_evolve.hpp>
+#include <xdiag/states/create_state.hpp>
+#include <xdiag/states/fill.hpp>
+#include <xdiag/states/random_state.hpp>
+#include <xdiag/states/sparse_state.hpp>
+#include <xdiag/utils/logger.hpp>
+
+using namespace xdiag;
+
+// Applies ops repeatedly to a product state, both with sparse and dense
+// States, and compares the results
+static void test_apply_sparse(OpSum const &ops, Block const &block,
+                              std::vector<std::string> const &pstate,
+                              bool real, int64_t napply) {
+  auto v = sparse_product_state(block, pstate, real, 0.5);
+  auto w = product_state(block, pstate, real);
+  REQUIRE(v.issparse());
+  REQUIRE(v.nnz() == 1);
+  REQUIRE(isapprox(dense(v), w));
+  for (int64_t i = 0; i < napply; ++i) {
+    v = apply(ops, v);
+    w = apply(ops, w);
+    REQUIRE(isreal(v) == isreal(w));
+    REQUIRE(isapprox(dense(v), w));
+    REQUIRE(v.nnz() <= dim(v));
+  }
+}
+
+TEST_CASE("sparse_state", "[states]") try {
+  using xdiag::testcases::electron::get_cyclic_group_irreps;
+  Log("Testing SparseState");
+
+  int64_t nsites = 12;
+  auto block = Spinhalf(nsites, nsites / 2);
+
+  // Construction, sorting and merging of indices
+  auto v =
+      SparseState(block, {5, 2, 5, 7}, std::vector<double>{1., 2., 3., 0.});
+  REQUIRE(v.isvalid());
+  REQUIRE(v.isreal());
+  REQUIRE(v.issparse());
+  REQUIRE(v.nnz() == 2);
+  REQUIRE(v.indices() == std::vector<int64_t>{2, 5});
+  REQUIRE(v.values() == std::vector<double>{2., 4.});
+  REQUIRE_THROWS(v.valuesC());
+  REQUIRE_THROWS(SparseState(block, {dim(block)}, std::vector<double>{1.}));
+  REQUIRE_THROWS(SparseState(block, {0, 1}, std::vector<double>{1.}));
+  REQUIRE_THROWS(SparseState(block, true, 1.5));
+
+  make_complex(v);
+  REQUIRE(!v.isreal());
+  REQUIRE(v.valuesC() == std::vector<complex>{2., 4.});
+
+  // Conversion from and to dense States
+  auto psi = State(block);
+  fill(psi, RandomState(42));
+  auto vpsi = SparseState(psi);
+  REQUIRE(!vpsi.issparse());
+  REQUIRE(vpsi.nnz() == dim(block));
+  REQUIRE_THROWS(vpsi.indices());
+  REQUIRE(isapprox(dense(vpsi), psi));
+  auto phi = product_state(block, {"Up", "Dn", "Up", "Dn", "Up", "Dn", "Up",
+                                   "Dn", "Up", "Dn", "Up", "Dn"});
+  auto vphi = SparseState(phi);
+  REQUIRE(vphi.issparse());
+  REQUIRE(vphi.nnz() == 1);
+  REQUIRE(isapprox(dense(vphi), phi));
+
+  // Sparse application of operators
+  std::vector<std::string> neel;
+  for (int64_t i = 0; i < nsites; ++i) {
+    neel.push_back((i % 2) ? "Dn" : "Up");
+  }
+  auto ops = testcases::spinhalf::HBchain(nsites, 1.0, 0.3);
+  test_apply_sparse(ops, block, neel, true, 6);
+  test_apply_sparse(ops, block, neel, false, 4);
+  test_apply_sparse(ops, Spinhalf(nsites), neel, true, 4);
+
+  // The Neel state has zero norm at momenta other than 0 and pi
+  auto irreps = get_cyclic_group_irreps(nsites);
+  std::vector<std::string> aperiodic = {"Up", "Up", "Up", "Dn", "Dn", "Up",
+                                        "Dn", "Up", "Dn", "Dn", "Up", "Dn"};
+  test_apply_sparse(ops, Spinhalf(nsites, nsites / 2, irreps[0]), neel, true,
+                    4);
+  test_apply_sparse(ops, Spinhalf(nsites, nsites / 2, irreps[2]), aperiodic,
+                    false, 4);
+
+  auto opsc = ops;
+  opsc += "Jc" * Op("Exchange", {0, 3});
+  opsc["Jc"] = complex(0.2, 0.4);
+  test_apply_sparse(opsc, block, neel, true, 4);
+
+  // Operators changing the quantum numbers
+  test_apply_sparse(OpSum(Op("S+", 1)), block, neel, true, 1);
+
+  // Other blocks are applied densely
+  nsites = 6;
+  ops = testcases::electron::get_linear_chain(nsites, 1.0, 4.0);
+  test_apply_sparse(ops, Electron(nsites, 3, 3),
+                    {"Up", "Dn", "Up", "Dn", "Up", "Dn"}, true, 2);
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
+
+TEST_CASE("sparse_state_evolve", "[states]") try {
+  Log("Testing time evolution of SparseState");
+
+  int64_t nsites = 12;
+  std::vector<std::string> neel;
+  for (int64_t i = 0; i < nsites; ++i) {
+    neel.push_back((i % 2) ? "Dn" : "Up");
+  }
+  auto ops = testcases::spinhalf::HBchain(nsites, 1.0, 0.3);
+  for (auto block : std::vector<Block>{Spinhalf(nsites, nsites / 2),
+                                       Spinhalf(nsites)}) {
+    auto v = sparse_product_state(block, neel, true, 0.5);
+    auto w = product_state(block, neel, true);
+
+    // Krylov vectors with few nonzeros are applied sparsely
+    arma::vec x = w.vector(0);
+    arma::vec y(dim(block), arma::fill::zeros);
+    REQUIRE(apply_if_sparse(ops, block, x, block, y, 0.5));
+    REQUIRE(isapprox(y, apply(ops, w).vector(0, false)));
+    x.randu();
+    REQUIRE(!apply_if_sparse(ops, block, x, block, y, 0.5));
+
+    auto rv = evolve_lanczos(ops, v, -0.3);
+    auto rw = evolve_lanczos(ops, w, -0.3);
+    REQUIRE(rv.niterations == rw.niterations);
+    REQUIRE(isapprox(rv.state, rw.state, 1e-10, 1e-10));
+
+    auto rvc = evolve_lanczos(ops, v, complex(0.1, -0.4), 1e-12, 0.2, true);
+    auto rwc = evolve_lanczos(ops, w, complex(0.1, -0.4), 1e-12, 0.2, true);
+    REQUIRE(isapprox(rvc.state, rwc.state, 1e-10, 1e-10));
+
+    REQUIRE(isapprox(time_evolve(ops, v, 0.7), time_evolve(ops, w, 0.7),
+                     1e-10, 1e-10));
+    REQUIRE(isapprox(time_evolve(ops, v, 0.7, 1e-12, "expokit"),
+                     time_evolve(ops, w, 0.7, 1e-12, "expokit"), 1e-10,
+                     1e-10));
+  }
+
+  // Other blocks are evolved densely
+  nsites = 6;
+  auto opse = testcases::electron::get_linear_chain(nsites, 1.0, 4.0);
+  auto block = Electron(nsites, 3, 3);
+  std::vector<std::string> pstate = {"Up", "Dn", "Up", "Dn", "Up", "Dn"};
+  auto v = sparse_product_state(block, pstate);
+  auto w = product_state(block, pstate);
+  REQUIRE(isapprox(time_evolve(opse, v, 0.5), time_evolve(opse, w, 0.5),
+                   1e-10, 1e-10));
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
@@ -3,6 +3,8 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "../catch.hpp"
+#include <xdiag/algebra/algebra.hpp>
+#include <xdiag/algebra/apply.hpp>
 #include <xdiag/states/state.hpp>
 #include <xdiag/utils/xdiag_show.hpp>
 
@@ -41,3 +43,55 @@ TEST_CASE("state", "[states]") try {
 } catch (xdiag::Error const &e) {
   error_trace(e);
 }
+
+TEST_CASE("state_view", "[states]") try {
+  using namespace xdiag;
+
+  int64_t nsites = 6;
+  auto block = Spinhalf(nsites, 3);
+  OpSum ops;
+  for (int64_t i = 0; i < nsites; ++i) {
+    ops += "J" * Op("SdotS", {i, (i + 1) % nsites});
+  }
+  ops["J"] = 1.0;
+
+  // Real views operate on the external memory
+  arma::vec v(block.size(), arma::fill::randn);
+  arma::vec w(block.size(), arma::fill::zeros);
+  auto psiv = state_view(block, v.memptr());
+  auto psiw = state_view(block, w.memptr());
+  REQUIRE(isview(psiv));
+  REQUIRE(psiw.memptr() == w.memptr());
+  apply(ops, psiv, psiw);
+  auto psi = State(block, v);
+  auto hpsi = apply(ops, psi);
+  REQUIRE(arma::norm(w - hpsi.vector()) < 1e-12);
+  REQUIRE(std::abs(norm(psiv) - arma::norm(v)) < 1e-12);
+  REQUIRE(std::abs(dot(psiv, psiw) - arma::dot(v, w)) < 1e-12);
+
+  // Copies of views own their memory
+  auto psi2 = psiv;
+  REQUIRE(!isview(psi2));
+  psi2 *= 2.0;
+  REQUIRE(arma::norm(psi2.vector() - 2.0 * v) < 1e-12);
+  REQUIRE(arma::norm(psi.vector() - v) < 1e-12);
+
+  // Assigning to a view copies into the external memory
+  psiw = psi2;
+  REQUIRE(isview(psiw));
+  REQUIRE(arma::norm(w - 2.0 * v) < 1e-12);
+  REQUIRE_THROWS(psiv.make_complex());
+
+  // Complex views
+  arma::cx_vec vc(block.size(), arma::fill::randn);
+  arma::cx_vec wc(block.size(), arma::fill::zeros);
+  auto psivc = state_view(block, vc.memptr());
+  auto psiwc = state_view(block, wc.memptr());
+  REQUIRE(!isreal(psivc));
+  apply(ops, psivc, psiwc);
+  REQUIRE(arma::norm(wc - apply(ops, State(block, vc)).vectorC()) < 1e-12);
+  psiwc = psiv;
+  REQUIRE(arma::norm(wc - arma::cx_vec(v, arma::zeros(v.n_elem))) < 1e-12);
+} catch (xdiag::Error const &e) {
+  error_trace(e);
+}
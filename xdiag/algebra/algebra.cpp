@@ -233,6 +233,53 @@ complex dot(Block const &block, arma::cx_vec const &v,
   XDIAG_RETHROW(error);
 }
 
+double dot(Block const &block, arma::fvec const &v, arma::fvec const &w) try {
+  if (isdistributed(block)) {
+    XDIAG_THROW("Single precision vectors are not supported for distributed "
+                "blocks");
+  }
+  int64_t size = v.n_elem;
+  float const *vptr = v.memptr();
+  float const *wptr = w.memptr();
+  double sum = 0.;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(+ : sum)
+#endif
+  for (int64_t i = 0; i < size; ++i) {
+    sum += (double)vptr[i] * (double)wptr[i];
+  }
+  return sum;
+} catch (Error const &error) {
+  XDIAG_RETHROW(error);
+}
+
+complex dot(Block const &block, arma::cx_fvec const &v,
+            arma::cx_fvec const &w) try {
+  if (isdistributed(block)) {
+    XDIAG_THROW("Single precision vectors are not supported for distributed "
+                "blocks");
+  }
+  int64_t size = v.n_elem;
+  std::complex<float> const *vptr = v.memptr();
+  std::complex<float> const *wptr = w.memptr();
+  double sum_real = 0.;
+  double sum_imag = 0.;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(+ : sum_real, sum_imag)
+#endif
+  for (int64_t i = 0; i < size; ++i) {
+    double vr = vptr[i].real();
+    double vi = vptr[i].imag();
+    double wr = wptr[i].real();
+    double wi = wptr[i].imag();
+    sum_real += vr * wr + vi * wi;
+    sum_imag += vr * wi - vi * wr;
+  }
+  return complex(sum_real, sum_imag);
+} catch (Error const &error) {
+  XDIAG_RETHROW(error);
+}
+
 template <typename coeff_t>
 double norm(Block const &block, arma::Col<coeff_t> const &v) try {
   return std::sqrt(xdiag::real(dot(block, v, v)));
@@ -242,6 +289,8 @@ double norm(Block const &block, arma::Col<coeff_t> const &v) try {
 
 template double norm(Block const &, arma::Col<double> const &);
 template double norm(Block const &, arma::Col<complex> const &);
+template double norm(Block const &, arma::Col<float> const &);
+template double norm(Block const &, arma::Col<std::complex<float>> const &);
 
 template <typename coeff_t>
 double norm1(Block const &block, arma::Col<coeff_t> const &v) try {
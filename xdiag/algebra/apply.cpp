@@ -155,6 +155,25 @@ void apply(Op const &op, State const &v, State &w) try {
   XDIAG_RETHROW(error);
 }
 
+#ifdef XDIAG_USE_MPI
+// Distributed blocks only support double precision vectors
+template <typename mat_t, typename block_t>
+static void apply_distributed(OpSum const &ops, block_t const &block_in,
+                              mat_t const &mat_in, block_t const &block_out,
+                              mat_t &mat_out) try {
+  using coeff_t = typename mat_t::elem_type;
+  if constexpr (std::is_same<coeff_t, double>::value ||
+                std::is_same<coeff_t, complex>::value) {
+    apply(ops, block_in, mat_in, block_out, mat_out);
+  } else {
+    XDIAG_THROW("Single precision vectors are not supported for distributed "
+                "blocks");
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+#endif
+
 template <typename mat_t>
 void apply(OpSum const &ops, Block const &block_in, mat_t const &mat_in,
            Block const &block_out, mat_t &mat_out) try {
@@ -171,13 +190,13 @@ void apply(OpSum const &ops, Block const &block_in, mat_t const &mat_in,
           },
 #ifdef XDIAG_USE_MPI
           [&](SpinhalfDistributed const &b1, SpinhalfDistributed const &b2) {
-            apply(ops, b1, mat_in, b2, mat_out);
+            apply_distributed(ops, b1, mat_in, b2, mat_out);
           },
           [&](tJDistributed const &b1, tJDistributed const &b2) {
-            apply(ops, b1, mat_in, b2, mat_out);
+            apply_distributed(ops, b1, mat_in, b2, mat_out);
           },
           [&](ElectronDistributed const &b1, ElectronDistributed const &b2) {
-            apply(ops, b1, mat_in, b2, mat_out);
+            apply_distributed(ops, b1, mat_in, b2, mat_out);
           },
 #endif
           [](auto const &, auto const &) {
@@ -196,6 +215,14 @@ template void apply(OpSum const &, Block const &, arma::mat const &,
                     Block const &, arma::mat &);
 template void apply(OpSum const &, Block const &, arma::cx_mat const &,
                     Block const &, arma::cx_mat &);
+template void apply(OpSum const &, Block const &, arma::fvec const &,
+                    Block const &, arma::fvec &);
+template void apply(OpSum const &, Block const &, arma::cx_fvec const &,
+                    Block const &, arma::cx_fvec &);
+template void apply(OpSum const &, Block const &, arma::fmat const &,
+                    Block const &, arma::fmat &);
+template void apply(OpSum const &, Block const &, arma::cx_fmat const &,
+                    Block const &, arma::cx_fmat &);
 
 template <typename mat_t, typename block_t>
 void apply(OpSum const &ops, block_t const &block_in, mat_t const &mat_in,
@@ -216,6 +243,14 @@ template void apply(OpSum const &, Spinhalf const &, arma::mat const &,
                     Spinhalf const &, arma::mat &);
 template void apply(OpSum const &, Spinhalf const &, arma::cx_mat const &,
                     Spinhalf const &, arma::cx_mat &);
+template void apply(OpSum const &, Spinhalf const &, arma::fvec const &,
+                    Spinhalf const &, arma::fvec &);
+template void apply(OpSum const &, Spinhalf const &, arma::cx_fvec const &,
+                    Spinhalf const &, arma::cx_fvec &);
+template void apply(OpSum const &, Spinhalf const &, arma::fmat const &,
+                    Spinhalf const &, arma::fmat &);
+template void apply(OpSum const &, Spinhalf const &, arma::cx_fmat const &,
+                    Spinhalf const &, arma::cx_fmat &);
 
 template void apply(OpSum const &, tJ const &, arma::vec const &, tJ const &,
                     arma::vec &);
@@ -225,6 +260,14 @@ template void apply(OpSum const &, tJ const &, arma::mat const &, tJ const &,
                     arma::mat &);
 template void apply(OpSum const &, tJ const &, arma::cx_mat const &, tJ const &,
                     arma::cx_mat &);
+template void apply(OpSum const &, tJ const &, arma::fvec const &,
+                    tJ const &, arma::fvec &);
+template void apply(OpSum const &, tJ const &, arma::cx_fvec const &,
+                    tJ const &, arma::cx_fvec &);
+template void apply(OpSum const &, tJ const &, arma::fmat const &,
+                    tJ const &, arma::fmat &);
+template void apply(OpSum const &, tJ const &, arma::cx_fmat const &,
+                    tJ const &, arma::cx_fmat &);
 
 template void apply(OpSum const &, Electron const &, arma::vec const &,
                     Electron const &, arma::vec &);
@@ -234,6 +277,14 @@ template void apply(OpSum const &, Electron const &, arma::mat const &,
                     Electron const &, arma::mat &);
 template void apply(OpSum const &, Electron const &, arma::cx_mat const &,
                     Electron const &, arma::cx_mat &);
+template void apply(OpSum const &, Electron const &, arma::fvec const &,
+                    Electron const &, arma::fvec &);
+template void apply(OpSum const &, Electron const &, arma::cx_fvec const &,
+                    Electron const &, arma::cx_fvec &);
+template void apply(OpSum const &, Electron const &, arma::fmat const &,
+                    Electron const &, arma::fmat &);
+template void apply(OpSum const &, Electron const &, arma::cx_fmat const &,
+                    Electron const &, arma::cx_fmat &);
 
 #ifdef XDIAG_USE_MPI
 template void apply(OpSum const &, SpinhalfDistributed const &,
@@ -0,0 +1,162 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "apply_sparse.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+#include <variant>
+
+#include <xdiag/algebra/apply.hpp>
+#include <xdiag/operators/logic/block.hpp>
+#include <xdiag/operators/logic/compilation.hpp>
+#include <xdiag/operators/logic/isapprox.hpp>
+#include <xdiag/operators/logic/real.hpp>
+#include <xdiag/operators/logic/valid.hpp>
+#include <xdiag/utils/logger.hpp>
+
+#include <xdiag/basis/spinhalf/apply/dispatch_apply.hpp>
+
+namespace xdiag {
+
+template <typename coeff_t>
+static void apply_sparse(OpSum const &ops, Spinhalf const &block_in,
+                         std::vector<int64_t> const &indices_in,
+                         std::vector<coeff_t> const &values_in,
+                         Spinhalf const &block_out,
+                         std::unordered_map<int64_t, coeff_t> &values_out) try {
+  check_valid(ops, block_in.nsites());
+  OpSum opsc = operators::compile<Spinhalf>(ops);
+  basis::dispatch_apply_sparse(opsc, block_in, indices_in, values_in,
+                               block_out, values_out);
+} catch (Error const &error) {
+  XDIAG_RETHROW(error);
+}
+
+template <typename coeff_t>
+static SparseState apply_sparse(OpSum const &ops, Spinhalf const &block_in,
+                                std::vector<int64_t> const &indices_in,
+                                std::vector<coeff_t> const &values_in,
+                                Spinhalf const &block_out,
+                                double max_density) try {
+  std::unordered_map<int64_t, coeff_t> values_out;
+  apply_sparse(ops, block_in, indices_in, values_in, block_out, values_out);
+  std::vector<int64_t> indices;
+  std::vector<coeff_t> values;
+  indices.reserve(values_out.size());
+  values.reserve(values_out.size());
+  for (auto const &[idx, val] : values_out) {
+    indices.push_back(idx);
+    values.push_back(val);
+  }
+  return SparseState(block_out, indices, values, max_density);
+} catch (Error const &error) {
+  XDIAG_RETHROW(error);
+  return SparseState();
+}
+
+SparseState apply(OpSum const &ops, SparseState const &v) try {
+  // invalid v
+  if (!isvalid(v)) {
+    return SparseState();
+  }
+
+  // ops is zero
+  if (isapprox(ops, OpSum())) {
+    return SparseState();
+  }
+
+  auto blockr = block(ops, v.block());
+  bool real = isreal(ops) && isreal(v);
+  double max_density = v.max_density();
+
+  // Every term maps a configuration to at most one other configuration, so
+  // nnz * nterms bounds the number of nonzeros of the result
+  double nnz_estimate = (double)v.nnz() * (double)ops.size();
+  if (!v.issparse()) {
+    return SparseState(apply(ops, v.dense()), max_density);
+  } else if (!std::holds_alternative<Spinhalf>(blockr)) {
+    Log.warn("Warning: sparse apply is only implemented for Spinhalf blocks, "
+             "applying the operator to the dense state instead");
+    return SparseState(apply(ops, v.dense()), max_density);
+  } else if (nnz_estimate > max_density * (double)dim(blockr)) {
+    Log(2, "Result of sparse apply is expected to exceed max_density, "
+           "applying the operator to the dense state instead");
+    return SparseState(apply(ops, v.dense()), max_density);
+  }
+
+  auto const &block_in = std::get<Spinhalf>(v.block());
+  auto const &block_out = std::get<Spinhalf>(blockr);
+  if (real) {
+    return apply_sparse(ops, block_in, v.indices(), v.values(), block_out,
+                        max_density);
+  } else if (isreal(v)) {
+    std::vector<complex> values(v.values().begin(), v.values().end());
+    return apply_sparse(ops, block_in, v.indices(), values, block_out,
+                        max_density);
+  } else {
+    return apply_sparse(ops, block_in, v.indices(), v.valuesC(), block_out,
+                        max_density);
+  }
+} catch (Error const &error) {
+  XDIAG_RETHROW(error);
+  return SparseState();
+}
+
+SparseState apply(Op const &op, SparseState const &v) try {
+  return apply(OpSum(op), v);
+} catch (Error const &error) {
+  XDIAG_RETHROW(error);
+  return SparseState();
+}
+
+template <typename coeff_t>
+bool apply_if_sparse(OpSum const &ops, Block const &block_in,
+                     arma::Col<coeff_t> const &v, Block const &block_out,
+                     arma::Col<coeff_t> &w, double max_density) try {
+  if (!std::holds_alternative<Spinhalf>(block_in) ||
+      !std::holds_alternative<Spinhalf>(block_out)) {
+    return false;
+  }
+
+  // Count the nonzeros, stopping early once a dense result is expected
+  double max_nnz = max_density * (double)dim(block_out) /
+                   std::max((double)ops.size(), 1.);
+  int64_t nnz = 0;
+  for (int64_t i = 0; i < (int64_t)v.n_elem; ++i) {
+    if ((v(i) != coeff_t(0.)) && ((double)(++nnz) > max_nnz)) {
+      return false;
+    }
+  }
+
+  std::vector<int64_t> indices;
+  std::vector<coeff_t> values;
+  indices.reserve(nnz);
+  values.reserve(nnz);
+  for (int64_t i = 0; i < (int64_t)v.n_elem; ++i) {
+    if (v(i) != coeff_t(0.)) {
+      indices.push_back(i);
+      values.push_back(v(i));
+    }
+  }
+  std::unordered_map<int64_t, coeff_t> values_out;
+  apply_sparse(ops, std::get<Spinhalf>(block_in), indices, values,
+               std::get<Spinhalf>(block_out), values_out);
+  w.zeros();
+  for (auto const &[idx, val] : values_out) {
+    w(idx) = val;
+  }
+  return true;
+} catch (Error const &error) {
+  XDIAG_RETHROW(error);
+  return false;
+}
+
+template bool apply_if_sparse(OpSum const &, Block const &, arma::vec const &,
+                              Block const &, arma::vec &, double);
+template bool apply_if_sparse(OpSum const &, Block const &,
+                              arma::cx_vec const &, Block const &,
+                              arma::cx_vec &, double);
+
+} // namespace xdiag
@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <xdiag/blocks/blocks.hpp>
+#include <xdiag/common.hpp>
+#include <xdiag/extern/armadillo/armadillo>
+#include <xdiag/operators/op.hpp>
+#include <xdiag/operators/opsum.hpp>
+#include <xdiag/states/sparse_state.hpp>
+
+namespace xdiag {
+
+// Applies an operator to a SparseState. Only the nonzero coefficients of the
+// input are visited, such that the cost is proportional to the number of
+// nonzeros times the number of terms. If the result is expected to become
+// denser than max_density, the dense apply is used instead. Sparse kernels
+// are only implemented for Spinhalf blocks, other blocks are applied densely
+// with a warning.
+XDIAG_API SparseState apply(Op const &op, SparseState const &v);
+XDIAG_API SparseState apply(OpSum const &ops, SparseState const &v);
+
+// Applies an operator to a dense vector on a Spinhalf block by the sparse
+// kernels, if the result is expected to have at most a fraction max_density
+// of nonzero coefficients. Returns whether the operator has been applied,
+// otherwise w is left untouched. Used by the iterative algorithms started
+// from a SparseState, whose first Krylov vectors are mostly zero.
+template <typename coeff_t>
+bool apply_if_sparse(OpSum const &ops, Block const &block_in,
+                     arma::Col<coeff_t> const &v, Block const &block_out,
+                     arma::Col<coeff_t> &w, double max_density);
+
+} // namespace xdiag
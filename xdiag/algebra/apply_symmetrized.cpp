@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "apply_symmetrized.hpp"
+
+#include <xdiag/algebra/algebra.hpp>
+#include <xdiag/algebra/apply.hpp>
+#include <xdiag/operators/logic/block.hpp>
+#include <xdiag/operators/logic/isapprox.hpp>
+#include <xdiag/operators/logic/real.hpp>
+#include <xdiag/operators/logic/symmetrize.hpp>
+
+namespace xdiag {
+
+// Symmetrizes ops and determines the block of the result. Returns an invalid
+// block if the symmetrized OpSum vanishes.
+static std::pair<OpSum, std::optional<Block>>
+symmetrized_block(OpSum const &ops, Representation const &irrep,
+                  State const &v) try {
+  bool symmetric = std::visit(
+      overload{[](Spinhalf const &b) { return (bool)b.irrep(); },
+               [](tJ const &b) { return (bool)b.irrep(); },
+               [](Electron const &b) { return (bool)b.irrep(); },
+               [](auto const &) { return false; }},
+      v.block());
+  if (!symmetric) {
+    XDIAG_THROW("The block of the State has no irreducible representation "
+                "defined. Use apply(symmetrize(ops, irrep), v) instead.");
+  }
+
+  OpSum ops_sym = symmetrize(ops, irrep);
+  if (isapprox(ops_sym, OpSum())) {
+    return {ops_sym, std::nullopt};
+  }
+
+  // For real characters, symmetrize(ops, irrep) transforms according to irrep
+  // by construction. Complex characters break this for terms like Exchange or
+  // Hop, whose hermitian conjugate part carries the conjugate coupling, so
+  // the representation is determined from the symmetrized OpSum.
+  if (isreal(irrep)) {
+    return {ops_sym, block(ops_sym, irrep, v.block())};
+  } else {
+    return {ops_sym, block(ops_sym, v.block())};
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+static State apply_to_block(OpSum const &ops, State const &v,
+                            Block const &block_out) try {
+  if (isreal(ops) && isreal(v)) {
+    auto w = State(block_out, true, v.ncols());
+    arma::mat vmat = v.matrix(false);
+    arma::mat wmat = w.matrix(false);
+    apply(ops, v.block(), vmat, w.block(), wmat);
+    return w;
+  } else {
+    auto v2 = v;
+    v2.make_complex();
+    auto w = State(block_out, false, v.ncols());
+    arma::cx_mat vmat = v2.matrixC(false);
+    arma::cx_mat wmat = w.matrixC(false);
+    apply(ops, v.block(), vmat, w.block(), wmat);
+    return w;
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+State apply_symmetrized(OpSum const &ops, Representation const &irrep,
+                        State const &v) try {
+  if (!isvalid(v)) {
+    return State();
+  }
+  auto [ops_sym, block_out] = symmetrized_block(ops, irrep, v);
+  if (!block_out) {
+    return State();
+  }
+  return apply_to_block(ops_sym, v, *block_out);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+State apply_symmetrized(Op const &op, Representation const &irrep,
+                        State const &v) try {
+  return apply_symmetrized(OpSum(op), irrep, v);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+double inner_symmetrized(OpSum const &ops, Representation const &irrep,
+                         State const &v) try {
+  if (!isvalid(v)) {
+    return 0.;
+  }
+  if (!(isreal(v) && isreal(ops) && isreal(irrep))) {
+    XDIAG_THROW("\"inner_symmetrized\" can only be called if the state, the "
+                "Ops and the irrep are real. Maybe use innerC_symmetrized(...) "
+                "instead.");
+  }
+  auto [ops_sym, block_out] = symmetrized_block(ops, irrep, v);
+  if (!block_out || !(*block_out == v.block())) {
+    return 0.;
+  }
+  auto w = apply_to_block(ops_sym, v, *block_out);
+  return dot(w, v);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+double inner_symmetrized(Op const &op, Representation const &irrep,
+                         State const &v) try {
+  return inner_symmetrized(OpSum(op), irrep, v);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+complex innerC_symmetrized(OpSum const &ops, Representation const &irrep,
+                           State const &v) try {
+  if (!isvalid(v)) {
+    return complex(0.);
+  }
+  auto [ops_sym, block_out] = symmetrized_block(ops, irrep, v);
+  if (!block_out || !(*block_out == v.block())) {
+    return complex(0.);
+  }
+  auto w = apply_to_block(ops_sym, v, *block_out);
+  return isreal(w) ? (complex)dot(w, v) : dotC(w, v);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+complex innerC_symmetrized(Op const &op, Representation const &irrep,
+                           State const &v) try {
+  return innerC_symmetrized(OpSum(op), irrep, v);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+} // namespace xdiag
@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <xdiag/common.hpp>
+#include <xdiag/operators/op.hpp>
+#include <xdiag/operators/opsum.hpp>
+#include <xdiag/states/state.hpp>
+#include <xdiag/symmetries/representation.hpp>
+
+namespace xdiag {
+
+// Applies symmetrize(ops, irrep) to a state v of a symmetric block. For a
+// real irrep, the resulting block is determined from the representations of
+// irrep and v instead of by permuting all terms of the symmetrized OpSum.
+XDIAG_API State apply_symmetrized(Op const &op, Representation const &irrep,
+                                  State const &v);
+XDIAG_API State apply_symmetrized(OpSum const &ops,
+                                  Representation const &irrep, State const &v);
+
+// Computes <v| symmetrize(ops, irrep) |v>. If the symmetrized OpSum maps v to
+// a different symmetry sector, the result vanishes and nothing is applied.
+XDIAG_API double inner_symmetrized(Op const &op, Representation const &irrep,
+                                   State const &v);
+XDIAG_API double inner_symmetrized(OpSum const &ops,
+                                   Representation const &irrep,
+                                   State const &v);
+XDIAG_API complex innerC_symmetrized(Op const &op, Representation const &irrep,
+                                     State const &v);
+XDIAG_API complex innerC_symmetrized(OpSum const &ops,
+                                     Representation const &irrep,
+                                     State const &v);
+
+} // namespace xdiag
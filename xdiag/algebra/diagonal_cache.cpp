@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "diagonal_cache.hpp"
+
+#include <variant>
+
+#include <xdiag/algebra/apply.hpp>
+#include <xdiag/operators/logic/compilation.hpp>
+#include <xdiag/operators/logic/real.hpp>
+#include <xdiag/operators/logic/types.hpp>
+#include <xdiag/operators/logic/valid.hpp>
+#include <xdiag/utils/timing.hpp>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace xdiag {
+
+DiagonalCache::DiagonalCache(OpSum const &ops, Block const &block,
+                             bool use) try
+    : ops_(ops), block_(block), offdiagonal_(ops), cached_(use) {
+  if (!use) {
+    return;
+  }
+
+  // Diagonal terms are identified after compilation, where e.g. SdotS is
+  // split into SzSz and Exchange
+  check_valid(ops, nsites(block));
+  OpSum opsc = std::visit(
+      [&](auto const &b) {
+        using block_t = typename std::decay<decltype(b)>::type;
+        return operators::compile<block_t>(ops);
+      },
+      block);
+  offdiagonal_ = OpSum();
+  for (auto const &[cpl, op] : opsc) {
+    if (is_diagonal_type(op.type())) {
+      diagonal_ops_ += cpl * op;
+    } else {
+      offdiagonal_ += cpl * op;
+    }
+  }
+  if (diagonal_ops_.size() == 0) {
+    cached_ = false;
+    offdiagonal_ = ops;
+    return;
+  }
+
+  // The diagonal is computed by applying the diagonal terms to the vector
+  // with all coefficients equal to one
+  auto ta = rightnow();
+  int64_t size = xdiag::size(block);
+  real_ = xdiag::isreal(diagonal_ops_) && xdiag::isreal(block);
+  if (real_) {
+    arma::vec ones(size, arma::fill::ones);
+    diagonal_.set_size(size);
+    xdiag::apply(diagonal_ops_, block, ones, block, diagonal_);
+  } else {
+    arma::cx_vec ones(size, arma::fill::ones);
+    diagonalC_.set_size(size);
+    xdiag::apply(diagonal_ops_, block, ones, block, diagonalC_);
+  }
+  timing(ta, rightnow(), "Diagonal cache", 1);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+OpSum const &DiagonalCache::ops() const { return ops_; }
+Block const &DiagonalCache::block() const { return block_; }
+OpSum const &DiagonalCache::offdiagonal() const { return offdiagonal_; }
+OpSum const &DiagonalCache::diagonal_ops() const { return diagonal_ops_; }
+bool DiagonalCache::isreal() const { return real_; }
+bool DiagonalCache::cached() const { return cached_; }
+arma::vec const &DiagonalCache::diagonal() const { return diagonal_; }
+arma::cx_vec const &DiagonalCache::diagonalC() const { return diagonalC_; }
+
+template <typename coeff_t>
+void DiagonalCache::apply_diagonal(coeff_t const *v, coeff_t *w,
+                                   int64_t size) const try {
+  if (real_) {
+    double const *d = diagonal_.memptr();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t i = 0; i < size; ++i) {
+      w[i] += d[i] * v[i];
+    }
+  } else {
+    if constexpr (std::is_same<coeff_t, complex>::value) {
+      complex const *d = diagonalC_.memptr();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for (int64_t i = 0; i < size; ++i) {
+        w[i] += d[i] * v[i];
+      }
+    } else {
+      XDIAG_THROW("Cannot apply a complex diagonal to a real vector");
+    }
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <typename coeff_t>
+void DiagonalCache::apply(arma::Col<coeff_t> const &v,
+                          arma::Col<coeff_t> &w) const try {
+  if (!cached_) {
+    xdiag::apply(offdiagonal_, block_, v, block_, w);
+    return;
+  }
+  if (offdiagonal_.size() > 0) {
+    xdiag::apply(offdiagonal_, block_, v, block_, w);
+  } else {
+    w.zeros();
+  }
+  apply_diagonal(v.memptr(), w.memptr(), v.n_rows);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <typename coeff_t>
+void DiagonalCache::apply(arma::Mat<coeff_t> const &v,
+                          arma::Mat<coeff_t> &w) const try {
+  if (!cached_) {
+    xdiag::apply(offdiagonal_, block_, v, block_, w);
+    return;
+  }
+  if (offdiagonal_.size() > 0) {
+    xdiag::apply(offdiagonal_, block_, v, block_, w);
+  } else {
+    w.zeros();
+  }
+  for (int64_t col = 0; col < (int64_t)v.n_cols; ++col) {
+    apply_diagonal(v.colptr(col), w.colptr(col), v.n_rows);
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template void DiagonalCache::apply(arma::vec const &, arma::vec &) const;
+template void DiagonalCache::apply(arma::cx_vec const &, arma::cx_vec &) const;
+template void DiagonalCache::apply(arma::mat const &, arma::mat &) const;
+template void DiagonalCache::apply(arma::cx_mat const &, arma::cx_mat &) const;
+
+} // namespace xdiag
@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <xdiag/blocks/blocks.hpp>
+#include <xdiag/common.hpp>
+#include <xdiag/extern/armadillo/armadillo>
+#include <xdiag/operators/opsum.hpp>
+
+namespace xdiag {
+
+// Applies an OpSum to vectors on a block, where all diagonal terms are
+// evaluated once into a vector d upon construction. Every application then
+// consists of the off-diagonal terms applied by the usual kernels, followed
+// by a single pass w += d .* v. If use is false, the full OpSum is applied
+// by the usual kernels. The iterative solvers (Lanczos, time evolution)
+// build a DiagonalCache once per call and use it if their argument
+// cache_diagonal is set.
+class DiagonalCache {
+public:
+  DiagonalCache() = default;
+  DiagonalCache(OpSum const &ops, Block const &block, bool use = true);
+
+  OpSum const &ops() const;
+  Block const &block() const;
+  OpSum const &offdiagonal() const;
+  OpSum const &diagonal_ops() const;
+  bool isreal() const;
+  bool cached() const;
+  arma::vec const &diagonal() const;
+  arma::cx_vec const &diagonalC() const;
+
+  template <typename coeff_t>
+  void apply(arma::Col<coeff_t> const &v, arma::Col<coeff_t> &w) const;
+  template <typename coeff_t>
+  void apply(arma::Mat<coeff_t> const &v, arma::Mat<coeff_t> &w) const;
+
+private:
+  OpSum ops_;
+  Block block_;
+  OpSum offdiagonal_;
+  OpSum diagonal_ops_;
+  bool cached_ = false;
+  bool real_ = true;
+  arma::vec diagonal_;
+  arma::cx_vec diagonalC_;
+
+  template <typename coeff_t>
+  void apply_diagonal(coeff_t const *v, coeff_t *w, int64_t size) const;
+};
+
+} // namespace xdiag
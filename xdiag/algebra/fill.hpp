@@ -4,7 +4,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
 #include <xdiag/common.hpp>
+#include <xdiag/utils/prefetch.hpp>
+#include <xdiag/utils/profile.hpp>
 
 namespace xdiag {
 
@@ -20,43 +27,170 @@ constexpr inline void fill_matrix(arma::Mat<coeff_t> &mat, int64_t idx_in,
   fill_matrix(mat.memptr(), idx_in, idx_out, mat.n_rows, val);
 }
 
+// Matrix elements are computed in double precision also when applying to
+// single precision vectors
+template <typename coeff_t> struct apply_coeff {
+  using type = coeff_t;
+};
+template <> struct apply_coeff<float> {
+  using type = double;
+};
+template <> struct apply_coeff<std::complex<float>> {
+  using type = complex;
+};
 template <typename coeff_t>
-inline void fill_apply(coeff_t const *vec_in, coeff_t *vec_out, int64_t idx_in,
-                       int64_t idx_out, coeff_t val) {
+using apply_coeff_t = typename apply_coeff<coeff_t>::type;
+
+template <typename vec_coeff_t, typename coeff_t>
+inline void fill_apply(vec_coeff_t const *vec_in, vec_coeff_t *vec_out,
+                       int64_t idx_in, int64_t idx_out, coeff_t val) {
   // Atomic update to avoid multiple threads writing to the same address
 #ifdef _OPENMP
-  if constexpr (isreal<coeff_t>()) {
-    coeff_t x = val * vec_in[idx_in];
+  if constexpr (std::is_floating_point<vec_coeff_t>::value) {
+    vec_coeff_t x = (vec_coeff_t)(val * (coeff_t)vec_in[idx_in]);
 #pragma omp atomic update
     vec_out[idx_out] += x;
+    profile::count_atomics(1);
   } else {
-    complex x = val * vec_in[idx_in];
-    double *r = &reinterpret_cast<double(&)[2]>(vec_out[idx_out])[0];
-    double *i = &reinterpret_cast<double(&)[2]>(vec_out[idx_out])[1];
+    using real_t = typename vec_coeff_t::value_type;
+    vec_coeff_t x = (vec_coeff_t)(val * (coeff_t)vec_in[idx_in]);
+    real_t *r = &reinterpret_cast<real_t(&)[2]>(vec_out[idx_out])[0];
+    real_t *i = &reinterpret_cast<real_t(&)[2]>(vec_out[idx_out])[1];
 #pragma omp atomic update
     *r += x.real();
 #pragma omp atomic update
     *i += x.imag();
+    profile::count_atomics(2);
   }
 #else
-  vec_out[idx_out] += val * vec_in[idx_in];
+  vec_out[idx_out] += (vec_coeff_t)(val * (coeff_t)vec_in[idx_in]);
 #endif
 }
 
-template <typename coeff_t>
-inline void fill_apply(arma::Col<coeff_t> const &vec_in,
-                       arma::Col<coeff_t> &vec_out, int64_t idx_in,
+template <typename vec_coeff_t, typename coeff_t>
+inline void fill_apply(arma::Col<vec_coeff_t> const &vec_in,
+                       arma::Col<vec_coeff_t> &vec_out, int64_t idx_in,
                        int64_t idx_out, coeff_t val) {
+  profile::count_element();
   fill_apply(vec_in.memptr(), vec_out.memptr(), idx_in, idx_out, val);
 }
-template <typename coeff_t>
-inline void fill_apply(arma::Mat<coeff_t> const &mat_in,
-                       arma::Mat<coeff_t> &mat_out, int64_t idx_in,
+template <typename vec_coeff_t, typename coeff_t>
+inline void fill_apply(arma::Mat<vec_coeff_t> const &mat_in,
+                       arma::Mat<vec_coeff_t> &mat_out, int64_t idx_in,
                        int64_t idx_out, coeff_t val) {
+  profile::count_element();
   // for each column call the usual fill_apply.
   for (int i = 0; i < mat_in.n_cols; i++) {
     fill_apply(mat_in.colptr(i), mat_out.colptr(i), idx_in, idx_out, val);
   }
 }
 
+// Fill functor applying to a vector, which can prefetch the output
+// coefficient of a matrix element before it is filled
+template <typename vec_coeff_t, typename coeff_t> class ApplyFill {
+public:
+  ApplyFill(arma::Col<vec_coeff_t> const &vec_in,
+            arma::Col<vec_coeff_t> &vec_out)
+      : vec_in_(&vec_in), vec_out_(&vec_out) {}
+
+  inline void operator()(int64_t idx_in, int64_t idx_out, coeff_t val) const {
+    fill_apply(*vec_in_, *vec_out_, idx_in, idx_out, val);
+  }
+  inline void prefetch(int64_t idx_out) const {
+    prefetch_write(vec_out_->memptr() + idx_out);
+  }
+
+private:
+  arma::Col<vec_coeff_t> const *vec_in_;
+  arma::Col<vec_coeff_t> *vec_out_;
+};
+
+template <class fill_f, class = void>
+struct has_fill_prefetch : std::false_type {};
+template <class fill_f>
+struct has_fill_prefetch<fill_f,
+                         std::void_t<decltype(std::declval<fill_f const &>()
+                                                  .prefetch(int64_t()))>>
+    : std::true_type {};
+
+// Prefetches the output coefficient idx_out if the fill functor supports it
+template <class fill_f>
+inline void prefetch_fill(fill_f const &fill, int64_t idx_out) {
+  if constexpr (has_fill_prefetch<fill_f>::value) {
+    fill.prefetch(idx_out);
+  }
+}
+
+// Fills the matrix elements of n input states in tiles of
+// prefetch_tile_size. element(i, idx_in, idx_out, val) computes the element
+// of the i-th input state and returns false if it vanishes. The output
+// coefficients of a whole tile are prefetched before the first is filled.
+template <typename coeff_t, class element_f, class fill_f>
+inline void staged_fill(int64_t n, element_f &&element, fill_f &fill) {
+  int64_t idxs_in[prefetch_tile_size];
+  int64_t idxs_out[prefetch_tile_size];
+  coeff_t vals[prefetch_tile_size];
+  for (int64_t begin = 0; begin < n; begin += prefetch_tile_size) {
+    int64_t end = std::min(begin + prefetch_tile_size, n);
+    int64_t m = 0;
+    for (int64_t i = begin; i < end; ++i) {
+      if (element(i, idxs_in[m], idxs_out[m], vals[m])) {
+        prefetch_fill(fill, idxs_out[m]);
+        ++m;
+      }
+    }
+    for (int64_t j = 0; j < m; ++j) {
+      fill(idxs_in[j], idxs_out[j], vals[j]);
+    }
+  }
+}
+
+// Fill functor applying to a sparse vector, given by its sorted nonzero
+// indices and values. The result is accumulated in a hash map. Kernels
+// detect sparse fill functors by is_sparse_fill_v and then only run over the
+// indices of the nonzero input coefficients (without multithreading), filling
+// through at(pos) with the position pos of the input coefficient.
+template <typename coeff_t> class SparseFill {
+public:
+  // Fill functor for the single input coefficient x
+  class Element {
+  public:
+    Element(coeff_t x, std::unordered_map<int64_t, coeff_t> &values_out)
+        : x_(x), values_out_(&values_out) {}
+    inline void operator()(int64_t, int64_t idx_out, coeff_t val) const {
+      profile::count_element();
+      (*values_out_)[idx_out] += val * x_;
+    }
+
+  private:
+    coeff_t x_;
+    std::unordered_map<int64_t, coeff_t> *values_out_;
+  };
+
+  SparseFill(std::vector<int64_t> const &indices_in,
+             std::vector<coeff_t> const &values_in,
+             std::unordered_map<int64_t, coeff_t> &values_out)
+      : indices_in_(&indices_in), values_in_(&values_in),
+        values_out_(&values_out) {}
+
+  std::vector<int64_t> const &indices_in() const { return *indices_in_; }
+  inline Element at(int64_t pos) const {
+    return Element((*values_in_)[pos], *values_out_);
+  }
+
+private:
+  std::vector<int64_t> const *indices_in_;
+  std::vector<coeff_t> const *values_in_;
+  std::unordered_map<int64_t, coeff_t> *values_out_;
+};
+
+template <class fill_f, class = void>
+struct is_sparse_fill : std::false_type {};
+template <class fill_f>
+struct is_sparse_fill<
+    fill_f, std::void_t<decltype(std::declval<fill_f const &>().indices_in())>>
+    : std::true_type {};
+template <class fill_f>
+constexpr bool is_sparse_fill_v = is_sparse_fill<fill_f>::value;
+
 } // namespace xdiag
@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "linear_operator.hpp"
+
+#include <xdiag/algebra/apply.hpp>
+#include <xdiag/operators/logic/block.hpp>
+#include <xdiag/operators/logic/hc.hpp>
+#include <xdiag/operators/logic/isapprox.hpp>
+#include <xdiag/operators/logic/real.hpp>
+#include <xdiag/operators/logic/valid.hpp>
+
+namespace xdiag {
+
+LinearOperator::LinearOperator(OpSum const &ops, Block const &block) try
+    : ops_(ops), block_(block), dim_(xdiag::dim(block)),
+      local_size_(xdiag::size(block)),
+      real_(xdiag::isreal(ops) && xdiag::isreal(block)),
+      hermitian_(isapprox(ops, hc(ops))) {
+  check_valid(ops, nsites(block));
+  if (!blocks_match(ops, block, block)) {
+    XDIAG_THROW("Cannot create LinearOperator, since the OpSum does not map "
+                "the block onto itself");
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+int64_t LinearOperator::dim() const { return dim_; }
+int64_t LinearOperator::local_size() const { return local_size_; }
+bool LinearOperator::isreal() const { return real_; }
+bool LinearOperator::ishermitian() const { return hermitian_; }
+bool LinearOperator::isdistributed() const {
+  return xdiag::isdistributed(block_);
+}
+OpSum const &LinearOperator::ops() const { return ops_; }
+Block const &LinearOperator::block() const { return block_; }
+
+template <typename coeff_t>
+void LinearOperator::apply_block_impl(coeff_t const *X, coeff_t *Y, int64_t k,
+                                      int64_t ldx, int64_t ldy) const try {
+  if constexpr (std::is_same<coeff_t, double>::value) {
+    if (!real_) {
+      XDIAG_THROW("Cannot apply a complex LinearOperator to real vectors");
+    }
+  }
+  int64_t n = local_size_;
+  ldx = (ldx < 0) ? n : ldx;
+  ldy = (ldy < 0) ? n : ldy;
+  if ((ldx < n) || (ldy < n)) {
+    XDIAG_THROW(fmt::format("Leading dimensions ({}, {}) smaller than the "
+                            "local size {} of the LinearOperator",
+                            ldx, ldy, n));
+  }
+  if (k < 0) {
+    XDIAG_THROW(fmt::format("Invalid number of vectors: {}", k));
+  }
+
+  // Wrap the memory without copying (copy_aux_mem = false, strict = true).
+  // Distributed blocks only implement the application to single vectors.
+  if ((k > 1) && (ldx == n) && (ldy == n) && !isdistributed()) {
+    arma::Mat<coeff_t> mat_in(const_cast<coeff_t *>(X), n, k, false, true);
+    arma::Mat<coeff_t> mat_out(Y, n, k, false, true);
+    xdiag::apply(ops_, block_, mat_in, block_, mat_out);
+  } else {
+    for (int64_t i = 0; i < k; ++i) {
+      arma::Col<coeff_t> vec_in(const_cast<coeff_t *>(X + i * ldx), n, false,
+                                true);
+      arma::Col<coeff_t> vec_out(Y + i * ldy, n, false, true);
+      xdiag::apply(ops_, block_, vec_in, block_, vec_out);
+    }
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+void LinearOperator::apply(double const *x, double *y) const try {
+  apply_block_impl(x, y, 1, local_size_, local_size_);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+void LinearOperator::apply(complex const *x, complex *y) const try {
+  apply_block_impl(x, y, 1, local_size_, local_size_);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+void LinearOperator::apply_block(double const *X, double *Y, int64_t k,
+                                 int64_t ldx, int64_t ldy) const try {
+  apply_block_impl(X, Y, k, ldx, ldy);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+void LinearOperator::apply_block(complex const *X, complex *Y, int64_t k,
+                                 int64_t ldx, int64_t ldy) const try {
+  apply_block_impl(X, Y, k, ldx, ldy);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+int64_t dim(LinearOperator const &op) { return op.dim(); }
+int64_t local_size(LinearOperator const &op) { return op.local_size(); }
+bool isreal(LinearOperator const &op) { return op.isreal(); }
+bool ishermitian(LinearOperator const &op) { return op.ishermitian(); }
+
+template <typename int_t, typename coeff_t>
+void apply_arpack(LinearOperator const &op, int_t const *ipntr,
+                  coeff_t *workd) try {
+  op.apply(workd + ipntr[0] - 1, workd + ipntr[1] - 1);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template XDIAG_API void apply_arpack(LinearOperator const &, int32_t const *,
+                                     double *);
+template XDIAG_API void apply_arpack(LinearOperator const &, int64_t const *,
+                                     double *);
+template XDIAG_API void apply_arpack(LinearOperator const &, int32_t const *,
+                                     complex *);
+template XDIAG_API void apply_arpack(LinearOperator const &, int64_t const *,
+                                     complex *);
+
+template <typename coeff_t>
+static int apply_block_noexcept(LinearOperator const &op, coeff_t const *X,
+                                coeff_t *Y, int64_t k, int64_t ldx,
+                                int64_t ldy) noexcept {
+  try {
+    op.apply_block(X, Y, k, ldx, ldy);
+    return 0;
+  } catch (Error const &e) {
+    error_trace(e);
+  } catch (...) {
+    Log.err("Error applying LinearOperator");
+  }
+  return 1;
+}
+
+int apply_block_noexcept(LinearOperator const &op, double const *X, double *Y,
+                         int64_t k, int64_t ldx, int64_t ldy) noexcept {
+  return apply_block_noexcept<double>(op, X, Y, k, ldx, ldy);
+}
+
+int apply_block_noexcept(LinearOperator const &op, complex const *X,
+                         complex *Y, int64_t k, int64_t ldx,
+                         int64_t ldy) noexcept {
+  return apply_block_noexcept<complex>(op, X, Y, k, ldx, ldy);
+}
+
+} // namespace xdiag
@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <xdiag/blocks/blocks.hpp>
+#include <xdiag/common.hpp>
+#include <xdiag/operators/opsum.hpp>
+
+namespace xdiag {
+
+// Matrix-free representation of an OpSum acting on a Block, to be used by
+// external iterative solvers. Vectors are passed as raw pointers to the
+// coefficients stored on the local process, i.e. local_size() coefficients
+// per vector. On distributed blocks every process passes its local slice
+// and apply has to be called collectively. No copies of the vectors are made
+// as long as the leading dimensions agree with local_size().
+class LinearOperator {
+public:
+  XDIAG_API LinearOperator() = default;
+  XDIAG_API LinearOperator(OpSum const &ops, Block const &block);
+
+  XDIAG_API int64_t dim() const;
+  XDIAG_API int64_t local_size() const;
+  XDIAG_API bool isreal() const;
+  XDIAG_API bool ishermitian() const;
+  XDIAG_API bool isdistributed() const;
+
+  // y = A x
+  XDIAG_API void apply(double const *x, double *y) const;
+  XDIAG_API void apply(complex const *x, complex *y) const;
+
+  // Y = A X for k vectors stored column-major with leading dimensions ldx and
+  // ldy. Negative leading dimensions default to local_size().
+  XDIAG_API void apply_block(double const *X, double *Y, int64_t k,
+                             int64_t ldx = -1, int64_t ldy = -1) const;
+  XDIAG_API void apply_block(complex const *X, complex *Y, int64_t k,
+                             int64_t ldx = -1, int64_t ldy = -1) const;
+
+  OpSum const &ops() const;
+  Block const &block() const;
+
+private:
+  OpSum ops_;
+  Block block_;
+  int64_t dim_ = 0;
+  int64_t local_size_ = 0;
+  bool real_ = true;
+  bool hermitian_ = true;
+
+  template <typename coeff_t>
+  void apply_block_impl(coeff_t const *X, coeff_t *Y, int64_t k, int64_t ldx,
+                        int64_t ldy) const;
+};
+
+XDIAG_API int64_t dim(LinearOperator const &op);
+XDIAG_API int64_t local_size(LinearOperator const &op);
+XDIAG_API bool isreal(LinearOperator const &op);
+XDIAG_API bool ishermitian(LinearOperator const &op);
+
+// Reverse communication adapter for ARPACK-style solvers. The solver
+// requests a product by returning to the caller with the 1-based offsets
+// ipntr[0] of the input and ipntr[1] of the output vector in workd. The
+// integer type of ipntr is int for standard builds of ARPACK and int64_t for
+// ILP64 builds.
+template <typename int_t, typename coeff_t>
+XDIAG_API void apply_arpack(LinearOperator const &op, int_t const *ipntr,
+                            coeff_t *workd);
+
+// Applies op to block_size vectors and returns a nonzero error code instead
+// of throwing, as required by callbacks of C libraries
+XDIAG_API int apply_block_noexcept(LinearOperator const &op, double const *X,
+                                   double *Y, int64_t k, int64_t ldx,
+                                   int64_t ldy) noexcept;
+XDIAG_API int apply_block_noexcept(LinearOperator const &op, complex const *X,
+                                   complex *Y, int64_t k, int64_t ldx,
+                                   int64_t ldy) noexcept;
+
+// Matrix-vector callback for PRIMME, where params_t is primme_params and the
+// LinearOperator is set as its member "matrix":
+//
+//   primme.matrix = &op;
+//   primme.matrixMatvec = matvec_callback<double, primme_params>;
+//
+// Errors are not propagated as exceptions, but reported by setting ierr to a
+// nonzero value.
+template <typename coeff_t, class params_t>
+void matvec_callback(void *x, int64_t *ldx, void *y, int64_t *ldy,
+                     int *block_size, params_t *params, int *ierr) {
+  auto const &op = *static_cast<LinearOperator const *>(params->matrix);
+  *ierr = apply_block_noexcept(op, static_cast<coeff_t const *>(x),
+                               static_cast<coeff_t *>(y), *block_size, *ldx,
+                               *ldy);
+}
+
+} // namespace xdiag
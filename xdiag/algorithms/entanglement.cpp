@@ -0,0 +1,527 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "entanglement.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <type_traits>
+
+#include <xdiag/bits/bitops.hpp>
+#include <xdiag/blocks/electron.hpp>
+#include <xdiag/blocks/spinhalf.hpp>
+#include <xdiag/blocks/tj.hpp>
+#include <xdiag/combinatorics/lin_table.hpp>
+#include <xdiag/symmetries/group_action/group_action_lookup.hpp>
+#include <xdiag/symmetries/operations/group_action_operations.hpp>
+
+namespace xdiag {
+
+// Coefficients of a state reshaped to a matrix, where the rows are labeled
+// by configurations on A and the columns by configurations on B
+template <typename coeff_t> struct EntanglementSector {
+  std::vector<int64_t> configs_A;
+  arma::Mat<coeff_t> psi;
+};
+
+template <typename bit_t, typename coeff_t, class basis_t>
+static std::vector<EntanglementSector<coeff_t>>
+entanglement_sectors(Spinhalf const &block, basis_t const &basis,
+                     arma::Col<coeff_t> const &vec,
+                     std::vector<int64_t> const &sites_A) try {
+  using combinatorics::LinTable;
+  int64_t nsites = block.nsites();
+  int64_t n_A = sites_A.size();
+  int64_t n_B = nsites - n_A;
+
+  bit_t mask_A = 0;
+  for (int64_t s : sites_A) {
+    mask_A |= (bit_t)1 << s;
+  }
+  bit_t mask_B = (((bit_t)1 << nsites) - 1) ^ mask_A;
+
+  // If the number of up spins is conserved, the state decomposes into
+  // sectors with a fixed number of up spins on A
+  std::vector<EntanglementSector<coeff_t>> sectors;
+  std::vector<LinTable<bit_t>> lintables_A;
+  std::vector<LinTable<bit_t>> lintables_B;
+  int64_t nup = block.nup() ? *block.nup() : 0;
+  int64_t nup_A_min = std::max((int64_t)0, nup - n_B);
+  if (block.nup()) {
+    for (int64_t k = 0; k <= n_A; ++k) {
+      lintables_A.push_back(LinTable<bit_t>(n_A, k));
+    }
+    for (int64_t k = 0; k <= n_B; ++k) {
+      lintables_B.push_back(LinTable<bit_t>(n_B, k));
+    }
+    for (int64_t k = nup_A_min; k <= std::min(n_A, nup); ++k) {
+      EntanglementSector<coeff_t> sector;
+      sector.configs_A.resize(lintables_A[k].size());
+      for (auto [a, idx] : lintables_A[k].states_indices()) {
+        sector.configs_A[idx] = a;
+      }
+      sector.psi.zeros(lintables_A[k].size(), lintables_B[nup - k].size());
+      sectors.push_back(sector);
+    }
+  } else {
+    EntanglementSector<coeff_t> sector;
+    sector.configs_A.resize((int64_t)1 << n_A);
+    for (int64_t a = 0; a < ((int64_t)1 << n_A); ++a) {
+      sector.configs_A[a] = a;
+    }
+    sector.psi.zeros((int64_t)1 << n_A, (int64_t)1 << n_B);
+    sectors.push_back(sector);
+  }
+
+  auto add = [&](bit_t spins, coeff_t amplitude) {
+    bit_t a = bits::extract(spins, mask_A);
+    bit_t b = bits::extract(spins, mask_B);
+    if (block.nup()) {
+      int64_t k = bits::popcnt(a);
+      sectors[k - nup_A_min].psi(lintables_A[k].index(a),
+                                 lintables_B[nup - k].index(b)) += amplitude;
+    } else {
+      sectors[0].psi(a, b) += amplitude;
+    }
+  };
+
+  if (block.irrep()) {
+    // Unfold the symmetric basis states, |r> = 1/(sqrt(|G|) N_r) sum_g
+    // chi(g) |g r>, where G includes the spin flips if present
+    auto const &irrep = *block.irrep();
+    auto spinflip = block.spinflip();
+    Vector characters_block =
+        spinflip ? characters_z2(irrep, *spinflip) : irrep.characters();
+    auto characters = characters_block.as<arma::Col<coeff_t>>();
+    auto group_action = GroupActionLookup<bit_t>(irrep.group(), (bool)spinflip);
+    int64_t n_symmetries = group_action.n_symmetries();
+    double sqrt_n_symmetries = std::sqrt((double)n_symmetries);
+    int64_t idx = 0;
+    for (bit_t rep : basis) {
+      double norm = symmetries::norm(rep, group_action, characters);
+      coeff_t prefactor = vec(idx) / (sqrt_n_symmetries * norm);
+      for (int64_t sym = 0; sym < n_symmetries; ++sym) {
+        add(group_action.apply(sym, rep), prefactor * characters(sym));
+      }
+      ++idx;
+    }
+  } else {
+    int64_t idx = 0;
+    for (bit_t spins : basis) {
+      add(spins, vec(idx));
+      ++idx;
+    }
+  }
+  return sectors;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+// Label sum_n d_n D^n of a configuration on n sites, where d_n = 0, 1, 2, 3
+// denotes the local states Emp, Up, Dn, UpDn of the n-th site
+template <typename bit_t>
+static int64_t fermion_label(bit_t ups, bit_t dns, int64_t n, int64_t D) {
+  int64_t label = 0;
+  int64_t power = 1;
+  for (int64_t i = 0; i < n; ++i) {
+    label += (int64_t)(((ups >> i) & 1) + 2 * ((dns >> i) & 1)) * power;
+    power *= D;
+  }
+  return label;
+}
+
+// Fermi sign of reordering c^dag_ups c^dag_dns, where each product is in
+// ascending order of the sites, into c^dag_upsA c^dag_dnsA c^dag_upsB
+// c^dag_dnsB, such that the state factorizes into states on A and B
+template <typename bit_t>
+static bool fermi_bool_bipartition(bit_t ups, bit_t dns, bit_t mask_A,
+                                   bit_t mask_B) {
+  bool fermi = (bits::popcnt(dns & mask_A) * bits::popcnt(ups & mask_B)) & 1;
+  for (bit_t spins : {ups, dns}) {
+    bit_t spins_A = spins & mask_A;
+    while (spins_A) {
+      bit_t site_mask = spins_A & (~spins_A + 1);
+      fermi ^= bits::popcnt(spins & mask_B & (site_mask - 1)) & 1;
+      spins_A ^= site_mask;
+    }
+  }
+  return fermi;
+}
+
+template <class basis_t, class = void>
+struct is_symmetric_basis : std::false_type {};
+template <class basis_t>
+struct is_symmetric_basis<
+    basis_t, std::void_t<decltype(std::declval<basis_t const &>().irrep())>>
+    : std::true_type {};
+
+// Projection of a block with spin flip or particle-hole symmetry
+static basis::SpinflipProjection const *projection(tJ const &block) {
+  return block.spinflip() ? &block.projection() : nullptr;
+}
+static basis::SpinflipProjection const *projection(Electron const &block) {
+  return block.projected() ? &block.projection() : nullptr;
+}
+
+// Calls f(ups, dns, amplitude) for every configuration of up and dn spins of
+// a tJ or Electron state. Symmetrized basis states, |r> = 1/(sqrt(|G|) N_r)
+// sum_g chi(g) g|r>, are unfolded including the fermi signs of g, and the
+// states projected by the spin flip or particle-hole symmetry are expanded
+// into the symmetrized basis states first.
+template <typename coeff_t, class block_t, class basis_t, class f_t>
+static void for_each_fermion_config(block_t const &block,
+                                    basis_t const &basis,
+                                    arma::Col<coeff_t> const &vec, f_t f) {
+  using bit_t = typename basis_t::bit_t;
+  if constexpr (is_symmetric_basis<basis_t>::value) {
+    auto const *proj = projection(block);
+    auto const &group_action = basis.group_action();
+    auto characters = basis.irrep().characters().template as<arma::cx_vec>();
+    int64_t n_symmetries = group_action.n_symmetries();
+
+    std::vector<std::pair<std::pair<bit_t, bit_t>, complex>> images;
+    int64_t idx = 0;
+    for (auto [ups, dns] : basis) {
+      coeff_t amplitude;
+      if (proj) {
+        int64_t idx_proj = proj->index(idx);
+        amplitude = (idx_proj == invalid_index)
+                        ? 0.
+                        : vec(idx_proj) * proj->template coeff<coeff_t>(idx);
+      } else {
+        amplitude = vec(idx);
+      }
+      ++idx;
+      if (amplitude == 0.) {
+        continue;
+      }
+
+      // images g|r> of the representative, merging coinciding images
+      images.clear();
+      for (int64_t sym = 0; sym < n_symmetries; ++sym) {
+        auto config = std::make_pair(group_action.apply(sym, ups),
+                                     group_action.apply(sym, dns));
+        bool fermi =
+            basis.fermi_bool_ups(sym, ups) ^ basis.fermi_bool_dns(sym, dns);
+        complex coeff = fermi ? -characters(sym) : characters(sym);
+        auto it =
+            std::find_if(images.begin(), images.end(),
+                         [&](auto const &p) { return p.first == config; });
+        if (it == images.end()) {
+          images.push_back({config, coeff});
+        } else {
+          it->second += coeff;
+        }
+      }
+      double norm = 0.;
+      for (auto const &image : images) {
+        norm += std::norm(image.second);
+      }
+      norm = std::sqrt(norm);
+      for (auto const &[config, coeff] : images) {
+        if constexpr (isreal<coeff_t>()) {
+          f(config.first, config.second, amplitude * coeff.real() / norm);
+        } else {
+          f(config.first, config.second, amplitude * coeff / norm);
+        }
+      }
+    }
+  } else {
+    int64_t idx = 0;
+    for (auto [ups, dns] : basis) {
+      f(ups, dns, vec(idx));
+      ++idx;
+    }
+  }
+}
+
+template <typename bit_t, typename coeff_t, class block_t, class basis_t>
+static std::vector<EntanglementSector<coeff_t>>
+entanglement_sectors_fermions(block_t const &block, basis_t const &basis,
+                              arma::Col<coeff_t> const &vec,
+                              std::vector<int64_t> const &sites_A) try {
+  using combinatorics::LinTable;
+  constexpr bool is_tj = std::is_same<block_t, tJ>::value;
+  int64_t D = is_tj ? 3 : 4;
+  int64_t nsites = block.nsites();
+  int64_t n_A = sites_A.size();
+  int64_t n_B = nsites - n_A;
+
+  bit_t mask_A = 0;
+  for (int64_t s : sites_A) {
+    mask_A |= (bit_t)1 << s;
+  }
+  bit_t mask_B = (((bit_t)1 << nsites) - 1) ^ mask_A;
+
+  std::map<std::pair<int64_t, int64_t>, LinTable<bit_t>> lintables;
+  auto lintable = [&](int64_t n, int64_t k) -> LinTable<bit_t> const & {
+    auto it = lintables.find({n, k});
+    if (it == lintables.end()) {
+      it = lintables.insert({{n, k}, LinTable<bit_t>(n, k)}).first;
+    }
+    return it->second;
+  };
+
+  // In the tJ model, the dn spins are indexed on the sites not occupied by
+  // up spins
+  auto dns_compressed = [&](bit_t ups, bit_t dns, int64_t n) {
+    return is_tj ? bits::extract(dns, ~ups & (((bit_t)1 << n) - 1)) : dns;
+  };
+  auto n_dns = [&](int64_t n, int64_t k_up) { return is_tj ? n - k_up : n; };
+  auto sector_size = [&](int64_t n, int64_t k_up, int64_t k_dn) {
+    return lintable(n, k_up).size() * lintable(n_dns(n, k_up), k_dn).size();
+  };
+  auto sector_index = [&](bit_t ups, bit_t dns, int64_t n) {
+    int64_t k_up = bits::popcnt(ups);
+    int64_t k_dn = bits::popcnt(dns);
+    auto const &lintable_dns = lintable(n_dns(n, k_up), k_dn);
+    return lintable(n, k_up).index(ups) * lintable_dns.size() +
+           lintable_dns.index(dns_compressed(ups, dns, n));
+  };
+
+  // If the numbers of up and dn spins are conserved, the state decomposes
+  // into sectors with fixed numbers of up and dn spins on A
+  std::vector<EntanglementSector<coeff_t>> sectors;
+  std::map<std::pair<int64_t, int64_t>, int64_t> sector_of;
+  if (block.nup()) {
+    int64_t nup = *block.nup();
+    int64_t ndn = *block.ndn();
+    for (int64_t k_up = std::max((int64_t)0, nup - n_B);
+         k_up <= std::min(n_A, nup); ++k_up) {
+      for (int64_t k_dn = std::max((int64_t)0, ndn - n_B);
+           k_dn <= std::min(n_A, ndn); ++k_dn) {
+        if (is_tj && ((k_up + k_dn > n_A) ||
+                      (nup - k_up + ndn - k_dn > n_B))) {
+          continue;
+        }
+        EntanglementSector<coeff_t> sector;
+        sector.configs_A.resize(sector_size(n_A, k_up, k_dn));
+        int64_t n_dns_A = n_dns(n_A, k_up);
+        for (auto [ups, idx_ups] : lintable(n_A, k_up).states_indices()) {
+          bit_t not_ups = ~ups & (((bit_t)1 << n_A) - 1);
+          for (auto [dnsc, idx_dns] :
+               lintable(n_dns_A, k_dn).states_indices()) {
+            bit_t dns = is_tj ? bits::deposit(dnsc, not_ups) : dnsc;
+            int64_t row = idx_ups * lintable(n_dns_A, k_dn).size() + idx_dns;
+            sector.configs_A[row] = fermion_label(ups, dns, n_A, D);
+          }
+        }
+        sector.psi.zeros(sector_size(n_A, k_up, k_dn),
+                         sector_size(n_B, nup - k_up, ndn - k_dn));
+        sector_of[{k_up, k_dn}] = sectors.size();
+        sectors.push_back(sector);
+      }
+    }
+  } else {
+    EntanglementSector<coeff_t> sector;
+    int64_t size_A = (int64_t)1 << (2 * n_A);
+    sector.configs_A.resize(size_A);
+    for (int64_t row = 0; row < size_A; ++row) {
+      bit_t ups = (bit_t)row & (((bit_t)1 << n_A) - 1);
+      bit_t dns = (bit_t)(row >> n_A);
+      sector.configs_A[row] = fermion_label(ups, dns, n_A, D);
+    }
+    sector.psi.zeros(size_A, (int64_t)1 << (2 * n_B));
+    sectors.push_back(sector);
+  }
+
+  auto add = [&](bit_t ups, bit_t dns, coeff_t amplitude) {
+    if (fermi_bool_bipartition(ups, dns, mask_A, mask_B)) {
+      amplitude = -amplitude;
+    }
+    bit_t ups_A = bits::extract(ups, mask_A);
+    bit_t dns_A = bits::extract(dns, mask_A);
+    bit_t ups_B = bits::extract(ups, mask_B);
+    bit_t dns_B = bits::extract(dns, mask_B);
+    if (block.nup()) {
+      int64_t sector = sector_of.at({bits::popcnt(ups_A), bits::popcnt(dns_A)});
+      sectors[sector].psi(sector_index(ups_A, dns_A, n_A),
+                          sector_index(ups_B, dns_B, n_B)) += amplitude;
+    } else {
+      sectors[0].psi((int64_t)ups_A | ((int64_t)dns_A << n_A),
+                     (int64_t)ups_B | ((int64_t)dns_B << n_B)) += amplitude;
+    }
+  };
+  for_each_fermion_config(block, basis, vec, add);
+  return sectors;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <typename coeff_t>
+static std::vector<EntanglementSector<coeff_t>>
+entanglement_sectors(State const &state, std::vector<int64_t> sites_A) try {
+  if (state.ncols() != 1) {
+    XDIAG_THROW("Entanglement can only be computed for a State with a single "
+                "column");
+  }
+  int64_t nsites = state.nsites();
+  for (int64_t s : sites_A) {
+    if ((s < 0) || (s >= nsites)) {
+      XDIAG_THROW(fmt::format(
+          "Site {} of subsystem A is out of range for a State with {} sites",
+          s, nsites));
+    }
+  }
+  std::sort(sites_A.begin(), sites_A.end());
+  if (std::adjacent_find(sites_A.begin(), sites_A.end()) != sites_A.end()) {
+    XDIAG_THROW("Sites of subsystem A are not unique");
+  }
+
+  arma::Col<coeff_t> vec;
+  if constexpr (isreal<coeff_t>()) {
+    vec = state.vector(0, false);
+  } else if (isreal(state)) {
+    vec = arma::conv_to<arma::cx_vec>::from(state.vector(0, false));
+  } else {
+    vec = state.vectorC(0, false);
+  }
+
+  return std::visit(
+      overload{[&](Spinhalf const &block) {
+                 return std::visit(
+                     [&](auto const &basis) {
+                       using basis_t =
+                           typename std::decay<decltype(basis)>::type;
+                       using bit_t = typename basis_t::bit_t;
+                       return entanglement_sectors<bit_t>(block, basis, vec,
+                                                          sites_A);
+                     },
+                     block.basis());
+               },
+               [&](tJ const &block) {
+                 return std::visit(
+                     [&](auto const &basis) {
+                       using basis_t =
+                           typename std::decay<decltype(basis)>::type;
+                       using bit_t = typename basis_t::bit_t;
+                       return entanglement_sectors_fermions<bit_t>(
+                           block, basis, vec, sites_A);
+                     },
+                     block.basis());
+               },
+               [&](Electron const &block) {
+                 return std::visit(
+                     [&](auto const &basis) {
+                       using basis_t =
+                           typename std::decay<decltype(basis)>::type;
+                       using bit_t = typename basis_t::bit_t;
+                       return entanglement_sectors_fermions<bit_t>(
+                           block, basis, vec, sites_A);
+                     },
+                     block.basis());
+               },
+               [&](auto const &) {
+                 XDIAG_THROW("Entanglement is not implemented for distributed "
+                             "blocks");
+                 return std::vector<EntanglementSector<coeff_t>>();
+               }},
+      state.block());
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+// Dimension D^n_A of the Hilbert space on A, where D is the number of local
+// states of a site
+static int64_t dimension_A(State const &state,
+                           std::vector<int64_t> const &sites_A) {
+  int64_t D = std::visit(overload{[](tJ const &) { return (int64_t)3; },
+                                  [](Electron const &) { return (int64_t)4; },
+                                  [](auto const &) { return (int64_t)2; }},
+                         state.block());
+  int64_t dim = 1;
+  for (int64_t i = 0; i < (int64_t)sites_A.size(); ++i) {
+    dim *= D;
+  }
+  return dim;
+}
+
+template <typename coeff_t>
+static arma::Mat<coeff_t>
+reduced_density_matrix(State const &state,
+                       std::vector<int64_t> const &sites_A) try {
+  auto sectors = entanglement_sectors<coeff_t>(state, sites_A);
+  int64_t dim_A = dimension_A(state, sites_A);
+  arma::Mat<coeff_t> rho(dim_A, dim_A, arma::fill::zeros);
+  for (auto const &sector : sectors) {
+    arma::Mat<coeff_t> rho_sector = sector.psi * sector.psi.t();
+    arma::uvec rows(sector.configs_A.size());
+    for (int64_t i = 0; i < (int64_t)sector.configs_A.size(); ++i) {
+      rows(i) = sector.configs_A[i];
+    }
+    rho.submat(rows, rows) = rho_sector;
+  }
+  return rho;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+arma::mat reduced_density_matrix(State const &state,
+                                 std::vector<int64_t> const &sites_A) try {
+  if (!isreal(state)) {
+    XDIAG_THROW("Cannot compute a real reduced density matrix of a complex "
+                "State. Use reduced_density_matrixC instead.");
+  }
+  return reduced_density_matrix<double>(state, sites_A);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+arma::cx_mat reduced_density_matrixC(State const &state,
+                                     std::vector<int64_t> const &sites_A) try {
+  return reduced_density_matrix<complex>(state, sites_A);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <typename coeff_t>
+static arma::vec entanglement_spectrum(State const &state,
+                                       std::vector<int64_t> const &sites_A) {
+  auto sectors = entanglement_sectors<coeff_t>(state, sites_A);
+  std::vector<double> spectrum;
+  for (auto const &sector : sectors) {
+    if (sector.psi.n_elem == 0) {
+      continue;
+    }
+    arma::vec s = arma::svd(sector.psi);
+    for (double sv : s) {
+      spectrum.push_back(sv * sv);
+    }
+    // Zero singular values are omitted by the thin SVD
+    int64_t n_zero = sector.psi.n_rows - s.n_elem;
+    for (int64_t i = 0; i < n_zero; ++i) {
+      spectrum.push_back(0.0);
+    }
+  }
+  // Configurations of A in sectors not compatible with the number of up
+  // and dn spins have zero weight
+  spectrum.resize(dimension_A(state, sites_A), 0.0);
+  std::sort(spectrum.begin(), spectrum.end(), std::greater<double>());
+  return arma::vec(spectrum);
+}
+
+arma::vec entanglement_spectrum(State const &state,
+                                std::vector<int64_t> const &sites_A) try {
+  return isreal(state) ? entanglement_spectrum<double>(state, sites_A)
+                       : entanglement_spectrum<complex>(state, sites_A);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+double entanglement_entropy(State const &state,
+                            std::vector<int64_t> const &sites_A) try {
+  arma::vec spectrum = entanglement_spectrum(state, sites_A);
+  double entropy = 0.;
+  for (double lambda : spectrum) {
+    if (lambda > 1e-14) {
+      entropy -= lambda * std::log(lambda);
+    }
+  }
+  return entropy;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+} // namespace xdiag
@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <vector>
+
+#include <xdiag/common.hpp>
+#include <xdiag/extern/armadillo/armadillo>
+#include <xdiag/states/state.hpp>
+
+namespace xdiag {
+
+// Reduced density matrix of a state on the subsystem A defined by sites_A.
+// The basis states are the configurations on A labeled by sum_n d_n D^n,
+// where d_n is the local state on the n-th site of A in ascending order. For
+// Spinhalf D = 2 and d_n = 0, 1 for Dn, Up. For tJ D = 3 and for Electron
+// D = 4, where d_n = 0, 1, 2, 3 for Emp, Up, Dn, UpDn. The fermionic states
+// on A are ordered as c^dag_upsA c^dag_dnsA with ascending sites.
+XDIAG_API arma::mat reduced_density_matrix(State const &state,
+                                           std::vector<int64_t> const &sites_A);
+XDIAG_API arma::cx_mat
+reduced_density_matrixC(State const &state,
+                        std::vector<int64_t> const &sites_A);
+
+// Eigenvalues of the reduced density matrix in descending order
+XDIAG_API arma::vec entanglement_spectrum(State const &state,
+                                          std::vector<int64_t> const &sites_A);
+
+// Von Neumann entanglement entropy, S = -Tr(rho_A log(rho_A))
+XDIAG_API double entanglement_entropy(State const &state,
+                                      std::vector<int64_t> const &sites_A);
+
+} // namespace xdiag
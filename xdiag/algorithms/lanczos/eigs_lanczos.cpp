@@ -4,10 +4,14 @@
 
 #include "eigs_lanczos.hpp"
 
+#include <algorithm>
+
 #include <xdiag/algebra/algebra.hpp>
 #include <xdiag/algebra/apply.hpp>
+#include <xdiag/algebra/diagonal_cache.hpp>
 #include <xdiag/algorithms/lanczos/eigvals_lanczos.hpp>
 #include <xdiag/algorithms/lanczos/lanczos.hpp>
+#include <xdiag/algorithms/lanczos/lanczos_checkpoint.hpp>
 #include <xdiag/algorithms/lanczos/lanczos_convergence.hpp>
 
 #include <xdiag/states/fill.hpp>
@@ -21,33 +25,21 @@
 
 namespace xdiag {
 
-EigsLanczosResult eigs_lanczos(OpSum const &ops, State const &state0,
-                               int64_t neigvals, double precision,
-                               int64_t max_iterations,
-                               double deflation_tol) try {
-  if (neigvals < 1) {
-    XDIAG_THROW("Argument \"neigvals\" needs to be >= 1");
-  } else if (neigvals > dim(state0.block())) {
-    neigvals = dim(state0.block());
-  }
-  if (!isvalid(state0)) {
-    XDIAG_THROW("Initial state must be a valid state (i.e. not default "
-                "constructed by e.g. an annihilation operator)");
-  }
-  if (!isapprox(ops, hc(ops))) {
-    XDIAG_THROW("Input OpSum is not hermitian");
-  }
-  auto const &block = state0.block();
+// Runs the Lanczos algorithm twice starting from "state", first to compute
+// the eigenvalues and second to compute the eigenvectors. The first run
+// overwrites state, which is restored by "restart" before the second run.
+template <class restart_f>
+static EigsLanczosResult eigs_lanczos_runs(DiagonalCache const &cache,
+                                           State &state, restart_f restart,
+                                           int64_t neigvals, double precision,
+                                           int64_t max_iterations,
+                                           double deflation_tol) try {
+  auto const &block = state.block();
+  bool real = isreal(cache.ops()) && isreal(block) && isreal(state);
 
-  bool real = isreal(ops) && isreal(block) && isreal(state0);
-
-  State state1 = state0;
-  if (!real) {
-    state1.make_complex();
-  }
   // Perform first run to compute eigenvalues
-  auto r = eigvals_lanczos_inplace(ops, state1, neigvals, precision,
-                                   max_iterations, deflation_tol);
+  auto r = lanczos::eigvals_lanczos_inplace(cache, state, neigvals, precision,
+                                            max_iterations, deflation_tol);
 
   // Perform second run to compute the eigenvectors
   arma::mat tmat = arma::diagmat(r.alphas);
@@ -67,18 +59,18 @@ EigsLanczosResult eigs_lanczos(OpSum const &ops, State const &state0,
   auto converged = [](Tmatrix const &) -> bool { return false; };
 
   State eigenvectors(block, real, neigvals);
-  state1 = state0;
+  restart(state);
   if (!real) {
-    state1.make_complex();
+    state.make_complex();
   }
 
   int64_t iter = 1;
   // Setup complex Lanczos run
   if (!real) {
-    arma::cx_vec v0 = state1.vectorC(0, false);
-    auto mult = [&iter, &ops, &block](arma::cx_vec const &v, arma::cx_vec &w) {
+    arma::cx_vec v0 = state.vectorC(0, false);
+    auto mult = [&iter, &cache](arma::cx_vec const &v, arma::cx_vec &w) {
       auto ta = rightnow();
-      apply(ops, block, v, block, w);
+      cache.apply(v, w);
       Log(1, "Lanczos iteration (rerun) {}", iter);
       timing(ta, rightnow(), "MVM", 1);
       ++iter;
@@ -97,10 +89,10 @@ EigsLanczosResult eigs_lanczos(OpSum const &ops, State const &state0,
 
     // Setup real Lanczos run
   } else {
-    arma::vec v0 = state1.vector(0, false);
-    auto mult = [&iter, &ops, &block](arma::vec const &v, arma::vec &w) {
+    arma::vec v0 = state.vector(0, false);
+    auto mult = [&iter, &cache](arma::vec const &v, arma::vec &w) {
       auto ta = rightnow();
-      apply(ops, block, v, block, w);
+      cache.apply(v, w);
       Log(1, "Lanczos iteration {}", iter);
       timing(ta, rightnow(), "MVM", 1);
       ++iter;
@@ -123,29 +115,273 @@ EigsLanczosResult eigs_lanczos(OpSum const &ops, State const &state0,
   XDIAG_RETHROW(e);
 }
 
+EigsLanczosResult eigs_lanczos(OpSum const &ops, State const &state0,
+                               int64_t neigvals, double precision,
+                               int64_t max_iterations, double deflation_tol,
+                               bool cache_diagonal) try {
+  if (neigvals < 1) {
+    XDIAG_THROW("Argument \"neigvals\" needs to be >= 1");
+  } else if (neigvals > dim(state0.block())) {
+    neigvals = dim(state0.block());
+  }
+  if (!isvalid(state0)) {
+    XDIAG_THROW("Initial state must be a valid state (i.e. not default "
+                "constructed by e.g. an annihilation operator)");
+  }
+  if (!isapprox(ops, hc(ops))) {
+    XDIAG_THROW("Input OpSum is not hermitian");
+  }
+
+  // The diagonal cache is shared by both runs
+  DiagonalCache cache(ops, state0.block(), cache_diagonal);
+
+  // Both runs work on a single copy of the initial state
+  State state1 = state0;
+  auto restart = [&state0](State &state) { state = state0; };
+  return eigs_lanczos_runs(cache, state1, restart, neigvals, precision,
+                           max_iterations, deflation_tol);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
 // starting from random vector
 EigsLanczosResult eigs_lanczos(OpSum const &ops, Block const &block,
                                int64_t neigvals, double precision,
                                int64_t max_iterations, double deflation_tol,
-                               int64_t random_seed) try {
+                               int64_t random_seed, bool cache_diagonal) try {
   if (neigvals < 1) {
     XDIAG_THROW("Argument \"neigvals\" needs to be >= 1");
   } else if (neigvals > dim(block)) {
     neigvals = dim(block);
   }
-  // if (!ops.ishermitian()) {
-  //   XDIAG_THROW("Input OpSum is not hermitian");
-  // }
+  if (!isapprox(ops, hc(ops))) {
+    XDIAG_THROW("Input OpSum is not hermitian");
+  }
 
+  // The random initial state is regenerated for the second run instead of
+  // being copied
   bool real = isreal(ops) && isreal(block);
   State state0(block, real);
   fill(state0, RandomState(random_seed));
+  auto restart = [random_seed](State &state) {
+    fill(state, RandomState(random_seed));
+  };
+  DiagonalCache cache(ops, block, cache_diagonal);
+  return eigs_lanczos_runs(cache, state0, restart, neigvals, precision,
+                           max_iterations, deflation_tol);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
 
-  auto r = eigs_lanczos(ops, state0, neigvals, precision, max_iterations,
-                        deflation_tol);
+#ifdef XDIAG_USE_HDF5
+// Second Lanczos run computing the eigenvectors as linear combinations of
+// the Lanczos vectors, continued after "iteration" steps. A checkpoint is
+// written every "interval" iterations.
+template <typename coeff_t>
+static EigsLanczosResult
+eigs_lanczos_rerun(DiagonalCache const &cache, std::string const &filename,
+                   int64_t interval,
+                   lanczos::lanczos_parameters_t const &params,
+                   EigvalsLanczosResult const &r, arma::Col<coeff_t> &v0,
+                   arma::Col<coeff_t> &v1, Tmatrix &tmatrix, int64_t iteration,
+                   arma::Mat<coeff_t> &eigenvectors) try {
+  auto const &block = cache.block();
+  int64_t neigvals = params.neigvals;
+  arma::mat tmat = arma::diagmat(r.alphas);
+  if (r.alphas.n_rows > 1) {
+    tmat += arma::diagmat(r.betas.head(r.betas.size() - 1), 1) +
+            arma::diagmat(r.betas.head(r.betas.size() - 1), -1);
+  }
+  arma::vec reigs;
+  arma::mat revecs;
+  try {
+    arma::eig_sym(reigs, revecs, tmat);
+  } catch (...) {
+    XDIAG_THROW("Error diagonalizing tridiagonal matrix");
+  }
+
+  int64_t iter = iteration + 1;
+  auto mult = [&iter, &cache](arma::Col<coeff_t> const &v,
+                              arma::Col<coeff_t> &w) {
+    auto ta = rightnow();
+    cache.apply(v, w);
+    Log(1, "Lanczos iteration (rerun) {}", iter);
+    timing(ta, rightnow(), "MVM", 1);
+    ++iter;
+  };
+  auto dotf = [&block](arma::Col<coeff_t> const &v,
+                       arma::Col<coeff_t> const &w) {
+    return dot(block, v, w);
+  };
+  auto converged = [](Tmatrix const &) -> bool { return false; };
+  auto operation = [&eigenvectors, &revecs, &iter,
+                    neigvals](arma::Col<coeff_t> const &v) {
+    eigenvectors +=
+        kron(v, revecs.submat(iter - 1, 0, iter - 1, neigvals - 1));
+  };
+  auto checkpoint = [&](arma::Col<coeff_t> const &v0,
+                        arma::Col<coeff_t> const &v1, Tmatrix const &tmat,
+                        int64_t iteration) {
+    if (iteration % interval == 0) {
+      lanczos::write_checkpoint(filename, [&](FileH5 &file) {
+        file["phase"] = (int64_t)2;
+        lanczos::write_parameters(file, params);
+        file["eigenvalues_run/alphas"] = r.alphas;
+        file["eigenvalues_run/betas"] = r.betas;
+        file["eigenvalues_run/eigenvalues"] = r.eigenvalues;
+        file["eigenvalues_run/niterations"] = r.niterations;
+        lanczos::write_string(file, "eigenvalues_run/criterion", r.criterion);
+        lanczos::write_recurrence(file, "lanczos", v0, v1, tmat, iteration);
+        file["eigenvectors"] = eigenvectors;
+      });
+    }
+  };
+  lanczos::lanczos_continue(mult, dotf, converged, operation, checkpoint, v0,
+                            v1, tmatrix, iteration, r.niterations,
+                            params.deflation_tol);
+  return {r.alphas,
+          r.betas,
+          r.eigenvalues,
+          State(block, eigenvectors),
+          r.niterations,
+          r.criterion};
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
 
-  return {r.alphas,       r.betas,       r.eigenvalues,
-          r.eigenvectors, r.niterations, r.criterion};
+// The second run starts from the same random vector as the first run
+template <typename coeff_t>
+static EigsLanczosResult
+eigs_lanczos_rerun(DiagonalCache const &cache, std::string const &filename,
+                   int64_t interval,
+                   lanczos::lanczos_parameters_t const &params,
+                   EigvalsLanczosResult const &r) try {
+  auto const &block = cache.block();
+  State state0(block, params.real);
+  fill(state0, RandomState(params.random_seed));
+  arma::Col<coeff_t> v1;
+  if constexpr (isreal<coeff_t>()) {
+    v1 = state0.vector(0, false);
+  } else {
+    v1 = state0.vectorC(0, false);
+  }
+  v1 /= norm(block, v1);
+  arma::Col<coeff_t> v0(v1.n_elem, arma::fill::zeros);
+  arma::Mat<coeff_t> eigenvectors(v1.n_elem, params.neigvals,
+                                  arma::fill::zeros);
+  Tmatrix tmatrix;
+  return eigs_lanczos_rerun(cache, filename, interval, params, r, v0, v1,
+                            tmatrix, 0, eigenvectors);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <typename coeff_t>
+static EigsLanczosResult
+eigs_lanczos_rerun_resume(DiagonalCache const &cache,
+                          std::string const &filename, int64_t interval,
+                          lanczos::lanczos_parameters_t const &params) try {
+  auto const &block = cache.block();
+  EigvalsLanczosResult r;
+  arma::Col<coeff_t> v0(size(block));
+  arma::Col<coeff_t> v1(size(block));
+  Tmatrix tmatrix;
+  int64_t iteration = 0;
+  arma::Mat<coeff_t> eigenvectors;
+  lanczos::read_checkpoint(filename, [&](FileH5 &file) {
+    r.alphas = file["eigenvalues_run/alphas"].as<arma::vec>();
+    r.betas = file["eigenvalues_run/betas"].as<arma::vec>();
+    r.eigenvalues = file["eigenvalues_run/eigenvalues"].as<arma::vec>();
+    r.niterations = file["eigenvalues_run/niterations"].as<int64_t>();
+    r.criterion = lanczos::read_string(file, "eigenvalues_run/criterion");
+    lanczos::read_recurrence(file, "lanczos", v0, v1, tmatrix, iteration);
+    eigenvectors = file["eigenvectors"].as<arma::Mat<coeff_t>>();
+  });
+  if ((int64_t)eigenvectors.n_rows != size(block)) {
+    XDIAG_THROW("Size of the eigenvectors in the checkpoint does not match "
+                "the size of the block");
+  }
+  Log(1, "Resuming Lanczos run (rerun) after iteration {}", iteration);
+  return eigs_lanczos_rerun(cache, filename, interval, params, r, v0, v1,
+                            tmatrix, iteration, eigenvectors);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+#endif
+
+EigsLanczosResult eigs_lanczos_checkpoint(OpSum const &ops, Block const &block,
+                                          std::string filename,
+                                          int64_t interval, int64_t neigvals,
+                                          double precision,
+                                          int64_t max_iterations,
+                                          double deflation_tol,
+                                          int64_t random_seed,
+                                          bool cache_diagonal) try {
+  lanczos::check_checkpoint_support();
+  if (!isapprox(ops, hc(ops))) {
+    XDIAG_THROW("Input OpSum is not hermitian");
+  }
+  DiagonalCache cache(ops, block, cache_diagonal);
+  auto r = lanczos::eigvals_lanczos_checkpoint(cache, filename, interval,
+                                               neigvals, precision,
+                                               max_iterations, deflation_tol,
+                                               random_seed);
+#ifdef XDIAG_USE_HDF5
+  bool real = isreal(ops) && isreal(block);
+  neigvals = std::min(neigvals, dim(block));
+  lanczos::lanczos_parameters_t params{neigvals,      precision,
+                                       max_iterations, deflation_tol,
+                                       random_seed,   real};
+  if (real) {
+    return eigs_lanczos_rerun<double>(cache, filename, interval, params, r);
+  } else {
+    return eigs_lanczos_rerun<complex>(cache, filename, interval, params, r);
+  }
+#else
+  return EigsLanczosResult();
+#endif
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+EigsLanczosResult eigs_lanczos_resume(OpSum const &ops, Block const &block,
+                                      std::string filename, int64_t interval,
+                                      bool cache_diagonal) try {
+  lanczos::check_checkpoint_support();
+#ifdef XDIAG_USE_HDF5
+  int64_t phase = 0;
+  lanczos::lanczos_parameters_t params;
+  lanczos::read_checkpoint(filename, [&](FileH5 &file) {
+    phase = file["phase"].as<int64_t>();
+    params = lanczos::read_parameters(file);
+  });
+
+  if ((phase != 1) && (phase != 2)) {
+    XDIAG_THROW("Checkpoint does not belong to an eigenvector computation");
+  }
+  DiagonalCache cache(ops, block, cache_diagonal);
+
+  // Interrupted during the first run computing the eigenvalues
+  if (phase == 1) {
+    auto r = lanczos::eigvals_lanczos_resume(cache, filename, interval);
+    if (params.real) {
+      return eigs_lanczos_rerun<double>(cache, filename, interval, params, r);
+    } else {
+      return eigs_lanczos_rerun<complex>(cache, filename, interval, params, r);
+    }
+
+    // Interrupted during the second run computing the eigenvectors
+  } else {
+    if (params.real) {
+      return eigs_lanczos_rerun_resume<double>(cache, filename, interval,
+                                               params);
+    } else {
+      return eigs_lanczos_rerun_resume<complex>(cache, filename, interval,
+                                                params);
+    }
+  }
+#endif
+  return EigsLanczosResult();
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
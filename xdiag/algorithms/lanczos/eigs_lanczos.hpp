@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <string>
+
 #include <xdiag/common.hpp>
 
 #include <xdiag/blocks/blocks.hpp>
@@ -21,17 +23,35 @@ struct EigsLanczosResult {
   std::string criterion;
 };
 
-XDIAG_API EigsLanczosResult eigs_lanczos(OpSum const &ops, Block const &block,
-                                         int64_t neigvals = 1,
-                                         double precision = 1e-12,
-                                         int64_t max_iterations = 1000,
-                                         double deflation_tol = 1e-7,
-                                         int64_t random_seed = 42);
-
-XDIAG_API EigsLanczosResult eigs_lanczos(OpSum const &ops, State const &state0,
-                                         int64_t neigvals = 1,
-                                         double precision = 1e-12,
-                                         int64_t max_iterations = 1000,
-                                         double deflation_tol = 1e-7);
+// If cache_diagonal is set, the diagonal of ops is precomputed once and used
+// by both Lanczos runs, see DiagonalCache
+XDIAG_API EigsLanczosResult
+eigs_lanczos(OpSum const &ops, Block const &block, int64_t neigvals = 1,
+             double precision = 1e-12, int64_t max_iterations = 1000,
+             double deflation_tol = 1e-7, int64_t random_seed = 42,
+             bool cache_diagonal = false);
+
+// Both Lanczos runs start from state0, which is copied once and left intact.
+// Starting from a random state on a block regenerates it instead of copying.
+XDIAG_API EigsLanczosResult
+eigs_lanczos(OpSum const &ops, State const &state0, int64_t neigvals = 1,
+             double precision = 1e-12, int64_t max_iterations = 1000,
+             double deflation_tol = 1e-7, bool cache_diagonal = false);
+
+// Lanczos runs writing a checkpoint to the HDF5 file "filename" every
+// "interval" iterations of both the run computing the eigenvalues and the
+// run computing the eigenvectors. An interrupted computation is continued
+// from the last checkpoint with eigs_lanczos_resume.
+XDIAG_API EigsLanczosResult eigs_lanczos_checkpoint(
+    OpSum const &ops, Block const &block, std::string filename,
+    int64_t interval = 10, int64_t neigvals = 1, double precision = 1e-12,
+    int64_t max_iterations = 1000, double deflation_tol = 1e-7,
+    int64_t random_seed = 42, bool cache_diagonal = false);
+
+XDIAG_API EigsLanczosResult eigs_lanczos_resume(OpSum const &ops,
+                                                Block const &block,
+                                                std::string filename,
+                                                int64_t interval = 10,
+                                                bool cache_diagonal = false);
 
 } // namespace xdiag
@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "eigs_lanczos_mixed.hpp"
+
+#include <xdiag/algebra/algebra.hpp>
+#include <xdiag/algebra/apply.hpp>
+#include <xdiag/algebra/fill.hpp>
+#include <xdiag/algorithms/lanczos/lanczos.hpp>
+#include <xdiag/algorithms/lanczos/lanczos_convergence.hpp>
+#include <xdiag/operators/logic/hc.hpp>
+#include <xdiag/operators/logic/isapprox.hpp>
+#include <xdiag/operators/logic/real.hpp>
+#include <xdiag/states/fill.hpp>
+#include <xdiag/states/random_state.hpp>
+#include <xdiag/utils/timing.hpp>
+
+namespace xdiag {
+
+template <typename coeff_t>
+static arma::Col<apply_coeff_t<coeff_t>>
+ritz_vectors_single(OpSum const &ops, Block const &block,
+                    arma::Col<coeff_t> const &start, int64_t neigvals,
+                    double precision_single, int64_t max_iterations,
+                    double deflation_tol) try {
+  using double_coeff_t = apply_coeff_t<coeff_t>;
+  int64_t iter = 1;
+  auto mult = [&iter, &ops, &block](arma::Col<coeff_t> const &v,
+                                    arma::Col<coeff_t> &w) {
+    auto ta = rightnow();
+    apply(ops, block, v, block, w);
+    Log(1, "Lanczos iteration (single precision) {}", iter);
+    timing(ta, rightnow(), "MVM", 1);
+    ++iter;
+  };
+  auto dotf = [&block](arma::Col<coeff_t> const &v,
+                       arma::Col<coeff_t> const &w) {
+    return dot(block, v, w);
+  };
+  auto converged = [neigvals, precision_single](Tmatrix const &tmat) -> bool {
+    return lanczos::converged_eigenvalues(tmat, neigvals, precision_single);
+  };
+  auto no_operation = [](arma::Col<coeff_t> const &) {};
+
+  // First run to compute the Ritz values
+  arma::Col<coeff_t> v0 = start;
+  auto r = lanczos::lanczos(mult, dotf, converged, no_operation, v0,
+                            max_iterations, deflation_tol);
+  Log(1, "Single precision Lanczos: {} iterations, criterion: {}",
+      r.niterations, r.criterion);
+
+  arma::mat tmat = arma::diagmat(r.alphas);
+  if (r.alphas.n_rows > 1) {
+    tmat += arma::diagmat(r.betas.head(r.betas.size() - 1), 1) +
+            arma::diagmat(r.betas.head(r.betas.size() - 1), -1);
+  }
+  arma::vec reigs;
+  arma::mat revecs;
+  try {
+    arma::eig_sym(reigs, revecs, tmat);
+  } catch (...) {
+    XDIAG_THROW("Error diagonalizing tridiagonal matrix");
+  }
+  int64_t nritz = std::min(neigvals, (int64_t)revecs.n_cols);
+  arma::vec coefficients = arma::sum(revecs.head_cols(nritz), 1);
+
+  // Second run to accumulate the Ritz vectors in double precision
+  arma::Col<double_coeff_t> ritz(start.n_elem, arma::fill::zeros);
+  auto accumulate = [&iter, &ritz, &coefficients](arma::Col<coeff_t> const &v) {
+    double c = coefficients(iter - 1);
+    int64_t size = v.n_elem;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t i = 0; i < size; ++i) {
+      ritz(i) += c * (double_coeff_t)v(i);
+    }
+  };
+  auto not_converged = [](Tmatrix const &) -> bool { return false; };
+  iter = 1;
+  v0 = start;
+  lanczos::lanczos(mult, dotf, not_converged, accumulate, v0, r.niterations,
+                   deflation_tol);
+  return ritz;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+// Approximate eigenvectors from a single precision Lanczos run, summed up
+// in a single double precision state
+static State ritz_vectors_single(OpSum const &ops, Block const &block,
+                                 int64_t neigvals, double precision_single,
+                                 int64_t max_iterations, double deflation_tol,
+                                 int64_t random_seed) try {
+  if (isdistributed(block)) {
+    XDIAG_THROW("Mixed precision Lanczos is not supported for distributed "
+                "blocks");
+  }
+  if (!isapprox(ops, hc(ops))) {
+    XDIAG_THROW("Input OpSum is not hermitian");
+  }
+  bool real = isreal(ops) && isreal(block);
+  State state0(block, real);
+  fill(state0, RandomState(random_seed));
+
+  if (real) {
+    arma::fvec start = arma::conv_to<arma::fvec>::from(state0.vector(0, false));
+    arma::vec ritz =
+        ritz_vectors_single(ops, block, start, neigvals, precision_single,
+                            max_iterations, deflation_tol);
+    return State(block, ritz);
+  } else {
+    arma::cx_fvec start =
+        arma::conv_to<arma::cx_fvec>::from(state0.vectorC(0, false));
+    arma::cx_vec ritz =
+        ritz_vectors_single(ops, block, start, neigvals, precision_single,
+                            max_iterations, deflation_tol);
+    return State(block, ritz);
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+EigvalsLanczosResult
+eigvals_lanczos_mixed(OpSum const &ops, Block const &block, int64_t neigvals,
+                      double precision, int64_t max_iterations,
+                      double deflation_tol, int64_t random_seed,
+                      double precision_single) try {
+  if (neigvals < 1) {
+    XDIAG_THROW("Argument \"neigvals\" needs to be >= 1");
+  } else if (neigvals > dim(block)) {
+    neigvals = dim(block);
+  }
+  auto state0 = ritz_vectors_single(ops, block, neigvals, precision_single,
+                                    max_iterations, deflation_tol, random_seed);
+  return eigvals_lanczos_inplace(ops, state0, neigvals, precision,
+                                 max_iterations, deflation_tol);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+EigsLanczosResult eigs_lanczos_mixed(OpSum const &ops, Block const &block,
+                                     int64_t neigvals, double precision,
+                                     int64_t max_iterations,
+                                     double deflation_tol, int64_t random_seed,
+                                     double precision_single) try {
+  if (neigvals < 1) {
+    XDIAG_THROW("Argument \"neigvals\" needs to be >= 1");
+  } else if (neigvals > dim(block)) {
+    neigvals = dim(block);
+  }
+  auto state0 = ritz_vectors_single(ops, block, neigvals, precision_single,
+                                    max_iterations, deflation_tol, random_seed);
+  return eigs_lanczos(ops, state0, neigvals, precision, max_iterations,
+                      deflation_tol);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+} // namespace xdiag
@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <xdiag/common.hpp>
+
+#include <xdiag/algorithms/lanczos/eigs_lanczos.hpp>
+#include <xdiag/algorithms/lanczos/eigvals_lanczos.hpp>
+#include <xdiag/blocks/blocks.hpp>
+#include <xdiag/operators/opsum.hpp>
+#include <xdiag/states/state.hpp>
+
+namespace xdiag {
+
+// Mixed precision Lanczos algorithms. A first Lanczos run is performed with
+// single precision vectors until the eigenvalues are converged up to
+// precision_single. The final result is then computed by a full double
+// precision Lanczos run, i.e. eigvals_lanczos or eigs_lanczos, started from
+// the sum of the single precision Ritz vectors. This only reduces the number
+// of double precision iterations, the refinement is not cheaper per step.
+XDIAG_API EigvalsLanczosResult eigvals_lanczos_mixed(
+    OpSum const &ops, Block const &block, int64_t neigvals = 1,
+    double precision = 1e-12, int64_t max_iterations = 1000,
+    double deflation_tol = 1e-7, int64_t random_seed = 42,
+    double precision_single = 1e-5);
+
+XDIAG_API EigsLanczosResult eigs_lanczos_mixed(
+    OpSum const &ops, Block const &block, int64_t neigvals = 1,
+    double precision = 1e-12, int64_t max_iterations = 1000,
+    double deflation_tol = 1e-7, int64_t random_seed = 42,
+    double precision_single = 1e-5);
+
+} // namespace xdiag
@@ -6,7 +6,9 @@
 
 #include <xdiag/algebra/algebra.hpp>
 #include <xdiag/algebra/apply.hpp>
+#include <xdiag/algebra/diagonal_cache.hpp>
 #include <xdiag/algorithms/lanczos/lanczos.hpp>
+#include <xdiag/algorithms/lanczos/lanczos_checkpoint.hpp>
 #include <xdiag/algorithms/lanczos/lanczos_convergence.hpp>
 
 #include <xdiag/states/fill.hpp>
@@ -28,7 +30,8 @@ EigvalsLanczosResult eigvals_lanczos(OpSum const &ops, Block const &block,
                                      int64_t neigvals, double precision,
                                      int64_t max_iterations,
                                      double deflation_tol,
-                                     int64_t random_seed) try {
+                                     int64_t random_seed,
+                                     bool cache_diagonal) try {
 
   if (neigvals < 1) {
     XDIAG_THROW("Argument \"neigvals\" needs to be >= 1");
@@ -41,7 +44,8 @@ EigvalsLanczosResult eigvals_lanczos(OpSum const &ops, Block const &block,
   fill(state0, RandomState(random_seed));
 
   auto r = eigvals_lanczos_inplace(ops, state0, neigvals, precision,
-                                   max_iterations, deflation_tol);
+                                   max_iterations, deflation_tol,
+                                   cache_diagonal);
 
   return {r.alphas, r.betas, r.eigenvalues, r.niterations, r.criterion};
 
@@ -52,9 +56,10 @@ EigvalsLanczosResult eigvals_lanczos(OpSum const &ops, Block const &block,
 EigvalsLanczosResult eigvals_lanczos(OpSum const &ops, State psi0,
                                      int64_t neigvals, double precision,
                                      int64_t max_iterations,
-                                     double deflation_tol) try {
+                                     double deflation_tol,
+                                     bool cache_diagonal) try {
   return eigvals_lanczos_inplace(ops, psi0, neigvals, precision, max_iterations,
-                                 deflation_tol);
+                                 deflation_tol, cache_diagonal);
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
@@ -62,13 +67,8 @@ EigvalsLanczosResult eigvals_lanczos(OpSum const &ops, State psi0,
 EigvalsLanczosResult eigvals_lanczos_inplace(OpSum const &ops, State &psi0,
                                              int64_t neigvals, double precision,
                                              int64_t max_iterations,
-                                             double deflation_tol) try {
-  if (neigvals < 1) {
-    XDIAG_THROW("Argument \"neigvals\" needs to be >= 1");
-  } else if (neigvals > dim(psi0.block())) {
-    neigvals = dim(psi0.block());
-  }
-
+                                             double deflation_tol,
+                                             bool cache_diagonal) try {
   if (!isvalid(psi0)) {
     XDIAG_THROW("Initial state must be a valid state (i.e. not default "
                 "constructed by e.g. an annihilation operator)");
@@ -77,10 +77,27 @@ EigvalsLanczosResult eigvals_lanczos_inplace(OpSum const &ops, State &psi0,
   if (!isapprox(ops, hc(ops))) {
     XDIAG_THROW("Input OpSum is not hermitian");
   }
+  DiagonalCache cache(ops, psi0.block(), cache_diagonal);
+  return lanczos::eigvals_lanczos_inplace(cache, psi0, neigvals, precision,
+                                          max_iterations, deflation_tol);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+EigvalsLanczosResult
+lanczos::eigvals_lanczos_inplace(DiagonalCache const &cache, State &psi0,
+                                 int64_t neigvals, double precision,
+                                 int64_t max_iterations,
+                                 double deflation_tol) try {
+  if (neigvals < 1) {
+    XDIAG_THROW("Argument \"neigvals\" needs to be >= 1");
+  } else if (neigvals > dim(psi0.block())) {
+    neigvals = dim(psi0.block());
+  }
 
   auto const &block = psi0.block();
 
-  bool real = isreal(ops) && isreal(block) && isreal(psi0);
+  bool real = isreal(cache.ops()) && isreal(block) && isreal(psi0);
   auto converged = [neigvals, precision](Tmatrix const &tmat) -> bool {
     return lanczos::converged_eigenvalues(tmat, neigvals, precision);
   };
@@ -90,9 +107,9 @@ EigvalsLanczosResult eigvals_lanczos_inplace(OpSum const &ops, State &psi0,
   if (!real) {
     psi0.make_complex();
     arma::cx_vec v0 = psi0.vectorC(0, false);
-    auto mult = [&iter, &ops, &block](arma::cx_vec const &v, arma::cx_vec &w) {
+    auto mult = [&iter, &cache](arma::cx_vec const &v, arma::cx_vec &w) {
       auto ta = rightnow();
-      apply(ops, block, v, block, w);
+      cache.apply(v, w);
       Log(1, "Lanczos iteration {}", iter);
       timing(ta, rightnow(), "MVM", 1);
       ++iter;
@@ -108,9 +125,9 @@ EigvalsLanczosResult eigvals_lanczos_inplace(OpSum const &ops, State &psi0,
     // Setup real Lanczos run
   } else {
     arma::vec v0 = psi0.vector(0, false);
-    auto mult = [&iter, &ops, &block](arma::vec const &v, arma::vec &w) {
+    auto mult = [&iter, &cache](arma::vec const &v, arma::vec &w) {
       auto ta = rightnow();
-      apply(ops, block, v, block, w);
+      cache.apply(v, w);
       Log(1, "Lanczos iteration {}", iter);
       timing(ta, rightnow(), "MVM", 1);
       ++iter;
@@ -128,4 +145,193 @@ EigvalsLanczosResult eigvals_lanczos_inplace(OpSum const &ops, State &psi0,
   XDIAG_RETHROW(e);
 }
 
+#ifdef XDIAG_USE_HDF5
+// Continues the recurrence v0, v1, tmatrix after "iteration" steps and
+// writes a checkpoint every "interval" iterations
+template <typename coeff_t>
+static EigvalsLanczosResult
+eigvals_lanczos_continue(DiagonalCache const &cache,
+                         std::string const &filename, int64_t interval,
+                         lanczos::lanczos_parameters_t const &params,
+                         arma::Col<coeff_t> &v0, arma::Col<coeff_t> &v1,
+                         Tmatrix &tmatrix, int64_t iteration) try {
+  auto const &block = cache.block();
+  int64_t iter = iteration + 1;
+  auto mult = [&iter, &cache](arma::Col<coeff_t> const &v,
+                              arma::Col<coeff_t> &w) {
+    auto ta = rightnow();
+    cache.apply(v, w);
+    Log(1, "Lanczos iteration {}", iter);
+    timing(ta, rightnow(), "MVM", 1);
+    ++iter;
+  };
+  auto dotf = [&block](arma::Col<coeff_t> const &v,
+                       arma::Col<coeff_t> const &w) {
+    return dot(block, v, w);
+  };
+  int64_t neigvals = params.neigvals;
+  double precision = params.precision;
+  auto converged = [neigvals, precision](Tmatrix const &tmat) -> bool {
+    return lanczos::converged_eigenvalues(tmat, neigvals, precision);
+  };
+  auto operation = [](arma::Col<coeff_t> const &) {};
+  auto checkpoint = [&](arma::Col<coeff_t> const &v0,
+                        arma::Col<coeff_t> const &v1, Tmatrix const &tmat,
+                        int64_t iteration) {
+    if (iteration % interval == 0) {
+      lanczos::write_checkpoint(filename, [&](FileH5 &file) {
+        file["phase"] = (int64_t)1;
+        lanczos::write_parameters(file, params);
+        lanczos::write_recurrence(file, "lanczos", v0, v1, tmat, iteration);
+      });
+    }
+  };
+  auto r = lanczos::lanczos_continue(mult, dotf, converged, operation,
+                                     checkpoint, v0, v1, tmatrix, iteration,
+                                     params.max_iterations,
+                                     params.deflation_tol);
+  return {r.alphas, r.betas, r.eigenvalues, r.niterations, r.criterion};
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <typename coeff_t>
+static EigvalsLanczosResult
+eigvals_lanczos_start(DiagonalCache const &cache, std::string const &filename,
+                      int64_t interval,
+                      lanczos::lanczos_parameters_t const &params) try {
+  auto const &block = cache.block();
+  State state0(block, params.real);
+  fill(state0, RandomState(params.random_seed));
+  arma::Col<coeff_t> v1;
+  if constexpr (isreal<coeff_t>()) {
+    v1 = state0.vector(0, false);
+  } else {
+    v1 = state0.vectorC(0, false);
+  }
+  double v1_norm = norm(block, v1);
+  if (v1_norm < 1e-12) {
+    XDIAG_THROW("Initial state of the Lanczos run has zero norm");
+  }
+  v1 /= v1_norm;
+  arma::Col<coeff_t> v0(v1.n_elem, arma::fill::zeros);
+  Tmatrix tmatrix;
+  return eigvals_lanczos_continue(cache, filename, interval, params, v0, v1,
+                                  tmatrix, 0);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <typename coeff_t>
+static EigvalsLanczosResult
+eigvals_lanczos_reread(DiagonalCache const &cache, std::string const &filename,
+                       int64_t interval,
+                       lanczos::lanczos_parameters_t const &params) try {
+  auto const &block = cache.block();
+  arma::Col<coeff_t> v0(size(block));
+  arma::Col<coeff_t> v1(size(block));
+  Tmatrix tmatrix;
+  int64_t iteration = 0;
+  lanczos::read_checkpoint(filename, [&](FileH5 &file) {
+    lanczos::read_recurrence(file, "lanczos", v0, v1, tmatrix, iteration);
+  });
+  Log(1, "Resuming Lanczos run after iteration {}", iteration);
+  return eigvals_lanczos_continue(cache, filename, interval, params, v0, v1,
+                                  tmatrix, iteration);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+#endif
+
+EigvalsLanczosResult eigvals_lanczos_checkpoint(
+    OpSum const &ops, Block const &block, std::string filename,
+    int64_t interval, int64_t neigvals, double precision,
+    int64_t max_iterations, double deflation_tol, int64_t random_seed,
+    bool cache_diagonal) try {
+  lanczos::check_checkpoint_support();
+  if (!isapprox(ops, hc(ops))) {
+    XDIAG_THROW("Input OpSum is not hermitian");
+  }
+  DiagonalCache cache(ops, block, cache_diagonal);
+  return lanczos::eigvals_lanczos_checkpoint(cache, filename, interval,
+                                             neigvals, precision,
+                                             max_iterations, deflation_tol,
+                                             random_seed);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+EigvalsLanczosResult lanczos::eigvals_lanczos_checkpoint(
+    DiagonalCache const &cache, std::string filename, int64_t interval,
+    int64_t neigvals, double precision, int64_t max_iterations,
+    double deflation_tol, int64_t random_seed) try {
+  lanczos::check_checkpoint_support();
+  auto const &block = cache.block();
+  if (neigvals < 1) {
+    XDIAG_THROW("Argument \"neigvals\" needs to be >= 1");
+  } else if (neigvals > dim(block)) {
+    neigvals = dim(block);
+  }
+  if (interval < 1) {
+    XDIAG_THROW("Argument \"interval\" needs to be >= 1");
+  }
+#ifdef XDIAG_USE_HDF5
+  bool real = isreal(cache.ops()) && isreal(block);
+  lanczos::lanczos_parameters_t params{neigvals,      precision,
+                                       max_iterations, deflation_tol,
+                                       random_seed,   real};
+  if (real) {
+    return eigvals_lanczos_start<double>(cache, filename, interval, params);
+  } else {
+    return eigvals_lanczos_start<complex>(cache, filename, interval, params);
+  }
+#else
+  return EigvalsLanczosResult();
+#endif
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+EigvalsLanczosResult eigvals_lanczos_resume(OpSum const &ops,
+                                            Block const &block,
+                                            std::string filename,
+                                            int64_t interval,
+                                            bool cache_diagonal) try {
+  lanczos::check_checkpoint_support();
+  DiagonalCache cache(ops, block, cache_diagonal);
+  return lanczos::eigvals_lanczos_resume(cache, filename, interval);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+EigvalsLanczosResult lanczos::eigvals_lanczos_resume(DiagonalCache const &cache,
+                                                     std::string filename,
+                                                     int64_t interval) try {
+  lanczos::check_checkpoint_support();
+  if (interval < 1) {
+    XDIAG_THROW("Argument \"interval\" needs to be >= 1");
+  }
+#ifdef XDIAG_USE_HDF5
+  int64_t phase = 0;
+  lanczos::lanczos_parameters_t params;
+  lanczos::read_checkpoint(filename, [&](FileH5 &file) {
+    phase = file["phase"].as<int64_t>();
+    params = lanczos::read_parameters(file);
+  });
+  if (phase != 1) {
+    XDIAG_THROW("Checkpoint does not contain the first Lanczos run of an "
+                "eigenvalue computation");
+  }
+  if (params.real) {
+    return eigvals_lanczos_reread<double>(cache, filename, interval, params);
+  } else {
+    return eigvals_lanczos_reread<complex>(cache, filename, interval, params);
+  }
+#else
+  return EigvalsLanczosResult();
+#endif
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
 } // namespace xdiag
@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <string>
+
 #include <xdiag/common.hpp>
 
+#include <xdiag/algebra/diagonal_cache.hpp>
 #include <xdiag/blocks/blocks.hpp>
 #include <xdiag/operators/opsum.hpp>
 #include <xdiag/states/state.hpp>
@@ -20,20 +23,63 @@ struct EigvalsLanczosResult {
   std::string criterion;
 };
 
+// If cache_diagonal is set, the diagonal of ops is precomputed once, see
+// DiagonalCache
 XDIAG_API EigvalsLanczosResult
 eigvals_lanczos(OpSum const &ops, Block const &block, int64_t neigvals = 1,
                 double precision = 1e-12, int64_t max_iterations = 1000,
-                double deflation_tol = 1e-7, int64_t random_seed = 42);
+                double deflation_tol = 1e-7, int64_t random_seed = 42,
+                bool cache_diagonal = false);
 
-XDIAG_API EigvalsLanczosResult eigvals_lanczos(OpSum const &ops, State psi0,
-                                               int64_t neigvals = 1,
-                                               double precision = 1e-12,
-                                               int64_t max_iterations = 1000,
-                                               double deflation_tol = 1e-7);
+// psi0 is taken by value, such that passing an lvalue copies it. To avoid the
+// copy, pass it with std::move or use eigvals_lanczos_inplace, which
+// overwrites psi0.
+XDIAG_API EigvalsLanczosResult
+eigvals_lanczos(OpSum const &ops, State psi0, int64_t neigvals = 1,
+                double precision = 1e-12, int64_t max_iterations = 1000,
+                double deflation_tol = 1e-7, bool cache_diagonal = false);
 
 XDIAG_API EigvalsLanczosResult
 eigvals_lanczos_inplace(OpSum const &ops, State &psi0, int64_t neigvals = 1,
                         double precision = 1e-12, int64_t max_iterations = 1000,
-                        double deflation_tol = 1e-7);
+                        double deflation_tol = 1e-7,
+                        bool cache_diagonal = false);
+
+// Lanczos run writing a checkpoint to the HDF5 file "filename" every
+// "interval" iterations. An interrupted run is continued from the last
+// checkpoint with eigvals_lanczos_resume, which reads all other parameters
+// from the checkpoint.
+XDIAG_API EigvalsLanczosResult eigvals_lanczos_checkpoint(
+    OpSum const &ops, Block const &block, std::string filename,
+    int64_t interval = 10, int64_t neigvals = 1, double precision = 1e-12,
+    int64_t max_iterations = 1000, double deflation_tol = 1e-7,
+    int64_t random_seed = 42, bool cache_diagonal = false);
+
+XDIAG_API EigvalsLanczosResult
+eigvals_lanczos_resume(OpSum const &ops, Block const &block,
+                       std::string filename, int64_t interval = 10,
+                       bool cache_diagonal = false);
+
+namespace lanczos {
+
+// Variants on a DiagonalCache built by the caller, such that eigs_lanczos
+// builds the cache only once for both of its Lanczos runs
+EigvalsLanczosResult eigvals_lanczos_inplace(DiagonalCache const &H,
+                                             State &psi0, int64_t neigvals,
+                                             double precision,
+                                             int64_t max_iterations,
+                                             double deflation_tol);
+
+EigvalsLanczosResult
+eigvals_lanczos_checkpoint(DiagonalCache const &H, std::string filename,
+                           int64_t interval, int64_t neigvals,
+                           double precision, int64_t max_iterations,
+                           double deflation_tol, int64_t random_seed);
+
+EigvalsLanczosResult eigvals_lanczos_resume(DiagonalCache const &H,
+                                            std::string filename,
+                                            int64_t interval);
+
+} // namespace lanczos
 
 } // namespace xdiag
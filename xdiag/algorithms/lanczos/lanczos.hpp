@@ -9,6 +9,7 @@
 #include <xdiag/algorithms/lanczos/lanczos_step.hpp>
 #include <xdiag/algorithms/lanczos/tmatrix.hpp>
 #include <xdiag/common.hpp>
+#include <xdiag/utils/allocator.hpp>
 #include <xdiag/utils/logger.hpp>
 
 namespace xdiag::lanczos {
@@ -21,43 +22,37 @@ struct lanczos_result_t {
   std::string criterion;
 };
 
+// Continues a Lanczos recurrence from the two most recent Lanczos vectors
+// v0 and v1 and the T-matrix after "iteration" steps. After every step
+// checkpoint(v0, v1, tmatrix, iteration) is called, which allows for storing
+// the recurrence such that an interrupted run can be continued later.
 template <class coeff_t, class mult_f, class dot_f, class converged_f,
-          class operation_f>
-lanczos_result_t lanczos(mult_f mult, dot_f dot, converged_f converged,
-                         operation_f operation, arma::Col<coeff_t> &v0,
-                         int max_iterations = 1000,
-                         double deflation_tol = 1e-7) try {
-  auto norm = [&dot](arma::Col<coeff_t> const &v) {
-    return std::sqrt(xdiag::real(dot(v, v)));
-  };
-  auto tmatrix = Tmatrix();
-
-  // Initialize Lanczos vectors and tmatrix
-  arma::Col<coeff_t> v1, w;
+          class operation_f, class checkpoint_f>
+lanczos_result_t
+lanczos_continue(mult_f mult, dot_f dot, converged_f converged,
+                 operation_f operation, checkpoint_f checkpoint,
+                 arma::Col<coeff_t> &v0, arma::Col<coeff_t> &v1,
+                 Tmatrix &tmatrix, int64_t iteration, int max_iterations = 1000,
+                 double deflation_tol = 1e-7) try {
+  numa_vector_uninit<coeff_t> w_storage;
   try {
-    v1 = v0;
-    w.resize(v0.size());
-    w.zeros();
-    v0.zeros();
+    w_storage.resize(v1.size());
   } catch (...) {
     XDIAG_THROW("Cannot allocate Lanczos vectors");
   }
+  arma::Col<coeff_t> w(w_storage.data(), v1.size(), false, true);
+  w.zeros();
 
   double alpha = 0.;
-  double beta = 0.;
-
-  // Normalize start vector or return if norm is zero
-  coeff_t v1_norm = norm(v1);
-  if (std::abs(v1_norm) > 1e-12) {
-    v1 /= v1_norm;
-  } else {
-    return lanczos_result_t();
-  }
+  double beta = (tmatrix.size() > 0) ? tmatrix.betas()(tmatrix.size() - 1) : 0.;
 
   // Main Lanczos loop
-  int64_t iteration = 0;
   std::string criterion;
   while (!converged(tmatrix)) {
+    if (iteration >= max_iterations) {
+      criterion = "maxiterations";
+      break;
+    }
     operation(v1);
     lanczos_step(v0, v1, w, alpha, beta, mult, dot);
     tmatrix.append(alpha, beta);
@@ -71,10 +66,7 @@ lanczos_result_t lanczos(mult_f mult, dot_f dot, converged_f converged,
       criterion = "deflated";
       break;
     }
-    if (iteration >= max_iterations) {
-      criterion = "maxiterations";
-      break;
-    }
+    checkpoint(v0, v1, tmatrix, iteration);
   }
 
   if (converged(tmatrix)) {
@@ -88,4 +80,56 @@ lanczos_result_t lanczos(mult_f mult, dot_f dot, converged_f converged,
   return lanczos_result_t();
 }
 
+template <class coeff_t, class mult_f, class dot_f, class converged_f,
+          class operation_f, class checkpoint_f>
+lanczos_result_t lanczos(mult_f mult, dot_f dot, converged_f converged,
+                         operation_f operation, checkpoint_f checkpoint,
+                         arma::Col<coeff_t> &v0, int max_iterations = 1000,
+                         double deflation_tol = 1e-7) try {
+  auto norm = [&dot](arma::Col<coeff_t> const &v) {
+    return std::sqrt(xdiag::real(dot(v, v)));
+  };
+  auto tmatrix = Tmatrix();
+
+  // Initialize Lanczos vectors
+  numa_vector_uninit<coeff_t> v1_storage;
+  try {
+    v1_storage.resize(v0.size());
+  } catch (...) {
+    XDIAG_THROW("Cannot allocate Lanczos vectors");
+  }
+  arma::Col<coeff_t> v1(v1_storage.data(), v0.size(), false, true);
+  v1 = v0;
+  v0.zeros();
+
+  // Normalize start vector or return if norm is zero
+  coeff_t v1_norm = norm(v1);
+  if (std::abs(v1_norm) > 1e-12) {
+    v1 /= v1_norm;
+  } else {
+    return lanczos_result_t();
+  }
+  return lanczos_continue(mult, dot, converged, operation, checkpoint, v0, v1,
+                          tmatrix, 0, max_iterations, deflation_tol);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+  return lanczos_result_t();
+}
+
+template <class coeff_t, class mult_f, class dot_f, class converged_f,
+          class operation_f>
+lanczos_result_t lanczos(mult_f mult, dot_f dot, converged_f converged,
+                         operation_f operation, arma::Col<coeff_t> &v0,
+                         int max_iterations = 1000,
+                         double deflation_tol = 1e-7) try {
+  auto no_checkpoint = [](arma::Col<coeff_t> const &,
+                          arma::Col<coeff_t> const &, Tmatrix const &,
+                          int64_t) {};
+  return lanczos(mult, dot, converged, operation, no_checkpoint, v0,
+                 max_iterations, deflation_tol);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+  return lanczos_result_t();
+}
+
 } // namespace xdiag::lanczos
@@ -0,0 +1,201 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "lanczos_checkpoint.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#ifdef XDIAG_USE_MPI
+#include <mpi.h>
+#endif
+
+#include <xdiag/utils/logger.hpp>
+
+namespace xdiag::lanczos {
+
+std::string checkpoint_filename(std::string const &filename) {
+#ifdef XDIAG_USE_MPI
+  int mpi_size, mpi_rank;
+  MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+  if (mpi_size > 1) {
+    return fmt::format("{}.{}", filename, mpi_rank);
+  }
+#endif
+  return filename;
+}
+
+bool checkpoint_exists(std::string const &filename) {
+  std::ifstream file(checkpoint_filename(filename));
+  int exists = file.good();
+#ifdef XDIAG_USE_MPI
+  int exists_all;
+  MPI_Allreduce(&exists, &exists_all, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  exists = exists_all;
+#endif
+  return exists;
+}
+
+void check_checkpoint_support() try {
+#ifndef XDIAG_USE_HDF5
+  XDIAG_THROW("Checkpointing requires XDiag to be compiled with HDF5 support");
+#endif
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+#ifdef XDIAG_USE_HDF5
+
+void write_checkpoint(std::string const &filename,
+                      std::function<void(FileH5 &)> const &write) try {
+  std::string name = checkpoint_filename(filename);
+  std::string name_tmp = name + ".tmp";
+  {
+    FileH5 file(name_tmp, "w!");
+    write(file);
+    file.close();
+  }
+  if (std::rename(name_tmp.c_str(), name.c_str()) != 0) {
+    XDIAG_THROW(fmt::format("Unable to move checkpoint to file \"{}\"", name));
+  }
+  Log(1, "Wrote checkpoint to file {}", name);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+void read_checkpoint(std::string const &filename,
+                     std::function<void(FileH5 &)> const &read) try {
+  std::string name = checkpoint_filename(filename);
+  if (!checkpoint_exists(filename)) {
+    XDIAG_THROW(fmt::format("Checkpoint file \"{}\" does not exist", name));
+  }
+  FileH5 file(name, "r");
+  read(file);
+  Log(1, "Read checkpoint from file {}", name);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+// Strings are stored as arrays of characters
+void write_string(FileH5 &file, std::string const &field,
+                  std::string const &str) try {
+  file[field] = std::vector<int8_t>(str.begin(), str.end());
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+std::string read_string(FileH5 &file, std::string const &field) try {
+  auto chars = file[field].as<std::vector<int8_t>>();
+  return std::string(chars.begin(), chars.end());
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <typename coeff_t>
+void write_recurrence(FileH5 &file, std::string const &group,
+                      arma::Col<coeff_t> const &v0,
+                      arma::Col<coeff_t> const &v1, Tmatrix const &tmatrix,
+                      int64_t iteration) try {
+  file[group + "/v0"] = v0;
+  file[group + "/v1"] = v1;
+  file[group + "/alphas"] = tmatrix.alphas();
+  file[group + "/betas"] = tmatrix.betas();
+  file[group + "/iteration"] = iteration;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <typename coeff_t>
+void read_recurrence(FileH5 &file, std::string const &group,
+                     arma::Col<coeff_t> &v0, arma::Col<coeff_t> &v1,
+                     Tmatrix &tmatrix, int64_t &iteration) try {
+  arma::Col<coeff_t> v0_file = file[group + "/v0"].as<arma::Col<coeff_t>>();
+  arma::Col<coeff_t> v1_file = file[group + "/v1"].as<arma::Col<coeff_t>>();
+  if ((v0_file.n_elem != v0.n_elem) || (v1_file.n_elem != v1.n_elem)) {
+    XDIAG_THROW(fmt::format(
+        "Size of the Lanczos vectors in the checkpoint ({}) does not match "
+        "the size of the block ({})",
+        v0_file.n_elem, v0.n_elem));
+  }
+  v0 = v0_file;
+  v1 = v1_file;
+  arma::vec alphas = file[group + "/alphas"].as<arma::vec>();
+  arma::vec betas = file[group + "/betas"].as<arma::vec>();
+  tmatrix = Tmatrix(arma::conv_to<std::vector<double>>::from(alphas),
+                    arma::conv_to<std::vector<double>>::from(betas));
+  iteration = file[group + "/iteration"].as<int64_t>();
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template void write_recurrence(FileH5 &, std::string const &,
+                               arma::Col<double> const &,
+                               arma::Col<double> const &, Tmatrix const &,
+                               int64_t);
+template void write_recurrence(FileH5 &, std::string const &,
+                               arma::Col<complex> const &,
+                               arma::Col<complex> const &, Tmatrix const &,
+                               int64_t);
+template void read_recurrence(FileH5 &, std::string const &,
+                              arma::Col<double> &, arma::Col<double> &,
+                              Tmatrix &, int64_t &);
+template void read_recurrence(FileH5 &, std::string const &,
+                              arma::Col<complex> &, arma::Col<complex> &,
+                              Tmatrix &, int64_t &);
+
+void write_parameters(FileH5 &file, lanczos_parameters_t const &params) try {
+  file["parameters/neigvals"] = params.neigvals;
+  file["parameters/precision"] = params.precision;
+  file["parameters/max_iterations"] = params.max_iterations;
+  file["parameters/deflation_tol"] = params.deflation_tol;
+  file["parameters/random_seed"] = params.random_seed;
+  file["parameters/real"] = (int64_t)params.real;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+lanczos_parameters_t read_parameters(FileH5 &file) try {
+  lanczos_parameters_t params;
+  params.neigvals = file["parameters/neigvals"].as<int64_t>();
+  params.precision = file["parameters/precision"].as<double>();
+  params.max_iterations = file["parameters/max_iterations"].as<int64_t>();
+  params.deflation_tol = file["parameters/deflation_tol"].as<double>();
+  params.random_seed = file["parameters/random_seed"].as<int64_t>();
+  params.real = (bool)file["parameters/real"].as<int64_t>();
+  return params;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+void write_state(FileH5 &file, std::string const &group,
+                 State const &state) try {
+  file[group + "/real"] = (int64_t)state.isreal();
+  if (state.isreal()) {
+    file[group + "/matrix"] = state.matrix(false);
+  } else {
+    file[group + "/matrix"] = state.matrixC(false);
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+State read_state(FileH5 &file, std::string const &group,
+                 Block const &block) try {
+  bool real = (bool)file[group + "/real"].as<int64_t>();
+  State state;
+  if (real) {
+    state = State(block, file[group + "/matrix"].as<arma::mat>());
+  } else {
+    state = State(block, file[group + "/matrix"].as<arma::cx_mat>());
+  }
+  return state;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+#endif
+
+} // namespace xdiag::lanczos
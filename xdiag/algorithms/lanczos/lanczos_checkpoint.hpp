@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include <xdiag/algorithms/lanczos/tmatrix.hpp>
+#include <xdiag/blocks/blocks.hpp>
+#include <xdiag/common.hpp>
+#include <xdiag/extern/armadillo/armadillo>
+#include <xdiag/states/state.hpp>
+
+#ifdef XDIAG_USE_HDF5
+#include <xdiag/io/file_h5.hpp>
+#endif
+
+namespace xdiag::lanczos {
+
+// Name of the checkpoint file written by the calling process. If several MPI
+// processes are used, every process writes its local part of the vectors to
+// its own file with the rank appended to the filename.
+std::string checkpoint_filename(std::string const &filename);
+
+// Checks whether the checkpoint files of all processes exist. With MPI this
+// has to be called by all processes, such that either all or none of them
+// read the checkpoint.
+bool checkpoint_exists(std::string const &filename);
+
+// Throws if XDiag has been compiled without HDF5 support
+void check_checkpoint_support();
+
+#ifdef XDIAG_USE_HDF5
+
+// Writes a checkpoint by calling write on a temporary file, which is then
+// moved to the checkpoint file. Hence, a crash while writing never leaves an
+// incomplete checkpoint behind.
+void write_checkpoint(std::string const &filename,
+                      std::function<void(FileH5 &)> const &write);
+void read_checkpoint(std::string const &filename,
+                     std::function<void(FileH5 &)> const &read);
+
+void write_string(FileH5 &file, std::string const &field,
+                  std::string const &str);
+std::string read_string(FileH5 &file, std::string const &field);
+
+// The recurrence of a Lanczos run after "iteration" steps, from which the
+// run can be continued using lanczos_continue
+template <typename coeff_t>
+void write_recurrence(FileH5 &file, std::string const &group,
+                      arma::Col<coeff_t> const &v0,
+                      arma::Col<coeff_t> const &v1, Tmatrix const &tmatrix,
+                      int64_t iteration);
+template <typename coeff_t>
+void read_recurrence(FileH5 &file, std::string const &group,
+                     arma::Col<coeff_t> &v0, arma::Col<coeff_t> &v1,
+                     Tmatrix &tmatrix, int64_t &iteration);
+
+// Parameters of an eigenvalue computation stored in the checkpoint, such
+// that a run can be resumed without specifying them again
+struct lanczos_parameters_t {
+  int64_t neigvals;
+  double precision;
+  int64_t max_iterations;
+  double deflation_tol;
+  int64_t random_seed;
+  bool real;
+};
+
+void write_parameters(FileH5 &file, lanczos_parameters_t const &params);
+lanczos_parameters_t read_parameters(FileH5 &file);
+
+// A State is stored as its local matrix of coefficients
+void write_state(FileH5 &file, std::string const &group, State const &state);
+State read_state(FileH5 &file, std::string const &group, Block const &block);
+
+#endif
+
+} // namespace xdiag::lanczos
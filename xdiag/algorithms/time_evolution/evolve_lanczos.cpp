@@ -4,8 +4,14 @@
 
 #include "evolve_lanczos.hpp"
 
+#include <type_traits>
+#include <variant>
+
 #include <xdiag/algebra/algebra.hpp>
 #include <xdiag/algebra/apply.hpp>
+#include <xdiag/algebra/apply_sparse.hpp>
+#include <xdiag/algebra/diagonal_cache.hpp>
+#include <xdiag/algorithms/lanczos/lanczos_checkpoint.hpp>
 #include <xdiag/algorithms/lanczos/lanczos_convergence.hpp>
 #include <xdiag/algorithms/time_evolution/exp_sym_v.hpp>
 #include <xdiag/operators/logic/hc.hpp>
@@ -17,9 +23,11 @@ namespace xdiag {
 EvolveLanczosResult evolve_lanczos(OpSum const &H, State psi, double tau,
                                    double precision, double shift,
                                    bool normalize, int64_t max_iterations,
-                                   double deflation_tol) try {
+                                   double deflation_tol,
+                                   bool cache_diagonal) try {
   auto r = evolve_lanczos_inplace(H, psi, tau, precision, shift, normalize,
-                                  max_iterations, deflation_tol);
+                                  max_iterations, deflation_tol,
+                                  cache_diagonal);
   return {r.alphas, r.betas, r.eigenvalues, r.niterations, r.criterion, psi};
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
@@ -28,19 +36,18 @@ EvolveLanczosResult evolve_lanczos(OpSum const &H, State psi, double tau,
 EvolveLanczosResult evolve_lanczos(OpSum const &H, State psi, complex tau,
                                    double precision, double shift,
                                    bool normalize, int64_t max_iterations,
-                                   double deflation_tol) try {
+                                   double deflation_tol,
+                                   bool cache_diagonal) try {
   auto r = evolve_lanczos_inplace(H, psi, tau, precision, shift, normalize,
-                                  max_iterations, deflation_tol);
+                                  max_iterations, deflation_tol,
+                                  cache_diagonal);
   return {r.alphas, r.betas, r.eigenvalues, r.niterations, r.criterion, psi};
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
 
-EvolveLanczosInplaceResult evolve_lanczos_inplace(OpSum const &H, State &psi,
-                                                  double tau, double precision,
-                                                  double shift, bool normalize,
-                                                  int64_t max_iterations,
-                                                  double deflation_tol) try {
+// Checks shared by the real and complex evolution
+static void check_evolve_lanczos(OpSum const &H, State const &psi) try {
   if (!isapprox(H, hc(H))) {
     XDIAG_THROW("Input OpSum is not hermitian. Evolution using the Lanczos "
                 "algorithm requires the operator to be hermitian.");
@@ -54,15 +61,62 @@ EvolveLanczosInplaceResult evolve_lanczos_inplace(OpSum const &H, State &psi,
   if (norm(psi) == 0.) {
     XDIAG_THROW("Initial state has zero norm");
   }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
 
+// If max_density > 0, Krylov vectors with few nonzeros are multiplied by the
+// sparse kernels, see apply_if_sparse
+static EvolveLanczosInplaceResult
+evolve_lanczos_inplace(DiagonalCache const &cache, State &psi, complex tau,
+                       double precision, double shift, bool normalize,
+                       int64_t max_iterations, double deflation_tol,
+                       double max_density = 0.) try {
+  if (psi.isreal()) {
+    psi.make_complex();
+  }
+  auto const &block = psi.block();
+
+  int iter = 1;
+  auto mult = [&iter, &cache, &block, max_density](arma::cx_vec const &v,
+                                                   arma::cx_vec &w) {
+    auto ta = rightnow();
+    if ((max_density == 0.) ||
+        !apply_if_sparse(cache.ops(), block, v, block, w, max_density)) {
+      cache.apply(v, w);
+    }
+    Log(2, "Lanczos iteration {}", iter);
+    timing(ta, rightnow(), "MVM", 1);
+    ++iter;
+  };
+  auto dot_f = [&block](arma::cx_vec const &v, arma::cx_vec const &w) {
+    return dot(block, v, w);
+  };
+  arma::cx_vec v = psi.vectorC(0, false);
+  auto r = exp_sym_v(mult, dot_f, v, tau, precision, shift, normalize,
+                     max_iterations, deflation_tol);
+  return {r.alphas, r.betas, r.eigenvalues, r.niterations, r.criterion};
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+static EvolveLanczosInplaceResult
+evolve_lanczos_inplace(DiagonalCache const &cache, State &psi, double tau,
+                       double precision, double shift, bool normalize,
+                       int64_t max_iterations, double deflation_tol,
+                       double max_density = 0.) try {
   auto const &block = psi.block();
 
   // Real time evolution is possible
-  if (psi.isreal() && isreal(H)) {
+  if (psi.isreal() && isreal(cache.ops())) {
     int iter = 1;
-    auto mult = [&iter, &H, &block](arma::vec const &v, arma::vec &w) {
+    auto mult = [&iter, &cache, &block, max_density](arma::vec const &v,
+                                                     arma::vec &w) {
       auto ta = rightnow();
-      apply(H, block, v, block, w);
+      if ((max_density == 0.) ||
+          !apply_if_sparse(cache.ops(), block, v, block, w, max_density)) {
+        cache.apply(v, w);
+      }
       Log(2, "Lanczos iteration {}", iter);
       timing(ta, rightnow(), "MVM", 1);
       ++iter;
@@ -77,52 +131,213 @@ EvolveLanczosInplaceResult evolve_lanczos_inplace(OpSum const &H, State &psi,
     return {r.alphas, r.betas, r.eigenvalues, r.niterations, r.criterion};
     // Refer to complex time evolution
   } else {
-    return evolve_lanczos_inplace(H, psi, complex(tau), precision, shift,
-                                  normalize, max_iterations, deflation_tol);
+    return evolve_lanczos_inplace(cache, psi, complex(tau), precision, shift,
+                                  normalize, max_iterations, deflation_tol,
+                                  max_density);
   }
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
 
+EvolveLanczosInplaceResult evolve_lanczos_inplace(OpSum const &H, State &psi,
+                                                  double tau, double precision,
+                                                  double shift, bool normalize,
+                                                  int64_t max_iterations,
+                                                  double deflation_tol,
+                                                  bool cache_diagonal) try {
+  check_evolve_lanczos(H, psi);
+  DiagonalCache cache(H, psi.block(), cache_diagonal);
+  return evolve_lanczos_inplace(cache, psi, tau, precision, shift, normalize,
+                                max_iterations, deflation_tol);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
 EvolveLanczosInplaceResult evolve_lanczos_inplace(OpSum const &H, State &psi,
                                                   complex tau, double precision,
                                                   double shift, bool normalize,
                                                   int64_t max_iterations,
-                                                  double deflation_tol) try {
+                                                  double deflation_tol,
+                                                  bool cache_diagonal) try {
+  check_evolve_lanczos(H, psi);
+  DiagonalCache cache(H, psi.block(), cache_diagonal);
+  return evolve_lanczos_inplace(cache, psi, tau, precision, shift, normalize,
+                                max_iterations, deflation_tol);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
 
-  if (!isapprox(H, hc(H))) {
-    XDIAG_THROW("Input OpSum is not hermitian. Evolution using the Lanczos "
-                "algorithm requires the operator to be hermitian.");
-  }
+template <typename tau_t>
+static EvolveLanczosResult
+evolve_lanczos_sparse(OpSum const &H, SparseState const &psi, tau_t tau,
+                      double precision, double shift, bool normalize,
+                      int64_t max_iterations, double deflation_tol,
+                      bool cache_diagonal) try {
   if (!isvalid(psi)) {
     XDIAG_THROW("Initial state must be a valid state (i.e. not default "
                 "constructed by e.g. an annihilation operator)");
   }
+  State psid = dense(psi);
+  check_evolve_lanczos(H, psid);
+  if (!std::holds_alternative<Spinhalf>(psid.block())) {
+    Log.warn("Warning: sparse apply is only implemented for Spinhalf blocks, "
+             "evolving the dense state instead");
+  }
+  DiagonalCache cache(H, psid.block(), cache_diagonal);
+  auto r = evolve_lanczos_inplace(cache, psid, tau, precision, shift,
+                                  normalize, max_iterations, deflation_tol,
+                                  psi.max_density());
+  return {r.alphas, r.betas, r.eigenvalues, r.niterations, r.criterion, psid};
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
 
-  if (norm(psi) == 0.) {
-    XDIAG_THROW("Initial state has zero norm");
+EvolveLanczosResult evolve_lanczos(OpSum const &H, SparseState const &psi,
+                                   double tau, double precision, double shift,
+                                   bool normalize, int64_t max_iterations,
+                                   double deflation_tol,
+                                   bool cache_diagonal) try {
+  return evolve_lanczos_sparse(H, psi, tau, precision, shift, normalize,
+                               max_iterations, deflation_tol, cache_diagonal);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+EvolveLanczosResult evolve_lanczos(OpSum const &H, SparseState const &psi,
+                                   complex tau, double precision, double shift,
+                                   bool normalize, int64_t max_iterations,
+                                   double deflation_tol,
+                                   bool cache_diagonal) try {
+  return evolve_lanczos_sparse(H, psi, tau, precision, shift, normalize,
+                               max_iterations, deflation_tol, cache_diagonal);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+#ifdef XDIAG_USE_HDF5
+// Performs the remaining steps of a checkpointed evolution starting at
+// "step", where the diagonal cache is built once for all steps
+template <typename tau_t>
+static EvolveLanczosResult
+evolve_lanczos_steps(OpSum const &H, State &psi, tau_t tau,
+                     std::string const &filename, int64_t step, int64_t nsteps,
+                     int64_t niterations, double precision, double shift,
+                     bool normalize, int64_t max_iterations,
+                     double deflation_tol, bool cache_diagonal) try {
+  check_evolve_lanczos(H, psi);
+  DiagonalCache cache(H, psi.block(), cache_diagonal);
+  tau_t dtau = tau / (double)nsteps;
+  EvolveLanczosInplaceResult r;
+  while (step < nsteps) {
+    r = evolve_lanczos_inplace(cache, psi, dtau, precision, shift, normalize,
+                               max_iterations, deflation_tol);
+    niterations += r.niterations;
+    ++step;
+    Log(1, "Evolution step {}/{} done", step, nsteps);
+    lanczos::write_checkpoint(filename, [&](FileH5 &file) {
+      file["evolution/step"] = step;
+      file["evolution/nsteps"] = nsteps;
+      file["evolution/tau"] = complex(tau);
+      file["evolution/real_tau"] = (int64_t)std::is_same<tau_t, double>::value;
+      file["evolution/niterations"] = niterations;
+      file["parameters/precision"] = precision;
+      file["parameters/shift"] = shift;
+      file["parameters/normalize"] = (int64_t)normalize;
+      file["parameters/max_iterations"] = max_iterations;
+      file["parameters/deflation_tol"] = deflation_tol;
+      lanczos::write_state(file, "state", psi);
+    });
   }
+  return {r.alphas, r.betas, r.eigenvalues, niterations, r.criterion, psi};
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+#endif
 
-  if (psi.isreal()) {
-    psi.make_complex();
+template <typename tau_t>
+static EvolveLanczosResult
+evolve_lanczos_checkpoint(OpSum const &H, State psi, tau_t tau,
+                          std::string const &filename, int64_t nsteps,
+                          double precision, double shift, bool normalize,
+                          int64_t max_iterations, double deflation_tol,
+                          bool cache_diagonal) try {
+  lanczos::check_checkpoint_support();
+  if (nsteps < 1) {
+    XDIAG_THROW("Argument \"nsteps\" needs to be >= 1");
   }
-  auto const &block = psi.block();
+#ifdef XDIAG_USE_HDF5
+  return evolve_lanczos_steps(H, psi, tau, filename, 0, nsteps, 0, precision,
+                              shift, normalize, max_iterations, deflation_tol,
+                              cache_diagonal);
+#else
+  return EvolveLanczosResult();
+#endif
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
 
-  int iter = 1;
-  auto mult = [&iter, &H, &block](arma::cx_vec const &v, arma::cx_vec &w) {
-    auto ta = rightnow();
-    apply(H, block, v, block, w);
-    Log(2, "Lanczos iteration {}", iter);
-    timing(ta, rightnow(), "MVM", 1);
-    ++iter;
-  };
-  auto dot_f = [&block](arma::cx_vec const &v, arma::cx_vec const &w) {
-    return dot(block, v, w);
-  };
-  arma::cx_vec v = psi.vectorC(0, false);
-  auto r = exp_sym_v(mult, dot_f, v, tau, precision, shift, normalize,
-                     max_iterations, deflation_tol);
-  return {r.alphas, r.betas, r.eigenvalues, r.niterations, r.criterion};
+EvolveLanczosResult evolve_lanczos_checkpoint(
+    OpSum const &H, State psi, double tau, std::string filename,
+    int64_t nsteps, double precision, double shift, bool normalize,
+    int64_t max_iterations, double deflation_tol, bool cache_diagonal) try {
+  return evolve_lanczos_checkpoint<double>(H, psi, tau, filename, nsteps,
+                                           precision, shift, normalize,
+                                           max_iterations, deflation_tol,
+                                           cache_diagonal);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+EvolveLanczosResult evolve_lanczos_checkpoint(
+    OpSum const &H, State psi, complex tau, std::string filename,
+    int64_t nsteps, double precision, double shift, bool normalize,
+    int64_t max_iterations, double deflation_tol, bool cache_diagonal) try {
+  return evolve_lanczos_checkpoint<complex>(H, psi, tau, filename, nsteps,
+                                            precision, shift, normalize,
+                                            max_iterations, deflation_tol,
+                                            cache_diagonal);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+EvolveLanczosResult evolve_lanczos_resume(OpSum const &H, Block const &block,
+                                          std::string filename,
+                                          bool cache_diagonal) try {
+  lanczos::check_checkpoint_support();
+#ifdef XDIAG_USE_HDF5
+  int64_t step, nsteps, niterations, max_iterations;
+  complex tau;
+  bool real_tau, normalize;
+  double precision, shift, deflation_tol;
+  State psi;
+  lanczos::read_checkpoint(filename, [&](FileH5 &file) {
+    step = file["evolution/step"].as<int64_t>();
+    nsteps = file["evolution/nsteps"].as<int64_t>();
+    tau = file["evolution/tau"].as<complex>();
+    real_tau = (bool)file["evolution/real_tau"].as<int64_t>();
+    niterations = file["evolution/niterations"].as<int64_t>();
+    precision = file["parameters/precision"].as<double>();
+    shift = file["parameters/shift"].as<double>();
+    normalize = (bool)file["parameters/normalize"].as<int64_t>();
+    max_iterations = file["parameters/max_iterations"].as<int64_t>();
+    deflation_tol = file["parameters/deflation_tol"].as<double>();
+    psi = lanczos::read_state(file, "state", block);
+  });
+  Log(1, "Resuming evolution after step {}/{}", step, nsteps);
+  if (real_tau) {
+    return evolve_lanczos_steps(H, psi, tau.real(), filename, step, nsteps,
+                                niterations, precision, shift, normalize,
+                                max_iterations, deflation_tol,
+                                cache_diagonal);
+  } else {
+    return evolve_lanczos_steps(H, psi, tau, filename, step, nsteps,
+                                niterations, precision, shift, normalize,
+                                max_iterations, deflation_tol,
+                                cache_diagonal);
+  }
+#else
+  return EvolveLanczosResult();
+#endif
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
@@ -4,9 +4,13 @@
 
 #pragma once
 
+#include <string>
+
 #include <xdiag/algorithms/lanczos/lanczos.hpp>
+#include <xdiag/blocks/blocks.hpp>
 #include <xdiag/common.hpp>
 #include <xdiag/operators/opsum.hpp>
+#include <xdiag/states/sparse_state.hpp>
 #include <xdiag/states/state.hpp>
 #include <xdiag/utils/timing.hpp>
 
@@ -21,15 +25,55 @@ struct EvolveLanczosResult {
   State state;
 };
 
+// If cache_diagonal is set, the diagonal of H is precomputed once, see
+// DiagonalCache
 XDIAG_API EvolveLanczosResult
 evolve_lanczos(OpSum const &H, State psi, double tau, double precision = 1e-12,
                double shift = 0., bool normalize = false,
-               int64_t max_iterations = 1000, double deflation_tol = 1e-7);
+               int64_t max_iterations = 1000, double deflation_tol = 1e-7,
+               bool cache_diagonal = false);
 
 XDIAG_API EvolveLanczosResult
 evolve_lanczos(OpSum const &H, State psi, complex tau, double precision = 1e-12,
                double shift = 0., bool normalize = false,
-               int64_t max_iterations = 1000, double deflation_tol = 1e-7);
+               int64_t max_iterations = 1000, double deflation_tol = 1e-7,
+               bool cache_diagonal = false);
+
+// Evolution of a SparseState, e.g. a product state. As long as the Krylov
+// vectors have few nonzeros they are multiplied by the sparse kernels (only
+// for Spinhalf blocks), such that the first iterations are cheap. The
+// evolved state is dense.
+XDIAG_API EvolveLanczosResult
+evolve_lanczos(OpSum const &H, SparseState const &psi, double tau,
+               double precision = 1e-12, double shift = 0.,
+               bool normalize = false, int64_t max_iterations = 1000,
+               double deflation_tol = 1e-7, bool cache_diagonal = false);
+
+XDIAG_API EvolveLanczosResult
+evolve_lanczos(OpSum const &H, SparseState const &psi, complex tau,
+               double precision = 1e-12, double shift = 0.,
+               bool normalize = false, int64_t max_iterations = 1000,
+               double deflation_tol = 1e-7, bool cache_diagonal = false);
+
+// Evolution split into "nsteps" steps of length tau / nsteps. After every
+// step the current state is written to the HDF5 checkpoint file "filename",
+// from which an interrupted evolution is continued with
+// evolve_lanczos_resume. The T-matrix returned is the one of the last step.
+XDIAG_API EvolveLanczosResult evolve_lanczos_checkpoint(
+    OpSum const &H, State psi, double tau, std::string filename,
+    int64_t nsteps = 10, double precision = 1e-12, double shift = 0.,
+    bool normalize = false, int64_t max_iterations = 1000,
+    double deflation_tol = 1e-7, bool cache_diagonal = false);
+
+XDIAG_API EvolveLanczosResult evolve_lanczos_checkpoint(
+    OpSum const &H, State psi, complex tau, std::string filename,
+    int64_t nsteps = 10, double precision = 1e-12, double shift = 0.,
+    bool normalize = false, int64_t max_iterations = 1000,
+    double deflation_tol = 1e-7, bool cache_diagonal = false);
+
+XDIAG_API EvolveLanczosResult
+evolve_lanczos_resume(OpSum const &H, Block const &block, std::string filename,
+                      bool cache_diagonal = false);
 
 struct EvolveLanczosInplaceResult {
   arma::vec alphas;
@@ -42,11 +86,11 @@ struct EvolveLanczosInplaceResult {
 XDIAG_API EvolveLanczosInplaceResult evolve_lanczos_inplace(
     OpSum const &H, State &psi, double tau, double precision = 1e-12,
     double shift = 0., bool normalize = false, int64_t max_iterations = 1000,
-    double deflation_tol = 1e-7);
+    double deflation_tol = 1e-7, bool cache_diagonal = false);
 
 XDIAG_API EvolveLanczosInplaceResult evolve_lanczos_inplace(
     OpSum const &H, State &psi, complex tau, double precision = 1e-12,
     double shift = 0., bool normalize = false, int64_t max_iterations = 1000,
-    double deflation_tol = 1e-7);
+    double deflation_tol = 1e-7, bool cache_diagonal = false);
 
 } // namespace xdiag
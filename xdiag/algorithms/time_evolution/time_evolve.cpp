@@ -4,6 +4,7 @@
 
 #include "time_evolve.hpp"
 
+#include <xdiag/algorithms/lanczos/lanczos_checkpoint.hpp>
 #include <xdiag/algorithms/time_evolution/evolve_lanczos.hpp>
 #include <xdiag/algorithms/time_evolution/time_evolve_expokit.hpp>
 
@@ -17,6 +18,18 @@ State time_evolve(OpSum const &H, State psi, double time, double precision,
   XDIAG_RETHROW(e);
 }
 
+State time_evolve(OpSum const &H, SparseState const &psi, double time,
+                  double precision, std::string algorithm) try {
+  if (algorithm == "lanczos") {
+    // minus sign in exp(-iHt) implemented here
+    return evolve_lanczos(H, psi, complex(0, -time), precision).state;
+  } else {
+    return time_evolve(H, dense(psi), time, precision, algorithm);
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
 void time_evolve_inplace(OpSum const &H, State &psi, double time,
                          double precision, std::string algorithm) try {
   if (algorithm == "lanczos") {
@@ -35,4 +48,70 @@ void time_evolve_inplace(OpSum const &H, State &psi, double time,
   XDIAG_RETHROW(e);
 }
 
+#ifdef XDIAG_USE_HDF5
+// Performs the remaining steps of a checkpointed evolution starting at "step"
+static void time_evolve_steps(OpSum const &H, State &psi, double time,
+                              std::string const &filename, int64_t step,
+                              int64_t nsteps, double precision,
+                              std::string const &algorithm) try {
+  double dt = time / (double)nsteps;
+  while (step < nsteps) {
+    time_evolve_inplace(H, psi, dt, precision, algorithm);
+    ++step;
+    Log(1, "Time evolution step {}/{} done, t={}", step, nsteps, step * dt);
+    lanczos::write_checkpoint(filename, [&](FileH5 &file) {
+      file["evolution/step"] = step;
+      file["evolution/nsteps"] = nsteps;
+      file["evolution/time"] = step * dt;
+      file["evolution/time_final"] = time;
+      file["parameters/precision"] = precision;
+      lanczos::write_string(file, "parameters/algorithm", algorithm);
+      lanczos::write_state(file, "state", psi);
+    });
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+#endif
+
+State time_evolve_checkpoint(OpSum const &H, State psi, double time,
+                             std::string filename, int64_t nsteps,
+                             double precision, std::string algorithm) try {
+  lanczos::check_checkpoint_support();
+  if (nsteps < 1) {
+    XDIAG_THROW("Argument \"nsteps\" needs to be >= 1");
+  }
+#ifdef XDIAG_USE_HDF5
+  time_evolve_steps(H, psi, time, filename, 0, nsteps, precision, algorithm);
+#endif
+  return psi;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+State time_evolve_resume(OpSum const &H, Block const &block,
+                         std::string filename) try {
+  lanczos::check_checkpoint_support();
+  State psi;
+#ifdef XDIAG_USE_HDF5
+  int64_t step, nsteps;
+  double time, precision;
+  std::string algorithm;
+  lanczos::read_checkpoint(filename, [&](FileH5 &file) {
+    step = file["evolution/step"].as<int64_t>();
+    nsteps = file["evolution/nsteps"].as<int64_t>();
+    time = file["evolution/time_final"].as<double>();
+    precision = file["parameters/precision"].as<double>();
+    algorithm = lanczos::read_string(file, "parameters/algorithm");
+    psi = lanczos::read_state(file, "state", block);
+  });
+  Log(1, "Resuming time evolution after step {}/{}", step, nsteps);
+  time_evolve_steps(H, psi, time, filename, step, nsteps, precision,
+                    algorithm);
+#endif
+  return psi;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
 } // namespace xdiag
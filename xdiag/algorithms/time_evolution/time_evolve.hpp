@@ -4,9 +4,13 @@
 
 #pragma once
 
+#include <string>
+
+#include <xdiag/blocks/blocks.hpp>
 #include <xdiag/common.hpp>
 
 #include <xdiag/operators/opsum.hpp>
+#include <xdiag/states/sparse_state.hpp>
 #include <xdiag/states/state.hpp>
 
 namespace xdiag {
@@ -15,8 +19,26 @@ XDIAG_API State time_evolve(OpSum const &H, State psi, double time,
                             double precision = 1e-12,
                             std::string algorithm = "lanczos");
 
+// Evolution of a SparseState, see evolve_lanczos. The evolved state is dense.
+XDIAG_API State time_evolve(OpSum const &H, SparseState const &psi,
+                            double time, double precision = 1e-12,
+                            std::string algorithm = "lanczos");
+
 XDIAG_API void time_evolve_inplace(OpSum const &H, State &psi, double time,
                                    double precision = 1e-12,
                                    std::string algorithm = "lanczos");
 
+// Evolution split into "nsteps" steps of length time / nsteps. After every
+// step the current state and time are written to the HDF5 checkpoint file
+// "filename", from which an interrupted evolution is continued with
+// time_evolve_resume.
+XDIAG_API State time_evolve_checkpoint(OpSum const &H, State psi, double time,
+                                       std::string filename,
+                                       int64_t nsteps = 10,
+                                       double precision = 1e-12,
+                                       std::string algorithm = "lanczos");
+
+XDIAG_API State time_evolve_resume(OpSum const &H, Block const &block,
+                                   std::string filename);
+
 } // namespace xdiag
@@ -6,6 +6,7 @@
 
 #include <xdiag/algebra/algebra.hpp>
 #include <xdiag/algebra/apply.hpp>
+#include <xdiag/algebra/diagonal_cache.hpp>
 #include <xdiag/algorithms/time_evolution/zahexpv.hpp>
 #include <xdiag/operators/logic/hc.hpp>
 #include <xdiag/operators/logic/isapprox.hpp>
@@ -16,9 +17,10 @@ namespace xdiag {
 TimeEvolveExpokitResult time_evolve_expokit(OpSum const &ops, State state,
                                             double time, double precision,
                                             int64_t m, double anorm,
-                                            int64_t nnorm) try {
-  auto res =
-      time_evolve_expokit_inplace(ops, state, time, precision, m, anorm, nnorm);
+                                            int64_t nnorm,
+                                            bool cache_diagonal) try {
+  auto res = time_evolve_expokit_inplace(ops, state, time, precision, m, anorm,
+                                         nnorm, cache_diagonal);
   return {res.error, res.hump, state};
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
@@ -27,7 +29,7 @@ TimeEvolveExpokitResult time_evolve_expokit(OpSum const &ops, State state,
 TimeEvolveExpokitInplaceResult
 time_evolve_expokit_inplace(OpSum const &ops, State &state, double time,
                             double precision, int64_t m, double anorm,
-                            int64_t nnorm) try {
+                            int64_t nnorm, bool cache_diagonal) try {
   if (!isapprox(ops, hc(ops))) {
     XDIAG_THROW("Input OpSum is not hermitian. Evolution using the expokit "
                 "algorithm requires the operator to be hermitian.");
@@ -57,10 +59,11 @@ time_evolve_expokit_inplace(OpSum const &ops, State &state, double time,
   }
 
   int64_t iter = 1;
-  auto apply_A = [&iter, &ops, &block](arma::cx_vec const &v) {
+  DiagonalCache cache(ops, block, cache_diagonal);
+  auto apply_A = [&iter, &cache](arma::cx_vec const &v) {
     auto ta = rightnow();
     auto w = arma::cx_vec(v.n_rows, arma::fill::zeros);
-    apply(ops, block, v, block, w);
+    cache.apply(v, w);
     w *= complex(0.0, -1.0);
     Log(2, "Lanczos iteration {}", iter);
     timing(ta, rightnow(), "MVM", 2);
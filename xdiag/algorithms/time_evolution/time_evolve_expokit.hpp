@@ -16,9 +16,12 @@ struct TimeEvolveExpokitResult {
   State state;
 };
 
+// If cache_diagonal is set, the diagonal of H is precomputed once, see
+// DiagonalCache
 XDIAG_API TimeEvolveExpokitResult time_evolve_expokit(
     OpSum const &H, State psi0, double time, double precision = 1e-12,
-    int64_t m = 30, double anorm = 0., int64_t nnorm = 2);
+    int64_t m = 30, double anorm = 0., int64_t nnorm = 2,
+    bool cache_diagonal = false);
 
 struct TimeEvolveExpokitInplaceResult {
   double error;
@@ -27,6 +30,7 @@ struct TimeEvolveExpokitInplaceResult {
 
 XDIAG_API TimeEvolveExpokitInplaceResult time_evolve_expokit_inplace(
     OpSum const &H, State &psi, double time, double precision = 1e-12,
-    int64_t m = 30, double anorm = 0., int64_t nnorm = 2);
+    int64_t m = 30, double anorm = 0., int64_t nnorm = 2,
+    bool cache_diagonal = false);
 
 } // namespace xdiag
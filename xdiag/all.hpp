@@ -8,21 +8,30 @@
 
 #include <xdiag/algebra/algebra.hpp>
 #include <xdiag/algebra/apply.hpp>
+#include <xdiag/algebra/apply_sparse.hpp>
+#include <xdiag/algebra/apply_symmetrized.hpp>
+#include <xdiag/algebra/diagonal_cache.hpp>
 #include <xdiag/algebra/isapprox.hpp>
+#include <xdiag/algebra/linear_operator.hpp>
 #include <xdiag/algebra/matrix.hpp>
+#include <xdiag/algorithms/entanglement.hpp>
 #include <xdiag/algorithms/lanczos/eigs_lanczos.hpp>
+#include <xdiag/algorithms/lanczos/eigs_lanczos_mixed.hpp>
 #include <xdiag/algorithms/lanczos/eigvals_lanczos.hpp>
 #include <xdiag/algorithms/sparse_diag.hpp>
 #include <xdiag/algorithms/time_evolution/evolve_lanczos.hpp>
 #include <xdiag/algorithms/time_evolution/imaginary_time_evolve.hpp>
 #include <xdiag/algorithms/time_evolution/time_evolve.hpp>
 #include <xdiag/algorithms/time_evolution/time_evolve_expokit.hpp>
+#include <xdiag/basis/backend_selection.hpp>
+#include <xdiag/basis/basis_cache.hpp>
 #include <xdiag/blocks/electron.hpp>
 #include <xdiag/blocks/spinhalf.hpp>
 #include <xdiag/blocks/tj.hpp>
 #include <xdiag/io/file_h5.hpp>
 #include <xdiag/io/file_toml.hpp>
 #include <xdiag/io/read.hpp>
+#include <xdiag/io/state_h5.hpp>
 #include <xdiag/operators/coupling.hpp>
 #include <xdiag/operators/logic/block.hpp>
 #include <xdiag/operators/logic/hc.hpp>
@@ -36,12 +45,14 @@
 #include <xdiag/states/fill.hpp>
 #include <xdiag/states/product_state.hpp>
 #include <xdiag/states/random_state.hpp>
+#include <xdiag/states/sparse_state.hpp>
 #include <xdiag/states/state.hpp>
 #include <xdiag/symmetries/permutation.hpp>
 #include <xdiag/symmetries/permutation_group.hpp>
 #include <xdiag/symmetries/representation.hpp>
 #include <xdiag/utils/error.hpp>
 #include <xdiag/utils/logger.hpp>
+#include <xdiag/utils/profile.hpp>
 #include <xdiag/utils/say_hello.hpp>
 #include <xdiag/utils/scalar.hpp>
 #include <xdiag/utils/xdiag_api.hpp>
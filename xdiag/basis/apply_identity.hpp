@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #pragma once
+#include <xdiag/algebra/fill.hpp>
 #include <xdiag/common.hpp>
 #include <xdiag/operators/coupling.hpp>
 
@@ -12,8 +13,16 @@ template <typename coeff_t, class basis_t, class fill_f>
 void apply_identity(Coupling const &cpl, basis_t const &basis,
                     fill_f fill) try {
   coeff_t s = cpl.scalar().as<coeff_t>();
-  for (int64_t i = 0; i < basis.size(); ++i) {
-    fill(i, i, s);
+  if constexpr (is_sparse_fill_v<fill_f>) {
+    auto const &indices_in = fill.indices_in();
+    for (int64_t pos = 0; pos < (int64_t)indices_in.size(); ++pos) {
+      int64_t i = indices_in[pos];
+      fill.at(pos)(i, i, s);
+    }
+  } else {
+    for (int64_t i = 0; i < basis.size(); ++i) {
+      fill(i, i, s);
+    }
   }
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
@@ -0,0 +1,263 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "backend_selection.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+#include <xdiag/combinatorics/binomial.hpp>
+#include <xdiag/combinatorics/fermi_table.hpp>
+#include <xdiag/symmetries/group_action/sublattice_stability.hpp>
+#include <xdiag/utils/logger.hpp>
+
+namespace xdiag {
+
+// Parses a number of bytes with an optional suffix K, M, G or T (optionally
+// followed by B), denoting powers of 1024
+static int64_t parse_memory(std::string const &str) try {
+  std::size_t pos = 0;
+  double value = std::stod(str, &pos);
+  std::string suffix;
+  for (char c : str.substr(pos)) {
+    if (!std::isspace((unsigned char)c)) {
+      suffix.push_back((char)std::toupper((unsigned char)c));
+    }
+  }
+  if ((suffix.size() == 2) && (suffix[1] == 'B')) {
+    suffix.pop_back();
+  }
+  double unit = 1.;
+  if (suffix == "" || suffix == "B") {
+    unit = 1.;
+  } else if (suffix == "K") {
+    unit = 1024.;
+  } else if (suffix == "M") {
+    unit = 1024. * 1024.;
+  } else if (suffix == "G") {
+    unit = 1024. * 1024. * 1024.;
+  } else if (suffix == "T") {
+    unit = 1024. * 1024. * 1024. * 1024.;
+  } else {
+    XDIAG_THROW(fmt::format("Invalid unit of memory: \"{}\"", str));
+  }
+  if (value < 0) {
+    XDIAG_THROW(fmt::format("Negative amount of memory: \"{}\"", str));
+  }
+  return (int64_t)(value * unit);
+} catch (std::logic_error const &) {
+  XDIAG_THROW(fmt::format("Unable to parse amount of memory: \"{}\"", str));
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+static int64_t initial_memory_limit() {
+  const char *limit = std::getenv("XDIAG_MEMORY_LIMIT");
+  if (!limit) {
+    return 0;
+  }
+  try {
+    return parse_memory(limit);
+  } catch (Error const &e) {
+    Log.warn("Warning: ignoring invalid XDIAG_MEMORY_LIMIT \"{}\"", limit);
+    return 0;
+  }
+}
+
+static int64_t &memory_limit_ref() {
+  static int64_t limit = initial_memory_limit();
+  return limit;
+}
+
+void set_memory_limit(int64_t bytes) try {
+  if (bytes < 0) {
+    XDIAG_THROW("Memory limit must not be negative");
+  }
+  memory_limit_ref() = bytes;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+int64_t memory_limit() { return memory_limit_ref(); }
+
+namespace basis {
+
+// Costs of a matrix element: a lookup in a table, the additional popcount of
+// FermiSignLookup, applying a symmetry in the sublattice algorithm and
+// finding a representative in the hash map or dense index
+static constexpr double cost_table = 1.0;
+static constexpr double cost_fermi_lookup = 0.1;
+static constexpr double cost_sublattice_sym = 1.0;
+static constexpr double cost_index_hash = 2.0;
+static constexpr double cost_index_dense = 1.0;
+
+static int64_t bytes(double x) {
+  return (x < (double)std::numeric_limits<int64_t>::max())
+             ? (int64_t)x
+             : std::numeric_limits<int64_t>::max();
+}
+
+static double pow2(int64_t n) { return std::ldexp(1.0, (int)n); }
+
+// Prefix and postfix tables of GroupActionLookup
+static double group_action_lookup_memory(int64_t nsites, int64_t n_symmetries,
+                                         int64_t bytes_bit_t) {
+  return n_symmetries * bytes_bit_t *
+         (pow2(nsites / 2) + pow2(nsites - nsites / 2));
+}
+
+// Tables of FermiSignLookup shared between up and down spins
+static double fermi_lookup_memory(int64_t nsites, int64_t n_symmetries,
+                                  int64_t bytes_bit_t) {
+  int64_t n_postfix =
+      (bytes_bit_t == 4)
+          ? combinatorics::FermiSignLookup<uint32_t>::n_postfix_bits(nsites)
+          : combinatorics::FermiSignLookup<uint64_t>::n_postfix_bits(nsites);
+  return n_symmetries *
+         (pow2(nsites - n_postfix) / 8. + pow2(n_postfix) * bytes_bit_t);
+}
+
+std::vector<BackendEstimate>
+backend_estimates_spinhalf(int64_t nsites, std::optional<int64_t> nup,
+                           Representation const &irrep, int64_t spinflip) {
+  auto const &group = irrep.group();
+  int64_t n_perms = group.size();
+  int64_t n_symmetries = (spinflip != 0) ? 2 * n_perms : n_perms;
+  double raw_size =
+      nup ? (double)combinatorics::binomial(nsites, *nup) : pow2(nsites);
+  double dim = raw_size / n_symmetries;
+
+  std::vector<BackendEstimate> estimates;
+
+  // BasisSymmetricSz / BasisSymmetricNoSz store the index and symmetries of
+  // the representative for every state
+  int64_t b = (nsites < 32) ? 4 : 8;
+  double memory_lookup = raw_size * 32 + dim * (b + 8) +
+                         group_action_lookup_memory(nsites, n_symmetries, b);
+  estimates.push_back({(nsites < 32) ? "32bit" : "64bit", bytes(memory_lookup),
+                       cost_table});
+
+  // BasisSublattice stores the representatives, norms and the tables of the
+  // symmetries acting on a single sublattice
+  for (int n_sublat = 1; n_sublat <= 5; ++n_sublat) {
+    int64_t nsites_sublat = nsites / n_sublat;
+    if ((nsites % n_sublat != 0) || (nsites > 64) || (nsites_sublat > 32) ||
+        !symmetries::is_sublattice_stable(n_sublat, group)) {
+      continue;
+    }
+    double memory = dim * 16 + n_sublat * pow2(nsites_sublat) *
+                                   (8. * n_perms + 16.);
+    double cost = cost_table + cost_sublattice_sym * n_symmetries;
+    double n_prefixes = std::min(dim, pow2(std::min(nsites, (int64_t)32)));
+    std::string backend = fmt::format("{}sublattice", n_sublat);
+    estimates.push_back(
+        {backend, bytes(memory + 48 * n_prefixes), cost + cost_index_hash});
+    estimates.push_back({backend + "_dense", bytes(memory + 8 * dim),
+                         cost + cost_index_dense});
+  }
+  return estimates;
+}
+
+// Fermionic bases with and without tabulated fermi signs, given the number
+// of up configurations for which representatives are stored, the dimension
+// and the memory of the fermi tables
+static std::vector<BackendEstimate>
+fermionic_estimates(int64_t nsites, int64_t n_symmetries, double raw_ups_size,
+                    double dim, double memory_fermi_tables) {
+  int64_t b = (nsites < 32) ? 4 : 8;
+  std::string bits = (nsites < 32) ? "32bit" : "64bit";
+  double memory = raw_ups_size * 32 + dim * (b + 8) +
+                  group_action_lookup_memory(nsites, n_symmetries, b);
+  double memory_lookup = fermi_lookup_memory(nsites, n_symmetries, b);
+  return {{bits, bytes(memory + memory_fermi_tables), cost_table},
+          {bits + "_fermi_lookup", bytes(memory + memory_lookup),
+           cost_table + cost_fermi_lookup}};
+}
+
+std::vector<BackendEstimate>
+backend_estimates_tj(int64_t nsites, int64_t nup, int64_t ndn,
+                     Representation const &irrep) {
+  using combinatorics::binomial;
+  int64_t n_symmetries = irrep.group().size();
+  double raw_ups_size = (double)binomial(nsites, nup);
+  double dim = raw_ups_size * binomial(nsites - nup, ndn) / n_symmetries;
+  double memory_fermi_tables =
+      n_symmetries * (raw_ups_size + binomial(nsites, ndn)) / 8.;
+  return fermionic_estimates(nsites, n_symmetries, raw_ups_size, dim,
+                             memory_fermi_tables);
+}
+
+std::vector<BackendEstimate>
+backend_estimates_electron(int64_t nsites, std::optional<int64_t> nup,
+                           std::optional<int64_t> ndn,
+                           Representation const &irrep) {
+  using combinatorics::binomial;
+  int64_t n_symmetries = irrep.group().size();
+  if (nup && ndn) {
+    double raw_ups_size = (double)binomial(nsites, *nup);
+    double raw_dns_size = (double)binomial(nsites, *ndn);
+    double dim = raw_ups_size * raw_dns_size / n_symmetries;
+    double memory_fermi_tables =
+        n_symmetries * (raw_ups_size + raw_dns_size) / 8.;
+    return fermionic_estimates(nsites, n_symmetries, raw_ups_size, dim,
+                               memory_fermi_tables);
+  } else {
+    double raw_size = pow2(nsites);
+    double dim = raw_size * raw_size / n_symmetries;
+    double memory_fermi_table = n_symmetries * raw_size / 8.;
+    return fermionic_estimates(nsites, n_symmetries, raw_size, dim,
+                               memory_fermi_table);
+  }
+}
+
+std::pair<std::string, bool> split_backend_suffix(std::string const &backend,
+                                                  std::string const &suffix) {
+  if ((backend.size() > suffix.size()) &&
+      (backend.substr(backend.size() - suffix.size()) == suffix)) {
+    return {backend.substr(0, backend.size() - suffix.size()), true};
+  }
+  return {backend, false};
+}
+
+std::string choose_backend(std::vector<BackendEstimate> const &estimates,
+                           int64_t limit) try {
+  if (estimates.empty()) {
+    XDIAG_THROW("No backend available");
+  }
+  auto less_memory = [](BackendEstimate const &a, BackendEstimate const &b) {
+    return a.memory < b.memory;
+  };
+  auto faster = [](BackendEstimate const &a, BackendEstimate const &b) {
+    return (a.cost < b.cost) || ((a.cost == b.cost) && (a.memory < b.memory));
+  };
+
+  BackendEstimate const *chosen = nullptr;
+  for (auto const &estimate : estimates) {
+    Log(2, "Backend \"{}\": estimated memory {} bytes, cost {}",
+        estimate.backend, estimate.memory, estimate.cost);
+    if (((limit == 0) || (estimate.memory <= limit)) &&
+        (!chosen || faster(estimate, *chosen))) {
+      chosen = &estimate;
+    }
+  }
+  if (chosen) {
+    Log(1, "Chose backend \"{}\" with estimated memory of {} bytes",
+        chosen->backend, chosen->memory);
+  } else {
+    chosen = &*std::min_element(estimates.begin(), estimates.end(),
+                                less_memory);
+    Log.warn("Warning: no backend fits into the memory limit of {} bytes, "
+             "chose backend \"{}\" with estimated memory of {} bytes",
+             limit, chosen->backend, chosen->memory);
+  }
+  return chosen->backend;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+} // namespace basis
+} // namespace xdiag
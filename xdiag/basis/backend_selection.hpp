@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <xdiag/common.hpp>
+#include <xdiag/symmetries/representation.hpp>
+
+namespace xdiag {
+
+// Memory in bytes available for the basis of a symmetric block when the
+// backend "auto" is chosen. Zero disables the limit, which is the default
+// unless the environment variable XDIAG_MEMORY_LIMIT is set, e.g. to "16GB".
+XDIAG_API void set_memory_limit(int64_t bytes);
+XDIAG_API int64_t memory_limit();
+
+namespace basis {
+
+// Estimated memory of a basis implementation in bytes and the cost of
+// computing a matrix element, in units of a lookup in a table
+struct BackendEstimate {
+  std::string backend;
+  int64_t memory;
+  double cost;
+};
+
+std::vector<BackendEstimate>
+backend_estimates_spinhalf(int64_t nsites, std::optional<int64_t> nup,
+                           Representation const &irrep, int64_t spinflip);
+std::vector<BackendEstimate> backend_estimates_tj(int64_t nsites, int64_t nup,
+                                                  int64_t ndn,
+                                                  Representation const &irrep);
+std::vector<BackendEstimate>
+backend_estimates_electron(int64_t nsites, std::optional<int64_t> nup,
+                           std::optional<int64_t> ndn,
+                           Representation const &irrep);
+
+// Splits a suffix like "_dense" or "_fermi_lookup" off a backend, returning
+// the base backend and whether the suffix was present
+std::pair<std::string, bool> split_backend_suffix(std::string const &backend,
+                                                  std::string const &suffix);
+
+// Chooses the backend with the lowest cost whose memory does not exceed
+// limit, preferring less memory for equal cost. If no backend fits, the one
+// with the least memory is chosen. A limit of zero means no limit.
+std::string choose_backend(std::vector<BackendEstimate> const &estimates,
+                           int64_t limit);
+
+} // namespace basis
+} // namespace xdiag
@@ -0,0 +1,155 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "basis_cache.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#ifdef XDIAG_USE_MPI
+#include <mpi.h>
+#endif
+
+#include <xdiag/blocks/spinhalf.hpp>
+#include <xdiag/io/binary.hpp>
+#include <xdiag/random/hash.hpp>
+#include <xdiag/random/hash_functions.hpp>
+
+namespace xdiag {
+
+static std::string initial_basis_cache_directory() {
+  const char *directory = std::getenv("XDIAG_BASIS_CACHE");
+  return directory ? std::string(directory) : std::string();
+}
+
+static std::string &basis_cache_directory_ref() {
+  static std::string directory = initial_basis_cache_directory();
+  return directory;
+}
+
+void set_basis_cache_directory(std::string const &directory) {
+  basis_cache_directory_ref() = directory;
+}
+
+std::string basis_cache_directory() { return basis_cache_directory_ref(); }
+
+namespace basis {
+
+// "XDIAGBAS" in ASCII, followed by the version of the file layout
+static constexpr uint64_t cache_magic = 0x5341424741494458;
+static constexpr uint64_t cache_version = 2;
+
+static int64_t n_cache_hits = 0;
+
+uint64_t cache_key(Spinhalf const &block) {
+  return cache_key(block, block.backend());
+}
+
+uint64_t cache_key(Spinhalf const &block, std::string const &backend) {
+  uint64_t h = random::hash(block);
+  for (char c : backend) {
+    h = random::hash_combine(h, random::hash_fnv1((uint64_t)c));
+  }
+  return h;
+}
+
+std::string cache_filename(uint64_t key) {
+  std::string directory = basis_cache_directory();
+  if (directory.empty()) {
+    return directory;
+  }
+  return fmt::format("{}/basis_{:016x}.bin", directory, key);
+}
+
+CacheHeader cache_header(Spinhalf const &block, std::string const &backend) {
+  CacheHeader header;
+  header.key = cache_key(block, backend);
+  header.nsites = block.nsites();
+  header.nup = block.nup() ? *block.nup() : -1;
+  header.spinflip = block.spinflip() ? *block.spinflip() : 0;
+  header.backend = backend;
+  if (block.irrep()) {
+    auto const &characters = block.irrep()->characters();
+    arma::vec re = characters.real();
+    arma::vec im = characters.imag();
+    header.characters_real = std::vector<double>(re.begin(), re.end());
+    header.characters_imag = std::vector<double>(im.begin(), im.end());
+  }
+  return header;
+}
+
+static void write_header(std::ostream &out, CacheHeader const &header) {
+  io::write_binary(out, cache_magic);
+  io::write_binary(out, cache_version);
+  io::write_binary(out, header.key);
+  io::write_binary(out, header.nsites);
+  io::write_binary(out, header.nup);
+  io::write_binary(out, header.spinflip);
+  io::write_binary(
+      out, std::vector<char>(header.backend.begin(), header.backend.end()));
+  io::write_binary(out, header.characters_real);
+  io::write_binary(out, header.characters_imag);
+}
+
+bool read_cache_header(std::istream &in, CacheHeader const &header) try {
+  uint64_t magic, version;
+  io::read_binary(in, magic);
+  io::read_binary(in, version);
+  if ((magic != cache_magic) || (version != cache_version)) {
+    return false;
+  }
+  CacheHeader file;
+  std::vector<char> backend;
+  io::read_binary(in, file.key);
+  io::read_binary(in, file.nsites);
+  io::read_binary(in, file.nup);
+  io::read_binary(in, file.spinflip);
+  io::read_binary(in, backend);
+  io::read_binary(in, file.characters_real);
+  io::read_binary(in, file.characters_imag);
+  file.backend = std::string(backend.begin(), backend.end());
+  return (file.key == header.key) && (file.nsites == header.nsites) &&
+         (file.nup == header.nup) && (file.spinflip == header.spinflip) &&
+         (file.backend == header.backend) &&
+         (file.characters_real == header.characters_real) &&
+         (file.characters_imag == header.characters_imag);
+} catch (Error const &e) {
+  return false;
+}
+
+int64_t cache_hits() { return n_cache_hits; }
+void count_cache_hit() { ++n_cache_hits; }
+
+void write_cache(std::string const &filename, CacheHeader const &header,
+                 std::function<void(std::ostream &)> const &write) try {
+#ifdef XDIAG_USE_MPI
+  int mpi_rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+  if (mpi_rank != 0) {
+    return;
+  }
+#endif
+  std::random_device rd;
+  std::string filename_tmp = fmt::format("{}.{:x}.tmp", filename, rd());
+  std::ofstream out(filename_tmp, std::ios::binary);
+  if (!out) {
+    Log.warn("Warning: unable to write basis to cache file {}", filename);
+    return;
+  }
+  write_header(out, header);
+  write(out);
+  out.close();
+  if (std::rename(filename_tmp.c_str(), filename.c_str()) != 0) {
+    std::remove(filename_tmp.c_str());
+    Log.warn("Warning: unable to write basis to cache file {}", filename);
+  } else {
+    Log(1, "Wrote basis to cache file {}", filename);
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+} // namespace basis
+} // namespace xdiag
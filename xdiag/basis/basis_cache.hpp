@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <xdiag/common.hpp>
+#include <xdiag/utils/logger.hpp>
+
+namespace xdiag {
+
+class Spinhalf;
+
+// Directory in which bases of symmetric blocks are stored after they have
+// been constructed. If the same block is created again, e.g. by a later job
+// of a parameter sweep, the basis is read from this directory instead of
+// being recomputed. An empty string disables the cache, which is the
+// default unless the environment variable XDIAG_BASIS_CACHE is set.
+XDIAG_API void set_basis_cache_directory(std::string const &directory);
+XDIAG_API std::string basis_cache_directory();
+
+namespace basis {
+
+// Key of the basis of a block in the cache, combining the hash of the block
+// with its backend. For the backend "auto", the key is built from the chosen
+// backend, as the chosen basis may depend on the memory limit.
+uint64_t cache_key(Spinhalf const &block);
+uint64_t cache_key(Spinhalf const &block, std::string const &backend);
+
+// Header of a cache file. Besides the key, the parameters of the block are
+// stored and compared on reading, such that a colliding key never leads to
+// the basis of a different block.
+struct CacheHeader {
+  uint64_t key;
+  int64_t nsites;
+  int64_t nup;      // -1 if the number of up spins is not conserved
+  int64_t spinflip; // 0 without spin flip symmetry
+  std::string backend;
+  std::vector<double> characters_real;
+  std::vector<double> characters_imag;
+};
+CacheHeader cache_header(Spinhalf const &block, std::string const &backend);
+
+// File of a basis with the given key in the cache directory, empty if the
+// cache is disabled
+std::string cache_filename(uint64_t key);
+
+// Checks whether a cached file starts with a header equal to header
+bool read_cache_header(std::istream &in, CacheHeader const &header);
+
+// Writes the header and the basis to a temporary file, which is then moved
+// to filename such that concurrent jobs never read an incomplete file
+void write_cache(std::string const &filename, CacheHeader const &header,
+                 std::function<void(std::ostream &)> const &write);
+
+// Number of bases which have been read from the cache so far
+XDIAG_API int64_t cache_hits();
+void count_cache_hit();
+
+// Constructs a basis from args, or reads it from the cache. The basis_t
+// needs to provide a constructor basis_t(args..., std::istream &) and a
+// member function write(std::ostream &).
+template <class basis_t, typename... args_t>
+basis_t cached(CacheHeader const &header, args_t const &...args) try {
+  std::string filename = cache_filename(header.key);
+  if (filename.empty()) {
+    return basis_t(args...);
+  }
+
+  std::ifstream in(filename, std::ios::binary);
+  if (in && read_cache_header(in, header)) {
+    try {
+      basis_t basis(args..., in);
+      count_cache_hit();
+      Log(1, "Read basis from cache file {}", filename);
+      return basis;
+    } catch (Error const &e) {
+      Log.warn("Warning: unable to read cached basis from {}, recomputing",
+               filename);
+    }
+  } else if (in) {
+    Log.warn("Warning: cache file {} does not match the block, recomputing",
+             filename);
+  }
+  in.close();
+
+  basis_t basis(args...);
+  write_cache(filename, header, [&](std::ostream &out) { basis.write(out); });
+  return basis;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+} // namespace basis
+} // namespace xdiag
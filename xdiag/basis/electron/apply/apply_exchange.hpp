@@ -4,8 +4,10 @@
 
 #pragma once
 
+#include <xdiag/basis/spinflip_projection.hpp>
 #include <xdiag/bits/bitops.hpp>
 #include <xdiag/common.hpp>
+#include <xdiag/utils/profile.hpp>
 #include <xdiag/operators/op.hpp>
 
 namespace xdiag::basis::electron {
@@ -116,13 +118,13 @@ void apply_exchange(Coupling const &cpl, Op const &op, basis_t const &basis,
         for (bit_t dns : dnss_in) {
 
           // If  dns can be raised
-          if ((dns & flipmask) == dns_mask) {
+          int64_t idx_in = up_offset_in + idx_dn;
+          if (((dns & flipmask) == dns_mask) && contributes(fill, idx_in)) {
             bit_t dns_flip = dns ^ flipmask;
             auto [idx_dn_flip, fermi_dn] =
                 basis.index_dns_fermi(dns_flip, sym, fermimask);
 
             coeff_t val = prefac / norms_in[idx_dn];
-            int64_t idx_in = up_offset_in + idx_dn;
             int64_t idx_out = up_offset_out + idx_dn_flip;
             fill(idx_in, idx_out, (fermi_up ^ fermi_dn) ? -val : val);
           }
@@ -145,7 +147,8 @@ void apply_exchange(Coupling const &cpl, Op const &op, basis_t const &basis,
         for (bit_t dns : dnss_in) {
 
           // If  dns can be raised
-          if ((dns & flipmask) == dns_mask) {
+          int64_t idx_in = up_offset_in + idx_dn;
+          if (((dns & flipmask) == dns_mask) && contributes(fill, idx_in)) {
             bit_t dns_flip = dns ^ flipmask;
             auto [idx_dn_flip, fermi_dn, sym] =
                 basis.index_dns_fermi_sym(dns_flip, syms, dnss_out, fermimask);
@@ -156,9 +159,10 @@ void apply_exchange(Coupling const &cpl, Op const &op, basis_t const &basis,
                   fermi_up_hop ^ basis.fermi_bool_ups(sym, ups_flip);
               coeff_t val =
                   prefacs[sym] * norms_out[idx_dn_flip] / norms_in[idx_dn];
-              int64_t idx_in = up_offset_in + idx_dn;
               int64_t idx_out = up_offset_out + idx_dn_flip;
               fill(idx_in, idx_out, (fermi_up ^ fermi_dn) ? -val : val);
+            } else {
+              profile::count_invalid();
             }
           }
           ++idx_dn;
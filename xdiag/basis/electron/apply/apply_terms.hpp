@@ -14,6 +14,7 @@
 
 #include <xdiag/common.hpp>
 #include <xdiag/operators/opsum.hpp>
+#include <xdiag/utils/profile.hpp>
 
 namespace xdiag::basis::electron {
 
@@ -24,6 +25,7 @@ void apply_terms(OpSum const &ops, basis_t const &basis_in,
   for (auto const &[cpl, op] : ops.plain()) {
 
     std::string type = op.type();
+    profile::Scope scope("Electron", type);
     if ((type == "Hopup") || (type == "Hopdn")) {
       electron::apply_hopping<coeff_t, symmetric>(cpl, op, basis_in, fill);
     } else if ((type == "Cdagup") || (type == "Cup") || (type == "Cdagdn") ||
@@ -5,16 +5,14 @@
 #pragma once
 
 #include <xdiag/basis/electron/apply/apply_terms.hpp>
+#include <xdiag/basis/spinflip_projection.hpp>
 #include <xdiag/common.hpp>
 
 namespace xdiag::basis::electron {
 
 template <typename coeff_t, class fill_f>
-inline void dispatch(OpSum const &ops, Electron const &block_in,
-                     Electron const &block_out, fill_f fill) try {
-  auto const &basis_in = block_in.basis();
-  auto const &basis_out = block_out.basis();
-
+inline void dispatch(OpSum const &ops, BasisElectron const &basis_in,
+                     BasisElectron const &basis_out, fill_f &fill) try {
   std::visit(overload{// uint32_t
                       [&](BasisNp<uint32_t> const &idx_in,
                           BasisNp<uint32_t> const &idx_out) {
@@ -58,4 +56,25 @@ inline void dispatch(OpSum const &ops, Electron const &block_in,
   XDIAG_RETHROW(error);
 }
 
+// Blocks with spin flip or particle-hole symmetry are applied with the
+// kernels of the symmetric bases, whose matrix elements are projected onto
+// the states of definite parity
+template <typename coeff_t, class fill_f>
+inline void dispatch(OpSum const &ops, Electron const &block_in,
+                     Electron const &block_out, fill_f fill) try {
+  if (block_in.projected() && block_out.projected()) {
+    auto fill_projected = projected_fill<coeff_t>(
+        block_in.projection(), block_out.projection(), fill);
+    dispatch<coeff_t>(ops, block_in.basis(), block_out.basis(),
+                      fill_projected);
+  } else if (block_in.projected() || block_out.projected()) {
+    XDIAG_THROW("Either both or none of the blocks must have a spin flip or "
+                "particle-hole symmetry");
+  } else {
+    dispatch<coeff_t>(ops, block_in.basis(), block_out.basis(), fill);
+  }
+} catch (Error const &error) {
+  XDIAG_RETHROW(error);
+}
+
 } // namespace xdiag::basis::electron
@@ -13,10 +13,9 @@ template <typename coeff_t>
 void dispatch_apply(OpSum const &ops, Electron const &block_in,
                     arma::Col<coeff_t> const &vec_in, Electron const &block_out,
                     arma::Col<coeff_t> &vec_out) try {
-  auto fill = [&](int64_t idx_in, int64_t idx_out, coeff_t val) {
-    return fill_apply(vec_in, vec_out, idx_in, idx_out, val);
-  };
-  electron::dispatch<coeff_t>(ops, block_in, block_out, fill);
+  using kernel_coeff_t = apply_coeff_t<coeff_t>;
+  ApplyFill<coeff_t, kernel_coeff_t> fill(vec_in, vec_out);
+  electron::dispatch<kernel_coeff_t>(ops, block_in, block_out, fill);
 } catch (Error const &error) {
   XDIAG_RETHROW(error);
 }
@@ -26,15 +25,22 @@ template void dispatch_apply(OpSum const &, Electron const &, arma::vec const &,
 template void dispatch_apply(OpSum const &, Electron const &,
                              arma::cx_vec const &, Electron const &block,
                              arma::cx_vec &);
+template void dispatch_apply(OpSum const &, Electron const &,
+                             arma::fvec const &, Electron const &block,
+                             arma::fvec &);
+template void dispatch_apply(OpSum const &, Electron const &,
+                             arma::cx_fvec const &, Electron const &block,
+                             arma::cx_fvec &);
 
 template <typename coeff_t>
 void dispatch_apply(OpSum const &ops, Electron const &block_in,
                     arma::Mat<coeff_t> const &mat_in, Electron const &block_out,
                     arma::Mat<coeff_t> &mat_out) try {
-  auto fill = [&](int64_t idx_in, int64_t idx_out, coeff_t val) {
+  using kernel_coeff_t = apply_coeff_t<coeff_t>;
+  auto fill = [&](int64_t idx_in, int64_t idx_out, kernel_coeff_t val) {
     return fill_apply(mat_in, mat_out, idx_in, idx_out, val);
   };
-  electron::dispatch<coeff_t>(ops, block_in, block_out, fill);
+  electron::dispatch<kernel_coeff_t>(ops, block_in, block_out, fill);
 } catch (Error const &error) {
   XDIAG_RETHROW(error);
 }
@@ -45,5 +51,11 @@ template void dispatch_apply(OpSum const &, Electron const &, arma::mat const &,
 template void dispatch_apply(OpSum const &, Electron const &,
                              arma::cx_mat const &, Electron const &block,
                              arma::cx_mat &);
+template void dispatch_apply(OpSum const &, Electron const &,
+                             arma::fmat const &, Electron const &block,
+                             arma::fmat &);
+template void dispatch_apply(OpSum const &, Electron const &,
+                             arma::cx_fmat const &, Electron const &block,
+                             arma::cx_fmat &);
 
 } // namespace xdiag::basis
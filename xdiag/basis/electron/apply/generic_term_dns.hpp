@@ -6,6 +6,9 @@
 
 #include <functional>
 
+#include <xdiag/basis/spinflip_projection.hpp>
+#include <xdiag/utils/profile.hpp>
+
 namespace xdiag::basis::electron {
 
 template <typename bit_t, typename coeff_t, bool symmetric, bool fermi_ups,
@@ -42,8 +45,8 @@ void generic_term_dns(basis_t const &basis_in, basis_t const &basis_out,
         int64_t dns_in_idx = 0;
         for (bit_t dns_in : dnss_in) {
 
-          if (non_zero_term(dns_in)) {
-            int64_t idx_in = ups_offset_in + dns_in_idx;
+          int64_t idx_in = ups_offset_in + dns_in_idx;
+          if (non_zero_term(dns_in) && contributes(fill, idx_in)) {
             auto [dns_flip, coeff] = term_action(dns_in);
 
             if constexpr (fermi_ups) { // not ideal to do this here
@@ -65,8 +68,8 @@ void generic_term_dns(basis_t const &basis_in, basis_t const &basis_out,
         int64_t dns_in_idx = 0;
         for (bit_t dns_in : dnss_in) {
 
-          if (non_zero_term(dns_in)) {
-            int64_t idx_in = ups_offset_in + dns_in_idx;
+          int64_t idx_in = ups_offset_in + dns_in_idx;
+          if (non_zero_term(dns_in) && contributes(fill, idx_in)) {
             auto [dns_flip, coeff] = term_action(dns_in);
 
             if constexpr (fermi_ups) { // not ideal to do this here
@@ -87,6 +90,8 @@ void generic_term_dns(basis_t const &basis_in, basis_t const &basis_out,
                   coeff * norms_out[idx_dns_flip] / norms_in[dns_in_idx];
 
               fill(idx_in, idx_out, (fermi_up ^ fermi_dn) ? -val : val);
+            } else {
+              profile::count_invalid();
             }
           }
 
@@ -4,8 +4,13 @@
 
 #pragma once
 
+#include <tuple>
 #include <vector>
 
+#include <xdiag/algebra/fill.hpp>
+#include <xdiag/basis/spinflip_projection.hpp>
+#include <xdiag/utils/profile.hpp>
+
 namespace xdiag::basis::electron {
 
 template <typename bit_t, typename coeff_t, bool symmetric, class basis_t,
@@ -27,7 +32,10 @@ void generic_term_ups(basis_t const &basis_in, basis_t const &basis_out,
       bit_t ups_in = basis_in.rep_ups(idx_up_in);
       if (non_zero_term(ups_in)) {
 
-        auto [ups_flip, coeff] = term_action(ups_in);
+        // no structured binding, as ups_flip is captured by the lambdas below
+        bit_t ups_flip;
+        coeff_t coeff;
+        std::tie(ups_flip, coeff) = term_action(ups_in);
         int64_t idx_ups_flip = basis_out.index_ups(ups_flip);
         bit_t ups_flip_rep = basis_out.rep_ups(idx_ups_flip);
 
@@ -48,18 +56,23 @@ void generic_term_ups(basis_t const &basis_in, basis_t const &basis_out,
           coeff_t prefac = coeff * bloch_factors(sym);
           bool fermi_up = basis_out.fermi_bool_ups(sym, ups_flip);
 
-          int64_t idx_dn = 0;
-          for (bit_t dns : dnss_in) {
-            int64_t idx_in = ups_offset_in + idx_dn;
-            bit_t dns_rep = group_action.apply(sym, dns);
-            int64_t idx_out = ups_offset_out + basis_out.index_dns(dns_rep);
-            bool fermi_dn = basis_out.fermi_bool_dns(sym, dns);
-
-            coeff_t val =
-                prefac / norms_in[idx_dn]; // norms_out = 1.0 in this case
-            fill(idx_in, idx_out, (fermi_up ^ fermi_dn) ? -val : val);
-            ++idx_dn;
-          }
+          staged_fill<coeff_t>(
+              dnss_in.size(),
+              [&](int64_t idx_dn, int64_t &idx_in, int64_t &idx_out,
+                  coeff_t &val) {
+                idx_in = ups_offset_in + idx_dn;
+                if (!contributes(fill, idx_in)) {
+                  return false;
+                }
+                bit_t dns = dnss_in[idx_dn];
+                bit_t dns_rep = group_action.apply(sym, dns);
+                idx_out = ups_offset_out + basis_out.index_dns(dns_rep);
+                bool fermi_dn = basis_out.fermi_bool_dns(sym, dns);
+                val = prefac / norms_in[idx_dn]; // norms_out = 1.0 here
+                val = (fermi_up ^ fermi_dn) ? -val : val;
+                return true;
+              },
+              fill);
 
         } else { // non-trivial up-stabilizer (unlikely)
           auto syms = syms_ups_out;
@@ -68,23 +81,28 @@ void generic_term_ups(basis_t const &basis_in, basis_t const &basis_out,
             prefacs[i] = coeff * bloch_factors(i);
           }
 
-          int64_t idx_dn = 0;
-          for (bit_t dns : dnss_in) {
-            int64_t idx_in = ups_offset_in + idx_dn;
-
-            auto [idx_dn_out, fermi_dn, sym] =
-                basis_out.index_dns_fermi_sym(dns, syms, dnss_out);
-
-            if (idx_dn_out != invalid_index) {
-              int64_t idx_out = ups_offset_out + idx_dn_out;
-              bool fermi_up = basis_out.fermi_bool_ups(sym, ups_flip);
-              coeff_t val =
-                  prefacs[sym] * norms_out[idx_dn_out] / norms_in[idx_dn];
-
-              fill(idx_in, idx_out, (fermi_up ^ fermi_dn) ? -val : val);
-            }
-            ++idx_dn;
-          }
+          staged_fill<coeff_t>(
+              dnss_in.size(),
+              [&](int64_t idx_dn, int64_t &idx_in, int64_t &idx_out,
+                  coeff_t &val) {
+                idx_in = ups_offset_in + idx_dn;
+                if (!contributes(fill, idx_in)) {
+                  return false;
+                }
+                auto [idx_dn_out, fermi_dn, sym] =
+                    basis_out.index_dns_fermi_sym(dnss_in[idx_dn], syms,
+                                                  dnss_out);
+                if (idx_dn_out == invalid_index) {
+                  profile::count_invalid();
+                  return false;
+                }
+                idx_out = ups_offset_out + idx_dn_out;
+                bool fermi_up = basis_out.fermi_bool_ups(sym, ups_flip);
+                val = prefacs[sym] * norms_out[idx_dn_out] / norms_in[idx_dn];
+                val = (fermi_up ^ fermi_dn) ? -val : val;
+                return true;
+              },
+              fill);
         } // if trivial stabilizer or not
       } // if non_zero_term
     } // loop over ups
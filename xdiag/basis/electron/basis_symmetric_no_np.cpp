@@ -8,16 +8,18 @@
 #include <xdiag/symmetries/operations/group_action_operations.hpp>
 #include <xdiag/symmetries/operations/representative_list.hpp>
 #include <xdiag/symmetries/operations/symmetry_operations.hpp>
+#include <xdiag/utils/logger.hpp>
 
 namespace xdiag::basis::electron {
 
 template <class bit_t>
 BasisSymmetricNoNp<bit_t>::BasisSymmetricNoNp(int64_t nsites,
-                                              Representation const &irrep) try
+                                              Representation const &irrep,
+                                              bool fermi_lookup) try
     : nsites_(nsites), group_action_(irrep.group()), irrep_(irrep),
       raw_ups_size_((int64_t)1 << nsites),
       raw_dns_size_((int64_t)1 << nsites), lintable_ups_(nsites),
-      lintable_dns_(nsites), fermi_table_(nsites_, irrep.group()) {
+      lintable_dns_(nsites), fermi_lookup_(fermi_lookup) {
   check_nsites_work_with_bits<bit_t>(nsites_);
 
   if (nsites < 0) {
@@ -26,6 +28,15 @@ BasisSymmetricNoNp<bit_t>::BasisSymmetricNoNp(int64_t nsites,
     XDIAG_THROW("nsites does not match the nsites in PermutationGroup");
   }
 
+  if (fermi_lookup) {
+    fermi_sign_lookup_ = combinatorics::FermiSignLookup<bit_t>(irrep.group());
+    Log(2, "fermi sign lookup: {} bytes", fermi_sign_lookup_.memory());
+  } else {
+    fermi_table_ =
+        combinatorics::FermiTableSubsets<bit_t>(nsites, irrep.group());
+    Log(2, "fermi table: {} bytes", fermi_table_.memory());
+  }
+
   using combinatorics::Subsets;
 
   std::tie(reps_up_, idces_up_, syms_up_, sym_limits_up_) =
@@ -16,6 +16,7 @@
 #include <xdiag/symmetries/operations/symmetry_operations.hpp>
 #include <xdiag/symmetries/permutation_group.hpp>
 #include <xdiag/symmetries/representation.hpp>
+#include <xdiag/utils/allocator.hpp>
 
 namespace xdiag::basis::electron {
 
@@ -27,7 +28,8 @@ public:
   using iterator_t = BasisSymmetricNoNpIterator<bit_t>;
   using span_size_t = gsl::span<int64_t const>::size_type;
 
-  BasisSymmetricNoNp(int64_t nsites, Representation const &irrep);
+  BasisSymmetricNoNp(int64_t nsites, Representation const &irrep,
+                     bool fermi_lookup = false);
 
   int64_t nsites() const;
   int64_t nup() const;
@@ -55,7 +57,7 @@ public:
                                                   int64_t sym) const {
     bit_t dns_rep = group_action_.apply(sym, dns);
     int64_t idx_dns_rep = lintable_dns_.index(dns_rep);
-    bool fermi_dns = fermi_table_.sign(sym, dns);
+    bool fermi_dns = fermi_bool_dns(sym, dns);
     return {idx_dns_rep, fermi_dns};
   }
 
@@ -64,7 +66,7 @@ public:
     bit_t dns_rep = group_action_.apply(sym, dns);
     int64_t idx_dns_rep = lintable_dns_.index(dns_rep);
     bool fermi_dns = (bits::popcnt(dns & fermimask) & 1);
-    fermi_dns ^= fermi_table_.sign(sym, dns);
+    fermi_dns ^= fermi_bool_dns(sym, dns);
     return {idx_dns_rep, fermi_dns};
   }
 
@@ -76,7 +78,7 @@ public:
         symmetries::representative_sym_subset(dns, group_action_, syms);
     auto it = std::lower_bound(dnss_out.begin(), dnss_out.end(), rep_dns);
     if ((it != dnss_out.end()) && (*it == rep_dns)) {
-      bool fermi_dns = fermi_table_.sign(rep_sym, dns);
+      bool fermi_dns = fermi_bool_dns(rep_sym, dns);
       return {std::distance(dnss_out.begin(), it), fermi_dns, rep_sym};
     } else {
       return {invalid_index, false, rep_sym};
@@ -91,7 +93,7 @@ public:
     auto it = std::lower_bound(dnss_out.begin(), dnss_out.end(), rep_dns);
     if ((it != dnss_out.end()) && (*it == rep_dns)) {
       bool fermi_dns = (bits::popcnt(dns & fermimask) & 1);
-      fermi_dns ^= fermi_table_.sign(rep_sym, dns);
+      fermi_dns ^= fermi_bool_dns(rep_sym, dns);
       return {std::distance(dnss_out.begin(), it), fermi_dns, rep_sym};
     } else {
       return {invalid_index, false, rep_sym};
@@ -141,10 +143,12 @@ public:
 
   // Fermi sign when applying sym on states
   inline bool fermi_bool_ups(int64_t sym, bit_t ups) const {
-    return fermi_table_.sign(sym, ups);
+    return fermi_lookup_ ? fermi_sign_lookup_.sign(sym, ups)
+                         : fermi_table_.sign(sym, ups);
   }
   inline bool fermi_bool_dns(int64_t sym, bit_t dns) const {
-    return fermi_table_.sign(sym, dns);
+    return fermi_lookup_ ? fermi_sign_lookup_.sign(sym, dns)
+                         : fermi_table_.sign(sym, dns);
   }
 
 private:
@@ -159,15 +163,17 @@ private:
 
   combinatorics::SubsetsIndexing<bit_t> lintable_ups_;
   combinatorics::SubsetsIndexing<bit_t> lintable_dns_;
+  bool fermi_lookup_;
   combinatorics::FermiTableSubsets<bit_t> fermi_table_;
+  combinatorics::FermiSignLookup<bit_t> fermi_sign_lookup_;
 
-  std::vector<bit_t> reps_up_;
-  std::vector<int64_t> idces_up_;
+  numa_vector<bit_t> reps_up_;
+  numa_vector<int64_t> idces_up_;
   std::vector<int64_t> syms_up_;
   std::vector<std::pair<span_size_t, span_size_t>> sym_limits_up_;
 
-  std::vector<bit_t> dns_storage_;
-  std::vector<double> norms_storage_;
+  numa_vector<bit_t> dns_storage_;
+  numa_vector<double> norms_storage_;
   std::vector<int64_t> ups_offset_;
   std::vector<std::pair<span_size_t, span_size_t>> dns_limits_;
 
@@ -10,19 +10,20 @@
 #include <xdiag/symmetries/operations/group_action_operations.hpp>
 #include <xdiag/symmetries/operations/representative_list.hpp>
 #include <xdiag/symmetries/operations/symmetry_operations.hpp>
+#include <xdiag/utils/logger.hpp>
 
 namespace xdiag::basis::electron {
 
 template <class bit_t>
 BasisSymmetricNp<bit_t>::BasisSymmetricNp(int64_t nsites, int64_t nup,
                                           int64_t ndn,
-                                          Representation const &irrep) try
+                                          Representation const &irrep,
+                                          bool fermi_lookup) try
     : nsites_(nsites), nup_(nup), ndn_(ndn), group_action_(irrep.group()),
       irrep_(irrep), raw_ups_size_(combinatorics::binomial(nsites, nup)),
       raw_dns_size_(combinatorics::binomial(nsites, ndn)),
       lintable_ups_(nsites, nup), lintable_dns_(nsites, ndn),
-      fermi_table_ups_(nsites, nup, irrep.group()),
-      fermi_table_dns_(nsites, ndn, irrep.group()) {
+      fermi_lookup_(fermi_lookup) {
   check_nsites_work_with_bits<bit_t>(nsites_);
 
   using combinatorics::Combinations;
@@ -36,6 +37,18 @@ BasisSymmetricNp<bit_t>::BasisSymmetricNp(int64_t nsites, int64_t nup,
     XDIAG_THROW("nsites does not match the nsites in PermutationGroup");
   }
 
+  if (fermi_lookup) {
+    fermi_sign_lookup_ = combinatorics::FermiSignLookup<bit_t>(irrep.group());
+    Log(2, "fermi sign lookup: {} bytes", fermi_sign_lookup_.memory());
+  } else {
+    fermi_table_ups_ = combinatorics::FermiTableCombinations<bit_t>(
+        nsites, nup, irrep.group());
+    fermi_table_dns_ = combinatorics::FermiTableCombinations<bit_t>(
+        nsites, ndn, irrep.group());
+    Log(2, "fermi tables: {} bytes",
+        fermi_table_ups_.memory() + fermi_table_dns_.memory());
+  }
+
   std::tie(reps_up_, idces_up_, syms_up_, sym_limits_up_) =
       symmetries::representatives_indices_symmetries_limits<bit_t>(
           combinatorics::CombinationsIndexing<bit_t>(nsites, nup),
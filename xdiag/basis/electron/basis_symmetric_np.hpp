@@ -18,6 +18,7 @@
 #include <xdiag/symmetries/operations/symmetry_operations.hpp>
 #include <xdiag/symmetries/permutation_group.hpp>
 #include <xdiag/symmetries/representation.hpp>
+#include <xdiag/utils/allocator.hpp>
 
 namespace xdiag::basis::electron {
 
@@ -30,7 +31,7 @@ public:
   using span_size_t = gsl::span<int64_t const>::size_type;
 
   BasisSymmetricNp(int64_t nsites, int64_t nup, int64_t ndn,
-                   Representation const &irrep);
+                   Representation const &irrep, bool fermi_lookup = false);
 
   int64_t nsites() const;
   int64_t nup() const;
@@ -58,7 +59,7 @@ public:
                                                   int64_t sym) const {
     bit_t dns_rep = group_action_.apply(sym, dns);
     int64_t idx_dns_rep = lintable_dns_.index(dns_rep);
-    bool fermi_dns = fermi_table_dns_.sign(sym, dns);
+    bool fermi_dns = fermi_bool_dns(sym, dns);
     return {idx_dns_rep, fermi_dns};
   }
 
@@ -67,7 +68,7 @@ public:
     bit_t dns_rep = group_action_.apply(sym, dns);
     int64_t idx_dns_rep = lintable_dns_.index(dns_rep);
     bool fermi_dns = (bits::popcnt(dns & fermimask) & 1);
-    fermi_dns ^= fermi_table_dns_.sign(sym, dns);
+    fermi_dns ^= fermi_bool_dns(sym, dns);
     return {idx_dns_rep, fermi_dns};
   }
 
@@ -79,7 +80,7 @@ public:
         symmetries::representative_sym_subset(dns, group_action_, syms);
     auto it = std::lower_bound(dnss_out.begin(), dnss_out.end(), rep_dns);
     if ((it != dnss_out.end()) && (*it == rep_dns)) {
-      bool fermi_dns = fermi_table_dns_.sign(rep_sym, dns);
+      bool fermi_dns = fermi_bool_dns(rep_sym, dns);
       return {std::distance(dnss_out.begin(), it), fermi_dns, rep_sym};
     } else {
       return {invalid_index, false, rep_sym};
@@ -94,7 +95,7 @@ public:
     auto it = std::lower_bound(dnss_out.begin(), dnss_out.end(), rep_dns);
     if ((it != dnss_out.end()) && (*it == rep_dns)) {
       bool fermi_dns = (bits::popcnt(dns & fermimask) & 1);
-      fermi_dns ^= fermi_table_dns_.sign(rep_sym, dns);
+      fermi_dns ^= fermi_bool_dns(rep_sym, dns);
       return {std::distance(dnss_out.begin(), it), fermi_dns, rep_sym};
     } else {
       return {invalid_index, false, rep_sym};
@@ -120,6 +121,32 @@ public:
     return {index, {syms_up_.data() + start, length}};
   }
 
+  // index of the representative of an arbitrary state, the symmetry mapping
+  // the state onto the representative and the fermi sign of this mapping
+  inline std::tuple<int64_t, int64_t, bool> index_sym_fermi(bit_t ups,
+                                                            bit_t dns) const {
+    auto [idx_ups, syms] = index_syms_up(ups);
+    int64_t up_offset = ups_offset(idx_ups);
+
+    // trivial up-stabilizer (likely)
+    if (syms.size() == 1) {
+      int64_t sym = syms.front();
+      auto [idx_dns, fermi_dns] = index_dns_fermi(dns, sym);
+      bool fermi = fermi_dns ^ fermi_bool_ups(sym, ups);
+      return {up_offset + idx_dns, sym, fermi};
+    }
+    // non-trivial up-stabilizer (unlikely)
+    else {
+      auto dnss = dns_for_ups_rep(ups);
+      auto [idx_dns, fermi_dns, sym] = index_dns_fermi_sym(dns, syms, dnss);
+      if (idx_dns == invalid_index) {
+        return {invalid_index, sym, false};
+      }
+      bool fermi = fermi_dns ^ fermi_bool_ups(sym, ups);
+      return {up_offset + idx_dns, sym, fermi};
+    }
+  }
+
   // Retrieving dns states and norms for given up configuration
   inline gsl::span<bit_t const> dns_for_ups_rep(bit_t ups) const {
     int64_t idx_ups = index_ups(ups);
@@ -144,10 +171,12 @@ public:
 
   // Fermi sign when applying sym on states
   inline bool fermi_bool_ups(int64_t sym, bit_t ups) const {
-    return fermi_table_ups_.sign(sym, ups);
+    return fermi_lookup_ ? fermi_sign_lookup_.sign(sym, ups)
+                         : fermi_table_ups_.sign(sym, ups);
   }
   inline bool fermi_bool_dns(int64_t sym, bit_t dns) const {
-    return fermi_table_dns_.sign(sym, dns);
+    return fermi_lookup_ ? fermi_sign_lookup_.sign(sym, dns)
+                         : fermi_table_dns_.sign(sym, dns);
   }
 
 private:
@@ -162,16 +191,18 @@ private:
 
   combinatorics::LinTable<bit_t> lintable_ups_;
   combinatorics::LinTable<bit_t> lintable_dns_;
+  bool fermi_lookup_;
   combinatorics::FermiTableCombinations<bit_t> fermi_table_ups_;
   combinatorics::FermiTableCombinations<bit_t> fermi_table_dns_;
+  combinatorics::FermiSignLookup<bit_t> fermi_sign_lookup_;
 
-  std::vector<bit_t> reps_up_;
-  std::vector<int64_t> idces_up_;
+  numa_vector<bit_t> reps_up_;
+  numa_vector<int64_t> idces_up_;
   std::vector<int64_t> syms_up_;
   std::vector<std::pair<span_size_t, span_size_t>> sym_limits_up_;
 
-  std::vector<bit_t> dns_storage_;
-  std::vector<double> norms_storage_;
+  numa_vector<bit_t> dns_storage_;
+  numa_vector<double> norms_storage_;
   std::vector<int64_t> ups_offset_;
   std::vector<std::pair<span_size_t, span_size_t>> dns_limits_;
 
@@ -12,6 +12,7 @@
 #include <xdiag/basis/electron_distributed/apply/apply_szsz.hpp>
 #include <xdiag/basis/electron_distributed/apply/apply_u.hpp>
 #include <xdiag/common.hpp>
+#include <xdiag/utils/profile.hpp>
 
 namespace xdiag::basis::electron_distributed {
 
@@ -31,32 +32,41 @@ void apply_terms(OpSum const &ops, basis_t const &basis_in,
   for (auto [cpl, op] : ops) {
     std::string type = op.type();
     if (type == "SzSz") {
+      profile::Scope scope("ElectronDistributed", type);
       electron_distributed::apply_szsz<coeff_t>(
           cpl, op, basis_in, vec_in.memptr(), vec_out.memptr());
     } else if ((type == "Nup") || (type == "Ndn")) {
+      profile::Scope scope("ElectronDistributed", type);
       electron_distributed::apply_number<coeff_t>(
           cpl, op, basis_in, vec_in.memptr(), vec_out.memptr());
     } else if (type == "Nupdn") {
+      profile::Scope scope("ElectronDistributed", type);
       electron_distributed::apply_nupdn<coeff_t>(
           cpl, op, basis_in, vec_in.memptr(), vec_out.memptr());
     } else if (type == "NupdnNupdn") {
+      profile::Scope scope("ElectronDistributed", type);
       electron_distributed::apply_nupdn_nupdn<coeff_t>(
           cpl, op, basis_in, vec_in.memptr(), vec_out.memptr());
     } else if (type == "NtotNtot") {
+      profile::Scope scope("ElectronDistributed", type);
       electron_distributed::apply_ntot_ntot<coeff_t>(
           cpl, op, basis_in, vec_in.memptr(), vec_out.memptr());
     } else if (type == "Exchange") {
+      profile::Scope scope("ElectronDistributed", type);
       electron_distributed::apply_exchange<coeff_t>(
           cpl, op, basis_in, vec_in.memptr(), vec_out.memptr());
     } else if (type == "Hopdn") {
+      profile::Scope scope("ElectronDistributed", type);
       electron_distributed::apply_hopping<coeff_t>(
           cpl, op, basis_in, vec_in.memptr(), vec_out.memptr());
     } else if ((type == "Cdagdn") || (type == "Cdn")) {
+      profile::Scope scope("ElectronDistributed", type);
       electron_distributed::apply_raise_lower<coeff_t>(
           cpl, op, basis_in, vec_in.memptr(), basis_out, vec_out.memptr());
     } else if ((type == "Hopup") || (type == "Cdagup") || (type == "Cup")) {
       continue;
     } else if (type == "HubbardU") {
+      profile::Scope scope("ElectronDistributed", type);
       electron_distributed::apply_u<coeff_t>(cpl, basis_in, vec_in.memptr(),
                                              vec_out.memptr());
     } else {
@@ -72,7 +82,10 @@ void apply_terms(OpSum const &ops, basis_t const &basis_in,
 
   // Perform a transpose to dn/up order
   time_start = MPI_Wtime();
-  basis_in.transpose(vec_in.memptr());
+  {
+    profile::Scope scope("ElectronDistributed", "transpose");
+    basis_in.transpose(vec_in.memptr());
+  }
   time_end = MPI_Wtime();
   Log(3, "  transpose   : {:.6f} secs", time_end - time_start);
 
@@ -88,9 +101,11 @@ void apply_terms(OpSum const &ops, basis_t const &basis_in,
   for (auto [cpl, op] : ops) {
     std::string type = op.type();
     if (type == "Hopup") {
+      profile::Scope scope("ElectronDistributed", type);
       electron_distributed::apply_hopping<coeff_t>(cpl, op, basis_in,
                                                    vec_in_trans, vec_out_trans);
     } else if ((type == "Cdagup") || (type == "Cup")) {
+      profile::Scope scope("ElectronDistributed", type);
       electron_distributed::apply_raise_lower<coeff_t>(
           cpl, op, basis_in, vec_in_trans, basis_out, vec_out_trans);
     } else if ((type == "SzSz") || (type == "Exchange") || (type == "Hopdn") ||
@@ -109,7 +124,10 @@ void apply_terms(OpSum const &ops, basis_t const &basis_in,
 
   // Finally we transpose back to send_buffer ...
   time_start = MPI_Wtime();
-  basis_out.transpose_r(vec_out_trans);
+  {
+    profile::Scope scope("ElectronDistributed", "transpose");
+    basis_out.transpose_r(vec_out_trans);
+  }
   time_end = MPI_Wtime();
   Log(3, "  transpose r : {:.6f} secs", time_end - time_start);
 
@@ -117,7 +135,9 @@ void apply_terms(OpSum const &ops, basis_t const &basis_in,
   coeff_t *send = mpi::buffer.send<coeff_t>();
 
   time_start = MPI_Wtime();
-  for (int64_t i = 0; i < basis_out.size(); ++i) {
+  int64_t size_out = basis_out.size();
+#pragma omp parallel for schedule(static)
+  for (int64_t i = 0; i < size_out; ++i) {
     vec_out[i] += send[i];
   }
   time_end = MPI_Wtime();
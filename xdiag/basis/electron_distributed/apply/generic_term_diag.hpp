@@ -13,9 +13,16 @@ void generic_term_diag(basis_t const &basis, term_action_f term_action,
                        const coeff_t *vec_in, coeff_t *vec_out) {
   using bit_t = typename basis_t::bit_t;
 
-  int64_t idx = 0;
-  for (bit_t up : basis.my_ups()) {
-    for (bit_t dn : basis.all_dns()) {
+  auto const &ups = basis.my_ups();
+  auto const &dns = basis.all_dns();
+  int64_t n_ups = ups.size();
+  int64_t n_dns = dns.size();
+
+#pragma omp parallel for schedule(guided)
+  for (int64_t idx_up = 0; idx_up < n_ups; ++idx_up) {
+    bit_t up = ups[idx_up];
+    int64_t idx = idx_up * n_dns;
+    for (bit_t dn : dns) {
       coeff_t val = term_action(up, dn);
       vec_out[idx] += val * vec_in[idx];
       ++idx;
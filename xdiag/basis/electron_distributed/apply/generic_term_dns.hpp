@@ -33,8 +33,12 @@ void generic_term_dns(basis_t const &basis_in, basis_t const &basis_out,
   int64_t ndn_configurations_out = combinatorics::binomial(nsites, ndn_out);
 
   // Loop over all configurations
-  int64_t idx_up = 0;
-  for (bit_t up : basis_in.my_ups()) {
+  auto const &ups = basis_in.my_ups();
+  int64_t n_ups = ups.size();
+
+#pragma omp parallel for schedule(guided)
+  for (int64_t idx_up = 0; idx_up < n_ups; ++idx_up) {
+    bit_t up = ups[idx_up];
 
     if (non_zero_term_ups(up)) {
       int64_t up_offset_in = idx_up * ndn_configurations_in;
@@ -59,7 +63,6 @@ void generic_term_dns(basis_t const &basis_in, basis_t const &basis_out,
         ++idx_in;
       }
     } // non-zero-term ups
-    ++idx_up;
   }
 }
 
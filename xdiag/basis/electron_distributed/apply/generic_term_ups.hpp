@@ -33,8 +33,12 @@ void generic_term_ups(basis_t const &basis_in, basis_t const &basis_out,
   int64_t nup_configurations_out = combinatorics::binomial(nsites, nup_out);
 
   // Loop over all configurations
-  int64_t idx_dn = 0;
-  for (bit_t dn : basis_in.my_dns()) {
+  auto const &dns = basis_in.my_dns();
+  int64_t n_dns = dns.size();
+
+#pragma omp parallel for schedule(guided)
+  for (int64_t idx_dn = 0; idx_dn < n_dns; ++idx_dn) {
+    bit_t dn = dns[idx_dn];
 
     if (non_zero_term_dns(dn)) {
       int64_t dn_offset_in = idx_dn * nup_configurations_in;
@@ -57,7 +61,6 @@ void generic_term_ups(basis_t const &basis_in, basis_t const &basis_out,
       } // for (bit_t up : basis_in.all_ups())
     } // non-zero-term ups
 
-    ++idx_dn;
   } // for (bit_t dn : basis_in.my_dns())
 }
 
@@ -12,7 +12,7 @@
 #include <xdiag/common.hpp>
 #include <xdiag/extern/gsl/span>
 #include <xdiag/parallel/mpi/communicator.hpp>
-#include <xdiag/random/hash_functions.hpp>
+#include <xdiag/parallel/mpi/partition.hpp>
 
 namespace xdiag::basis::electron_distributed {
 
@@ -24,10 +24,12 @@ public:
   using iterator_t = BasisNpIterator<bit_t>;
 
   BasisNp() = default;
-  BasisNp(int64_t nsites, int64_t nup, int64_t ndn);
+  BasisNp(int64_t nsites, int64_t nup, int64_t ndn,
+          std::string partition = "hash");
 
   int64_t nsites() const;
   int64_t nup() const;
+  std::string partition() const;
   int64_t ndn() const;
   // static constexpr bool np_conserved() { return true; }
 
@@ -59,6 +61,7 @@ private:
 
   int mpi_rank_;
   int mpi_size_;
+  mpi::Partition<bit_t> partition_;
   bit_t sitesmask_;
 
   mpi::Communicator transpose_communicator_;
@@ -84,7 +87,7 @@ public:
   std::vector<bit_t> const &all_ups() const;
 
   inline int rank(bit_t spins) const { // mpi ranks are ints
-    return (int)(random::hash_div3(spins) % mpi_size_);
+    return partition_.rank(spins);
   };
   inline int64_t index_dns(bit_t dns) const { return lintable_dns_.index(dns); }
   inline int64_t index_ups(bit_t ups) const { return lintable_ups_.index(ups); }
@@ -0,0 +1,208 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "spinflip_projection.hpp"
+
+#include <xdiag/basis/electron/basis_symmetric_np.hpp>
+#include <xdiag/basis/tj/basis_symmetric_np.hpp>
+#include <xdiag/bits/popcnt.hpp>
+
+namespace xdiag::basis {
+
+template <class basis_t> struct is_electron_basis : std::false_type {};
+template <typename bit_t>
+struct is_electron_basis<electron::BasisSymmetricNp<bit_t>> : std::true_type {
+};
+
+// Images F|a> = phi_a |b> of every state a of the symmetric basis under the
+// spin flip (particlehole = false) or the particle-hole transformation
+template <class basis_t>
+static std::pair<std::vector<int64_t>, std::vector<complex>>
+images(basis_t const &basis, bool particlehole,
+       std::vector<int64_t> const &bipartition) try {
+  using bit_t = typename basis_t::bit_t;
+  int64_t nsites = basis.nsites();
+  bit_t mask = ((bit_t)1 << nsites) - 1;
+
+  // Annihilating the particles of c^dag_ups c^dag_dns from the fully occupied
+  // state yields the sign (-1)^i e_i for every occupied site i
+  bit_t signmask = 0;
+  for (int64_t i = 0; i < (int64_t)bipartition.size(); ++i) {
+    if ((bipartition[i] == 1) != (bool)(i & 1)) {
+      signmask |= (bit_t)1 << i;
+    }
+  }
+
+  // Exchanging the up and dn creation operators in c^dag_ups c^dag_dns
+  complex sign_flip = ((basis.nup() * basis.ndn()) & 1) ? -1.0 : 1.0;
+  auto characters = basis.irrep().characters().template as<arma::cx_vec>();
+
+  std::vector<int64_t> image(basis.size());
+  std::vector<complex> phase(basis.size());
+  int64_t idx = 0;
+  for (auto [ups, dns] : basis) {
+    int64_t idx_image;
+    int64_t sym;
+    bool fermi;
+    complex sign;
+    if (particlehole) {
+      std::tie(idx_image, sym, fermi) =
+          basis.index_sym_fermi(~ups & mask, ~dns & mask);
+      sign = ((bits::popcnt(ups & signmask) + bits::popcnt(dns & signmask)) &
+              1)
+                 ? -1.0
+                 : 1.0;
+    } else {
+      std::tie(idx_image, sym, fermi) = basis.index_sym_fermi(dns, ups);
+      sign = sign_flip;
+    }
+    if (idx_image == invalid_index) {
+      XDIAG_THROW(fmt::format("{} representative not found in basis",
+                              particlehole ? "Particle-hole transformed"
+                                           : "Spin flipped"));
+    }
+    image[idx] = idx_image;
+    phase[idx] = fermi ? -sign * characters(sym) : sign * characters(sym);
+    ++idx;
+  }
+  return {image, phase};
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <class basis_t>
+SpinflipProjection::SpinflipProjection(
+    basis_t const &basis, int64_t spinflip, int64_t particlehole,
+    std::vector<int64_t> const &bipartition) try
+    : spinflip_(spinflip), particlehole_(particlehole), size_(0),
+      index_(basis.size(), invalid_index), primary_(basis.size(), 0) {
+  if ((spinflip != 0) && (spinflip != 1) && (spinflip != -1)) {
+    XDIAG_THROW(fmt::format(
+        "Invalid spin flip parity: {}. Must be either +1 or -1", spinflip));
+  } else if ((spinflip != 0) && (basis.nup() != basis.ndn())) {
+    XDIAG_THROW("Spin flip symmetry requires nup == ndn");
+  } else if ((particlehole != 0) && (particlehole != 1) &&
+             (particlehole != -1)) {
+    XDIAG_THROW(fmt::format("Invalid particle-hole parity: {}. Must be either "
+                            "+1 or -1",
+                            particlehole));
+  } else if ((particlehole != 0) && !is_electron_basis<basis_t>::value) {
+    XDIAG_THROW("Particle-hole symmetry is only defined for Electron bases");
+  } else if ((particlehole != 0) &&
+             ((2 * basis.nup() != basis.nsites()) ||
+              (2 * basis.ndn() != basis.nsites()))) {
+    XDIAG_THROW("Particle-hole symmetry requires nup == ndn == nsites / 2");
+  } else if ((particlehole != 0) &&
+             ((int64_t)bipartition.size() != basis.nsites())) {
+    XDIAG_THROW("Size of bipartition does not match nsites");
+  }
+
+  bool real = basis.irrep().isreal();
+  if (real) {
+    coeffs_.resize(basis.size(), 0.);
+  } else {
+    coeffsC_.resize(basis.size(), 0.);
+  }
+
+  std::vector<int64_t> image_f, image_p;
+  std::vector<complex> phase_f, phase_p;
+  if (spinflip != 0) {
+    std::tie(image_f, phase_f) = images(basis, false, bipartition);
+  }
+  if (particlehole != 0) {
+    std::tie(image_p, phase_p) = images(basis, true, bipartition);
+  }
+
+  // The unnormalized projection sum_h z(h) h|a> over the group generated by
+  // F and P, collected as (index, coefficient) of the symmetric states
+  std::vector<uint8_t> visited(basis.size(), 0);
+  std::vector<std::pair<int64_t, complex>> terms;
+  auto add = [&terms](int64_t idx, complex coeff) {
+    for (auto &term : terms) {
+      if (term.first == idx) {
+        term.second += coeff;
+        return;
+      }
+    }
+    terms.push_back({idx, coeff});
+  };
+
+  for (int64_t idx = 0; idx < (int64_t)basis.size(); ++idx) {
+    if (visited[idx]) {
+      continue;
+    }
+    terms.clear();
+    add(idx, 1.0);
+    if (spinflip != 0) {
+      add(image_f[idx], (double)spinflip * phase_f[idx]);
+    }
+    if (particlehole != 0) {
+      add(image_p[idx], (double)particlehole * phase_p[idx]);
+    }
+    if ((spinflip != 0) && (particlehole != 0)) {
+      int64_t idx_pf = image_p[image_f[idx]];
+      complex phase_pf = phase_f[idx] * phase_p[image_f[idx]];
+      int64_t idx_fp = image_f[image_p[idx]];
+      complex phase_fp = phase_p[idx] * phase_f[image_p[idx]];
+      if ((idx_pf != idx_fp) || (std::abs(phase_pf - phase_fp) > 1e-8)) {
+        XDIAG_THROW("Spin flip and particle-hole transformation do not "
+                    "commute on the symmetric basis");
+      }
+      add(idx_pf, (double)(spinflip * particlehole) * phase_pf);
+    }
+
+    double norm = 0.;
+    for (auto const &[idx_term, coeff] : terms) {
+      visited[idx_term] = 1;
+      norm += std::norm(coeff);
+    }
+    norm = std::sqrt(norm);
+    if (norm < 1e-8) {
+      continue;
+    }
+
+    primary_[idx] = 1;
+    for (auto const &[idx_term, coeff] : terms) {
+      index_[idx_term] = size_;
+      if (real) {
+        coeffs_[idx_term] = coeff.real() / norm;
+      } else {
+        coeffsC_[idx_term] = coeff / norm;
+      }
+    }
+    ++size_;
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+int64_t SpinflipProjection::spinflip() const { return spinflip_; }
+int64_t SpinflipProjection::particlehole() const { return particlehole_; }
+int64_t SpinflipProjection::size() const { return size_; }
+int64_t SpinflipProjection::size_unprojected() const { return index_.size(); }
+
+bool SpinflipProjection::operator==(SpinflipProjection const &rhs) const {
+  return (spinflip_ == rhs.spinflip_) &&
+         (particlehole_ == rhs.particlehole_) && (size_ == rhs.size_) &&
+         (index_ == rhs.index_) && (coeffs_ == rhs.coeffs_) &&
+         (coeffsC_ == rhs.coeffsC_);
+}
+bool SpinflipProjection::operator!=(SpinflipProjection const &rhs) const {
+  return !operator==(rhs);
+}
+
+template SpinflipProjection::SpinflipProjection(
+    electron::BasisSymmetricNp<uint32_t> const &, int64_t, int64_t,
+    std::vector<int64_t> const &);
+template SpinflipProjection::SpinflipProjection(
+    electron::BasisSymmetricNp<uint64_t> const &, int64_t, int64_t,
+    std::vector<int64_t> const &);
+template SpinflipProjection::SpinflipProjection(
+    tj::BasisSymmetricNp<uint32_t> const &, int64_t, int64_t,
+    std::vector<int64_t> const &);
+template SpinflipProjection::SpinflipProjection(
+    tj::BasisSymmetricNp<uint64_t> const &, int64_t, int64_t,
+    std::vector<int64_t> const &);
+
+} // namespace xdiag::basis
@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <type_traits>
+#include <vector>
+
+#include <xdiag/common.hpp>
+
+namespace xdiag::basis {
+
+// Projection of a symmetric electron basis onto the states with parity
+// z = +1 or -1 under the spin flip F exchanging c^dag_{i,up} and
+// c^dag_{i,dn}. Denoting by F|a> = phi_a |b> the action of the spin flip on
+// the symmetrized state |a>, the projected basis states are
+//
+//   |R> = (|a> + z phi_a |b>) / sqrt(2)   if a < b,
+//   |R> = |a>                             if a = b and z phi_a = 1.
+//
+// Electron bases at half filling can additionally be projected with the
+// particle-hole transformation P, c_{i,s} -> e_i c^dag_{i,s}, where e_i = +1
+// (-1) on the sites with label 0 (1) of a bipartition. The states |R> are
+// then obtained by applying the projector onto the parities of F and P to
+// the state |a>. Either of the parities can be 0, meaning no projection.
+//
+// Every state a of the symmetric basis is mapped to the index of R and its
+// coefficient in |R>. The state with the smallest index is called primary.
+class SpinflipProjection {
+public:
+  SpinflipProjection() = default;
+  template <class basis_t>
+  SpinflipProjection(basis_t const &basis, int64_t spinflip,
+                     int64_t particlehole = 0,
+                     std::vector<int64_t> const &bipartition = {});
+
+  int64_t spinflip() const;
+  int64_t particlehole() const;
+  int64_t size() const;
+  int64_t size_unprojected() const;
+
+  // index of the projected state containing the state idx of the symmetric
+  // basis, invalid_index if it is annihilated by the projection
+  inline int64_t index(int64_t idx) const { return index_[idx]; }
+  inline bool primary(int64_t idx) const { return primary_[idx]; }
+
+  template <typename coeff_t> inline coeff_t coeff(int64_t idx) const {
+    if constexpr (std::is_same<coeff_t, double>::value) {
+      return coeffs_.empty() ? coeffsC_[idx].real() : coeffs_[idx];
+    } else {
+      return coeffs_.empty() ? coeffsC_[idx] : (coeff_t)coeffs_[idx];
+    }
+  }
+
+  bool operator==(SpinflipProjection const &rhs) const;
+  bool operator!=(SpinflipProjection const &rhs) const;
+
+private:
+  int64_t spinflip_ = 0;
+  int64_t particlehole_ = 0;
+  int64_t size_ = 0;
+  std::vector<int64_t> index_;
+  std::vector<uint8_t> primary_;
+  std::vector<double> coeffs_;
+  std::vector<complex> coeffsC_;
+};
+
+// Turns a fill function for the projected bases into a fill function for the
+// matrix elements of the symmetric bases. For an operator H with F H F = p H
+// (likewise for P) and z_out = p z_in one finds <R'|H|R> = <R'|H|a> / c_a,
+// such that only the primary ingoing states a contribute. Hence, every
+// ingoing projected state is filled from a single state, which keeps matrix
+// fills free of data races.
+template <typename coeff_t, class fill_f> class ProjectedFill {
+public:
+  ProjectedFill(SpinflipProjection const &projection_in,
+                SpinflipProjection const &projection_out, fill_f &fill)
+      : projection_in_(projection_in), projection_out_(projection_out),
+        fill_(fill) {}
+
+  inline bool contributes(int64_t idx_in) const {
+    return projection_in_.primary(idx_in);
+  }
+
+  inline void operator()(int64_t idx_in, int64_t idx_out, coeff_t val) const {
+    int64_t idx_out_projected = projection_out_.index(idx_out);
+    if (projection_in_.primary(idx_in) &&
+        (idx_out_projected != invalid_index)) {
+      int64_t idx_in_projected = projection_in_.index(idx_in);
+      double c_in = projection_in_.coeff<double>(idx_in);
+      coeff_t c_out = projection_out_.coeff<coeff_t>(idx_out);
+      if constexpr (std::is_same<coeff_t, double>::value) {
+        fill_(idx_in_projected, idx_out_projected, c_out * val / c_in);
+      } else {
+        fill_(idx_in_projected, idx_out_projected,
+              std::conj(c_out) * val / c_in);
+      }
+    }
+  }
+
+private:
+  SpinflipProjection const &projection_in_;
+  SpinflipProjection const &projection_out_;
+  fill_f &fill_;
+};
+
+template <typename coeff_t, class fill_f>
+inline ProjectedFill<coeff_t, fill_f>
+projected_fill(SpinflipProjection const &projection_in,
+               SpinflipProjection const &projection_out, fill_f &fill) {
+  return ProjectedFill<coeff_t, fill_f>(projection_in, projection_out, fill);
+}
+
+// Whether the ingoing state idx_in of a symmetric basis contributes to the
+// matrix elements collected by fill. The kernels of the off-diagonal terms
+// skip all other states before looking up the outgoing states, such that
+// only the primary states of a spin flip projection are visited.
+template <class fill_f> inline bool contributes(fill_f const &, int64_t) {
+  return true;
+}
+
+template <typename coeff_t, class fill_f>
+inline bool contributes(ProjectedFill<coeff_t, fill_f> const &fill,
+                        int64_t idx_in) {
+  return fill.contributes(idx_in);
+}
+
+} // namespace xdiag::basis
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <xdiag/algebra/fill.hpp>
 #include <xdiag/common.hpp>
 
 #ifdef _OPENMP
@@ -24,22 +25,32 @@ void apply_term_diag(basis_t const &basis, term_coeff_f term_coeff,
                      fill_f fill) {
   using bit_t = typename basis_t::bit_t;
 
+  if constexpr (is_sparse_fill_v<fill_f>) {
+    auto const &indices_in = fill.indices_in();
+    for (int64_t pos = 0; pos < (int64_t)indices_in.size(); ++pos) {
+      int64_t idx = indices_in[pos];
+      bit_t spins = basis.state(idx);
+      apply_term_diag_to_spins<bit_t, coeff_t>(spins, idx, term_coeff,
+                                               fill.at(pos));
+    }
+  } else {
 #ifdef _OPENMP
-  int64_t size = basis.size();
+    int64_t size = basis.size();
 
 #pragma omp parallel for schedule(guided)
-  for (int64_t idx = 0; idx < size; ++idx) {
-    bit_t spins = basis.state(idx);
-    apply_term_diag_to_spins<bit_t, coeff_t>(spins, idx, term_coeff, fill);
-  }
+    for (int64_t idx = 0; idx < size; ++idx) {
+      bit_t spins = basis.state(idx);
+      apply_term_diag_to_spins<bit_t, coeff_t>(spins, idx, term_coeff, fill);
+    }
 
 #else
-  int64_t idx = 0;
-  for (auto spins : basis) {
-    apply_term_diag_to_spins<bit_t, coeff_t>(spins, idx, term_coeff, fill);
-    ++idx;
-  }
+    int64_t idx = 0;
+    for (auto spins : basis) {
+      apply_term_diag_to_spins<bit_t, coeff_t>(spins, idx, term_coeff, fill);
+      ++idx;
+    }
 #endif
+  }
 }
 
 } // namespace xdiag::basis::spinhalf
@@ -4,7 +4,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+
+#include <xdiag/algebra/fill.hpp>
 #include <xdiag/common.hpp>
+#include <xdiag/utils/prefetch.hpp>
 #ifdef _OPENMP
 #include <xdiag/parallel/omp/omp_utils.hpp>
 #endif
@@ -25,6 +30,54 @@ void apply_term_offdiag_no_sym_to_spins(bit_t spins_in, int64_t idx_in,
   }
 }
 
+template <class basis_t, class = void>
+struct has_prefetch_index : std::false_type {};
+template <class basis_t>
+struct has_prefetch_index<
+    basis_t,
+    std::void_t<decltype(std::declval<basis_t const &>().prefetch_index(
+        std::declval<typename basis_t::bit_t>()))>> : std::true_type {};
+
+// Applies the term to the input states idx_begin <= idx_in < idx_end in
+// stages. First, all output configurations of the tile are computed and the
+// entries of the index tables prefetched. Second, the indices are resolved
+// and the output coefficients prefetched. Third, the matrix elements are
+// filled, such that the independent memory accesses of a tile can overlap.
+template <typename bit_t, typename coeff_t, class basis_t,
+          class non_zero_term_f, class term_action_f, class fill_f>
+void apply_term_offdiag_no_sym_tile(int64_t idx_begin, int64_t idx_end,
+                                    basis_t const &basis_in,
+                                    basis_t const &basis_out,
+                                    non_zero_term_f non_zero_term,
+                                    term_action_f term_action, fill_f fill) {
+  int64_t idxs_in[prefetch_tile_size];
+  bit_t spins_out[prefetch_tile_size];
+  coeff_t coeffs[prefetch_tile_size];
+  int64_t idxs_out[prefetch_tile_size];
+
+  int64_t n = 0;
+  for (int64_t idx_in = idx_begin; idx_in < idx_end; ++idx_in) {
+    bit_t spins_in = basis_in.state(idx_in);
+    if (non_zero_term(spins_in)) {
+      auto [spins, coeff] = term_action(spins_in);
+      if constexpr (has_prefetch_index<basis_t>::value) {
+        basis_out.prefetch_index(spins);
+      }
+      idxs_in[n] = idx_in;
+      spins_out[n] = spins;
+      coeffs[n] = coeff;
+      ++n;
+    }
+  }
+  for (int64_t i = 0; i < n; ++i) {
+    idxs_out[i] = basis_out.index(spins_out[i]);
+    prefetch_fill(fill, idxs_out[i]);
+  }
+  for (int64_t i = 0; i < n; ++i) {
+    fill(idxs_in[i], idxs_out[i], coeffs[i]);
+  }
+}
+
 template <typename coeff_t, class basis_t, class non_zero_term_f,
           class term_action_f, class fill_f>
 void apply_term_offdiag_no_sym(basis_t const &basis_in,
@@ -33,24 +86,30 @@ void apply_term_offdiag_no_sym(basis_t const &basis_in,
                                term_action_f term_action, fill_f fill) {
   using bit_t = typename basis_t::bit_t;
 
-#ifdef _OPENMP
-  int64_t size = basis_in.size();
+  if constexpr (is_sparse_fill_v<fill_f>) {
+    auto const &indices_in = fill.indices_in();
+    for (int64_t pos = 0; pos < (int64_t)indices_in.size(); ++pos) {
+      int64_t idx_in = indices_in[pos];
+      bit_t spins_in = basis_in.state(idx_in);
+      apply_term_offdiag_no_sym_to_spins<coeff_t>(spins_in, idx_in, basis_out,
+                                                  non_zero_term, term_action,
+                                                  fill.at(pos));
+    }
+  } else {
+    int64_t size = basis_in.size();
+    int64_t ntiles = (size + prefetch_tile_size - 1) / prefetch_tile_size;
 
+#ifdef _OPENMP
 #pragma omp parallel for schedule(guided)
-  for (int64_t idx_in = 0; idx_in < size; ++idx_in) {
-    bit_t spins_in = basis_in.state(idx_in);
-    apply_term_offdiag_no_sym_to_spins<coeff_t>(
-        spins_in, idx_in, basis_out, non_zero_term, term_action, fill);
-  }
-
-#else
-  int64_t idx_in = 0;
-  for (auto spins_in : basis_in) {
-    apply_term_offdiag_no_sym_to_spins<coeff_t>(
-        spins_in, idx_in, basis_out, non_zero_term, term_action, fill);
-    ++idx_in;
-  }
 #endif
+    for (int64_t tile = 0; tile < ntiles; ++tile) {
+      int64_t idx_begin = tile * prefetch_tile_size;
+      int64_t idx_end = std::min(idx_begin + prefetch_tile_size, size);
+      apply_term_offdiag_no_sym_tile<bit_t, coeff_t>(
+          idx_begin, idx_end, basis_in, basis_out, non_zero_term, term_action,
+          fill);
+    }
+  }
 }
 
 } // namespace xdiag::basis::spinhalf
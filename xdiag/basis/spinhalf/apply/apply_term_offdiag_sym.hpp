@@ -4,7 +4,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+
+#include <xdiag/algebra/fill.hpp>
 #include <xdiag/common.hpp>
+#include <xdiag/utils/prefetch.hpp>
+#include <xdiag/utils/profile.hpp>
 #ifdef _OPENMP
 #include <xdiag/parallel/omp/omp_utils.hpp>
 #endif
@@ -30,6 +36,87 @@ void apply_term_offdiag_sym_to_spins(bit_t spins_in, int64_t idx_in,
       coeff_t bloch = characters(sym);
       coeff_t val = coeff * bloch * norm_out / norm_in;
       fill(idx_in, idx_out, val);
+    } else {
+      profile::count_invalid();
+    }
+  }
+}
+
+template <class basis_t, class = void>
+struct has_prefetch_index_sym : std::false_type {};
+template <class basis_t>
+struct has_prefetch_index_sym<
+    basis_t,
+    std::void_t<decltype(std::declval<basis_t const &>().prefetch_index_sym(
+        std::declval<typename basis_t::bit_t>()))>> : std::true_type {};
+
+template <class basis_t, class = void>
+struct has_prefetch_norm : std::false_type {};
+template <class basis_t>
+struct has_prefetch_norm<
+    basis_t,
+    std::void_t<decltype(std::declval<basis_t const &>().prefetch_norm(
+        std::declval<int64_t>()))>> : std::true_type {};
+
+// Applies the term to the input states idx_begin <= idx_in < idx_end in
+// three stages. First, all output configurations are computed and the table
+// entries needed to find their representatives are prefetched, if the basis
+// looks them up in tables. Second, the indices are resolved and the norms
+// and output coefficients prefetched. Third, the matrix elements are filled.
+// Thereby, the random accesses of a whole tile are in flight simultaneously
+// instead of one at a time.
+template <typename bit_t, typename coeff_t, class basis_t,
+          class non_zero_term_f, class term_action_f, class fill_f>
+void apply_term_offdiag_sym_tile(int64_t idx_begin, int64_t idx_end,
+                                 arma::Col<coeff_t> const &characters,
+                                 basis_t const &basis_in,
+                                 basis_t const &basis_out,
+                                 non_zero_term_f non_zero_term,
+                                 term_action_f term_action, fill_f fill) {
+  int64_t idxs_in[prefetch_tile_size];
+  bit_t spins_out[prefetch_tile_size];
+  coeff_t coeffs[prefetch_tile_size];
+  int64_t idxs_out[prefetch_tile_size];
+  int64_t syms[prefetch_tile_size];
+
+  int64_t n = 0;
+  for (int64_t idx_in = idx_begin; idx_in < idx_end; ++idx_in) {
+    bit_t spins_in = basis_in.state(idx_in);
+    if (non_zero_term(spins_in)) {
+      auto [spins, coeff] = term_action(spins_in);
+      if constexpr (has_prefetch_index_sym<basis_t>::value) {
+        basis_out.prefetch_index_sym(spins);
+      }
+      idxs_in[n] = idx_in;
+      spins_out[n] = spins;
+      coeffs[n] = coeff;
+      ++n;
+    }
+  }
+
+  for (int64_t i = 0; i < n; ++i) {
+    auto [idx_out, sym] = basis_out.index_sym(spins_out[i]);
+    if (idx_out != invalid_index) {
+      if constexpr (has_prefetch_norm<basis_t>::value) {
+        basis_out.prefetch_norm(idx_out);
+      }
+      prefetch_fill(fill, idx_out);
+    }
+    idxs_out[i] = idx_out;
+    syms[i] = sym;
+  }
+
+  for (int64_t i = 0; i < n; ++i) {
+    int64_t idx_out = idxs_out[i];
+    if (idx_out != invalid_index) {
+      int64_t idx_in = idxs_in[i];
+      double norm_out = basis_out.norm(idx_out);
+      double norm_in = basis_in.norm(idx_in);
+      coeff_t bloch = characters(syms[i]);
+      coeff_t val = coeffs[i] * bloch * norm_out / norm_in;
+      fill(idx_in, idx_out, val);
+    } else {
+      profile::count_invalid();
     }
   }
 }
@@ -41,30 +128,33 @@ void apply_term_offdiag_sym(basis_t const &basis_in, basis_t const &basis_out,
                             term_action_f term_action, fill_f fill) {
   using bit_t = typename basis_t::bit_t;
 
-  Representation irrep_out = basis_out.irrep();
-  auto characters = irrep_out.characters().as<arma::Col<coeff_t>>();
+  Vector const &characters_out = basis_out.characters();
+  auto characters = characters_out.as<arma::Col<coeff_t>>();
 
-#ifdef _OPENMP
-  int64_t size = basis_in.size();
+  if constexpr (is_sparse_fill_v<fill_f>) {
+    auto const &indices_in = fill.indices_in();
+    for (int64_t pos = 0; pos < (int64_t)indices_in.size(); ++pos) {
+      int64_t idx_in = indices_in[pos];
+      bit_t spins_in = basis_in.state(idx_in);
+      apply_term_offdiag_sym_to_spins(spins_in, idx_in, characters, basis_in,
+                                      basis_out, non_zero_term, term_action,
+                                      fill.at(pos));
+    }
+  } else {
+    int64_t size = basis_in.size();
+    int64_t ntiles = (size + prefetch_tile_size - 1) / prefetch_tile_size;
 
+#ifdef _OPENMP
 #pragma omp parallel for schedule(guided)
-  for (int64_t idx_in = 0; idx_in < size; ++idx_in) {
-    bit_t spins_in = basis_in.state(idx_in);
-    apply_term_offdiag_sym_to_spins(spins_in, idx_in, characters, basis_in,
-                                    basis_out, non_zero_term, term_action,
-                                    fill);
-  }
-
-#else
-  // Run through all states and apply term
-  int64_t idx_in = 0;
-  for (auto spins_in : basis_in) {
-    apply_term_offdiag_sym_to_spins(spins_in, idx_in, characters, basis_in,
-                                    basis_out, non_zero_term, term_action,
-                                    fill);
-    ++idx_in;
-  }
 #endif
+    for (int64_t tile = 0; tile < ntiles; ++tile) {
+      int64_t idx_begin = tile * prefetch_tile_size;
+      int64_t idx_end = std::min(idx_begin + prefetch_tile_size, size);
+      apply_term_offdiag_sym_tile<bit_t>(idx_begin, idx_end, characters,
+                                         basis_in, basis_out, non_zero_term,
+                                         term_action, fill);
+    }
+  }
 }
 
 } // namespace xdiag::basis::spinhalf
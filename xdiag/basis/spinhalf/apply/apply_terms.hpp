@@ -13,6 +13,7 @@
 #include <xdiag/basis/spinhalf/apply/apply_szsz.hpp>
 
 #include <xdiag/common.hpp>
+#include <xdiag/utils/profile.hpp>
 #include <xdiag/utils/timing.hpp>
 
 namespace xdiag::basis::spinhalf {
@@ -22,6 +23,7 @@ void apply_terms(OpSum const &ops, basis_t const &basis_in,
                  basis_t const &basis_out, fill_f fill) try {
   for (auto const &[cpl, op] : ops.plain()) {
     std::string type = op.type();
+    profile::Scope scope("Spinhalf", type);
     if (type == "Id") {
       apply_identity<coeff_t>(cpl, basis_in, fill);
     } else if (type == "Exchange") {
@@ -13,10 +13,9 @@ template <typename coeff_t>
 void dispatch_apply(OpSum const &ops, Spinhalf const &block_in,
                     arma::Col<coeff_t> const &vec_in, Spinhalf const &block_out,
                     arma::Col<coeff_t> &vec_out) try {
-  auto fill = [&](int64_t idx_in, int64_t idx_out, coeff_t val) {
-    return fill_apply(vec_in, vec_out, idx_in, idx_out, val);
-  };
-  spinhalf::dispatch<coeff_t>(ops, block_in, block_out, fill);
+  using kernel_coeff_t = apply_coeff_t<coeff_t>;
+  ApplyFill<coeff_t, kernel_coeff_t> fill(vec_in, vec_out);
+  spinhalf::dispatch<kernel_coeff_t>(ops, block_in, block_out, fill);
 } catch (Error const &error) {
   XDIAG_RETHROW(error);
 }
@@ -25,10 +24,11 @@ template <typename coeff_t>
 void dispatch_apply(OpSum const &ops, Spinhalf const &block_in,
                     arma::Mat<coeff_t> const &mat_in, Spinhalf const &block_out,
                     arma::Mat<coeff_t> &mat_out) try {
-  auto fill = [&](int64_t idx_in, int64_t idx_out, coeff_t val) {
+  using kernel_coeff_t = apply_coeff_t<coeff_t>;
+  auto fill = [&](int64_t idx_in, int64_t idx_out, kernel_coeff_t val) {
     return fill_apply(mat_in, mat_out, idx_in, idx_out, val);
   };
-  spinhalf::dispatch<coeff_t>(ops, block_in, block_out, fill);
+  spinhalf::dispatch<kernel_coeff_t>(ops, block_in, block_out, fill);
 } catch (Error const &error) {
   XDIAG_RETHROW(error);
 }
@@ -43,5 +43,40 @@ template void dispatch_apply(OpSum const &, Spinhalf const &, arma::mat const &,
 template void dispatch_apply(OpSum const &, Spinhalf const &,
                              arma::cx_mat const &, Spinhalf const &block,
                              arma::cx_mat &);
+template void dispatch_apply(OpSum const &, Spinhalf const &,
+                             arma::fvec const &, Spinhalf const &block,
+                             arma::fvec &);
+template void dispatch_apply(OpSum const &, Spinhalf const &,
+                             arma::cx_fvec const &, Spinhalf const &block,
+                             arma::cx_fvec &);
+template void dispatch_apply(OpSum const &, Spinhalf const &,
+                             arma::fmat const &, Spinhalf const &block,
+                             arma::fmat &);
+template void dispatch_apply(OpSum const &, Spinhalf const &,
+                             arma::cx_fmat const &, Spinhalf const &block,
+                             arma::cx_fmat &);
+
+template <typename coeff_t>
+void dispatch_apply_sparse(
+    OpSum const &ops, Spinhalf const &block_in,
+    std::vector<int64_t> const &indices_in,
+    std::vector<coeff_t> const &values_in, Spinhalf const &block_out,
+    std::unordered_map<int64_t, coeff_t> &values_out) try {
+  SparseFill<coeff_t> fill(indices_in, values_in, values_out);
+  spinhalf::dispatch<coeff_t>(ops, block_in, block_out, fill);
+} catch (Error const &error) {
+  XDIAG_RETHROW(error);
+}
+
+template void dispatch_apply_sparse(OpSum const &, Spinhalf const &,
+                                    std::vector<int64_t> const &,
+                                    std::vector<double> const &,
+                                    Spinhalf const &,
+                                    std::unordered_map<int64_t, double> &);
+template void dispatch_apply_sparse(OpSum const &, Spinhalf const &,
+                                    std::vector<int64_t> const &,
+                                    std::vector<complex> const &,
+                                    Spinhalf const &,
+                                    std::unordered_map<int64_t, complex> &);
 
 } // namespace xdiag::basis
@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <vector>
+
 #include <xdiag/blocks/spinhalf.hpp>
 #include <xdiag/operators/opsum.hpp>
 
@@ -19,4 +22,13 @@ void dispatch_apply(OpSum const &ops, Spinhalf const &block_in,
                     arma::Mat<coeff_t> const &mat_in, Spinhalf const &block_out,
                     arma::Mat<coeff_t> &mat_out);
 
+// Applies to a sparse vector given by its sorted nonzero indices and values,
+// where only the nonzero input coefficients are visited
+template <typename coeff_t>
+void dispatch_apply_sparse(OpSum const &ops, Spinhalf const &block_in,
+                           std::vector<int64_t> const &indices_in,
+                           std::vector<coeff_t> const &values_in,
+                           Spinhalf const &block_out,
+                           std::unordered_map<int64_t, coeff_t> &values_out);
+
 } // namespace xdiag::basis
@@ -41,9 +41,11 @@ using BasisSpinhalfIterator = std::variant<
   combinatorics::SubsetsIterator<uint32_t>,
   combinatorics::CombinationsIterator<uint32_t>,
   typename std::vector<uint32_t>::const_iterator,
+  typename numa_vector<uint32_t>::const_iterator,
   combinatorics::SubsetsIterator<uint64_t>,
   combinatorics::CombinationsIterator<uint64_t>,
-  typename std::vector<uint64_t>::const_iterator>;
+  typename std::vector<uint64_t>::const_iterator,
+  typename numa_vector<uint64_t>::const_iterator>;
 // clang-format on
 
 int64_t dim(BasisSpinhalf const &basis);
@@ -6,12 +6,14 @@
 
 #include <xdiag/combinatorics/combinations.hpp>
 #include <xdiag/combinatorics/subsets.hpp>
+#include <xdiag/io/binary.hpp>
 
 #include <xdiag/symmetries/operations/group_action_operations.hpp>
 #include <xdiag/symmetries/operations/symmetry_operations.hpp>
 #include <xdiag/utils/logger.hpp>
 
 #include <algorithm>
+#include <numeric>
 
 #ifdef _OPENMP
 #include <xdiag/parallel/omp/omp_utils.hpp>
@@ -20,13 +22,13 @@
 namespace xdiag::basis::spinhalf {
 
 template <typename bit_t, typename coeff_t, int n_sublat>
-static std::pair<std::vector<bit_t>, std::vector<double>>
+static std::pair<numa_vector<bit_t>, numa_vector<double>>
 reps_norms_no_sz(GroupActionSublattice<bit_t, n_sublat> const &group_action,
                  arma::Col<coeff_t> const &characters) {
   using combinatorics::Subsets;
 
-  std::vector<bit_t> reps;
-  std::vector<double> norms;
+  numa_vector<bit_t> reps;
+  numa_vector<double> norms;
 
   int64_t nsites = group_action.nsites();
   int64_t nsites_sublat = nsites / n_sublat;
@@ -91,20 +93,51 @@ reps_norms_no_sz(GroupActionSublattice<bit_t, n_sublat> const &group_action,
   return {reps, norms};
 }
 
+// Norm of a symmetrized state, or zero if the state is not a representative.
+// With spin flip, a representative also needs to be minimal among the
+// flipped states and the characters contain the spin flipped symmetries.
 template <typename bit_t, typename coeff_t, int n_sublat>
-static std::pair<std::vector<bit_t>, std::vector<double>>
-reps_norms_sz(int64_t nup,
+static double norm_of_representative(
+    bit_t state, int64_t spinflip, bit_t flip_mask,
+    GroupActionSublattice<bit_t, n_sublat> const &group_action,
+    arma::Col<coeff_t> const &characters) {
+  if (group_action.representative(state) != state) {
+    return 0.;
+  } else if (spinflip == 0) {
+    return symmetries::norm(state, group_action, characters);
+  } else if (group_action.representative(state ^ flip_mask) < state) {
+    return 0.;
+  }
+
+  int64_t n_symmetries = group_action.n_symmetries();
+  coeff_t amplitude = 0.0;
+  for (int64_t sym = 0; sym < n_symmetries; ++sym) {
+    bit_t tstate = group_action.apply(sym, state);
+    if (tstate == state) {
+      amplitude += characters(sym);
+    }
+    if ((tstate ^ flip_mask) == state) {
+      amplitude += characters(n_symmetries + sym);
+    }
+  }
+  return std::sqrt(std::abs(amplitude));
+}
+
+template <typename bit_t, typename coeff_t, int n_sublat>
+static std::pair<numa_vector<bit_t>, numa_vector<double>>
+reps_norms_sz(int64_t nup, int64_t spinflip,
               GroupActionSublattice<bit_t, n_sublat> const &group_action,
               arma::Col<coeff_t> const &characters) {
 
   using bits::popcnt;
-  std::vector<bit_t> reps;
-  std::vector<double> norms;
+  numa_vector<bit_t> reps;
+  numa_vector<double> norms;
 
   int64_t nsites = group_action.nsites();
   int64_t nsites_sublat = nsites / n_sublat;
   int64_t n_leading = nsites_sublat;
   int64_t n_trailing = (n_sublat - 1) * nsites_sublat;
+  bit_t flip_mask = ((bit_t)1 << nsites) - 1;
 
   for (auto prefix : combinatorics::Subsets<bit_t>(n_leading)) {
 
@@ -125,13 +158,11 @@ reps_norms_sz(int64_t nup,
     for (auto postfix :
          combinatorics::Combinations<bit_t>(n_trailing, nup_postfix)) {
       bit_t state = (prefix << n_trailing) | postfix;
-      bit_t rep = group_action.representative(state);
-      if (state == rep) {
-        double norm = symmetries::norm(rep, group_action, characters);
-        if (std::abs(norm) > 1e-6) {
-          reps.push_back(rep);
-          norms.push_back(norm);
-        }
+      double norm = norm_of_representative(state, spinflip, flip_mask,
+                                           group_action, characters);
+      if (std::abs(norm) > 1e-6) {
+        reps.push_back(state);
+        norms.push_back(norm);
       }
     }
 
@@ -153,13 +184,11 @@ reps_norms_sz(int64_t nup,
       for (auto postfix :
            combinatorics::CombinationsThread<bit_t>(n_trailing, nup_postfix)) {
         bit_t state = (prefix << n_trailing) | postfix;
-        bit_t rep = group_action.representative(state);
-        if (state == rep) {
-          double norm = symmetries::norm(rep, group_action, characters);
-          if (std::abs(norm) > 1e-6) {
-            reps_thread[myid].push_back(rep);
-            norms_thread[myid].push_back(norm);
-          }
+        double norm = norm_of_representative(state, spinflip, flip_mask,
+                                             group_action, characters);
+        if (std::abs(norm) > 1e-6) {
+          reps_thread[myid].push_back(state);
+          norms_thread[myid].push_back(norm);
         }
       }
     } // pragma omp parallel
@@ -179,7 +208,7 @@ reps_norms_sz(int64_t nup,
 
 template <typename bit_t>
 ska::flat_hash_map<bit_t, gsl::span<bit_t const>>
-compute_rep_search_range_serial(std::vector<bit_t> const &reps,
+compute_rep_search_range_serial(numa_vector<bit_t> const &reps,
                                 int n_postfix_bits) {
   ska::flat_hash_map<bit_t, gsl::span<bit_t const>> rep_search_range;
 
@@ -207,7 +236,7 @@ compute_rep_search_range_serial(std::vector<bit_t> const &reps,
 #ifdef _OPENMP
 template <typename bit_t>
 ska::flat_hash_map<bit_t, gsl::span<bit_t const>>
-compute_rep_search_range_omp(std::vector<bit_t> const &reps,
+compute_rep_search_range_omp(numa_vector<bit_t> const &reps,
                              int64_t n_postfix_bits) {
   //// COMMENT: HAS A BUG DO NOT USE
 
@@ -275,12 +304,42 @@ compute_rep_search_range_omp(std::vector<bit_t> const &reps,
 } // namespace xdiag::basis::spinhalf
 #endif
 
+// Offsets of the representatives with equal leading bits. The number of
+// leading bits is chosen such that there are at most as many offsets as
+// representatives, which requires the representatives to be sorted.
+template <typename bit_t>
+std::pair<int64_t, numa_vector<int64_t>>
+compute_dense_offsets(numa_vector<bit_t> const &reps, int64_t nsites) try {
+  if (!std::is_sorted(reps.begin(), reps.end())) {
+    XDIAG_THROW("Representatives are not sorted, unable to create a dense "
+                "index of the representatives");
+  }
+  int64_t max_prefix_bits = std::min(nsites, maximum_dense_prefix_bits);
+  int64_t n_prefix_bits = std::min((int64_t)1, nsites);
+  while ((n_prefix_bits < max_prefix_bits) &&
+         (((int64_t)1 << (n_prefix_bits + 1)) <= (int64_t)reps.size())) {
+    ++n_prefix_bits;
+  }
+  int64_t shift = nsites - n_prefix_bits;
+  numa_vector<int64_t> offsets(((int64_t)1 << n_prefix_bits) + 1, 0);
+  for (auto rep : reps) {
+    ++offsets[(int64_t)(rep >> shift) + 1];
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  return {shift, offsets};
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+  return {0, numa_vector<int64_t>()};
+}
+
 template <typename bit_t, int n_sublat>
 BasisSublattice<bit_t, n_sublat>::BasisSublattice(
-    Representation const &irrep) try
+    Representation const &irrep, bool dense_index) try
     : nsites_(irrep.group().nsites()), nup_(undefined),
       n_postfix_bits_(nsites_ - std::min(maximum_prefix_bits, nsites_)),
-      group_action_(irrep.group()), irrep_(irrep) {
+      dense_index_(dense_index), spinflip_(0), spinflip_mask_(0),
+      irrep_(irrep), characters_(irrep.characters()),
+      group_action_(irrep.group()) {
   check_nsites_work_with_bits<bit_t>(nsites_);
 
   if (isreal(irrep)) {
@@ -291,46 +350,114 @@ BasisSublattice<bit_t, n_sublat>::BasisSublattice(
     std::tie(reps_, norms_) = reps_norms_no_sz(group_action_, characters);
   }
 
-  rep_search_range_ = compute_rep_search_range_serial(reps_, n_postfix_bits_);
+  init_index();
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
 
 template <typename bit_t, int n_sublat>
-BasisSublattice<bit_t, n_sublat>::BasisSublattice(
-    int64_t nup, Representation const &irrep) try
+BasisSublattice<bit_t, n_sublat>::BasisSublattice(int64_t nup,
+                                                  Representation const &irrep,
+                                                  bool dense_index,
+                                                  int64_t spinflip) try
     : nsites_(irrep.group().nsites()), nup_(nup),
       n_postfix_bits_(nsites_ - std::min(maximum_prefix_bits, nsites_)),
-      group_action_(irrep.group()), irrep_(irrep) {
+      dense_index_(dense_index), spinflip_(spinflip),
+      spinflip_mask_(((bit_t)1 << nsites_) - 1), irrep_(irrep),
+      characters_(spinflip == 0 ? irrep.characters()
+                                : characters_z2(irrep, spinflip)),
+      group_action_(irrep.group()) {
   check_nsites_work_with_bits<bit_t>(nsites_);
+  if ((spinflip != 0) && (2 * nup != nsites_)) {
+    XDIAG_THROW("Spin flip symmetry requires nup = nsites / 2");
+  }
 
-  if (isreal(irrep)) {
-    arma::vec characters = irrep.characters().as<arma::vec>();
-    std::tie(reps_, norms_) = reps_norms_sz(nup, group_action_, characters);
+  if (characters_.isreal()) {
+    arma::vec characters = characters_.as<arma::vec>();
+    std::tie(reps_, norms_) =
+        reps_norms_sz(nup, spinflip, group_action_, characters);
   } else {
-    arma::cx_vec characters = irrep.characters().as<arma::cx_vec>();
-    std::tie(reps_, norms_) = reps_norms_sz(nup, group_action_, characters);
+    arma::cx_vec characters = characters_.as<arma::cx_vec>();
+    std::tie(reps_, norms_) =
+        reps_norms_sz(nup, spinflip, group_action_, characters);
   }
 
-#ifdef _OPENMP
-  // omp version still has a bug, use serial (not so bad performance actually)
-  // rep_search_range_ = compute_rep_search_range_omp(reps_, n_postfix_bits_);
-  rep_search_range_ = compute_rep_search_range_serial(reps_, n_postfix_bits_);
-#else
-  rep_search_range_ = compute_rep_search_range_serial(reps_, n_postfix_bits_);
-#endif
+  init_index();
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <typename bit_t, int n_sublat>
+BasisSublattice<bit_t, n_sublat>::BasisSublattice(Representation const &irrep,
+                                                  bool dense_index,
+                                                  std::istream &in) try
+    : nsites_(irrep.group().nsites()), nup_(undefined),
+      n_postfix_bits_(nsites_ - std::min(maximum_prefix_bits, nsites_)),
+      dense_index_(dense_index), spinflip_(0), spinflip_mask_(0),
+      irrep_(irrep), characters_(irrep.characters()),
+      group_action_(irrep.group()) {
+  check_nsites_work_with_bits<bit_t>(nsites_);
+  io::read_binary(in, reps_);
+  io::read_binary(in, norms_);
+  init_index();
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <typename bit_t, int n_sublat>
+BasisSublattice<bit_t, n_sublat>::BasisSublattice(int64_t nup,
+                                                  Representation const &irrep,
+                                                  bool dense_index,
+                                                  int64_t spinflip,
+                                                  std::istream &in) try
+    : nsites_(irrep.group().nsites()), nup_(nup),
+      n_postfix_bits_(nsites_ - std::min(maximum_prefix_bits, nsites_)),
+      dense_index_(dense_index), spinflip_(spinflip),
+      spinflip_mask_(((bit_t)1 << nsites_) - 1), irrep_(irrep),
+      characters_(spinflip == 0 ? irrep.characters()
+                                : characters_z2(irrep, spinflip)),
+      group_action_(irrep.group()) {
+  check_nsites_work_with_bits<bit_t>(nsites_);
+  io::read_binary(in, reps_);
+  io::read_binary(in, norms_);
+  init_index();
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <typename bit_t, int n_sublat>
+void BasisSublattice<bit_t, n_sublat>::init_index() try {
+  if (dense_index_) {
+    std::tie(dense_prefix_shift_, dense_offsets_) =
+        compute_dense_offsets(reps_, nsites_);
+  } else {
+    // omp version still has a bug, use serial (not so bad performance
+    // actually)
+    rep_search_range_ =
+        compute_rep_search_range_serial(reps_, n_postfix_bits_);
+  }
+  Log(2, "Index of representatives of BasisSublattice ({}): {} bytes",
+      dense_index_ ? "dense" : "hash", index_memory());
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <typename bit_t, int n_sublat>
+void BasisSublattice<bit_t, n_sublat>::write(std::ostream &out) const try {
+  io::write_binary(out, reps_);
+  io::write_binary(out, norms_);
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
 
 template <typename bit_t, int n_sublat>
-typename std::vector<bit_t>::const_iterator
+typename numa_vector<bit_t>::const_iterator
 BasisSublattice<bit_t, n_sublat>::begin() const {
   return reps_.begin();
 }
 
 template <typename bit_t, int n_sublat>
-typename std::vector<bit_t>::const_iterator
+typename numa_vector<bit_t>::const_iterator
 BasisSublattice<bit_t, n_sublat>::end() const {
   return reps_.end();
 }
@@ -356,7 +483,26 @@ int64_t BasisSublattice<bit_t, n_sublat>::nup() const {
 }
 
 template <typename bit_t, int n_sublat>
+int64_t BasisSublattice<bit_t, n_sublat>::spinflip() const {
+  return spinflip_;
+}
+
+template <typename bit_t, int n_sublat>
+bool BasisSublattice<bit_t, n_sublat>::dense_index() const {
+  return dense_index_;
+}
+
+template <typename bit_t, int n_sublat>
+int64_t BasisSublattice<bit_t, n_sublat>::index_memory() const {
+  if (dense_index_) {
+    return dense_offsets_.size() * sizeof(int64_t);
+  } else {
+    return rep_search_range_.bucket_count() *
+           sizeof(std::pair<bit_t, gsl::span<bit_t const>>);
+  }
+}
 
+template <typename bit_t, int n_sublat>
 Representation const &BasisSublattice<bit_t, n_sublat>::irrep() const {
   return irrep_;
 }
@@ -367,10 +513,38 @@ BasisSublattice<bit_t, n_sublat>::group_action() const {
   return group_action_;
 }
 
+template <typename bit_t, int n_sublat>
+Vector const &BasisSublattice<bit_t, n_sublat>::characters() const {
+  return characters_;
+}
+
 template <typename bit_t, int n_sublat>
 int64_t
 BasisSublattice<bit_t, n_sublat>::index_of_representative(bit_t rep) const {
 
+  if (dense_index_) {
+    int64_t prefix = (int64_t)(rep >> dense_prefix_shift_);
+    bit_t const *first = reps_.data() + dense_offsets_[prefix];
+    bit_t const *last = reps_.data() + dense_offsets_[prefix + 1];
+
+    // Branchless binary search for the first element not less than rep
+    int64_t n = last - first;
+    if (n == 0) {
+      return invalid_index;
+    }
+    while (n > 1) {
+      int64_t half = n / 2;
+      first = (first[half] < rep) ? first + half : first;
+      n -= half;
+    }
+    first += (*first < rep);
+    if ((first != last) && (*first == rep)) {
+      return first - reps_.data();
+    } else {
+      return invalid_index;
+    }
+  }
+
   bit_t prefix = rep >> n_postfix_bits_;
   auto itr = rep_search_range_.find(prefix);
   if (itr == rep_search_range_.end()) {
@@ -396,6 +570,14 @@ template <typename bit_t, int n_sublat>
 std::pair<int64_t, int64_t>
 BasisSublattice<bit_t, n_sublat>::index_sym(bit_t state) const {
   auto [rep, sym] = group_action_.representative_sym(state);
+  if (spinflip_ != 0) {
+    auto [rep_flip, sym_flip] =
+        group_action_.representative_sym(state ^ spinflip_mask_);
+    if (rep_flip < rep) {
+      rep = rep_flip;
+      sym = group_action_.n_symmetries() + sym_flip;
+    }
+  }
   int64_t idx = index_of_representative(rep);
   return {idx, sym};
 }
@@ -404,14 +586,34 @@ template <typename bit_t, int n_sublat>
 std::pair<int64_t, gsl::span<int64_t const>>
 BasisSublattice<bit_t, n_sublat>::index_syms(bit_t state) const {
   auto [rep, syms] = group_action_.representative_syms(state);
+  if (spinflip_ == 0) {
+    int64_t idx = index_of_representative(rep);
+    return {idx, syms};
+  }
+
+  // syms is overwritten by the next call to representative_syms
+  syms_spinflip_.assign(syms.begin(), syms.end());
+  auto [rep_flip, syms_flip] =
+      group_action_.representative_syms(state ^ spinflip_mask_);
+  if (rep_flip < rep) {
+    rep = rep_flip;
+    syms_spinflip_.clear();
+  }
+  if (rep_flip == rep) {
+    for (int64_t sym : syms_flip) {
+      syms_spinflip_.push_back(group_action_.n_symmetries() + sym);
+    }
+  }
   int64_t idx = index_of_representative(rep);
-  return {idx, syms};
+  return {idx, gsl::span<int64_t const>(syms_spinflip_.data(),
+                                        syms_spinflip_.size())};
 }
 
 template <typename bit_t, int n_sublat>
 bool BasisSublattice<bit_t, n_sublat>::operator==(
     BasisSublattice<bit_t, n_sublat> const &rhs) const {
   return (nsites_ == rhs.nsites_) && (nup_ == rhs.nup_) &&
+         (spinflip_ == rhs.spinflip_) &&
          (n_postfix_bits_ == rhs.n_postfix_bits_) &&
          (group_action_ == rhs.group_action_);
 }
@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <istream>
+#include <ostream>
+
 #include <xdiag/extern/flat_hash_map.hpp>
 #include <xdiag/extern/gsl/span>
 
@@ -12,19 +16,39 @@
 #include <xdiag/symmetries/group_action/group_action_sublattice.hpp>
 #include <xdiag/symmetries/permutation_group.hpp>
 #include <xdiag/symmetries/representation.hpp>
+#include <xdiag/utils/allocator.hpp>
+#include <xdiag/utils/prefetch.hpp>
 
 namespace xdiag::basis::spinhalf {
 
 constexpr int64_t maximum_prefix_bits = 32;
 
+// Maximal number of prefix bits of the dense index, limiting its memory to
+// 2^28 offsets
+constexpr int64_t maximum_dense_prefix_bits = 28;
+
 template <typename bit_tt, int n_sublat> class BasisSublattice {
 public:
   using bit_t = bit_tt;
-  using iterator_t = typename std::vector<bit_t>::const_iterator;
-
+  using iterator_t = typename numa_vector<bit_t>::const_iterator;
+
+  // If dense_index is true, the index of a representative is looked up in a
+  // dense array of offsets addressed by the leading bits of the
+  // representative, instead of a hash map of the leading bits. If spinflip
+  // is +1 or -1, the basis is additionally symmetrized with respect to the
+  // global spin flip with this parity, where the symmetries n <= sym < 2n
+  // denote the permutation sym - n followed by a spin flip.
   BasisSublattice() = default;
-  BasisSublattice(Representation const &irrep);
-  BasisSublattice(int64_t nup, Representation const &irrep);
+  BasisSublattice(Representation const &irrep, bool dense_index = false);
+  BasisSublattice(int64_t nup, Representation const &irrep,
+                  bool dense_index = false, int64_t spinflip = 0);
+
+  // Reads the representatives and norms written by write
+  BasisSublattice(Representation const &irrep, bool dense_index,
+                  std::istream &in);
+  BasisSublattice(int64_t nup, Representation const &irrep, bool dense_index,
+                  int64_t spinflip, std::istream &in);
+  void write(std::ostream &out) const;
 
   iterator_t begin() const;
   iterator_t end() const;
@@ -37,10 +61,18 @@ public:
 
   int64_t nsites() const;
   int64_t nup() const;
+  int64_t spinflip() const;
+  bool dense_index() const;
+
+  // Memory in bytes used by the lookup of the index of a representative
+  int64_t index_memory() const;
 
   Representation const &irrep() const;
   GroupActionSublattice<bit_t, n_sublat> const &group_action() const;
 
+  // Characters of all symmetries, including the spin flipped ones
+  Vector const &characters() const;
+
   bool operator==(BasisSublattice<bit_t, n_sublat> const &rhs) const;
   bool operator!=(BasisSublattice<bit_t, n_sublat> const &rhs) const;
 
@@ -48,22 +80,46 @@ private:
   int64_t nsites_;
   int64_t nup_;
   int64_t n_postfix_bits_;
+  bool dense_index_;
+  int64_t spinflip_;
+  bit_t spinflip_mask_;
 
   Representation irrep_;
+  Vector characters_;
   GroupActionSublattice<bit_t, n_sublat> group_action_;
-  std::vector<bit_t> reps_;
-  std::vector<double> norms_;
+  numa_vector<bit_t> reps_;
+  numa_vector<double> norms_;
   // std::unordered_map<bit_t, gsl::span<bit_t const>> rep_search_range_;
   ska::flat_hash_map<bit_t, gsl::span<bit_t const>> rep_search_range_;
 
+  // Representatives with leading bits prefix = rep >> dense_prefix_shift_
+  // are stored at positions [dense_offsets_[prefix], dense_offsets_[prefix+1])
+  int64_t dense_prefix_shift_ = 0;
+  numa_vector<int64_t> dense_offsets_;
+
+  // Buffer for the symmetries returned by index_syms with spin flip
+  mutable std::vector<int64_t> syms_spinflip_;
+
+  void init_index();
   int64_t index_of_representative(bit_t rep) const;
 
   // functions used in implementation of terms
 public:
   inline bit_t representative(bit_t state) const {
-    return group_action_.representative(state);
+    bit_t rep = group_action_.representative(state);
+    if (spinflip_ != 0) {
+      rep = std::min(rep,
+                     group_action_.representative(state ^ spinflip_mask_));
+    }
+    return rep;
   }
   std::pair<int64_t, int64_t> index_sym(bit_t raw_state) const;
+
+  // The representative is computed by the sublattice algorithm, so only the
+  // norm is prefetched
+  inline void prefetch_norm(int64_t idx) const {
+    prefetch(norms_.data() + idx);
+  }
   std::pair<int64_t, gsl::span<int64_t const>>
   index_syms(bit_t raw_state) const;
 };
@@ -9,6 +9,7 @@
 #else
 #include <xdiag/symmetries/operations/representative_list.hpp>
 #endif
+#include <xdiag/io/binary.hpp>
 
 namespace xdiag::basis::spinhalf {
 
@@ -46,13 +47,40 @@ BasisSymmetricNoSz<bit_t>::BasisSymmetricNoSz(Representation const &irrep) try
 }
 
 template <class bit_t>
-typename std::vector<bit_t>::const_iterator
+BasisSymmetricNoSz<bit_t>::BasisSymmetricNoSz(Representation const &irrep,
+                                                std::istream &in) try
+    : nsites_(irrep.group().nsites()), group_action_(irrep.group()),
+      irrep_(irrep), subsets_basis_(nsites_) {
+  check_nsites_work_with_bits<bit_t>(nsites_);
+  io::read_binary(in, reps_);
+  io::read_binary(in, index_for_rep_);
+  io::read_binary(in, syms_);
+  io::read_binary(in, sym_limits_for_rep_);
+  io::read_binary(in, norms_);
+  size_ = (int64_t)reps_.size();
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <class bit_t>
+void BasisSymmetricNoSz<bit_t>::write(std::ostream &out) const try {
+  io::write_binary(out, reps_);
+  io::write_binary(out, index_for_rep_);
+  io::write_binary(out, syms_);
+  io::write_binary(out, sym_limits_for_rep_);
+  io::write_binary(out, norms_);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <class bit_t>
+typename BasisSymmetricNoSz<bit_t>::iterator_t
 BasisSymmetricNoSz<bit_t>::begin() const {
   return reps_.begin();
 }
 
 template <class bit_t>
-typename std::vector<bit_t>::const_iterator
+typename BasisSymmetricNoSz<bit_t>::iterator_t
 BasisSymmetricNoSz<bit_t>::end() const {
   return reps_.end();
 }
@@ -77,6 +105,10 @@ template <class bit_t>
 Representation const &BasisSymmetricNoSz<bit_t>::irrep() const {
   return irrep_;
 }
+template <class bit_t>
+Vector const &BasisSymmetricNoSz<bit_t>::characters() const {
+  return irrep_.characters();
+}
 
 template <typename bit_t>
 bool BasisSymmetricNoSz<bit_t>::operator==(
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <istream>
+#include <ostream>
 #include <utility>
 #include <vector>
 #include <xdiag/extern/gsl/span>
@@ -13,18 +15,24 @@
 #include <xdiag/symmetries/group_action/group_action_lookup.hpp>
 #include <xdiag/symmetries/permutation_group.hpp>
 #include <xdiag/symmetries/representation.hpp>
+#include <xdiag/utils/allocator.hpp>
+#include <xdiag/utils/prefetch.hpp>
 
 namespace xdiag::basis::spinhalf {
 
 template <typename bit_tt> class BasisSymmetricNoSz {
 public:
   using bit_t = bit_tt;
-  using iterator_t = typename std::vector<bit_t>::const_iterator;
+  using iterator_t = typename numa_vector<bit_t>::const_iterator;
   using span_size_t = gsl::span<int64_t const>::size_type;
 
   BasisSymmetricNoSz() = default;
   BasisSymmetricNoSz(Representation const &irrep);
 
+  // Reads the representatives, norms and symmetry tables written by write
+  BasisSymmetricNoSz(Representation const &irrep, std::istream &in);
+  void write(std::ostream &out) const;
+
   int64_t dim() const;
   int64_t size() const;
   iterator_t begin() const;
@@ -39,6 +47,7 @@ public:
   int64_t nsites() const;
   GroupActionLookup<bit_t> const &group_action() const;
   Representation const &irrep() const;
+  Vector const &characters() const;
 
   bool operator==(BasisSymmetricNoSz const &rhs) const;
   bool operator!=(BasisSymmetricNoSz const &rhs) const;
@@ -49,11 +58,11 @@ private:
   Representation irrep_;
   combinatorics::SubsetsIndexing<bit_t> subsets_basis_;
 
-  std::vector<bit_t> reps_;
-  std::vector<int64_t> index_for_rep_;
+  numa_vector<bit_t> reps_;
+  numa_vector<int64_t> index_for_rep_;
   std::vector<int64_t> syms_;
   std::vector<std::pair<span_size_t, span_size_t>> sym_limits_for_rep_;
-  std::vector<double> norms_;
+  numa_vector<double> norms_;
 
   int64_t size_;
 
@@ -73,6 +82,16 @@ public:
     return {index, syms_[start]};
   }
 
+  // Prefetch the table entries read by index_sym and norm
+  inline void prefetch_index_sym(bit_t raw_state) const {
+    int64_t raw_idx = subsets_basis_.index(raw_state);
+    prefetch(index_for_rep_.data() + raw_idx);
+    prefetch(sym_limits_for_rep_.data() + raw_idx);
+  }
+  inline void prefetch_norm(int64_t idx) const {
+    prefetch(norms_.data() + idx);
+  }
+
   inline std::pair<int64_t, gsl::span<int64_t const>>
   index_syms(bit_t raw_state) const {
     int64_t raw_idx = subsets_basis_.index(raw_state);
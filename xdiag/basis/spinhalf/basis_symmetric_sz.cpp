@@ -9,25 +9,32 @@
 #else
 #include <xdiag/symmetries/operations/representative_list.hpp>
 #endif
+#include <xdiag/io/binary.hpp>
 #include <xdiag/utils/logger.hpp>
 
 namespace xdiag::basis::spinhalf {
 
 template <class bit_t>
 BasisSymmetricSz<bit_t>::BasisSymmetricSz(int64_t nup,
-                                          Representation const &irrep) try
-    : nsites_(irrep.group().nsites()), nup_(nup), group_action_(irrep.group()),
-      irrep_(irrep), combinations_indexing_(nsites_, nup) {
+                                          Representation const &irrep,
+                                          int64_t spinflip) try
+    : nsites_(irrep.group().nsites()), nup_(nup), spinflip_(spinflip),
+      group_action_(irrep.group(), spinflip != 0), irrep_(irrep),
+      characters_(spinflip == 0 ? irrep.characters()
+                                : characters_z2(irrep, spinflip)),
+      combinations_indexing_(nsites_, nup) {
   check_nsites_work_with_bits<bit_t>(nsites_);
 
   if (nup < 0) {
     XDIAG_THROW("Invalid value of nup: nup < 0");
   } else if (nup > nsites_) {
     XDIAG_THROW("Invalid value of nup: nup > nsites");
+  } else if ((spinflip != 0) && (2 * nup != nsites_)) {
+    XDIAG_THROW("Spin flip symmetry requires nup = nsites / 2");
   }
 
   if (isreal(irrep)) {
-    arma::vec characters = irrep.characters().as<arma::vec>();
+    arma::vec characters = characters_.as<arma::vec>();
 
     std::tie(reps_, index_for_rep_, syms_, sym_limits_for_rep_, norms_) =
 #ifdef _OPENMP
@@ -38,7 +45,7 @@ BasisSymmetricSz<bit_t>::BasisSymmetricSz(int64_t nup,
             combinations_indexing_, group_action_, characters);
 #endif
   } else {
-    arma::cx_vec characters = irrep.characters().as<arma::cx_vec>();
+    arma::cx_vec characters = characters_.as<arma::cx_vec>();
     std::tie(reps_, index_for_rep_, syms_, sym_limits_for_rep_, norms_) =
 #ifdef _OPENMP
         symmetries::representatives_indices_symmetries_limits_norms_omp<bit_t>(
@@ -55,12 +62,44 @@ BasisSymmetricSz<bit_t>::BasisSymmetricSz(int64_t nup,
 }
 
 template <class bit_t>
-typename std::vector<bit_t>::const_iterator
+BasisSymmetricSz<bit_t>::BasisSymmetricSz(int64_t nup,
+                                          Representation const &irrep,
+                                          int64_t spinflip,
+                                          std::istream &in) try
+    : nsites_(irrep.group().nsites()), nup_(nup), spinflip_(spinflip),
+      group_action_(irrep.group(), spinflip != 0), irrep_(irrep),
+      characters_(spinflip == 0 ? irrep.characters()
+                                : characters_z2(irrep, spinflip)),
+      combinations_indexing_(nsites_, nup) {
+  check_nsites_work_with_bits<bit_t>(nsites_);
+  io::read_binary(in, reps_);
+  io::read_binary(in, index_for_rep_);
+  io::read_binary(in, syms_);
+  io::read_binary(in, sym_limits_for_rep_);
+  io::read_binary(in, norms_);
+  size_ = (int64_t)reps_.size();
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <class bit_t>
+void BasisSymmetricSz<bit_t>::write(std::ostream &out) const try {
+  io::write_binary(out, reps_);
+  io::write_binary(out, index_for_rep_);
+  io::write_binary(out, syms_);
+  io::write_binary(out, sym_limits_for_rep_);
+  io::write_binary(out, norms_);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <class bit_t>
+typename BasisSymmetricSz<bit_t>::iterator_t
 BasisSymmetricSz<bit_t>::begin() const {
   return reps_.begin();
 }
 template <class bit_t>
-typename std::vector<bit_t>::const_iterator
+typename BasisSymmetricSz<bit_t>::iterator_t
 BasisSymmetricSz<bit_t>::end() const {
   return reps_.end();
 }
@@ -78,6 +117,9 @@ template <class bit_t> int64_t BasisSymmetricSz<bit_t>::nsites() const {
 template <class bit_t> int64_t BasisSymmetricSz<bit_t>::nup() const {
   return nup_;
 }
+template <class bit_t> int64_t BasisSymmetricSz<bit_t>::spinflip() const {
+  return spinflip_;
+}
 template <class bit_t>
 GroupActionLookup<bit_t> const &BasisSymmetricSz<bit_t>::group_action() const {
   return group_action_;
@@ -86,11 +128,16 @@ template <class bit_t>
 Representation const &BasisSymmetricSz<bit_t>::irrep() const {
   return irrep_;
 }
+template <class bit_t>
+Vector const &BasisSymmetricSz<bit_t>::characters() const {
+  return characters_;
+}
 
 template <typename bit_t>
 bool BasisSymmetricSz<bit_t>::operator==(
     BasisSymmetricSz<bit_t> const &rhs) const {
   return (nsites_ == rhs.nsites_) && (nup_ == rhs.nup_) &&
+         (spinflip_ == rhs.spinflip_) &&
          (group_action_ == rhs.group_action_) && (irrep_ == rhs.irrep_);
 }
 
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <istream>
+#include <ostream>
 #include <utility>
 #include <vector>
 
@@ -13,17 +15,29 @@
 #include <xdiag/symmetries/group_action/group_action_lookup.hpp>
 #include <xdiag/symmetries/permutation_group.hpp>
 #include <xdiag/symmetries/representation.hpp>
+#include <xdiag/utils/allocator.hpp>
+#include <xdiag/utils/prefetch.hpp>
 
 namespace xdiag::basis::spinhalf {
 
 template <typename bit_tt> class BasisSymmetricSz {
 public:
   using bit_t = bit_tt;
-  using iterator_t = typename std::vector<bit_t>::const_iterator;
+  using iterator_t = typename numa_vector<bit_t>::const_iterator;
   using span_size_t = gsl::span<int64_t const>::size_type;
 
+  // If spinflip is +1 or -1, the basis is additionally symmetrized with
+  // respect to the global spin flip with this parity. The symmetries
+  // n <= sym < 2n then denote the permutation sym - n followed by a spin
+  // flip, where n is the size of the group of irrep.
   BasisSymmetricSz() = default;
-  BasisSymmetricSz(int64_t nup, Representation const &irrep);
+  BasisSymmetricSz(int64_t nup, Representation const &irrep,
+                   int64_t spinflip = 0);
+
+  // Reads the representatives, norms and symmetry tables written by write
+  BasisSymmetricSz(int64_t nup, Representation const &irrep,
+                   int64_t spinflip, std::istream &in);
+  void write(std::ostream &out) const;
 
   int64_t dim() const;
   int64_t size() const;
@@ -38,24 +52,30 @@ public:
 
   int64_t nsites() const;
   int64_t nup() const;
+  int64_t spinflip() const;
   GroupActionLookup<bit_t> const &group_action() const;
   Representation const &irrep() const;
 
+  // Characters of all symmetries, including the spin flipped ones
+  Vector const &characters() const;
+
   bool operator==(BasisSymmetricSz const &rhs) const;
   bool operator!=(BasisSymmetricSz const &rhs) const;
 
 private:
   int64_t nsites_;
   int64_t nup_;
+  int64_t spinflip_;
   GroupActionLookup<bit_t> group_action_;
   Representation irrep_;
+  Vector characters_;
   combinatorics::CombinationsIndexing<bit_t> combinations_indexing_;
 
-  std::vector<bit_t> reps_;
-  std::vector<int64_t> index_for_rep_;
+  numa_vector<bit_t> reps_;
+  numa_vector<int64_t> index_for_rep_;
   std::vector<int64_t> syms_;
   std::vector<std::pair<span_size_t, span_size_t>> sym_limits_for_rep_;
-  std::vector<double> norms_;
+  numa_vector<double> norms_;
 
   int64_t size_;
 
@@ -73,6 +93,16 @@ public:
     int64_t start = sym_limits_for_rep_[raw_idx].first;
     return {index, syms_[start]};
   }
+  // Prefetch the table entries read by index_sym and norm
+  inline void prefetch_index_sym(bit_t raw_state) const {
+    int64_t raw_idx = combinations_indexing_.index(raw_state);
+    prefetch(index_for_rep_.data() + raw_idx);
+    prefetch(sym_limits_for_rep_.data() + raw_idx);
+  }
+  inline void prefetch_norm(int64_t idx) const {
+    prefetch(norms_.data() + idx);
+  }
+
   inline std::pair<int64_t, gsl::span<int64_t const>>
   index_syms(bit_t raw_state) const {
     int64_t raw_idx = combinations_indexing_.index(raw_state);
@@ -25,6 +25,7 @@ public:
   int64_t size() const;
 
   inline int64_t index(bit_t spins) const { return lintable_.index(spins); }
+  inline void prefetch_index(bit_t spins) const { lintable_.prefetch(spins); }
   inline bit_t state(int64_t index) const { return states_[index]; }
 
   int64_t nsites() const;
@@ -8,6 +8,7 @@
 #include <tuple>
 
 #include <xdiag/bits/bitops.hpp>
+#include <xdiag/combinatorics/binomial.hpp>
 #include <xdiag/combinatorics/subsets.hpp>
 #include <xdiag/extern/armadillo/armadillo>
 #include <xdiag/operators/op.hpp>
@@ -35,11 +36,16 @@ void apply_exchange_postfix(Coupling const &cpl, Op const &op,
 
   bit_t mask = ((bit_t)1 << s1) | ((bit_t)1 << s2);
 
-  int64_t idx = 0;
-  for (bit_t prefix : basis.prefixes()) {
+  auto const &prefixes = basis.prefixes();
+  int64_t n_prefixes = prefixes.size();
+
+#pragma omp parallel for schedule(guided)
+  for (int64_t prefix_idx = 0; prefix_idx < n_prefixes; ++prefix_idx) {
+    bit_t prefix = prefixes[prefix_idx];
     auto const &lintable = basis.postfix_lintable(prefix);
     auto const &postfixes = basis.postfix_states(prefix);
     int64_t prefix_begin = basis.prefix_begin(prefix);
+    int64_t idx = prefix_begin;
     for (bit_t postfix : postfixes) {
 
       if (bits::popcnt(postfix & mask) & 1) {
@@ -77,11 +83,16 @@ void apply_exchange_prefix(Coupling const &cpl, Op const &op,
   bit_t mask = (((bit_t)1 << s1) | ((bit_t)1 << s2)) >> n_postfix_bits;
 
   // loop through all postfixes
-  int64_t idx = 0;
-  for (bit_t postfix : basis.postfixes()) {
+  auto const &postfixes = basis.postfixes();
+  int64_t n_postfixes = postfixes.size();
+
+#pragma omp parallel for schedule(guided)
+  for (int64_t postfix_idx = 0; postfix_idx < n_postfixes; ++postfix_idx) {
+    bit_t postfix = postfixes[postfix_idx];
     auto const &lintable = basis.prefix_lintable(postfix);
     auto const &prefixes = basis.prefix_states(postfix);
     int64_t postfix_begin = basis.postfix_begin(postfix);
+    int64_t idx = postfix_begin;
     for (bit_t prefix : prefixes) {
       if (bits::popcnt(prefix & mask) & 1) {
         bit_t new_prefix = prefix ^ mask;
@@ -163,18 +174,42 @@ void apply_exchange_mixed(Coupling const &cpl, Op const &op,
   mpi::buffer.clean_send();
   mpi::buffer.clean_recv();
 
+  // Number of postfixes of a prefix which are sent, i.e. the postfix bit must
+  // be opposite to the prefix bit
+  auto n_states_sent = [&](bit_t prefix) -> int64_t {
+    int64_t nup_postfix = nup - bits::popcnt(prefix);
+    return (prefix & prefix_mask)
+               ? combinatorics::binomial(n_postfix_bits - 1, nup_postfix)
+               : combinatorics::binomial(n_postfix_bits - 1, nup_postfix - 1);
+  };
+
+  // Compute the offsets in the send buffer of every prefix (prefix sum per
+  // target rank), such that the send buffer can be filled in parallel
+  auto const &prefixes = basis.prefixes();
+  int64_t n_prefixes = prefixes.size();
+  std::vector<int64_t> send_offsets(n_prefixes);
+  std::vector<int64_t> n_states_prepared(mpi_size, 0);
+  for (int64_t prefix_idx = 0; prefix_idx < n_prefixes; ++prefix_idx) {
+    bit_t prefix = prefixes[prefix_idx];
+    int32_t target_rank = basis.rank(prefix ^ prefix_mask);
+    send_offsets[prefix_idx] = comm.n_values_i_send_offset(target_rank) +
+                               n_states_prepared[target_rank];
+    n_states_prepared[target_rank] += n_states_sent(prefix);
+  }
+
   // Loop through all my states and fill them in send buffer
-  int64_t idx = 0;
-  for (auto prefix : basis.prefixes()) {
-    bit_t prefix_flipped = prefix ^ prefix_mask;
-    int32_t target_rank = basis.rank(prefix_flipped);
+#pragma omp parallel for schedule(guided)
+  for (int64_t prefix_idx = 0; prefix_idx < n_prefixes; ++prefix_idx) {
+    bit_t prefix = prefixes[prefix_idx];
     auto const &postfixes = basis.postfix_states(prefix);
+    int64_t idx = basis.prefix_begin(prefix);
+    int64_t send_idx = send_offsets[prefix_idx];
 
     // prefix up, postfix must be dn
     if (prefix & prefix_mask) {
       for (auto postfix : postfixes) {
         if (!(postfix & postfix_mask)) {
-          comm.add_to_send_buffer(target_rank, vec_in(idx), send_buffer);
+          send_buffer[send_idx++] = vec_in(idx);
         }
         ++idx;
       }
@@ -183,7 +218,7 @@ void apply_exchange_mixed(Coupling const &cpl, Op const &op,
     else {
       for (auto postfix : postfixes) {
         if (postfix & postfix_mask) {
-          comm.add_to_send_buffer(target_rank, vec_in(idx), send_buffer);
+          send_buffer[send_idx++] = vec_in(idx);
         }
         ++idx;
       }
@@ -193,8 +228,10 @@ void apply_exchange_mixed(Coupling const &cpl, Op const &op,
   // Communicate
   comm.all_to_all(send_buffer, recv_buffer);
 
-  // Fill received states into vec_out (gnarlyy!!!)
-  // auto recv_offsets = comm.n_values_i_recv_offsets();
+  // Determine which prefixes have been received and where their coefficients
+  // are located in the receive buffer (gnarlyy!!!)
+  std::vector<bit_t> prefixes_received;
+  std::vector<int64_t> recv_offsets;
   std::vector<int64_t> offsets(mpi_size, 0);
   for (bit_t prefix : combinatorics::Subsets<bit_t>(n_prefix_bits)) {
 
@@ -217,7 +254,21 @@ void apply_exchange_mixed(Coupling const &cpl, Op const &op,
       continue;
 
     int32_t origin_rank = basis.rank(prefix);
-    int64_t origin_offset = comm.n_values_i_recv_offset(origin_rank);
+    prefixes_received.push_back(prefix);
+    recv_offsets.push_back(comm.n_values_i_recv_offset(origin_rank) +
+                           offsets[origin_rank]);
+    offsets[origin_rank] += n_states_sent(prefix);
+  }
+
+  // Fill received states into vec_out
+  int64_t n_prefixes_received = prefixes_received.size();
+
+#pragma omp parallel for schedule(guided)
+  for (int64_t recv_prefix_idx = 0; recv_prefix_idx < n_prefixes_received;
+       ++recv_prefix_idx) {
+    bit_t prefix = prefixes_received[recv_prefix_idx];
+    int64_t idx_received = recv_offsets[recv_prefix_idx];
+    bit_t prefix_flipped = prefix ^ prefix_mask;
 
     auto const &postfixes = basis.postfix_states(prefix);
     auto const &postfix_flipped_lintable =
@@ -229,12 +280,11 @@ void apply_exchange_mixed(Coupling const &cpl, Op const &op,
       for (auto postfix : postfixes) {
         if (!(postfix & postfix_mask)) {
           bit_t postfix_flipped = postfix ^ postfix_mask;
-          int64_t idx_received = origin_offset + offsets[origin_rank];
           int64_t int64_target =
               prefix_flipped_offset +
               postfix_flipped_lintable.index(postfix_flipped);
           vec_out(int64_target) += Jhalf * recv_buffer[idx_received];
-          ++offsets[origin_rank];
+          ++idx_received;
         }
       }
     }
@@ -243,16 +293,15 @@ void apply_exchange_mixed(Coupling const &cpl, Op const &op,
       for (auto postfix : postfixes) {
         if (postfix & postfix_mask) {
           bit_t postfix_flipped = postfix ^ postfix_mask;
-          int64_t idx_received = origin_offset + offsets[origin_rank];
           int64_t int64_target =
               prefix_flipped_offset +
               postfix_flipped_lintable.index(postfix_flipped);
           vec_out(int64_target) += Jhalf * recv_buffer[idx_received];
-          ++offsets[origin_rank];
+          ++idx_received;
         }
       }
     }
-  } // for (bit_t prefix : Subsets<bit_t>(n_prefix_bits))
+  } // for (recv_prefix_idx = 0; ...)
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
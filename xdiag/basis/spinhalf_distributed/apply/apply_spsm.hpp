@@ -25,11 +25,16 @@ void apply_spsm_postfix(Coupling const &cpl, Op const &op,
   bit_t mask = ((bit_t)1 << s);
 
   int64_t n_postfix_bits = basis_in.n_postfix_bits();
-  int64_t idx = 0;
-  for (auto prefix : basis_in.prefixes()) {
+  auto const &prefixes = basis_in.prefixes();
+  int64_t n_prefixes = prefixes.size();
+
+#pragma omp parallel for schedule(guided)
+  for (int64_t prefix_idx = 0; prefix_idx < n_prefixes; ++prefix_idx) {
+    bit_t prefix = prefixes[prefix_idx];
     auto const &postfixes = basis_in.postfix_states(prefix);
     auto const &lintable = basis_out.postfix_lintable(prefix);
     int64_t idx_prefix = basis_out.prefix_begin(prefix);
+    int64_t idx = basis_in.prefix_begin(prefix);
 
     if (idx_prefix != invalid_index) { // can happen since total Sz changes
       if (type == "S+") {
@@ -51,8 +56,6 @@ void apply_spsm_postfix(Coupling const &cpl, Op const &op,
           ++idx;
         }
       }
-    } else {
-      idx += postfixes.size();
     }
   }
 } catch (Error const &e) {
@@ -78,12 +81,16 @@ void apply_spsm_prefix(Coupling const &cpl, Op const &op,
   coeff_t *recv_buffer = mpi::buffer.recv<coeff_t>();
 
   // loop through all postfixes
-  int64_t idx = 0;
-  for (auto postfix : basis_in.postfixes()) {
+  auto const &postfixes = basis_in.postfixes();
+  int64_t n_postfixes = postfixes.size();
 
+#pragma omp parallel for schedule(guided)
+  for (int64_t postfix_idx = 0; postfix_idx < n_postfixes; ++postfix_idx) {
+    bit_t postfix = postfixes[postfix_idx];
     auto const &prefixes = basis_in.prefix_states(postfix);
     auto const &lintable = basis_out.prefix_lintable(postfix);
     int64_t idx_postfix = basis_out.postfix_begin(postfix);
+    int64_t idx = basis_in.postfix_begin(postfix);
 
     if (idx_postfix != invalid_index) { // can happen since total Sz changes
       if (type == "S+") {
@@ -106,8 +113,6 @@ void apply_spsm_prefix(Coupling const &cpl, Op const &op,
           ++idx;
         }
       }
-    } else {
-      idx += prefixes.size();
     }
   }
 } catch (Error const &e) {
@@ -27,9 +27,14 @@ void apply_sz(Coupling const &cpl, Op const &op, basis_t const &basis,
   coeff_t val_dn = -H / 2.;
   int n_postfix_bits = basis.n_postfix_bits();
 
-  int64_t idx = 0;
-  for (auto prefix : basis.prefixes()) {
-    auto postfixes = basis.postfix_states(prefix);
+  auto const &prefixes = basis.prefixes();
+  int64_t n_prefixes = prefixes.size();
+
+#pragma omp parallel for schedule(guided)
+  for (int64_t prefix_idx = 0; prefix_idx < n_prefixes; ++prefix_idx) {
+    bit_t prefix = prefixes[prefix_idx];
+    auto const &postfixes = basis.postfix_states(prefix);
+    int64_t idx = basis.prefix_begin(prefix);
 
     // site in postfixes
     if (s < n_postfix_bits) {
@@ -50,7 +55,7 @@ void apply_sz(Coupling const &cpl, Op const &op, basis_t const &basis,
         vec_out(idx) += val * vec_in(idx);
       }
     }
-  } // for (auto prefix : basis.prefixes())
+  } // for (prefix_idx = 0; prefix_idx < n_prefixes; ++prefix_idx)
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
@@ -33,10 +33,15 @@ void apply_szsz(Coupling const &cpl, Op const &op, basis_t const &basis,
   bit_t s1mask = (bit_t)1 << s1;
   bit_t s2mask = (bit_t)1 << (s2 - n_postfix_bits);
 
-  int64_t idx = 0;
-  for (bit_t prefix : basis.prefixes()) {
+  auto const &prefixes = basis.prefixes();
+  int64_t n_prefixes = prefixes.size();
+
+#pragma omp parallel for schedule(guided)
+  for (int64_t prefix_idx = 0; prefix_idx < n_prefixes; ++prefix_idx) {
+    bit_t prefix = prefixes[prefix_idx];
     bit_t prefix_shifted = (prefix << n_postfix_bits);
     auto const &postfixes = basis.postfix_states(prefix);
+    int64_t idx = basis.prefix_begin(prefix);
 
     // Both sites are on prefixes
     if ((s1 >= n_postfix_bits) && (s2 >= n_postfix_bits)) {
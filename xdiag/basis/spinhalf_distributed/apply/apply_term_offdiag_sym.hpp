@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifdef XDIAG_USE_MPI
+
+#include <vector>
+
+#include <xdiag/extern/armadillo/armadillo>
+#include <xdiag/operators/op.hpp>
+#include <xdiag/parallel/mpi/buffer.hpp>
+#include <xdiag/parallel/mpi/communicator.hpp>
+
+namespace xdiag::basis::spinhalf_distributed {
+
+// Applies an offdiagonal term on a symmetric distributed basis. For every new
+// state the representative is computed on the fly and the contribution is
+// sent together with the representative to the process owning it. The
+// number of values sent to every process is stored in the CommPattern of
+// basis_in, such that it only needs to be computed once per Op.
+template <typename coeff_t, class basis_t, class non_zero_term_f,
+          class term_action_f>
+void apply_term_offdiag_sym(Op const &op, basis_t const &basis_in,
+                            arma::Col<coeff_t> const &vec_in,
+                            basis_t const &basis_out,
+                            arma::Col<coeff_t> &vec_out,
+                            non_zero_term_f non_zero_term,
+                            term_action_f term_action) {
+  using bit_t = typename basis_t::bit_t;
+
+  int mpi_size;
+  MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+
+  arma::Col<coeff_t> characters =
+      basis_out.irrep().characters().template as<arma::Col<coeff_t>>();
+  int64_t size_in = basis_in.size();
+
+  // Determine how many values are sent to every process
+  mpi::Communicator comm;
+  if (basis_in.comm_pattern().contains(op)) {
+    comm = basis_in.comm_pattern()[op];
+  } else {
+    std::vector<int64_t> n_values_i_send(mpi_size, 0);
+    for (int64_t idx_in = 0; idx_in < size_in; ++idx_in) {
+      bit_t spins_in = basis_in.state(idx_in);
+      if (non_zero_term(spins_in)) {
+        bit_t spins_out = term_action(spins_in).first;
+        bit_t rep = basis_out.representative(spins_out);
+        ++n_values_i_send[basis_out.rank(rep)];
+      }
+    }
+    comm = mpi::Communicator(n_values_i_send);
+    basis_in.comm_pattern().append(op, comm);
+  }
+
+  int64_t buffer_size =
+      std::max(comm.send_buffer_size(), comm.recv_buffer_size());
+  mpi::buffer.reserve<coeff_t>(buffer_size);
+  coeff_t *send_buffer = mpi::buffer.send<coeff_t>();
+  coeff_t *recv_buffer = mpi::buffer.recv<coeff_t>();
+  std::vector<bit_t> reps_send(comm.send_buffer_size());
+  std::vector<bit_t> reps_recv(comm.recv_buffer_size());
+
+  // Compute representatives and coefficients of new states
+  std::vector<int64_t> offsets(mpi_size);
+  for (int rank = 0; rank < mpi_size; ++rank) {
+    offsets[rank] = comm.n_values_i_send_offset(rank);
+  }
+  for (int64_t idx_in = 0; idx_in < size_in; ++idx_in) {
+    bit_t spins_in = basis_in.state(idx_in);
+    if (non_zero_term(spins_in)) {
+      auto [spins_out, coeff] = term_action(spins_in);
+      auto [rep, sym] = basis_out.representative_sym(spins_out);
+      int64_t idx_send = offsets[basis_out.rank(rep)]++;
+      reps_send[idx_send] = rep;
+      send_buffer[idx_send] =
+          coeff * characters(sym) * vec_in(idx_in) / basis_in.norm(idx_in);
+    }
+  }
+
+  comm.all_to_all(reps_send.data(), reps_recv.data());
+  comm.all_to_all(send_buffer, recv_buffer);
+
+  // Add received coefficients to the output vector
+  int64_t recv_size = comm.recv_buffer_size();
+  for (int64_t idx = 0; idx < recv_size; ++idx) {
+    int64_t idx_out = basis_out.index_of_representative(reps_recv[idx]);
+    if (idx_out != invalid_index) { // can happen if norm of rep vanishes
+      vec_out(idx_out) += recv_buffer[idx] * basis_out.norm(idx_out);
+    }
+  }
+}
+
+} // namespace xdiag::basis::spinhalf_distributed
+#endif
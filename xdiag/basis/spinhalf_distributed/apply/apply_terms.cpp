@@ -13,6 +13,7 @@
 #include <xdiag/basis/spinhalf_distributed/basis_sz.hpp>
 #include <xdiag/basis/spinhalf_distributed/transpose.hpp>
 #include <xdiag/utils/logger.hpp>
+#include <xdiag/utils/profile.hpp>
 
 namespace xdiag::basis::spinhalf_distributed {
 
@@ -59,6 +60,7 @@ void apply_terms(OpSum const &ops, basis_t const &basis_in,
   double time_start = MPI_Wtime();
   for (auto [cpl, op] : ops_diagonal) {
     std::string type = op.type();
+    profile::Scope scope("SpinhalfDistributed", type);
     if (type == "SzSz") {
       apply_szsz(cpl, op, basis_in, vec_in, vec_out);
     } else if (type == "Sz") {
@@ -80,6 +82,7 @@ void apply_terms(OpSum const &ops, basis_t const &basis_in,
   time_start = MPI_Wtime();
   for (auto [cpl, op] : ops_postfix) {
     std::string type = op.type();
+    profile::Scope scope("SpinhalfDistributed", type);
     if (type == "Exchange") {
       apply_exchange_postfix(cpl, op, basis_in, vec_in, vec_out);
     } else if ((type == "S+") || (type == "S-")) {
@@ -101,13 +104,17 @@ void apply_terms(OpSum const &ops, basis_t const &basis_in,
 
   // Transpose to postfix | prefix order
   time_start = MPI_Wtime();
-  transpose(basis_in, vec_in.memptr(), false);
+  {
+    profile::Scope scope("SpinhalfDistributed", "transpose");
+    transpose(basis_in, vec_in.memptr(), false);
+  }
   time_end = MPI_Wtime();
   Log(3, "  transpose   : {:.6f} secs", time_end - time_start);
 
   time_start = MPI_Wtime();
   for (auto [cpl, op] : ops_prefix) {
     std::string type = op.type();
+    profile::Scope scope("SpinhalfDistributed", type);
     if (type == "Exchange") {
       apply_exchange_prefix<basis_t, coeff_t>(cpl, op, basis_in);
     } else if ((type == "S+") || (type == "S-")) {
@@ -122,13 +129,18 @@ void apply_terms(OpSum const &ops, basis_t const &basis_in,
 
   // Transpose back to prefix | postfix order
   time_start = MPI_Wtime();
-  transpose(basis_out, recv_buffer, true);
+  {
+    profile::Scope scope("SpinhalfDistributed", "transpose");
+    transpose(basis_out, recv_buffer, true);
+  }
   time_end = MPI_Wtime();
   Log(3, "  transpose r : {:.6f} secs", time_end - time_start);
 
   // Fill contents of send buffer into vec_out
   time_start = MPI_Wtime();
-  for (int64_t idx = 0; idx < vec_out.size(); ++idx) {
+  int64_t size_out = vec_out.size();
+#pragma omp parallel for schedule(static)
+  for (int64_t idx = 0; idx < size_out; ++idx) {
     vec_out(idx) += send_buffer[idx];
   }
   time_end = MPI_Wtime();
@@ -139,6 +151,7 @@ void apply_terms(OpSum const &ops, basis_t const &basis_in,
   time_start = MPI_Wtime();
   for (auto [cpl, op] : ops_mixed) {
     std::string type = op.type();
+    profile::Scope scope("SpinhalfDistributed", type);
     if (type == "Exchange") {
       apply_exchange_mixed(cpl, op, basis_in, vec_in, vec_out);
     } else {
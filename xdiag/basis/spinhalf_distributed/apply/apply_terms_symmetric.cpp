@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "apply_terms_symmetric.hpp"
+
+#include <functional>
+
+#include <xdiag/symmetries/representation.hpp>
+
+#include <xdiag/basis/apply_identity.hpp>
+#include <xdiag/basis/spinhalf/apply/apply_term_offdiag_no_sym.hpp>
+#include <xdiag/basis/spinhalf/apply/apply_term_offdiag_sym.hpp>
+#include <xdiag/basis/spinhalf/apply/apply_sz.hpp>
+#include <xdiag/basis/spinhalf/apply/apply_szsz.hpp>
+#include <xdiag/basis/spinhalf_distributed/apply/apply_term_offdiag_sym.hpp>
+#include <xdiag/basis/spinhalf_distributed/basis_symmetric_sz.hpp>
+#include <xdiag/bits/bitops.hpp>
+#include <xdiag/utils/logger.hpp>
+#include <xdiag/utils/profile.hpp>
+
+namespace xdiag::basis::spinhalf_distributed {
+
+template <typename coeff_t, class basis_t>
+void apply_terms_symmetric(OpSum const &ops, basis_t const &basis_in,
+                           arma::Col<coeff_t> const &vec_in,
+                           basis_t const &basis_out,
+                           arma::Col<coeff_t> &vec_out) try {
+  using bit_t = typename basis_t::bit_t;
+
+  auto fill = [&](int64_t idx_in, int64_t idx_out, coeff_t val) {
+    vec_out(idx_out) += val * vec_in(idx_in);
+  };
+
+  double time_start = MPI_Wtime();
+  for (auto [cpl, op] : ops.plain()) {
+    std::string type = op.type();
+    profile::Scope scope("SpinhalfDistributed", type);
+    coeff_t J = cpl.scalar().template as<coeff_t>();
+
+    // Diagonal operators are applied locally if the basis does not change
+    bool diagonal = (type == "SzSz") || (type == "Sz") || (type == "Id");
+    if (diagonal && (basis_in == basis_out)) {
+      if (type == "SzSz") {
+        spinhalf::apply_szsz<coeff_t, true>(cpl, op, basis_in, basis_out, fill);
+      } else if (type == "Sz") {
+        spinhalf::apply_sz<coeff_t, true>(cpl, op, basis_in, basis_out, fill);
+      } else {
+        apply_identity<coeff_t>(cpl, basis_in, fill);
+      }
+      continue;
+    }
+
+    // All other operators route the new states to the owning process
+    std::function<bool(bit_t)> non_zero_term;
+    std::function<std::pair<bit_t, coeff_t>(bit_t)> term_action;
+
+    if (type == "Exchange") {
+      bit_t flipmask = ((bit_t)1 << op[0]) | ((bit_t)1 << op[1]);
+      bit_t s1mask = (bit_t)1 << op[0];
+      coeff_t Jhalf = J / 2.0;
+      coeff_t Jhalf_conj = xdiag::conj(Jhalf);
+      non_zero_term = [=](bit_t spins) {
+        return bits::popcnt(spins & flipmask) & 1;
+      };
+      term_action = [=](bit_t spins) -> std::pair<bit_t, coeff_t> {
+        return {spins ^ flipmask, (spins & s1mask) ? Jhalf : Jhalf_conj};
+      };
+    } else if (type == "S+") {
+      bit_t mask = (bit_t)1 << op[0];
+      non_zero_term = [=](bit_t spins) { return !(spins & mask); };
+      term_action = [=](bit_t spins) -> std::pair<bit_t, coeff_t> {
+        return {spins | mask, J};
+      };
+    } else if (type == "S-") {
+      bit_t mask = (bit_t)1 << op[0];
+      non_zero_term = [=](bit_t spins) { return (bool)(spins & mask); };
+      term_action = [=](bit_t spins) -> std::pair<bit_t, coeff_t> {
+        return {spins ^ mask, J};
+      };
+    } else if (type == "SzSz") {
+      bit_t mask = ((bit_t)1 << op[0]) | ((bit_t)1 << op[1]);
+      non_zero_term = [](bit_t) { return true; };
+      term_action = [=](bit_t spins) -> std::pair<bit_t, coeff_t> {
+        return {spins, (bits::popcnt(spins & mask) & 1) ? -J / 4.0 : J / 4.0};
+      };
+    } else if (type == "Sz") {
+      bit_t mask = (bit_t)1 << op[0];
+      non_zero_term = [](bit_t) { return true; };
+      term_action = [=](bit_t spins) -> std::pair<bit_t, coeff_t> {
+        return {spins, (spins & mask) ? J / 2.0 : -J / 2.0};
+      };
+    } else if (type == "Id") {
+      non_zero_term = [](bit_t) { return true; };
+      term_action = [=](bit_t spins) -> std::pair<bit_t, coeff_t> {
+        return {spins, J};
+      };
+    } else {
+      XDIAG_THROW(fmt::format(
+          "Unknown Op for symmetric SpinhalfDistributed block: \"{}\"", type));
+    }
+    apply_term_offdiag_sym(op, basis_in, vec_in, basis_out, vec_out,
+                           non_zero_term, term_action);
+  }
+  double time_end = MPI_Wtime();
+  Log(3, "  symmetric ops: {:.6f} secs", time_end - time_start);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+using basis_lookup32_t =
+    BasisSymmetricSz<uint32_t, GroupActionLookup<uint32_t>>;
+using basis_lookup64_t =
+    BasisSymmetricSz<uint64_t, GroupActionLookup<uint64_t>>;
+using basis_sublattice1_t =
+    BasisSymmetricSz<uint64_t, GroupActionSublattice<uint64_t, 1>>;
+using basis_sublattice2_t =
+    BasisSymmetricSz<uint64_t, GroupActionSublattice<uint64_t, 2>>;
+using basis_sublattice3_t =
+    BasisSymmetricSz<uint64_t, GroupActionSublattice<uint64_t, 3>>;
+using basis_sublattice4_t =
+    BasisSymmetricSz<uint64_t, GroupActionSublattice<uint64_t, 4>>;
+using basis_sublattice5_t =
+    BasisSymmetricSz<uint64_t, GroupActionSublattice<uint64_t, 5>>;
+
+template void
+apply_terms_symmetric(OpSum const &, basis_lookup32_t const &,
+                      arma::Col<double> const &, basis_lookup32_t const &,
+                      arma::Col<double> &);
+template void
+apply_terms_symmetric(OpSum const &, basis_lookup32_t const &,
+                      arma::Col<complex> const &, basis_lookup32_t const &,
+                      arma::Col<complex> &);
+template void
+apply_terms_symmetric(OpSum const &, basis_lookup64_t const &,
+                      arma::Col<double> const &, basis_lookup64_t const &,
+                      arma::Col<double> &);
+template void
+apply_terms_symmetric(OpSum const &, basis_lookup64_t const &,
+                      arma::Col<complex> const &, basis_lookup64_t const &,
+                      arma::Col<complex> &);
+template void
+apply_terms_symmetric(OpSum const &, basis_sublattice1_t const &,
+                      arma::Col<double> const &, basis_sublattice1_t const &,
+                      arma::Col<double> &);
+template void
+apply_terms_symmetric(OpSum const &, basis_sublattice1_t const &,
+                      arma::Col<complex> const &, basis_sublattice1_t const &,
+                      arma::Col<complex> &);
+template void
+apply_terms_symmetric(OpSum const &, basis_sublattice2_t const &,
+                      arma::Col<double> const &, basis_sublattice2_t const &,
+                      arma::Col<double> &);
+template void
+apply_terms_symmetric(OpSum const &, basis_sublattice2_t const &,
+                      arma::Col<complex> const &, basis_sublattice2_t const &,
+                      arma::Col<complex> &);
+template void
+apply_terms_symmetric(OpSum const &, basis_sublattice3_t const &,
+                      arma::Col<double> const &, basis_sublattice3_t const &,
+                      arma::Col<double> &);
+template void
+apply_terms_symmetric(OpSum const &, basis_sublattice3_t const &,
+                      arma::Col<complex> const &, basis_sublattice3_t const &,
+                      arma::Col<complex> &);
+template void
+apply_terms_symmetric(OpSum const &, basis_sublattice4_t const &,
+                      arma::Col<double> const &, basis_sublattice4_t const &,
+                      arma::Col<double> &);
+template void
+apply_terms_symmetric(OpSum const &, basis_sublattice4_t const &,
+                      arma::Col<complex> const &, basis_sublattice4_t const &,
+                      arma::Col<complex> &);
+template void
+apply_terms_symmetric(OpSum const &, basis_sublattice5_t const &,
+                      arma::Col<double> const &, basis_sublattice5_t const &,
+                      arma::Col<double> &);
+template void
+apply_terms_symmetric(OpSum const &, basis_sublattice5_t const &,
+                      arma::Col<complex> const &, basis_sublattice5_t const &,
+                      arma::Col<complex> &);
+
+} // namespace xdiag::basis::spinhalf_distributed
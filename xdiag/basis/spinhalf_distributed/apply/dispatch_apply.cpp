@@ -5,6 +5,7 @@
 #include "dispatch_apply.hpp"
 
 #include <xdiag/basis/spinhalf_distributed/apply/apply_terms.hpp>
+#include <xdiag/basis/spinhalf_distributed/apply/apply_terms_symmetric.hpp>
 
 namespace xdiag::basis {
 
@@ -20,9 +21,15 @@ void dispatch_apply(OpSum const &ops, SpinhalfDistributed const &block_in,
       [&](auto &&basis_in, auto &&basis_out) {
         using basis_in_t = typename std::decay<decltype(basis_in)>::type;
         using basis_out_t = typename std::decay<decltype(basis_out)>::type;
-        if constexpr (std::is_same<basis_in_t, basis_out_t>::value) {
+        using bit_t = typename basis_in_t::bit_t;
+        using basis_sz_t = basis::spinhalf_distributed::BasisSz<bit_t>;
+        if constexpr (std::is_same<basis_in_t, basis_out_t>::value &&
+                      std::is_same<basis_in_t, basis_sz_t>::value) {
           basis::spinhalf_distributed::apply_terms(ops, basis_in, vec_in,
                                                    basis_out, vec_out);
+        } else if constexpr (std::is_same<basis_in_t, basis_out_t>::value) {
+          basis::spinhalf_distributed::apply_terms_symmetric(
+              ops, basis_in, vec_in, basis_out, vec_out);
         } else {
           XDIAG_THROW(
               "Invalid combination of bases for \"SpinhalfDistributed\" block.")
@@ -6,6 +6,7 @@
 #ifdef XDIAG_USE_MPI
 #include <variant>
 #include <xdiag/common.hpp>
+#include <xdiag/basis/spinhalf_distributed/basis_symmetric_sz.hpp>
 #include <xdiag/basis/spinhalf_distributed/basis_sz.hpp>
 
 namespace xdiag::basis {
@@ -13,13 +14,22 @@ namespace xdiag::basis {
 // clang-format off
 using BasisSpinhalfDistributed =
   std::variant<basis::spinhalf_distributed::BasisSz<uint32_t>,
-	       basis::spinhalf_distributed::BasisSz<uint64_t>>;
+	       basis::spinhalf_distributed::BasisSz<uint64_t>,
+	       basis::spinhalf_distributed::BasisSymmetricSz<uint32_t, GroupActionLookup<uint32_t>>,
+	       basis::spinhalf_distributed::BasisSymmetricSz<uint64_t, GroupActionLookup<uint64_t>>,
+	       basis::spinhalf_distributed::BasisSymmetricSz<uint64_t, GroupActionSublattice<uint64_t, 1>>,
+	       basis::spinhalf_distributed::BasisSymmetricSz<uint64_t, GroupActionSublattice<uint64_t, 2>>,
+	       basis::spinhalf_distributed::BasisSymmetricSz<uint64_t, GroupActionSublattice<uint64_t, 3>>,
+	       basis::spinhalf_distributed::BasisSymmetricSz<uint64_t, GroupActionSublattice<uint64_t, 4>>,
+	       basis::spinhalf_distributed::BasisSymmetricSz<uint64_t, GroupActionSublattice<uint64_t, 5>>>;
 // clang-format on
 
 // clang-format off
 using BasisSpinhalfDistributedIterator =
   std::variant<basis::spinhalf_distributed::BasisSzIterator<uint32_t>,
-	       basis::spinhalf_distributed::BasisSzIterator<uint64_t>>;
+	       basis::spinhalf_distributed::BasisSzIterator<uint64_t>,
+	       std::vector<uint32_t>::const_iterator,
+	       std::vector<uint64_t>::const_iterator>;
 // clang-format on
   
 int64_t dim(BasisSpinhalfDistributed const &basis);
@@ -0,0 +1,192 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "basis_symmetric_sz.hpp"
+
+#include <xdiag/combinatorics/combinations.hpp>
+#include <xdiag/combinatorics/subsets.hpp>
+#include <xdiag/parallel/mpi/allreduce.hpp>
+#include <xdiag/parallel/mpi/communicator.hpp>
+#include <xdiag/utils/logger.hpp>
+
+namespace xdiag::basis::spinhalf_distributed {
+
+// Every process enumerates the states of its share of prefixes, keeps the
+// representatives with nonzero norm and sends them to the owning process
+template <typename bit_t, class basis_t, typename coeff_t>
+static std::vector<bit_t>
+representatives(int64_t nsites, int64_t nup, int64_t n_prefix_bits,
+                basis_t const &basis, arma::Col<coeff_t> const &characters) {
+  int mpi_rank, mpi_size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+
+  int64_t n_postfix_bits = nsites - n_prefix_bits;
+  std::vector<std::vector<bit_t>> reps_for_rank(mpi_size);
+  int64_t prefix_idx = 0;
+  for (bit_t prefix : combinatorics::Subsets<bit_t>(n_prefix_bits)) {
+    int64_t nup_prefix = bits::popcnt(prefix);
+    int64_t nup_postfix = nup - nup_prefix;
+    if ((nup_postfix < 0) || (nup_postfix > n_postfix_bits)) {
+      continue;
+    }
+    if ((prefix_idx++ % mpi_size) != mpi_rank) {
+      continue;
+    }
+
+    for (bit_t postfix :
+         combinatorics::Combinations<bit_t>(n_postfix_bits, nup_postfix)) {
+      bit_t state = (prefix << n_postfix_bits) | postfix;
+      if (basis.representative(state) == state) {
+        double nrm = symmetries::norm(state, basis.group_action(), characters);
+        if (std::abs(nrm) > 1e-6) {
+          reps_for_rank[basis.rank(state)].push_back(state);
+        }
+      }
+    }
+  }
+
+  // Send the representatives to their owners
+  std::vector<int64_t> n_reps_i_send(mpi_size, 0);
+  for (int r = 0; r < mpi_size; ++r) {
+    n_reps_i_send[r] = reps_for_rank[r].size();
+  }
+  mpi::Communicator comm(n_reps_i_send);
+  std::vector<bit_t> send_buffer(comm.send_buffer_size());
+  std::vector<bit_t> recv_buffer(comm.recv_buffer_size());
+  for (int r = 0; r < mpi_size; ++r) {
+    std::copy(reps_for_rank[r].begin(), reps_for_rank[r].end(),
+              send_buffer.begin() + comm.n_values_i_send_offset(r));
+  }
+  comm.all_to_all(send_buffer.data(), recv_buffer.data());
+
+  std::sort(recv_buffer.begin(), recv_buffer.end());
+  return recv_buffer;
+}
+
+template <typename bit_t, class group_action_t>
+BasisSymmetricSz<bit_t, group_action_t>::BasisSymmetricSz(
+    int64_t nup, Representation const &irrep) try
+    : nsites_(irrep.group().nsites()), nup_(nup), n_prefix_bits_(nsites_ / 2),
+      n_postfix_bits_(nsites_ - n_prefix_bits_), group_action_(irrep.group()),
+      irrep_(irrep), characters_(irrep.characters()) {
+  check_nsites_work_with_bits<bit_t>(nsites_);
+
+  if (nup < 0) {
+    XDIAG_THROW("Invalid value of nup: nup < 0");
+  } else if (nup > nsites_) {
+    XDIAG_THROW("Invalid value of nup: nup > nsites");
+  }
+
+  MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank_);
+  MPI_Comm_size(MPI_COMM_WORLD, &mpi_size_);
+
+  if (isreal(irrep)) {
+    arma::vec characters = irrep.characters().as<arma::vec>();
+    reps_ = representatives<bit_t>(nsites_, nup, n_prefix_bits_, *this,
+                                   characters);
+    norms_.resize(reps_.size());
+    for (int64_t idx = 0; idx < (int64_t)reps_.size(); ++idx) {
+      norms_[idx] = symmetries::norm(reps_[idx], group_action_, characters);
+    }
+  } else {
+    arma::cx_vec characters = irrep.characters().as<arma::cx_vec>();
+    reps_ = representatives<bit_t>(nsites_, nup, n_prefix_bits_, *this,
+                                   characters);
+    norms_.resize(reps_.size());
+    for (int64_t idx = 0; idx < (int64_t)reps_.size(); ++idx) {
+      norms_[idx] = symmetries::norm(reps_[idx], group_action_, characters);
+    }
+  }
+
+  size_ = reps_.size();
+  mpi::Allreduce(&size_, &dim_, 1, MPI_SUM, MPI_COMM_WORLD);
+  mpi::Allreduce(&size_, &size_max_, 1, MPI_MAX, MPI_COMM_WORLD);
+  mpi::Allreduce(&size_, &size_min_, 1, MPI_MIN, MPI_COMM_WORLD);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <typename bit_t, class group_action_t>
+int64_t BasisSymmetricSz<bit_t, group_action_t>::nsites() const {
+  return nsites_;
+}
+template <typename bit_t, class group_action_t>
+int64_t BasisSymmetricSz<bit_t, group_action_t>::nup() const {
+  return nup_;
+}
+template <typename bit_t, class group_action_t>
+int64_t BasisSymmetricSz<bit_t, group_action_t>::dim() const {
+  return dim_;
+}
+template <typename bit_t, class group_action_t>
+int64_t BasisSymmetricSz<bit_t, group_action_t>::size() const {
+  return size_;
+}
+template <typename bit_t, class group_action_t>
+int64_t BasisSymmetricSz<bit_t, group_action_t>::size_max() const {
+  return size_max_;
+}
+template <typename bit_t, class group_action_t>
+int64_t BasisSymmetricSz<bit_t, group_action_t>::size_min() const {
+  return size_min_;
+}
+template <typename bit_t, class group_action_t>
+typename BasisSymmetricSz<bit_t, group_action_t>::iterator_t
+BasisSymmetricSz<bit_t, group_action_t>::begin() const {
+  return reps_.begin();
+}
+template <typename bit_t, class group_action_t>
+typename BasisSymmetricSz<bit_t, group_action_t>::iterator_t
+BasisSymmetricSz<bit_t, group_action_t>::end() const {
+  return reps_.end();
+}
+
+template <typename bit_t, class group_action_t>
+int64_t BasisSymmetricSz<bit_t, group_action_t>::index(bit_t spins) const {
+  return index_of_representative(representative(spins));
+}
+
+template <typename bit_t, class group_action_t>
+group_action_t const &
+BasisSymmetricSz<bit_t, group_action_t>::group_action() const {
+  return group_action_;
+}
+template <typename bit_t, class group_action_t>
+Representation const &BasisSymmetricSz<bit_t, group_action_t>::irrep() const {
+  return irrep_;
+}
+template <typename bit_t, class group_action_t>
+Vector const &BasisSymmetricSz<bit_t, group_action_t>::characters() const {
+  return characters_;
+}
+
+template <typename bit_t, class group_action_t>
+mpi::CommPattern &
+BasisSymmetricSz<bit_t, group_action_t>::comm_pattern() const {
+  return comm_pattern_;
+}
+
+template <typename bit_t, class group_action_t>
+bool BasisSymmetricSz<bit_t, group_action_t>::operator==(
+    BasisSymmetricSz const &rhs) const {
+  return (nsites_ == rhs.nsites_) && (nup_ == rhs.nup_) &&
+         (group_action_ == rhs.group_action_) && (irrep_ == rhs.irrep_);
+}
+
+template <typename bit_t, class group_action_t>
+bool BasisSymmetricSz<bit_t, group_action_t>::operator!=(
+    BasisSymmetricSz const &rhs) const {
+  return !operator==(rhs);
+}
+
+template class BasisSymmetricSz<uint32_t, GroupActionLookup<uint32_t>>;
+template class BasisSymmetricSz<uint64_t, GroupActionLookup<uint64_t>>;
+template class BasisSymmetricSz<uint64_t, GroupActionSublattice<uint64_t, 1>>;
+template class BasisSymmetricSz<uint64_t, GroupActionSublattice<uint64_t, 2>>;
+template class BasisSymmetricSz<uint64_t, GroupActionSublattice<uint64_t, 3>>;
+template class BasisSymmetricSz<uint64_t, GroupActionSublattice<uint64_t, 4>>;
+template class BasisSymmetricSz<uint64_t, GroupActionSublattice<uint64_t, 5>>;
+
+} // namespace xdiag::basis::spinhalf_distributed
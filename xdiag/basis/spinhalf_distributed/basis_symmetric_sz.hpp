@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifdef XDIAG_USE_MPI
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <xdiag/common.hpp>
+#include <xdiag/parallel/mpi/comm_pattern.hpp>
+#include <xdiag/random/hash_functions.hpp>
+#include <xdiag/symmetries/group_action/group_action_lookup.hpp>
+#include <xdiag/symmetries/group_action/group_action_sublattice.hpp>
+#include <xdiag/symmetries/operations/group_action_operations.hpp>
+#include <xdiag/symmetries/representation.hpp>
+
+namespace xdiag::basis::spinhalf_distributed {
+
+// Distributed basis of symmetry adapted states with fixed number of up spins.
+//
+// Representatives are assigned to MPI processes by a hash of the
+// representative. Every process stores its representatives in ascending
+// order, such that the local index of a representative is found by binary
+// search. Representatives and symmetries of arbitrary states are computed on
+// the fly using the group action, which can either be a "GroupActionLookup"
+// or a "GroupActionSublattice".
+template <typename bit_tt, class group_action_tt> class BasisSymmetricSz {
+public:
+  using bit_t = bit_tt;
+  using group_action_t = group_action_tt;
+  using iterator_t = typename std::vector<bit_t>::const_iterator;
+
+  BasisSymmetricSz() = default;
+  BasisSymmetricSz(int64_t nup, Representation const &irrep);
+
+  int64_t nsites() const;
+  int64_t nup() const;
+
+  int64_t dim() const;
+  int64_t size() const;
+  int64_t size_max() const;
+  int64_t size_min() const;
+  iterator_t begin() const;
+  iterator_t end() const;
+
+  // local index of the representative of spins, invalid_index if the
+  // representative is not stored on this process
+  int64_t index(bit_t spins) const;
+  inline bit_t state(int64_t idx) const { return reps_[idx]; }
+  inline double norm(int64_t idx) const { return norms_[idx]; }
+
+  group_action_t const &group_action() const;
+  Representation const &irrep() const;
+  Vector const &characters() const;
+
+  // MPI rank owning a representative
+  inline int rank(bit_t rep) const {
+    return (int)(random::hash_div3(rep) % mpi_size_);
+  }
+
+  static constexpr bool lookup =
+      std::is_same<group_action_t, GroupActionLookup<bit_t>>::value;
+
+  inline bit_t representative(bit_t spins) const {
+    if constexpr (lookup) {
+      return symmetries::representative(spins, group_action_);
+    } else {
+      return group_action_.representative(spins);
+    }
+  }
+
+  inline std::pair<bit_t, int64_t> representative_sym(bit_t spins) const {
+    if constexpr (lookup) {
+      return symmetries::representative_sym(spins, group_action_);
+    } else {
+      return group_action_.representative_sym(spins);
+    }
+  }
+
+  inline int64_t index_of_representative(bit_t rep) const {
+    auto it = std::lower_bound(reps_.begin(), reps_.end(), rep);
+    if ((it != reps_.end()) && (*it == rep)) {
+      return (int64_t)(it - reps_.begin());
+    } else {
+      return invalid_index;
+    }
+  }
+
+  inline std::pair<int64_t, int64_t> index_sym(bit_t spins) const {
+    auto [rep, sym] = representative_sym(spins);
+    return {index_of_representative(rep), sym};
+  }
+
+  mpi::CommPattern &comm_pattern() const;
+
+  bool operator==(BasisSymmetricSz const &rhs) const;
+  bool operator!=(BasisSymmetricSz const &rhs) const;
+
+private:
+  int64_t nsites_;
+  int64_t nup_;
+  int64_t n_prefix_bits_;
+  int64_t n_postfix_bits_;
+
+  group_action_t group_action_;
+  Representation irrep_;
+  Vector characters_;
+
+  int64_t dim_;
+  int64_t size_;
+  int64_t size_max_;
+  int64_t size_min_;
+
+  int mpi_rank_;
+  int mpi_size_;
+
+  std::vector<bit_t> reps_;
+  std::vector<double> norms_;
+
+  mutable mpi::CommPattern comm_pattern_;
+};
+
+} // namespace xdiag::basis::spinhalf_distributed
+#endif
@@ -8,6 +8,7 @@
 #include <xdiag/combinatorics/combinations.hpp>
 #include <xdiag/combinatorics/subsets.hpp>
 #include <xdiag/parallel/mpi/allreduce.hpp>
+#include <xdiag/utils/logger.hpp>
 
 namespace xdiag::basis::spinhalf_distributed {
 
@@ -66,8 +67,66 @@ fill_tables(int64_t nsites, int64_t nup, int64_t n_prefix_bits, process_f rank,
   return size;
 }
 
+// Possible number of up spins of prefixes with n_prefix_bits bits
+static std::vector<int64_t> nups_prefix(int64_t nsites, int64_t nup,
+                                        int64_t n_prefix_bits) {
+  int64_t n_postfix_bits = nsites - n_prefix_bits;
+  std::vector<int64_t> nups;
+  for (int64_t k = 0; k <= n_prefix_bits; ++k) {
+    if ((nup - k >= 0) && (nup - k <= n_postfix_bits)) {
+      nups.push_back(k);
+    }
+  }
+  return nups;
+}
+
+// Computes where the values received from other processes during a
+// transpose are stored in the transposed order
 template <typename bit_t>
-BasisSz<bit_t>::BasisSz(int64_t nsites, int64_t nup)
+static std::vector<int64_t>
+compute_transpose_permutation(BasisSz<bit_t> const &basis, bool reverse) {
+  int mpi_size;
+  MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+
+  mpi::Communicator com = basis.transpose_communicator(reverse);
+  std::vector<int64_t> permutation(com.recv_buffer_size());
+  std::vector<int64_t> offsets(mpi_size, 0);
+
+  int n_prefix_bits = reverse ? basis.n_postfix_bits() : basis.n_prefix_bits();
+  int n_postfix_bits = reverse ? basis.n_prefix_bits() : basis.n_postfix_bits();
+  auto const &postfixes = reverse ? basis.prefixes() : basis.postfixes();
+
+  for (auto prefix : combinatorics::Subsets<bit_t>(n_prefix_bits)) {
+    int nup_prefix = bits::popcnt(prefix);
+    int nup_postfix = basis.nup() - nup_prefix;
+    if ((nup_postfix < 0) || (nup_postfix > n_postfix_bits)) {
+      continue;
+    }
+
+    int origin_rank =
+        reverse ? basis.rank_transpose(prefix) : basis.rank(prefix);
+    int64_t origin_offset = com.n_values_i_recv_offset(origin_rank);
+    bit_t postfix_min = ((bit_t)1 << nup_postfix) - 1;
+    int64_t prefix_idx =
+        reverse ? basis.postfix_lintable(postfix_min).index(prefix)
+                : basis.prefix_lintable(postfix_min).index(prefix);
+
+    for (bit_t postfix : postfixes) {
+      if (bits::popcnt(postfix) != nup_postfix) {
+        continue;
+      }
+      int64_t idx_received = origin_offset + offsets[origin_rank];
+      int64_t postfix_begin = reverse ? basis.prefix_begin(postfix)
+                                      : basis.postfix_begin(postfix);
+      permutation[idx_received] = postfix_begin + prefix_idx;
+      ++offsets[origin_rank];
+    }
+  }
+  return permutation;
+}
+
+template <typename bit_t>
+BasisSz<bit_t>::BasisSz(int64_t nsites, int64_t nup, std::string partition)
     : nsites_(nsites), nup_(nup), n_prefix_bits_(nsites / 2),
       n_postfix_bits_(nsites - n_prefix_bits_) {
   using namespace combinatorics;
@@ -83,6 +142,10 @@ BasisSz<bit_t>::BasisSz(int64_t nsites, int64_t nup)
 
   MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank_);
   MPI_Comm_size(MPI_COMM_WORLD, &mpi_size_);
+  partition_ = mpi::Partition<bit_t>(
+      n_prefix_bits_, nups_prefix(nsites, nup, n_prefix_bits_), partition);
+  partition_transpose_ = mpi::Partition<bit_t>(
+      n_postfix_bits_, nups_prefix(nsites, nup, n_postfix_bits_), partition);
 
   dim_ = binomial(nsites, nup);
   size_ = fill_tables(
@@ -90,8 +153,9 @@ BasisSz<bit_t>::BasisSz(int64_t nsites, int64_t nup)
       prefixes_, prefix_begin_, postfix_lintables_, postfix_states_);
 
   size_transpose_ = fill_tables(
-      nsites, nup, n_postfix_bits_, [this](bit_t spins) { return rank(spins); },
-      postfixes_, postfix_begin_, prefix_lintables_, prefix_states_);
+      nsites, nup, n_postfix_bits_,
+      [this](bit_t spins) { return rank_transpose(spins); }, postfixes_,
+      postfix_begin_, prefix_lintables_, prefix_states_);
 
   // Compute max/min number of states stored locally
   int64_t size_max;
@@ -107,6 +171,8 @@ BasisSz<bit_t>::BasisSz(int64_t nsites, int64_t nup)
   mpi::Allreduce(&size_transpose_, &size_min_transpose, 1, MPI_MIN,
                  MPI_COMM_WORLD);
   size_min_ = std::min(size_min, size_min_transpose);
+  Log(1, "SpinhalfDistributed partition \"{}\": imbalance factor {:.4f}",
+      partition, mpi::imbalance_factor(size_max_, dim_));
 
   // Check local sizes sum up to the actual dimension
   int64_t dim;
@@ -121,11 +187,11 @@ BasisSz<bit_t>::BasisSz(int64_t nsites, int64_t nup)
   std::vector<int64_t> n_states_i_send(mpi_size_, 0);
   for (bit_t prefix : prefixes()) {
     for (bit_t postfix : postfix_states(prefix)) {
-      int target_rank = rank(postfix);
+      int target_rank = rank_transpose(postfix);
       ++n_states_i_send[target_rank];
     }
   }
-  transpose_communicator_ = mpi::Communicator(n_states_i_send);
+  transpose_communicator_ = mpi::Communicator(n_states_i_send, true);
 
   // Create the transpose communicator (reverse)
   std::vector<int64_t> n_states_i_send_reverse(mpi_size_, 0);
@@ -135,13 +201,21 @@ BasisSz<bit_t>::BasisSz(int64_t nsites, int64_t nup)
       ++n_states_i_send_reverse[target_rank];
     }
   }
-  transpose_communicator_reverse_ = mpi::Communicator(n_states_i_send_reverse);
+  transpose_communicator_reverse_ =
+      mpi::Communicator(n_states_i_send_reverse, true);
+
+  transpose_permutation_ = compute_transpose_permutation(*this, false);
+  transpose_permutation_reverse_ =
+      compute_transpose_permutation(*this, true);
 }
 
 template <typename bit_t> int64_t BasisSz<bit_t>::nsites() const {
   return nsites_;
 }
 template <typename bit_t> int64_t BasisSz<bit_t>::nup() const { return nup_; }
+template <typename bit_t> std::string BasisSz<bit_t>::partition() const {
+  return partition_.type();
+}
 template <typename bit_t> int64_t BasisSz<bit_t>::n_prefix_bits() const {
   return n_prefix_bits_;
 };
@@ -243,6 +317,12 @@ mpi::Communicator BasisSz<bit_t>::transpose_communicator(bool reverse) const {
   return reverse ? transpose_communicator_reverse_ : transpose_communicator_;
 }
 
+template <typename bit_t>
+std::vector<int64_t> const &
+BasisSz<bit_t>::transpose_permutation(bool reverse) const {
+  return reverse ? transpose_permutation_reverse_ : transpose_permutation_;
+}
+
 template class BasisSz<uint32_t>;
 template class BasisSz<uint64_t>;
 
@@ -12,7 +12,7 @@
 #include <xdiag/common.hpp>
 #include <xdiag/parallel/mpi/comm_pattern.hpp>
 #include <xdiag/parallel/mpi/communicator.hpp>
-#include <xdiag/random/hash_functions.hpp>
+#include <xdiag/parallel/mpi/partition.hpp>
 
 namespace xdiag::basis::spinhalf_distributed {
 
@@ -24,10 +24,11 @@ public:
   using iterator_t = BasisSzIterator<bit_t>;
 
   BasisSz() = default;
-  BasisSz(int64_t nsites, int64_t nup);
+  BasisSz(int64_t nsites, int64_t nup, std::string partition = "hash");
 
   int64_t nsites() const;
   int64_t nup() const;
+  std::string partition() const;
 
   int64_t n_prefix_bits() const;
   int64_t n_postfix_bits() const;
@@ -51,13 +52,20 @@ public:
   combinatorics::LinTable<bit_t> const &prefix_lintable(bit_t postfix) const;
   std::vector<bit_t> const &prefix_states(bit_t postfix) const;
 
-  inline int rank(bit_t spins) const {
-    return (int)(random::hash_div3(spins) % mpi_size_);
+  // MPI rank owning a prefix in prefix / postfix order
+  inline int rank(bit_t prefix) const { return partition_.rank(prefix); };
+
+  // MPI rank owning a postfix in postfix / prefix (transposed) order
+  inline int rank_transpose(bit_t postfix) const {
+    return partition_transpose_.rank(postfix);
   };
 
   mpi::CommPattern &comm_pattern() const;
   mpi::Communicator transpose_communicator(bool reverse) const;
 
+  // position in the transposed order of every value received in a transpose
+  std::vector<int64_t> const &transpose_permutation(bool reverse) const;
+
   bool operator==(BasisSz const &rhs) const;
   bool operator!=(BasisSz const &rhs) const;
 
@@ -76,6 +84,8 @@ private:
 
   int mpi_rank_;
   int mpi_size_;
+  mpi::Partition<bit_t> partition_;
+  mpi::Partition<bit_t> partition_transpose_;
 
   std::vector<bit_t> prefixes_;
   std::unordered_map<bit_t, int64_t> prefix_begin_;
@@ -90,6 +100,8 @@ private:
   mutable mpi::CommPattern comm_pattern_;
   mpi::Communicator transpose_communicator_;
   mpi::Communicator transpose_communicator_reverse_;
+  std::vector<int64_t> transpose_permutation_;
+  std::vector<int64_t> transpose_permutation_reverse_;
 };
 
 template <typename bit_tt> class BasisSzIterator {
@@ -11,6 +11,7 @@
 #include <xdiag/basis/tj/apply/apply_raise_lower.hpp>
 #include <xdiag/basis/tj/apply/apply_szsz.hpp>
 #include <xdiag/common.hpp>
+#include <xdiag/utils/profile.hpp>
 
 namespace xdiag::basis::tj {
 
@@ -20,6 +21,7 @@ void apply_terms(OpSum const &ops, basis_t const &basis_in,
 
   for (auto const &[cpl, op] : ops) {
     std::string type = op.type();
+    profile::Scope scope("tJ", type);
     if ((type == "SzSz") || (type == "tJSzSz")) {
       tj::apply_szsz<coeff_t, symmetric>(cpl, op, basis_in, fill);
     } else if ((type == "Nup") || (type == "Ndn")) {
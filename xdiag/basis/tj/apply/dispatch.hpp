@@ -5,16 +5,14 @@
 #pragma once
 
 #include <xdiag/basis/tj/apply/apply_terms.hpp>
+#include <xdiag/basis/spinflip_projection.hpp>
 #include <xdiag/common.hpp>
 
 namespace xdiag::basis::tj {
 
 template <typename coeff_t, class fill_f>
-inline void dispatch(OpSum const &ops, tJ const &block_in, tJ const &block_out,
-                     fill_f &&fill) try {
-  auto const &basis_in = block_in.basis();
-  auto const &basis_out = block_out.basis();
-
+inline void dispatch(OpSum const &ops, BasistJ const &basis_in,
+                     BasistJ const &basis_out, fill_f &fill) try {
   std::visit(overload{// uint32_t
                       [&](BasisNp<uint32_t> const &idx_in,
                           BasisNp<uint32_t> const &idx_out) {
@@ -41,4 +39,25 @@ inline void dispatch(OpSum const &ops, tJ const &block_in, tJ const &block_out,
   XDIAG_RETHROW(e);
 }
 
+// Blocks with spin flip symmetry are applied with the kernels of the
+// symmetric bases, whose matrix elements are projected onto the spin flip
+// symmetric states
+template <typename coeff_t, class fill_f>
+inline void dispatch(OpSum const &ops, tJ const &block_in,
+                     tJ const &block_out, fill_f &&fill) try {
+  if (block_in.spinflip() && block_out.spinflip()) {
+    auto fill_projected = projected_fill<coeff_t>(
+        block_in.projection(), block_out.projection(), fill);
+    dispatch<coeff_t>(ops, block_in.basis(), block_out.basis(),
+                      fill_projected);
+  } else if (block_in.spinflip() || block_out.spinflip()) {
+    XDIAG_THROW("Either both or none of the blocks must have a spin flip "
+                "symmetry");
+  } else {
+    dispatch<coeff_t>(ops, block_in.basis(), block_out.basis(), fill);
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
 } // namespace xdiag::basis::tj
@@ -13,10 +13,9 @@ template <typename coeff_t>
 void dispatch_apply(OpSum const &ops, tJ const &block_in,
                     arma::Col<coeff_t> const &vec_in, tJ const &block_out,
                     arma::Col<coeff_t> &vec_out) try {
-  auto fill = [&](int64_t idx_in, int64_t idx_out, coeff_t val) {
-    return fill_apply(vec_in, vec_out, idx_in, idx_out, val);
-  };
-  tj::dispatch<coeff_t>(ops, block_in, block_out, fill);
+  using kernel_coeff_t = apply_coeff_t<coeff_t>;
+  ApplyFill<coeff_t, kernel_coeff_t> fill(vec_in, vec_out);
+  tj::dispatch<kernel_coeff_t>(ops, block_in, block_out, fill);
 } catch (Error const &error) {
   XDIAG_RETHROW(error);
 }
@@ -25,15 +24,20 @@ template void dispatch_apply(OpSum const &, tJ const &, arma::vec const &,
                              tJ const &block, arma::vec &);
 template void dispatch_apply(OpSum const &, tJ const &, arma::cx_vec const &,
                              tJ const &block, arma::cx_vec &);
+template void dispatch_apply(OpSum const &, tJ const &, arma::fvec const &,
+                             tJ const &block, arma::fvec &);
+template void dispatch_apply(OpSum const &, tJ const &, arma::cx_fvec const &,
+                             tJ const &block, arma::cx_fvec &);
 
 template <typename coeff_t>
 void dispatch_apply(OpSum const &ops, tJ const &block_in,
                     arma::Mat<coeff_t> const &mat_in, tJ const &block_out,
                     arma::Mat<coeff_t> &mat_out) try {
-  auto fill = [&](int64_t idx_in, int64_t idx_out, coeff_t val) {
+  using kernel_coeff_t = apply_coeff_t<coeff_t>;
+  auto fill = [&](int64_t idx_in, int64_t idx_out, kernel_coeff_t val) {
     return fill_apply(mat_in, mat_out, idx_in, idx_out, val);
   };
-  tj::dispatch<coeff_t>(ops, block_in, block_out, fill);
+  tj::dispatch<kernel_coeff_t>(ops, block_in, block_out, fill);
 } catch (Error const &error) {
   XDIAG_RETHROW(error);
 }
@@ -42,4 +46,8 @@ template void dispatch_apply(OpSum const &, tJ const &, arma::mat const &,
                              tJ const &block, arma::mat &);
 template void dispatch_apply(OpSum const &, tJ const &, arma::cx_mat const &,
                              tJ const &block, arma::cx_mat &);
+template void dispatch_apply(OpSum const &, tJ const &, arma::fmat const &,
+                             tJ const &block, arma::fmat &);
+template void dispatch_apply(OpSum const &, tJ const &, arma::cx_fmat const &,
+                             tJ const &block, arma::cx_fmat &);
 } // namespace xdiag::basis
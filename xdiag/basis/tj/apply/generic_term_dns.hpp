@@ -6,7 +6,9 @@
 
 #include <functional>
 
+#include <xdiag/basis/spinflip_projection.hpp>
 #include <xdiag/bits/bitops.hpp>
+#include <xdiag/utils/profile.hpp>
 
 namespace xdiag::basis::tj {
 
@@ -53,7 +55,7 @@ void generic_term_dns(basis_t const &basis_in, basis_t const &basis_out,
           int64_t idx_in = up_in_offset;
           for (bit_t dnc_in : dncs_in) {
             int64_t dn_in = bits::deposit(dnc_in, not_up_in);
-            if (non_zero_term_dns(dn_in)) {
+            if (non_zero_term_dns(dn_in) && contributes(fill, idx_in)) {
               auto [dn_flip, coeff] = term_action(dn_in);
               if ((dn_flip & up_in) == 0) { // tJ constraint
                 bit_t dnc_flip = bits::extract(dn_flip, not_up_in);
@@ -77,7 +79,7 @@ void generic_term_dns(basis_t const &basis_in, basis_t const &basis_out,
           int64_t idx_in = up_in_offset;
           int64_t idx_dn_in = 0;
           for (bit_t dn_in : dncs_in) {
-            if (non_zero_term_dns(dn_in)) {
+            if (non_zero_term_dns(dn_in) && contributes(fill, idx_in)) {
               auto [dn_flip, coeff] = term_action(dn_in);
               auto [idx_dn_flip, fermi_dn, sym] =
                   basis_out.index_dns_fermi_sym(dn_flip, syms_out, dncs_out);
@@ -91,6 +93,8 @@ void generic_term_dns(basis_t const &basis_in, basis_t const &basis_out,
                 coeff_t val = coeff * bloch_factors(sym) *
                               norms_out[idx_dn_flip] / norms_in[idx_dn_in];
                 fill(idx_in, idx_out, (fermi_up ^ fermi_dn) ? -val : val);
+              } else {
+                profile::count_invalid();
               }
             }
             ++idx_dn_in;
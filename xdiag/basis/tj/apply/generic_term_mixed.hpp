@@ -6,7 +6,9 @@
 
 #include <vector>
 
+#include <xdiag/basis/spinflip_projection.hpp>
 #include <xdiag/bits/bitops.hpp>
+#include <xdiag/utils/profile.hpp>
 
 namespace xdiag::basis::tj {
 
@@ -66,7 +68,7 @@ void generic_term_mixed(BasisIn &&basis_in, BasisOut &&basis_out,
             int64_t idx_in = up_in_offset;
             for (bit_t dnc_in : dnss_in) {
               bit_t dn_in = bits::deposit(dnc_in, not_up_in);
-              if (non_zero_term_dns(dn_in)) {
+              if (non_zero_term_dns(dn_in) && contributes(fill, idx_in)) {
                 auto [dn_flip, coeff_dn] = term_actiondns(dn_in);
 
                 if ((dn_flip & up_flip) == 0) { // t-J constraint
@@ -87,7 +89,7 @@ void generic_term_mixed(BasisIn &&basis_in, BasisOut &&basis_out,
             int64_t idx_in = up_in_offset;
             int64_t idx_dn = 0;
             for (bit_t dn : dnss_in) {
-              if (non_zero_term_dns(dn)) {
+              if (non_zero_term_dns(dn) && contributes(fill, idx_in)) {
                 auto [dn_flip, coeff_dn] = term_actiondns(dn);
                 if ((dn_flip & up_flip) == 0) { // t-J constraint
                   auto [idx_dn_out, fermi_dn] =
@@ -116,7 +118,7 @@ void generic_term_mixed(BasisIn &&basis_in, BasisOut &&basis_out,
             int64_t idx_in = up_in_offset;
             for (bit_t dnc : dnss_in) {
               bit_t dn = bits::deposit(dnc, not_up_in);
-              if (non_zero_term_dns(dn)) {
+              if (non_zero_term_dns(dn) && contributes(fill, idx_in)) {
                 auto [dn_flip, coeff_dn] = term_actiondns(dn);
 
                 if ((dn_flip & up_flip) == 0) { // t-J constraint
@@ -129,6 +131,8 @@ void generic_term_mixed(BasisIn &&basis_in, BasisOut &&basis_out,
                     coeff_t val =
                         prefacs[sym] * coeff_dn * norms_out[idx_dn_out];
                     fill(idx_in, idx_out, (fermi_up ^ fermi_dn) ? -val : val);
+                  } else {
+                    profile::count_invalid();
                   }
                 }
               }
@@ -143,7 +147,7 @@ void generic_term_mixed(BasisIn &&basis_in, BasisOut &&basis_out,
             int64_t idx_in = up_in_offset;
             int64_t idx_dn = 0;
             for (bit_t dn : dnss_in) {
-              if (non_zero_term_dns(dn)) {
+              if (non_zero_term_dns(dn) && contributes(fill, idx_in)) {
                 auto [dn_flip, coeff_dn] = term_actiondns(dn);
 
                 if ((dn_flip & up_flip) == 0) { // t-J constraint
@@ -156,6 +160,8 @@ void generic_term_mixed(BasisIn &&basis_in, BasisOut &&basis_out,
                     coeff_t val = prefacs[sym] * coeff_dn *
                                   norms_out[idx_dn_out] / norms_in[idx_dn];
                     fill(idx_in, idx_out, (fermi_up ^ fermi_dn) ? -val : val);
+                  } else {
+                    profile::count_invalid();
                   }
                 }
               }
@@ -4,9 +4,13 @@
 
 #pragma once
 
+#include <tuple>
 #include <vector>
 
+#include <xdiag/algebra/fill.hpp>
+#include <xdiag/basis/spinflip_projection.hpp>
 #include <xdiag/bits/bitops.hpp>
+#include <xdiag/utils/profile.hpp>
 
 namespace xdiag::basis::tj {
 
@@ -34,7 +38,10 @@ void generic_term_ups(basis_t const &basis_in, basis_t const &basis_out,
       bit_t ups_in = basis_in.rep_ups(idx_up_in);
       if (non_zero_term(ups_in)) {
 
-        auto [ups_flip, coeff] = term_action(ups_in);
+        // no structured binding, as ups_flip is captured by the lambdas below
+        bit_t ups_flip;
+        coeff_t coeff;
+        std::tie(ups_flip, coeff) = term_action(ups_in);
         int64_t idx_ups_flip = basis_out.index_ups(ups_flip);
         bit_t ups_flip_rep = basis_out.rep_ups(idx_ups_flip);
         bit_t not_ups_flip_rep = (~ups_flip_rep) & sitesmask;
@@ -60,36 +67,46 @@ void generic_term_ups(basis_t const &basis_in, basis_t const &basis_out,
 
           // Origin ups trivial stabilizer -> dns need to be deposited
           if (syms_ups_in.size() == 1) {
-            int64_t idx_in = ups_offset_in;
             bit_t not_ups_in = (~ups_in) & sitesmask;
-            for (bit_t dnsc : dnss_in) {
-              bit_t dns = bits::deposit(dnsc, not_ups_in);
-              if ((dns & ups_flip) == 0) { // t-J constraint
-                bit_t dns_rep = group_action.apply(sym, dns);
-                bit_t dns_rep_c = bits::extract(dns_rep, not_ups_flip_rep);
-                int64_t idx_out =
-                    ups_offset_out + basis_out.dnsc_index(dns_rep_c);
-                bool fermi_dn = basis_out.fermi_bool_dns(sym, dns);
-                fill(idx_in, idx_out, (fermi_up ^ fermi_dn) ? -prefac : prefac);
-              }
-              ++idx_in;
-            }
+            staged_fill<coeff_t>(
+                dnss_in.size(),
+                [&](int64_t idx_dn, int64_t &idx_in, int64_t &idx_out,
+                    coeff_t &val) {
+                  idx_in = ups_offset_in + idx_dn;
+                  bit_t dns = bits::deposit(dnss_in[idx_dn], not_ups_in);
+                  // t-J constraint
+                  if (((dns & ups_flip) != 0) || !contributes(fill, idx_in)) {
+                    return false;
+                  }
+                  bit_t dns_rep = group_action.apply(sym, dns);
+                  bit_t dns_rep_c = bits::extract(dns_rep, not_ups_flip_rep);
+                  idx_out = ups_offset_out + basis_out.dnsc_index(dns_rep_c);
+                  bool fermi_dn = basis_out.fermi_bool_dns(sym, dns);
+                  val = (fermi_up ^ fermi_dn) ? -prefac : prefac;
+                  return true;
+                },
+                fill);
           }
           // Origin ups have stabilizer -> dns DONT need to be deposited
           else {
-            int64_t idx_dn = 0;
-            int64_t idx_in = ups_offset_in;
-            for (bit_t dns : dnss_in) {
-              if ((dns & ups_flip) == 0) { // t-J constraint
-                auto [idx_dn_out, fermi_dn] =
-                    basis_out.index_dns_fermi(dns, sym, not_ups_flip_rep);
-                coeff_t val = prefac / norms_in[idx_dn];
-                int64_t idx_out = ups_offset_out + idx_dn_out;
-                fill(idx_in, idx_out, (fermi_up ^ fermi_dn) ? -val : val);
-              }
-              ++idx_in;
-              ++idx_dn;
-            }
+            staged_fill<coeff_t>(
+                dnss_in.size(),
+                [&](int64_t idx_dn, int64_t &idx_in, int64_t &idx_out,
+                    coeff_t &val) {
+                  idx_in = ups_offset_in + idx_dn;
+                  bit_t dns = dnss_in[idx_dn];
+                  // t-J constraint
+                  if (((dns & ups_flip) != 0) || !contributes(fill, idx_in)) {
+                    return false;
+                  }
+                  auto [idx_dn_out, fermi_dn] =
+                      basis_out.index_dns_fermi(dns, sym, not_ups_flip_rep);
+                  idx_out = ups_offset_out + idx_dn_out;
+                  val = prefac / norms_in[idx_dn];
+                  val = (fermi_up ^ fermi_dn) ? -val : val;
+                  return true;
+                },
+                fill);
           }
 
           ////////////////////////////////////////////////////////////////////////
@@ -103,46 +120,58 @@ void generic_term_ups(basis_t const &basis_in, basis_t const &basis_out,
           // Origin ups trivial stabilizer -> dns need to be deposited
           if (syms_ups_in.size() == 1) {
             bit_t not_ups_in = (~ups_in) & sitesmask;
-
-            int64_t idx_in = ups_offset_in;
-            for (bit_t dnsc : dnss_in) {
-              bit_t dns = bits::deposit(dnsc, not_ups_in);
-
-              if ((dns & ups_flip) == 0) { // t-J constraint
-                auto [idx_dn_out, fermi_dn, sym] =
-                    basis_out.index_dns_fermi_sym(dns, syms_ups_out, dnss_out);
-
-                if (idx_dn_out != invalid_index) {
-                  int64_t idx_out = ups_offset_out + idx_dn_out;
+            staged_fill<coeff_t>(
+                dnss_in.size(),
+                [&](int64_t idx_dn, int64_t &idx_in, int64_t &idx_out,
+                    coeff_t &val) {
+                  idx_in = ups_offset_in + idx_dn;
+                  bit_t dns = bits::deposit(dnss_in[idx_dn], not_ups_in);
+                  // t-J constraint
+                  if (((dns & ups_flip) != 0) || !contributes(fill, idx_in)) {
+                    return false;
+                  }
+                  auto [idx_dn_out, fermi_dn, sym] =
+                      basis_out.index_dns_fermi_sym(dns, syms_ups_out,
+                                                    dnss_out);
+                  if (idx_dn_out == invalid_index) {
+                    profile::count_invalid();
+                    return false;
+                  }
+                  idx_out = ups_offset_out + idx_dn_out;
                   bool fermi_up = basis_out.fermi_bool_ups(sym, ups_flip);
-                  coeff_t val = prefacs[sym] * norms_out[idx_dn_out];
-
-                  fill(idx_in, idx_out, (fermi_up ^ fermi_dn) ? -val : val);
-                }
-              }
-              ++idx_in;
-            }
+                  val = prefacs[sym] * norms_out[idx_dn_out];
+                  val = (fermi_up ^ fermi_dn) ? -val : val;
+                  return true;
+                },
+                fill);
           }
 
           // Origin ups non-trivial stabilizer -> dns DONT need to be deposited
           else {
-            int64_t idx_in = ups_offset_in;
-            int64_t idx_dn = 0;
-            for (bit_t dns : dnss_in) {
-              if ((dns & ups_flip) == 0) { // t-J constraint
-                auto [idx_dn_out, fermi_dn, sym] =
-                    basis_out.index_dns_fermi_sym(dns, syms_ups_out, dnss_out);
-                if (idx_dn_out != invalid_index) {
-                  int64_t idx_out = ups_offset_out + idx_dn_out;
+            staged_fill<coeff_t>(
+                dnss_in.size(),
+                [&](int64_t idx_dn, int64_t &idx_in, int64_t &idx_out,
+                    coeff_t &val) {
+                  idx_in = ups_offset_in + idx_dn;
+                  bit_t dns = dnss_in[idx_dn];
+                  // t-J constraint
+                  if (((dns & ups_flip) != 0) || !contributes(fill, idx_in)) {
+                    return false;
+                  }
+                  auto [idx_dn_out, fermi_dn, sym] =
+                      basis_out.index_dns_fermi_sym(dns, syms_ups_out,
+                                                    dnss_out);
+                  if (idx_dn_out == invalid_index) {
+                    profile::count_invalid();
+                    return false;
+                  }
+                  idx_out = ups_offset_out + idx_dn_out;
                   bool fermi_up = basis_out.fermi_bool_ups(sym, ups_flip);
-                  coeff_t val =
-                      prefacs[sym] * norms_out[idx_dn_out] / norms_in[idx_dn];
-                  fill(idx_in, idx_out, (fermi_up ^ fermi_dn) ? -val : val);
-                }
-              }
-              ++idx_dn;
-              ++idx_in;
-            }
+                  val = prefacs[sym] * norms_out[idx_dn_out] / norms_in[idx_dn];
+                  val = (fermi_up ^ fermi_dn) ? -val : val;
+                  return true;
+                },
+                fill);
           }
 
         } // if target trivial stabilizer or not
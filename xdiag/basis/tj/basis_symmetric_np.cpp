@@ -6,6 +6,7 @@
 
 #include <xdiag/combinatorics/combinations.hpp>
 #include <xdiag/symmetries/operations/symmetry_operations.hpp>
+#include <xdiag/utils/logger.hpp>
 
 namespace xdiag::basis::tj {
 
@@ -13,15 +14,15 @@ template <typename bit_t>
 BasisSymmetricNp<bit_t>::BasisSymmetricNp(int64_t nsites, int64_t nup,
                                           int64_t ndn,
                                           PermutationGroup const &group,
-                                          Vector const &characters) try
+                                          Vector const &characters,
+                                          bool fermi_lookup) try
     : nsites_(nsites), nup_(nup), ndn_(ndn), group_action_(group),
       irrep_(group, characters),
       raw_ups_size_(combinatorics::binomial(nsites, nup)),
       raw_dns_size_(combinatorics::binomial(nsites, ndn)),
       raw_dnsc_size_(combinatorics::binomial(nsites - nup, ndn)),
       lintable_ups_(nsites, nup), lintable_dns_(nsites, ndn),
-      lintable_dnsc_(nsites - nup, ndn), fermi_table_ups_(nsites, nup, group),
-      fermi_table_dns_(nsites, ndn, group) {
+      lintable_dnsc_(nsites - nup, ndn), fermi_lookup_(fermi_lookup) {
   check_nsites_work_with_bits<bit_t>(nsites_);
 
   using combinatorics::Combinations;
@@ -35,6 +36,18 @@ BasisSymmetricNp<bit_t>::BasisSymmetricNp(int64_t nsites, int64_t nup,
     XDIAG_THROW("nsites does not match the nsites in PermutationGroup");
   }
 
+  if (fermi_lookup) {
+    fermi_sign_lookup_ = combinatorics::FermiSignLookup<bit_t>(group);
+    Log(2, "fermi sign lookup: {} bytes", fermi_sign_lookup_.memory());
+  } else {
+    fermi_table_ups_ =
+        combinatorics::FermiTableCombinations<bit_t>(nsites, nup, group);
+    fermi_table_dns_ =
+        combinatorics::FermiTableCombinations<bit_t>(nsites, ndn, group);
+    Log(2, "fermi tables: {} bytes",
+        fermi_table_ups_.memory() + fermi_table_dns_.memory());
+  }
+
   std::tie(reps_up_, idces_up_, syms_up_, sym_limits_up_) =
       symmetries::representatives_indices_symmetries_limits<bit_t>(
           lintable_ups_, group_action_);
@@ -191,7 +204,7 @@ BasisSymmetricNp<bit_t>::index_dns_fermi(bit_t dns, int64_t sym,
   bit_t dns_rep = group_action_.apply(sym, dns);
   bit_t dns_rep_c = bits::extract(dns_rep, not_ups);
   int64_t idx_dns_rep = lintable_dnsc_.index(dns_rep_c);
-  bool fermi_dns = fermi_table_dns_.sign(sym, dns);
+  bool fermi_dns = fermi_bool_dns(sym, dns);
   return {idx_dns_rep, fermi_dns};
 }
 
@@ -204,7 +217,7 @@ BasisSymmetricNp<bit_t>::index_dns_fermi(bit_t dns, int64_t sym, bit_t not_ups,
   bit_t dns_rep_c = bits::extract(dns_rep, not_ups);
   int64_t idx_dns_rep = lintable_dnsc_.index(dns_rep_c);
   bool fermi_dns = (bits::popcnt(dns & fermimask) & 1);
-  fermi_dns ^= fermi_table_dns_.sign(sym, dns);
+  fermi_dns ^= fermi_bool_dns(sym, dns);
   return {idx_dns_rep, fermi_dns};
 }
 
@@ -217,7 +230,7 @@ std::tuple<int64_t, bool, int64_t> BasisSymmetricNp<bit_t>::index_dns_fermi_sym(
       symmetries::representative_sym_subset(dns, group_action_, syms);
   auto it = std::lower_bound(dnss_out.begin(), dnss_out.end(), rep_dns);
   if ((it != dnss_out.end()) && (*it == rep_dns)) {
-    bool fermi_dns = fermi_table_dns_.sign(rep_sym, dns);
+    bool fermi_dns = fermi_bool_dns(rep_sym, dns);
     return {std::distance(dnss_out.begin(), it), fermi_dns, rep_sym};
   } else {
     return {invalid_index, false, rep_sym};
@@ -234,7 +247,7 @@ std::tuple<int64_t, bool, int64_t> BasisSymmetricNp<bit_t>::index_dns_fermi_sym(
   auto it = std::lower_bound(dnss_out.begin(), dnss_out.end(), rep_dns);
   if ((it != dnss_out.end()) && (*it == rep_dns)) {
     bool fermi_dns = (bits::popcnt(dns & fermimask) & 1);
-    fermi_dns ^= fermi_table_dns_.sign(rep_sym, dns);
+    fermi_dns ^= fermi_bool_dns(rep_sym, dns);
     return {std::distance(dnss_out.begin(), it), fermi_dns, rep_sym};
   } else {
     return {invalid_index, false, rep_sym};
@@ -264,6 +277,33 @@ BasisSymmetricNp<bit_t>::index_syms_up(bit_t ups) const {
   return {index, {syms_up_.data() + start, length}};
 }
 
+template <typename bit_t>
+std::tuple<int64_t, int64_t, bool>
+BasisSymmetricNp<bit_t>::index_sym_fermi(bit_t ups, bit_t dns) const {
+  auto [idx_ups, syms] = index_syms_up(ups);
+  int64_t up_offset = ups_offset(idx_ups);
+
+  // trivial up-stabilizer (likely)
+  if (syms.size() == 1) {
+    bit_t sitesmask = ((bit_t)1 << nsites_) - 1;
+    bit_t not_ups_rep = (~rep_ups(idx_ups)) & sitesmask;
+    int64_t sym = syms.front();
+    auto [idx_dns, fermi_dns] = index_dns_fermi(dns, sym, not_ups_rep);
+    bool fermi = fermi_dns ^ fermi_bool_ups(sym, ups);
+    return {up_offset + idx_dns, sym, fermi};
+  }
+  // non-trivial up-stabilizer (unlikely)
+  else {
+    auto dnss = dns_for_ups_rep(ups);
+    auto [idx_dns, fermi_dns, sym] = index_dns_fermi_sym(dns, syms, dnss);
+    if (idx_dns == invalid_index) {
+      return {invalid_index, sym, false};
+    }
+    bool fermi = fermi_dns ^ fermi_bool_ups(sym, ups);
+    return {up_offset + idx_dns, sym, fermi};
+  }
+}
+
 // Retrieving dns states and norms for given up configuration
 template <typename bit_t>
 gsl::span<bit_t const>
@@ -295,12 +335,14 @@ BasisSymmetricNp<bit_t>::dns_norms_for_up_rep(bit_t ups) const {
 template <typename bit_t>
 
 bool BasisSymmetricNp<bit_t>::fermi_bool_ups(int64_t sym, bit_t ups) const {
-  return fermi_table_ups_.sign(sym, ups);
+  return fermi_lookup_ ? fermi_sign_lookup_.sign(sym, ups)
+                       : fermi_table_ups_.sign(sym, ups);
 }
 template <typename bit_t>
 
 bool BasisSymmetricNp<bit_t>::fermi_bool_dns(int64_t sym, bit_t dns) const {
-  return fermi_table_dns_.sign(sym, dns);
+  return fermi_lookup_ ? fermi_sign_lookup_.sign(sym, dns)
+                       : fermi_table_dns_.sign(sym, dns);
 }
 
 template <typename bit_t>
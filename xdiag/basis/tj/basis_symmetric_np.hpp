@@ -16,6 +16,7 @@
 #include <xdiag/symmetries/operations/symmetry_operations.hpp>
 #include <xdiag/symmetries/permutation_group.hpp>
 #include <xdiag/symmetries/representation.hpp>
+#include <xdiag/utils/allocator.hpp>
 
 namespace xdiag::basis::tj {
 
@@ -28,7 +29,8 @@ public:
   using span_size_t = gsl::span<int64_t const>::size_type;
 
   BasisSymmetricNp(int64_t nsites, int64_t nup, int64_t ndn,
-                   PermutationGroup const &group, Vector const &characters);
+                   PermutationGroup const &group, Vector const &characters,
+                   bool fermi_lookup = false);
 
   int64_t nsites() const;
   int64_t nup() const;
@@ -57,18 +59,20 @@ private:
   combinatorics::LinTable<bit_t> lintable_ups_;
   combinatorics::LinTable<bit_t> lintable_dns_;
   combinatorics::LinTable<bit_t> lintable_dnsc_;
+  bool fermi_lookup_;
   combinatorics::FermiTableCombinations<bit_t> fermi_table_ups_;
   combinatorics::FermiTableCombinations<bit_t> fermi_table_dns_;
+  combinatorics::FermiSignLookup<bit_t> fermi_sign_lookup_;
 
-  std::vector<bit_t> reps_up_;
-  std::vector<int64_t> idces_up_;
+  numa_vector<bit_t> reps_up_;
+  numa_vector<int64_t> idces_up_;
   std::vector<int64_t> syms_up_;
   std::vector<std::pair<span_size_t, span_size_t>> sym_limits_up_;
 
   std::vector<int64_t> ups_offset_;
   std::vector<std::pair<span_size_t, span_size_t>> dns_limits_;
-  std::vector<bit_t> dns_storage_;
-  std::vector<double> norms_storage_;
+  numa_vector<bit_t> dns_storage_;
+  numa_vector<double> norms_storage_;
 
   int64_t size_;
 
@@ -100,6 +104,11 @@ public:
   gsl::span<int64_t const> syms_ups(bit_t ups) const;
   std::pair<int64_t, gsl::span<int64_t const>> index_syms_up(bit_t ups) const;
 
+  // index of the representative of an arbitrary state, the symmetry mapping
+  // the state onto the representative and the fermi sign of this mapping
+  std::tuple<int64_t, int64_t, bool> index_sym_fermi(bit_t ups,
+                                                     bit_t dns) const;
+
   // Retrieving dns states and norms for given up configuration
   gsl::span<bit_t const> dns_for_ups_rep(bit_t ups) const;
   gsl::span<double const> norms_for_ups_rep(bit_t ups) const;
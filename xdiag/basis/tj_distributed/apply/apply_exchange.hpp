@@ -5,6 +5,7 @@
 #pragma once
 
 #include <xdiag/bits/bitops.hpp>
+#include <xdiag/combinatorics/binomial.hpp>
 #include <xdiag/combinatorics/combinations.hpp>
 #include <xdiag/common.hpp>
 #include <xdiag/operators/op.hpp>
@@ -40,109 +41,127 @@ void apply_exchange(Coupling const &cpl, Op const &op, basis_t const &basis,
   int64_t ndn = basis.ndn();
   int64_t ndn_configurations = combinatorics::binomial(nsites - nup, ndn);
 
+  // Every up configuration with a single up spin on the flipped sites has the
+  // same number of compatible dn configurations, namely those where the
+  // remaining flipped site is occupied by a dn spin
+  int64_t n_dns_flip = combinatorics::binomial(nsites - nup - 1, ndn - 1);
+
   // Find out how many states is sent to each process
   std::vector<int64_t> n_states_i_send(mpi_size, 0);
-
-  // Flip states and check out how much needs to be communicated
-  int64_t idx_up = 0;
   for (bit_t up : basis.my_ups()) {
     if (popcnt(up & flipmask) == 1) {
       bit_t flipped_up = up ^ flipmask;
       int target = basis.rank(flipped_up);
-
-      for (bit_t dn : basis.my_dns_for_ups(idx_up)) {
-        if (popcnt(dn & flipmask) == 1)
-          ++n_states_i_send[target];
-      }
+      n_states_i_send[target] += n_dns_flip;
     }
-    ++idx_up;
   }
 
   // Exchange information on who sends how much to whom
   mpi::Communicator comm(n_states_i_send);
   mpi::buffer.reserve<coeff_t>(comm.send_buffer_size(),
                                comm.recv_buffer_size());
-
-  // Flip states and check how much needs to be communicated
-  idx_up = 0;
-  int64_t idx = 0;
-  for (bit_t up : basis.my_ups()) {
+  coeff_t *send_buffer = mpi::buffer.send<coeff_t>();
+  coeff_t *recv_buffer = mpi::buffer.recv<coeff_t>();
+
+  // Compute the offsets of every up configuration in the send buffer, such
+  // that the send buffer can be filled in parallel
+  auto const &ups = basis.my_ups();
+  int64_t n_ups = ups.size();
+  std::vector<int64_t> send_offsets(n_ups, 0);
+  std::vector<int64_t> n_states_prepared(mpi_size, 0);
+  for (int64_t idx_up = 0; idx_up < n_ups; ++idx_up) {
+    bit_t up = ups[idx_up];
     if (popcnt(up & flipmask) == 1) {
       bit_t flipped_up = up ^ flipmask;
       int target = basis.rank(flipped_up);
+      send_offsets[idx_up] =
+          comm.n_values_i_send_offset(target) + n_states_prepared[target];
+      n_states_prepared[target] += n_dns_flip;
+    }
+  }
 
-      for (bit_t dn : basis.my_dns_for_ups(idx_up)) {
+  // Flip states and fill them into the send buffer
+#pragma omp parallel for schedule(guided)
+  for (int64_t idx_up = 0; idx_up < n_ups; ++idx_up) {
+    bit_t up = ups[idx_up];
+    if (popcnt(up & flipmask) == 1) {
+      int64_t up_offset = idx_up * ndn_configurations;
+      int64_t send_idx = send_offsets[idx_up];
+      for (int64_t idx = up_offset; idx < up_offset + ndn_configurations;
+           ++idx) {
+        bit_t dn = basis.my_dns_for_ups_storage(idx);
         if (popcnt(dn & flipmask) == 1) {
-          comm.add_to_send_buffer(target, vec_in[idx],
-                                  mpi::buffer.send<coeff_t>());
+          send_buffer[send_idx++] = vec_in[idx];
         }
-        ++idx;
       }
-    } else {
-      idx += ndn_configurations;
     }
-    ++idx_up;
   }
 
   // Alltoall called
-  comm.all_to_all(mpi::buffer.send<coeff_t>(), mpi::buffer.recv<coeff_t>());
+  comm.all_to_all(send_buffer, recv_buffer);
 
   // Get the original upspin configuration and its source proc
   std::vector<std::vector<bit_t>> ups_i_get_from_proc(mpi_size);
   for (bit_t up : basis.my_ups()) {
-    bit_t flipped_up = up ^ flipmask;
-    int source = basis.rank(flipped_up);
-    ups_i_get_from_proc[source].push_back(up);
+    if (popcnt(up & flipmask) == 1) {
+      bit_t flipped_up = up ^ flipmask;
+      int source = basis.rank(flipped_up);
+      ups_i_get_from_proc[source].push_back(up);
+    }
   }
 
-  int64_t recv_idx = 0;
-
-  // Loop over origin of arrived
+  // Sort according to order of flipped upspins and determine the offsets of
+  // every received up configuration in the receive buffer
+  std::vector<bit_t> ups_received;
+  std::vector<int64_t> recv_offsets;
+  int64_t recv_offset = 0;
   for (int m = 0; m < mpi_size; ++m) {
-
-    // Sort according to order of flipped upspins
     std::sort(ups_i_get_from_proc[m].begin(), ups_i_get_from_proc[m].end(),
               [&flipmask](bit_t const &a, bit_t const &b) {
                 bit_t flipped_a = a ^ flipmask;
                 bit_t flipped_b = b ^ flipmask;
                 return flipped_a < flipped_b;
               });
-
     for (bit_t up : ups_i_get_from_proc[m]) {
-      if (popcnt(up & flipmask) == 1) {
-        bool fermi_up = bits::popcnt(up & fermimask) & 1;
-        bool up_s1_set = bits::gbit(up, s2);
-
-        int64_t up_offset = basis.my_ups_offset(up);
-
-        for (int64_t target_idx = up_offset;
-             target_idx < up_offset + ndn_configurations; ++target_idx) {
-          bit_t dn = basis.my_dns_for_ups_storage(target_idx);
-
-          if (bits::popcnt(dn & flipmask) == 1) {
-            bool fermi_dn = bits::popcnt(dn & fermimask) & 1;
-
-            if constexpr (isreal<coeff_t>()) {
-              vec_out[target_idx] += ((fermi_up ^ fermi_dn) ? Jhalf : -Jhalf) *
-                                     mpi::buffer.recv<coeff_t>()[recv_idx];
-            } else {
-              if (up_s1_set) {
-                vec_out[target_idx] +=
-                    ((fermi_up ^ fermi_dn) ? Jhalf : -Jhalf) *
-                    mpi::buffer.recv<coeff_t>()[recv_idx];
-              } else {
-                vec_out[target_idx] +=
-                    ((fermi_up ^ fermi_dn) ? Jhalf_conj : -Jhalf_conj) *
-                    mpi::buffer.recv<coeff_t>()[recv_idx];
-              }
-            }
-            ++recv_idx;
+      ups_received.push_back(up);
+      recv_offsets.push_back(recv_offset);
+      recv_offset += n_dns_flip;
+    }
+  }
+
+  // Fill the received coefficients into the output vector
+  int64_t n_ups_received = ups_received.size();
+
+#pragma omp parallel for schedule(guided)
+  for (int64_t idx_recv = 0; idx_recv < n_ups_received; ++idx_recv) {
+    bit_t up = ups_received[idx_recv];
+    int64_t recv_idx = recv_offsets[idx_recv];
+    bool fermi_up = bits::popcnt(up & fermimask) & 1;
+    bool up_s1_set = bits::gbit(up, s2);
+
+    int64_t up_offset = basis.my_ups_offset(up);
+    for (int64_t target_idx = up_offset;
+         target_idx < up_offset + ndn_configurations; ++target_idx) {
+      bit_t dn = basis.my_dns_for_ups_storage(target_idx);
+      if (bits::popcnt(dn & flipmask) == 1) {
+        bool fermi_dn = bits::popcnt(dn & fermimask) & 1;
+        if constexpr (isreal<coeff_t>()) {
+          vec_out[target_idx] +=
+              ((fermi_up ^ fermi_dn) ? Jhalf : -Jhalf) * recv_buffer[recv_idx];
+        } else {
+          if (up_s1_set) {
+            vec_out[target_idx] += ((fermi_up ^ fermi_dn) ? Jhalf : -Jhalf) *
+                                   recv_buffer[recv_idx];
+          } else {
+            vec_out[target_idx] +=
+                ((fermi_up ^ fermi_dn) ? Jhalf_conj : -Jhalf_conj) *
+                recv_buffer[recv_idx];
           }
         }
+        ++recv_idx;
       }
     }
-
-  } // loop over processes
+  } // for (idx_recv = 0; idx_recv < n_ups_received; ++idx_recv)
 }
 
 } // namespace xdiag::basis::tj_distributed
@@ -13,15 +13,18 @@ void generic_term_diag(basis_t const &basis, term_action_f term_action,
                        const coeff_t *vec_in, coeff_t *vec_out) {
   using bit_t = typename basis_t::bit_t;
 
-  int64_t idx_up = 0;
-  int64_t idx = 0;
-  for (bit_t up : basis.my_ups()) {
+  auto const &ups = basis.my_ups();
+  int64_t n_ups = ups.size();
+
+#pragma omp parallel for schedule(guided)
+  for (int64_t idx_up = 0; idx_up < n_ups; ++idx_up) {
+    bit_t up = ups[idx_up];
+    int64_t idx = basis.my_ups_offset(up);
     for (bit_t dn : basis.my_dns_for_ups(idx_up)) {
       coeff_t val = term_action(up, dn);
       vec_out[idx] += val * vec_in[idx];
       ++idx;
     }
-    ++idx_up;
   }
 }
 
@@ -35,8 +35,12 @@ void generic_term_dns(basis_t const &basis_in, basis_t const &basis_out,
       combinatorics::binomial(nsites - nup_out, ndn_out);
 
   // Loop over all configurations
-  int64_t idx_up = 0;
-  for (bit_t up : basis_in.my_ups()) {
+  auto const &ups = basis_in.my_ups();
+  int64_t n_ups = ups.size();
+
+#pragma omp parallel for schedule(guided)
+  for (int64_t idx_up = 0; idx_up < n_ups; ++idx_up) {
+    bit_t up = ups[idx_up];
 
     if (non_zero_term_ups(up)) {
       bit_t not_up = (~up) & sitesmask;
@@ -63,7 +67,6 @@ void generic_term_dns(basis_t const &basis_in, basis_t const &basis_out,
       } // if ((upspins & flipmask) == 0)
     } // non-zero-term ups
 
-    ++idx_up;
   } // for(const bit_t& upspins : my_upspins_)
 }
 
@@ -35,8 +35,12 @@ void generic_term_ups(basis_t const &basis_in, basis_t const &basis_out,
       combinatorics::binomial(nsites - ndn_out, nup_out);
 
   // Loop over all configurations
-  int64_t idx_dn = 0;
-  for (bit_t dn : basis_in.my_dns()) {
+  auto const &dns = basis_in.my_dns();
+  int64_t n_dns = dns.size();
+
+#pragma omp parallel for schedule(guided)
+  for (int64_t idx_dn = 0; idx_dn < n_dns; ++idx_dn) {
+    bit_t dn = dns[idx_dn];
 
     if (non_zero_term_dns(dn)) {
       bit_t not_dn = (~dn) & sitesmask;
@@ -58,7 +62,6 @@ void generic_term_ups(basis_t const &basis_in, basis_t const &basis_out,
       } // if ((upspins & flipmask) == 0)
     } // non-zero-term ups
 
-    ++idx_dn;
   } // for(const bit_t& upspins : my_upspins_)
 }
 
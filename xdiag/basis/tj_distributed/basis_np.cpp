@@ -7,11 +7,13 @@
 #include <xdiag/combinatorics/binomial.hpp>
 #include <xdiag/combinatorics/combinations.hpp>
 #include <xdiag/parallel/mpi/allreduce.hpp>
+#include <xdiag/utils/logger.hpp>
 
 namespace xdiag::basis::tj_distributed {
 
 template <typename bit_t>
-BasisNp<bit_t>::BasisNp(int64_t nsites, int64_t nup, int64_t ndn) try
+BasisNp<bit_t>::BasisNp(int64_t nsites, int64_t nup, int64_t ndn,
+                        std::string partition) try
     : nsites_(nsites), nup_(nup), ndn_(ndn), lintable_dncs_(nsites - nup, ndn),
       lintable_upcs_(nsites - ndn, nup) {
   check_nsites_work_with_bits<bit_t>(nsites_);
@@ -29,6 +31,7 @@ BasisNp<bit_t>::BasisNp(int64_t nsites, int64_t nup, int64_t ndn) try
   dim_ = binomial(nsites, nup) * binomial(nsites - nup, ndn);
   MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank_);
   MPI_Comm_size(MPI_COMM_WORLD, &mpi_size_);
+  partition_ = mpi::Partition<bit_t>(nsites, {nup, ndn}, partition);
   sitesmask_ = ((bit_t)1 << nsites) - 1;
 
   // ////////////////////////////////////////////////////////////////
@@ -111,7 +114,7 @@ BasisNp<bit_t>::BasisNp(int64_t nsites, int64_t nup, int64_t ndn) try
       ++n_states_i_send[target];
     }
   }
-  transpose_communicator_ = mpi::Communicator(n_states_i_send);
+  transpose_communicator_ = mpi::Communicator(n_states_i_send, true);
   int64_t send_size = transpose_communicator_.send_buffer_size();
   int64_t recv_size = transpose_communicator_.recv_buffer_size();
   mpi::buffer.reserve<bit_t>(send_size, recv_size);
@@ -166,7 +169,7 @@ BasisNp<bit_t>::BasisNp(int64_t nsites, int64_t nup, int64_t ndn) try
       ++n_states_i_send[target];
     }
   }
-  transpose_communicator_r_ = mpi::Communicator(n_states_i_send);
+  transpose_communicator_r_ = mpi::Communicator(n_states_i_send, true);
   send_size = transpose_communicator_r_.send_buffer_size();
   recv_size = transpose_communicator_r_.recv_buffer_size();
   mpi::buffer.reserve<bit_t>(send_size, recv_size);
@@ -225,6 +228,8 @@ BasisNp<bit_t>::BasisNp(int64_t nsites, int64_t nup, int64_t ndn) try
   mpi::Allreduce(&size_, &size_min_f, 1, MPI_MIN, MPI_COMM_WORLD);
   mpi::Allreduce(&size_transpose_, &size_min_r, 1, MPI_MIN, MPI_COMM_WORLD);
   size_min_ = std::min(size_min_f, size_min_r);
+  Log(1, "tJDistributed partition \"{}\": imbalance factor {:.4f}", partition,
+      mpi::imbalance_factor(size_max_, dim_));
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
@@ -234,6 +239,10 @@ template <typename bit_t> int64_t BasisNp<bit_t>::nsites() const {
 }
 template <typename bit_t> int64_t BasisNp<bit_t>::nup() const { return nup_; }
 
+template <typename bit_t> std::string BasisNp<bit_t>::partition() const {
+  return partition_.type();
+}
+
 template <typename bit_t> int64_t BasisNp<bit_t>::ndn() const { return ndn_; }
 
 template <typename bit_t>
@@ -332,14 +341,16 @@ void BasisNp<bit_t>::transpose(const coeff_t *in_vec, coeff_t *out_vec) const
 
   // Sort to proper order
   if (out_vec) {
-    for (idx = 0; idx < size_transpose_; ++idx) {
-      int64_t sorted_idx = transpose_permutation_[idx];
-      out_vec[sorted_idx] = recv_buffer[idx];
+#pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < size_transpose_; ++i) {
+      int64_t sorted_idx = transpose_permutation_[i];
+      out_vec[sorted_idx] = recv_buffer[i];
     }
   } else {
-    for (idx = 0; idx < size_transpose_; ++idx) {
-      int64_t sorted_idx = transpose_permutation_[idx];
-      send_buffer[sorted_idx] = recv_buffer[idx];
+#pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < size_transpose_; ++i) {
+      int64_t sorted_idx = transpose_permutation_[i];
+      send_buffer[sorted_idx] = recv_buffer[i];
     }
   }
   mpi::buffer.clean_recv();
@@ -380,14 +391,16 @@ void BasisNp<bit_t>::transpose_r(coeff_t const *in_vec, coeff_t *out_vec) const
 
   // Sort to proper order
   if (out_vec) {
-    for (idx = 0; idx < size_; ++idx) {
-      int64_t sorted_idx = transpose_permutation_r_[idx];
-      out_vec[sorted_idx] = recv_buffer[idx];
+#pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < size_; ++i) {
+      int64_t sorted_idx = transpose_permutation_r_[i];
+      out_vec[sorted_idx] = recv_buffer[i];
     }
   } else {
-    for (idx = 0; idx < size_; ++idx) {
-      int64_t sorted_idx = transpose_permutation_r_[idx];
-      send_buffer[sorted_idx] = recv_buffer[idx];
+#pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < size_; ++i) {
+      int64_t sorted_idx = transpose_permutation_r_[i];
+      send_buffer[sorted_idx] = recv_buffer[i];
     }
   }
 
@@ -3,12 +3,53 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "electron.hpp"
+
+#include <algorithm>
+
+#include <xdiag/basis/backend_selection.hpp>
 #include <xdiag/random/hash.hpp>
 
 namespace xdiag {
 
 using namespace basis;
 
+// Chooses the backend "auto" of a symmetric block from estimates of memory and
+// cost, and the bits for "auto_fermi_lookup"
+static std::string symmetric_backend(std::string const &backend,
+                                     int64_t nsites, std::optional<int64_t> nup,
+                                     std::optional<int64_t> ndn,
+                                     Representation const &irrep) try {
+  if ((backend != "auto") && (backend != "auto_fermi_lookup")) {
+    return backend;
+  }
+  if (nsites >= 64) {
+    XDIAG_THROW("Blocks with more than 64 sites currently not implemented");
+  }
+  if (backend == "auto") {
+    return choose_backend(backend_estimates_electron(nsites, nup, ndn, irrep),
+                          memory_limit());
+  }
+  return (nsites < 32) ? "32bit_fermi_lookup" : "64bit_fermi_lookup";
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <typename bit_t>
+static std::shared_ptr<SpinflipProjection>
+spinflip_projection(electron::BasisSymmetricNp<bit_t> const &basis,
+                    int64_t spinflip, int64_t particlehole,
+                    std::vector<int64_t> const &bipartition) {
+  return std::make_shared<SpinflipProjection>(basis, spinflip, particlehole,
+                                              bipartition);
+}
+
+template <class basis_t>
+static std::shared_ptr<SpinflipProjection>
+spinflip_projection(basis_t const &, int64_t, int64_t,
+                    std::vector<int64_t> const &) {
+  XDIAG_THROW("Spin flip symmetry is not implemented for this basis");
+}
+
 Electron::Electron(int64_t nsites, std::string backend) try
     : nsites_(nsites), backend_(backend), nup_(std::nullopt),
       ndn_(std::nullopt), irrep_(std::nullopt) {
@@ -91,23 +132,17 @@ Electron::Electron(int64_t nsites, Representation const &irrep,
     XDIAG_THROW("nsites does not match the nsites in PermutationGroup");
   }
 
-  // Choose basis implementation
-  if (backend == "auto") {
-    if (nsites < 32) {
-      basis_ = std::make_shared<basis_t>(
-          electron::BasisSymmetricNoNp<uint32_t>(nsites, irrep));
-    } else if (nsites < 64) {
-      basis_ = std::make_shared<basis_t>(
-          electron::BasisSymmetricNoNp<uint64_t>(nsites, irrep));
-    } else {
-      XDIAG_THROW("Blocks with more than 64 sites currently not implemented");
-    }
-  } else if (backend == "32bit") {
-    basis_ = std::make_shared<basis_t>(
-        electron::BasisSymmetricNoNp<uint32_t>(nsites, irrep));
-  } else if (backend == "64bit") {
-    basis_ = std::make_shared<basis_t>(
-        electron::BasisSymmetricNoNp<uint64_t>(nsites, irrep));
+  // Choose basis implementation, "<backend>_fermi_lookup" evaluates fermi
+  // signs of symmetries on the fly
+  auto [base, fermi_lookup] = split_backend_suffix(
+      symmetric_backend(backend, nsites, std::nullopt, std::nullopt, irrep),
+      "_fermi_lookup");
+  if (base == "32bit") {
+    basis_ = std::make_shared<basis_t>(electron::BasisSymmetricNoNp<uint32_t>(
+        nsites, irrep, fermi_lookup));
+  } else if (base == "64bit") {
+    basis_ = std::make_shared<basis_t>(electron::BasisSymmetricNoNp<uint64_t>(
+        nsites, irrep, fermi_lookup));
   } else {
     XDIAG_THROW(fmt::format("Unknown backend: \"{}\"", backend));
   }
@@ -120,7 +155,47 @@ Electron::Electron(int64_t nsites, Representation const &irrep,
 
 Electron::Electron(int64_t nsites, int64_t nup, int64_t ndn,
                    Representation const &irrep, std::string backend) try
-    : nsites_(nsites), backend_(backend), nup_(nup), ndn_(ndn), irrep_(irrep) {
+    : Electron(nsites, nup, ndn, irrep, 0, backend) {
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+Electron::Electron(int64_t nsites, int64_t nup, int64_t ndn,
+                   Representation const &irrep, int64_t spinflip,
+                   std::string backend) try
+    : Electron(nsites, nup, ndn, irrep, spinflip, 0, {}, backend) {
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+// Whether every permutation of the group either preserves or exchanges the
+// two sublattices of the bipartition
+static bool preserves_bipartition(PermutationGroup const &group,
+                                  std::vector<int64_t> const &bipartition) {
+  int64_t nsites = bipartition.size();
+  for (int64_t sym = 0; sym < group.size(); ++sym) {
+    Permutation const &perm = group[sym];
+    bool exchanged = bipartition[perm[0]] != bipartition[0];
+    for (int64_t i = 0; i < nsites; ++i) {
+      if ((bipartition[perm[i]] != bipartition[i]) != exchanged) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+Electron::Electron(int64_t nsites, int64_t nup, int64_t ndn,
+                   Representation const &irrep, int64_t spinflip,
+                   int64_t particlehole,
+                   std::vector<int64_t> const &bipartition,
+                   std::string backend) try
+    : nsites_(nsites), backend_(backend), nup_(nup), ndn_(ndn), irrep_(irrep),
+      spinflip_(spinflip == 0 ? std::nullopt
+                              : std::optional<int64_t>(spinflip)),
+      particlehole_(particlehole == 0 ? std::nullopt
+                                      : std::optional<int64_t>(particlehole)),
+      bipartition_(particlehole == 0 ? std::vector<int64_t>() : bipartition) {
   // Safety checks
   if (nsites < 0) {
     XDIAG_THROW("Invalid argument: nsites < 0");
@@ -130,29 +205,59 @@ Electron::Electron(int64_t nsites, int64_t nup, int64_t ndn,
     XDIAG_THROW("Invalid argument: (ndn < 0) or (ndn > nsites)");
   } else if (nsites != irrep.group().nsites()) {
     XDIAG_THROW("nsites does not match the nsites in PermutationGroup");
+  } else if ((spinflip != 0) && (spinflip != 1) && (spinflip != -1)) {
+    XDIAG_THROW(fmt::format(
+        "Invalid argument: spinflip must be +1 or -1, got {}", spinflip));
+  } else if ((spinflip != 0) && (nup != ndn)) {
+    XDIAG_THROW("Spin flip symmetry requires nup = ndn");
+  } else if ((particlehole != 0) && (particlehole != 1) &&
+             (particlehole != -1)) {
+    XDIAG_THROW(fmt::format(
+        "Invalid argument: particlehole must be +1 or -1, got {}",
+        particlehole));
+  } else if ((particlehole != 0) && ((2 * nup != nsites) || (nup != ndn))) {
+    XDIAG_THROW("Particle-hole symmetry requires nup = ndn = nsites / 2");
+  } else if ((particlehole != 0) && ((int64_t)bipartition.size() != nsites)) {
+    XDIAG_THROW(fmt::format("Size of bipartition ({}) does not match nsites "
+                            "({})",
+                            bipartition.size(), nsites));
+  } else if ((particlehole != 0) &&
+             std::any_of(bipartition.begin(), bipartition.end(),
+                         [](int64_t s) { return (s != 0) && (s != 1); })) {
+    XDIAG_THROW("Invalid argument: bipartition must only contain the labels "
+                "0 and 1");
+  } else if ((particlehole != 0) &&
+             !preserves_bipartition(irrep.group(), bipartition)) {
+    XDIAG_THROW("Particle-hole symmetry requires every permutation of the "
+                "group to either preserve or exchange the two sublattices "
+                "of the bipartition");
   }
 
-  // Choose basis implementation
-  if (backend == "auto") {
-    if (nsites < 32) {
-      basis_ = std::make_shared<basis_t>(
-          electron::BasisSymmetricNp<uint32_t>(nsites, nup, ndn, irrep));
-    } else if (nsites < 64) {
-      basis_ = std::make_shared<basis_t>(
-          electron::BasisSymmetricNp<uint64_t>(nsites, nup, ndn, irrep));
-    } else {
-      XDIAG_THROW("Blocks with more than 64 sites currently not implemented");
-    }
-  } else if (backend == "32bit") {
-    basis_ = std::make_shared<basis_t>(
-        electron::BasisSymmetricNp<uint32_t>(nsites, nup, ndn, irrep));
-  } else if (backend == "64bit") {
-    basis_ = std::make_shared<basis_t>(
-        electron::BasisSymmetricNp<uint64_t>(nsites, nup, ndn, irrep));
+  // Choose basis implementation, "<backend>_fermi_lookup" evaluates fermi
+  // signs of symmetries on the fly
+  auto [base, fermi_lookup] = split_backend_suffix(
+      symmetric_backend(backend, nsites, nup, ndn, irrep), "_fermi_lookup");
+  if (base == "32bit") {
+    basis_ = std::make_shared<basis_t>(electron::BasisSymmetricNp<uint32_t>(
+        nsites, nup, ndn, irrep, fermi_lookup));
+  } else if (base == "64bit") {
+    basis_ = std::make_shared<basis_t>(electron::BasisSymmetricNp<uint64_t>(
+        nsites, nup, ndn, irrep, fermi_lookup));
   } else {
     XDIAG_THROW(fmt::format("Unknown backend: \"{}\"", backend));
   }
-  size_ = basis::size(*basis_);
+
+  if (projected()) {
+    projection_ = std::visit(
+        [&](auto const &basis) {
+          return spinflip_projection(basis, spinflip, particlehole,
+                                     bipartition_);
+        },
+        *basis_);
+    size_ = projection_->size();
+  } else {
+    size_ = basis::size(*basis_);
+  }
   check_dimension_works_with_blas_int_size(size_);
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
@@ -166,7 +271,8 @@ int64_t Electron::index(ProductState const &pstate) const try {
         using basis_t = typename std::decay<decltype(basis)>::type;
         using bit_t = typename basis_t::bit_t;
         auto [ups, dns] = to_bits_electron<bit_t>(pstate);
-        return basis.index(ups, dns);
+        int64_t idx = basis.index(ups, dns);
+        return projection_ ? projection_->index(idx) : idx;
       },
       *basis_);
 } catch (Error const &e) {
@@ -175,7 +281,9 @@ int64_t Electron::index(ProductState const &pstate) const try {
 
 bool Electron::operator==(Electron const &rhs) const {
   return (nsites_ == rhs.nsites_) && (nup_ == rhs.nup_) && (ndn_ == rhs.ndn_) &&
-         (irrep_ == rhs.irrep_);
+         (irrep_ == rhs.irrep_) && (spinflip_ == rhs.spinflip_) &&
+         (particlehole_ == rhs.particlehole_) &&
+         (bipartition_ == rhs.bipartition_);
 }
 bool Electron::operator!=(Electron const &rhs) const {
   return !operator==(rhs);
@@ -188,8 +296,24 @@ std::string Electron::backend() const { return backend_; }
 std::optional<int64_t> Electron::nup() const { return nup_; }
 std::optional<int64_t> Electron::ndn() const { return ndn_; }
 std::optional<Representation> const &Electron::irrep() const { return irrep_; }
+std::optional<int64_t> Electron::spinflip() const { return spinflip_; }
+std::optional<int64_t> Electron::particlehole() const { return particlehole_; }
+std::vector<int64_t> const &Electron::bipartition() const {
+  return bipartition_;
+}
+bool Electron::projected() const {
+  return (bool)spinflip_ || (bool)particlehole_;
+}
 bool Electron::isreal() const { return irrep_ ? irrep_->isreal() : true; }
 Electron::basis_t const &Electron::basis() const { return *basis_; }
+SpinflipProjection const &Electron::projection() const try {
+  if (!projection_) {
+    XDIAG_THROW("Block has neither spin flip nor particle-hole symmetry");
+  }
+  return *projection_;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
 
 int64_t index(Electron const &block, ProductState const &pstate) {
   return block.index(pstate);
@@ -218,6 +342,12 @@ std::ostream &operator<<(std::ostream &out, Electron const &block) {
     out << "  irrep    : defined with ID " << std::hex
         << random::hash(*block.irrep()) << std::dec << "\n";
   }
+  if (block.spinflip()) {
+    out << "  spinflip : " << *block.spinflip() << "\n";
+  }
+  if (block.particlehole()) {
+    out << "  ph parity: " << *block.particlehole() << "\n";
+  }
   std::stringstream ss;
   ss.imbue(std::locale("en_US.UTF-8"));
   ss << block.size();
@@ -237,10 +367,29 @@ ElectronIterator::ElectronIterator(Electron const &block, bool begin)
                 begin ? basis.begin() : basis.end();
             return it;
           },
-          block.basis())) {}
+          block.basis())),
+      projection_(block.projected() ? &block.projection() : nullptr),
+      idx_(0) {
+  // skip states which are not primary states of the projection
+  if (begin && projection_) {
+    while ((idx_ < projection_->size_unprojected()) &&
+           !projection_->primary(idx_)) {
+      std::visit([](auto &&it) { ++it; }, it_);
+      ++idx_;
+    }
+  }
+}
 
 ElectronIterator &ElectronIterator::operator++() {
   std::visit([](auto &&it) { ++it; }, it_);
+  ++idx_;
+  if (projection_) {
+    while ((idx_ < projection_->size_unprojected()) &&
+           !projection_->primary(idx_)) {
+      std::visit([](auto &&it) { ++it; }, it_);
+      ++idx_;
+    }
+  }
   return *this;
 }
 
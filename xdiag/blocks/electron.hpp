@@ -5,10 +5,12 @@
 #pragma once
 
 #include <optional>
+#include <vector>
 
 #include <xdiag/common.hpp>
 
 #include <xdiag/basis/electron/basis_electron.hpp>
+#include <xdiag/basis/spinflip_projection.hpp>
 #include <xdiag/states/product_state.hpp>
 #include <xdiag/symmetries/representation.hpp>
 
@@ -30,6 +32,23 @@ public:
   XDIAG_API Electron(int64_t nsites, int64_t nup, int64_t ndn,
                      Representation const &irrep, std::string backend = "auto");
 
+  // Additionally symmetrized with respect to the spin flip exchanging up and
+  // dn spins, where spinflip = +1 or -1 is the parity. Requires nup = ndn.
+  XDIAG_API Electron(int64_t nsites, int64_t nup, int64_t ndn,
+                     Representation const &irrep, int64_t spinflip,
+                     std::string backend = "auto");
+
+  // Additionally symmetrized with respect to the particle-hole transformation
+  // c_{i,s} -> e_i c^dag_{i,s} at half filling, nup = ndn = nsites / 2. Here,
+  // e_i = +1 (-1) on the sites with label 0 (1) of the bipartition and
+  // particlehole = +1 or -1 is the parity. The permutations of the group must
+  // preserve or exchange the two sublattices. spinflip = 0 omits the spin flip.
+  XDIAG_API Electron(int64_t nsites, int64_t nup, int64_t ndn,
+                     Representation const &irrep, int64_t spinflip,
+                     int64_t particlehole,
+                     std::vector<int64_t> const &bipartition,
+                     std::string backend = "auto");
+
   XDIAG_API iterator_t begin() const;
   XDIAG_API iterator_t end() const;
   XDIAG_API int64_t index(ProductState const &pstate) const;
@@ -46,7 +65,12 @@ public:
   std::optional<int64_t> nup() const;
   std::optional<int64_t> ndn() const;
   std::optional<Representation> const &irrep() const;
+  std::optional<int64_t> spinflip() const;
+  std::optional<int64_t> particlehole() const;
+  std::vector<int64_t> const &bipartition() const;
+  bool projected() const;
   basis_t const &basis() const;
+  basis::SpinflipProjection const &projection() const;
 
 private:
   int64_t nsites_;
@@ -54,7 +78,11 @@ private:
   std::optional<int64_t> nup_;
   std::optional<int64_t> ndn_;
   std::optional<Representation> irrep_;
+  std::optional<int64_t> spinflip_;
+  std::optional<int64_t> particlehole_;
+  std::vector<int64_t> bipartition_;
   std::shared_ptr<basis_t> basis_;
+  std::shared_ptr<basis::SpinflipProjection> projection_;
   int64_t size_;
 };
 
@@ -77,6 +105,8 @@ private:
   int64_t nsites_;
   mutable ProductState pstate_;
   basis::BasisElectronIterator it_;
+  basis::SpinflipProjection const *projection_;
+  int64_t idx_;
 };
 
 } // namespace xdiag
@@ -10,8 +10,10 @@
 namespace xdiag {
 
 ElectronDistributed::ElectronDistributed(int64_t nsites, int64_t nup,
-                                         int64_t ndn, std::string backend) try
-    : nsites_(nsites), backend_(backend), nup_(nup), ndn_(ndn) {
+                                         int64_t ndn, std::string backend,
+                                         std::string partition) try
+    : nsites_(nsites), backend_(backend), partition_(partition), nup_(nup),
+      ndn_(ndn) {
   using namespace combinatorics;
   using namespace basis::electron_distributed;
 
@@ -29,16 +31,20 @@ ElectronDistributed::ElectronDistributed(int64_t nsites, int64_t nup,
   // Choose basis implementation
   if (backend == "auto") {
     if (nsites < 32) {
-      basis_ = std::make_shared<basis_t>(BasisNp<uint32_t>(nsites, nup, ndn));
+      basis_ = std::make_shared<basis_t>(
+          BasisNp<uint32_t>(nsites, nup, ndn, partition));
     } else if (nsites < 64) {
-      basis_ = std::make_shared<basis_t>(BasisNp<uint64_t>(nsites, nup, ndn));
+      basis_ = std::make_shared<basis_t>(
+          BasisNp<uint64_t>(nsites, nup, ndn, partition));
     } else {
       XDIAG_THROW("Blocks with more than 64 sites currently not implemented");
     }
   } else if (backend == "32bit") {
-    basis_ = std::make_shared<basis_t>(BasisNp<uint32_t>(nsites, nup, ndn));
+    basis_ = std::make_shared<basis_t>(
+        BasisNp<uint32_t>(nsites, nup, ndn, partition));
   } else if (backend == "64bit") {
-    basis_ = std::make_shared<basis_t>(BasisNp<uint64_t>(nsites, nup, ndn));
+    basis_ = std::make_shared<basis_t>(
+        BasisNp<uint64_t>(nsites, nup, ndn, partition));
   } else {
     XDIAG_THROW(fmt::format("Unknown backend: \"{}\"", backend));
   }
@@ -52,6 +58,7 @@ ElectronDistributed::ElectronDistributed(int64_t nsites, int64_t nup,
 
 int64_t ElectronDistributed::nsites() const { return nsites_; }
 std::string ElectronDistributed::backend() const { return backend_; }
+std::string ElectronDistributed::partition() const { return partition_; }
 std::optional<int64_t> ElectronDistributed::nup() const { return nup_; }
 std::optional<int64_t> ElectronDistributed::ndn() const { return ndn_; }
 
@@ -86,7 +93,8 @@ bool ElectronDistributed::isreal() const {
 }
 
 bool ElectronDistributed::operator==(ElectronDistributed const &rhs) const {
-  return (nsites_ == rhs.nsites_) && (nup_ == rhs.nup_) && (ndn_ == rhs.ndn_);
+  return (nsites_ == rhs.nsites_) && (nup_ == rhs.nup_) &&
+         (ndn_ == rhs.ndn_) && (partition_ == rhs.partition_);
 }
 bool ElectronDistributed::operator!=(ElectronDistributed const &rhs) const {
   return !operator==(rhs);
@@ -140,6 +148,7 @@ std::ostream &operator<<(std::ostream &out, ElectronDistributed const &block) {
   out << "  size (max local): " << ssmax.str() << "\n";
   out << "  size (min local): " << ssmin.str() << "\n";
   out << "  size (avg local): " << ssavg.str() << "\n";
+  out << "  partition       : " << block.partition() << "\n";
   out << "  ID              : " << std::hex << random::hash(block) << std::dec
       << "\n";
   return out;
@@ -21,7 +21,8 @@ public:
 
   XDIAG_API ElectronDistributed() = default;
   XDIAG_API ElectronDistributed(int64_t nsites, int64_t nup, int64_t ndn,
-                                std::string backend = "auto");
+                                std::string backend = "auto",
+                                std::string partition = "hash");
 
   XDIAG_API iterator_t begin() const;
   XDIAG_API iterator_t end() const;
@@ -38,6 +39,7 @@ public:
   XDIAG_API bool isreal() const;
 
   std::string backend() const;
+  std::string partition() const;
   std::optional<int64_t> nup() const;
   std::optional<int64_t> ndn() const;
   basis_t const &basis() const;
@@ -45,6 +47,7 @@ public:
 private:
   int64_t nsites_;
   std::string backend_;
+  std::string partition_;
   std::optional<int64_t> nup_;
   std::optional<int64_t> ndn_;
   std::shared_ptr<basis_t> basis_;
@@ -4,6 +4,8 @@
 
 #include "spinhalf.hpp"
 
+#include <xdiag/basis/backend_selection.hpp>
+#include <xdiag/basis/basis_cache.hpp>
 #include <xdiag/combinatorics/binomial.hpp>
 #include <xdiag/random/hash.hpp>
 
@@ -93,38 +95,40 @@ Spinhalf::Spinhalf(int64_t nsites, Representation const &irrep,
   }
 
   // Choose basis implementation
+  std::string impl = backend;
   if (backend == "auto") {
-    if (nsites < 32) {
-      basis_ = std::make_shared<basis_t>(
-          spinhalf::BasisSymmetricNoSz<uint32_t>(irrep));
-    } else if (nsites < 64) {
-      basis_ = std::make_shared<basis_t>(
-          spinhalf::BasisSymmetricNoSz<uint64_t>(irrep));
-    } else {
+    if (nsites >= 64) {
       XDIAG_THROW(
           "Spinhalf blocks with more than 64 sites currently not implemented");
     }
-  } else if (backend == "32bit") {
+    impl = choose_backend(
+        backend_estimates_spinhalf(nsites, std::nullopt, irrep, 0),
+        memory_limit());
+  }
+  auto header = cache_header(*this, impl);
+  // "<k>sublattice_dense" looks up representatives in a dense index
+  auto [sublattice, dense] = split_backend_suffix(impl, "_dense");
+  if (impl == "32bit") {
     basis_ = std::make_shared<basis_t>(
-        spinhalf::BasisSymmetricNoSz<uint32_t>(irrep));
-  } else if (backend == "64bit") {
+        cached<spinhalf::BasisSymmetricNoSz<uint32_t>>(header, irrep));
+  } else if (impl == "64bit") {
     basis_ = std::make_shared<basis_t>(
-        spinhalf::BasisSymmetricNoSz<uint64_t>(irrep));
-  } else if (backend == "1sublattice") {
+        cached<spinhalf::BasisSymmetricNoSz<uint64_t>>(header, irrep));
+  } else if (sublattice == "1sublattice") {
     basis_ = std::make_shared<basis_t>(
-        spinhalf::BasisSublattice<uint64_t, 1>(irrep));
-  } else if (backend == "2sublattice") {
+        cached<spinhalf::BasisSublattice<uint64_t, 1>>(header, irrep, dense));
+  } else if (sublattice == "2sublattice") {
     basis_ = std::make_shared<basis_t>(
-        spinhalf::BasisSublattice<uint64_t, 2>(irrep));
-  } else if (backend == "3sublattice") {
+        cached<spinhalf::BasisSublattice<uint64_t, 2>>(header, irrep, dense));
+  } else if (sublattice == "3sublattice") {
     basis_ = std::make_shared<basis_t>(
-        spinhalf::BasisSublattice<uint64_t, 3>(irrep));
-  } else if (backend == "4sublattice") {
+        cached<spinhalf::BasisSublattice<uint64_t, 3>>(header, irrep, dense));
+  } else if (sublattice == "4sublattice") {
     basis_ = std::make_shared<basis_t>(
-        spinhalf::BasisSublattice<uint64_t, 4>(irrep));
-  } else if (backend == "5sublattice") {
+        cached<spinhalf::BasisSublattice<uint64_t, 4>>(header, irrep, dense));
+  } else if (sublattice == "5sublattice") {
     basis_ = std::make_shared<basis_t>(
-        spinhalf::BasisSublattice<uint64_t, 5>(irrep));
+        cached<spinhalf::BasisSublattice<uint64_t, 5>>(header, irrep, dense));
   } else {
     XDIAG_THROW(fmt::format("Unknown backend: \"{}\"", backend));
   }
@@ -137,7 +141,16 @@ Spinhalf::Spinhalf(int64_t nsites, Representation const &irrep,
 
 Spinhalf::Spinhalf(int64_t nsites, int64_t nup, Representation const &irrep,
                    std::string backend) try
-    : nsites_(nsites), backend_(backend), nup_(nup), irrep_(irrep) {
+    : Spinhalf(nsites, nup, irrep, 0, backend) {
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+Spinhalf::Spinhalf(int64_t nsites, int64_t nup, Representation const &irrep,
+                   int64_t spinflip, std::string backend) try
+    : nsites_(nsites), backend_(backend), nup_(nup), irrep_(irrep),
+      spinflip_(spinflip == 0 ? std::nullopt
+                              : std::optional<int64_t>(spinflip)) {
 
   // Safety checks
   if (nsites < 0) {
@@ -148,41 +161,55 @@ Spinhalf::Spinhalf(int64_t nsites, int64_t nup, Representation const &irrep,
     XDIAG_THROW("Invalid argument: nup > nsites");
   } else if (nsites != irrep.group().nsites()) {
     XDIAG_THROW("nsites does not match the nsites in PermutationGroup");
+  } else if ((spinflip != 0) && (spinflip != 1) && (spinflip != -1)) {
+    XDIAG_THROW(fmt::format(
+        "Invalid argument: spinflip must be +1 or -1, got {}", spinflip));
+  } else if ((spinflip != 0) && (2 * nup != nsites)) {
+    XDIAG_THROW("Spin flip symmetry requires nup = nsites / 2");
   }
 
   // Choose basis implementation
+  std::string impl = backend;
   if (backend == "auto") {
-    if (nsites < 32) {
-      basis_ = std::make_shared<basis_t>(
-          spinhalf::BasisSymmetricSz<uint32_t>(nup, irrep));
-    } else if (nsites < 64) {
-      basis_ = std::make_shared<basis_t>(
-          spinhalf::BasisSymmetricSz<uint64_t>(nup, irrep));
-    } else {
+    if (nsites >= 64) {
       XDIAG_THROW(
           "Spinhalf blocks with more than 64 sites currently not implemented");
     }
-  } else if (backend == "32bit") {
+    impl = choose_backend(
+        backend_estimates_spinhalf(nsites, nup, irrep, spinflip),
+        memory_limit());
+  }
+  auto header = cache_header(*this, impl);
+  // "<k>sublattice_dense" looks up representatives in a dense index
+  auto [sublattice, dense] = split_backend_suffix(impl, "_dense");
+  if (impl == "32bit") {
     basis_ = std::make_shared<basis_t>(
-        spinhalf::BasisSymmetricSz<uint32_t>(nup, irrep));
-  } else if (backend == "64bit") {
+        cached<spinhalf::BasisSymmetricSz<uint32_t>>(header, nup, irrep,
+                                                     spinflip));
+  } else if (impl == "64bit") {
     basis_ = std::make_shared<basis_t>(
-        spinhalf::BasisSymmetricSz<uint64_t>(nup, irrep));
-  } else if (backend == "1sublattice") {
+        cached<spinhalf::BasisSymmetricSz<uint64_t>>(header, nup, irrep,
+                                                     spinflip));
+  } else if (sublattice == "1sublattice") {
     basis_ = std::make_shared<basis_t>(
-        spinhalf::BasisSublattice<uint64_t, 1>(nup, irrep));
-  } else if (backend == "2sublattice") {
+        cached<spinhalf::BasisSublattice<uint64_t, 1>>(header, nup, irrep,
+                                                       dense, spinflip));
+  } else if (sublattice == "2sublattice") {
     basis_ = std::make_shared<basis_t>(
-        spinhalf::BasisSublattice<uint64_t, 2>(nup, irrep));
-  } else if (backend == "3sublattice") {
+        cached<spinhalf::BasisSublattice<uint64_t, 2>>(header, nup, irrep,
+                                                       dense, spinflip));
+  } else if (sublattice == "3sublattice") {
     basis_ = std::make_shared<basis_t>(
-        spinhalf::BasisSublattice<uint64_t, 3>(nup, irrep));
-  } else if (backend == "4sublattice") {
+        cached<spinhalf::BasisSublattice<uint64_t, 3>>(header, nup, irrep,
+                                                       dense, spinflip));
+  } else if (sublattice == "4sublattice") {
     basis_ = std::make_shared<basis_t>(
-        spinhalf::BasisSublattice<uint64_t, 4>(nup, irrep));
-  } else if (backend == "5sublattice") {
+        cached<spinhalf::BasisSublattice<uint64_t, 4>>(header, nup, irrep,
+                                                       dense, spinflip));
+  } else if (sublattice == "5sublattice") {
     basis_ = std::make_shared<basis_t>(
-        spinhalf::BasisSublattice<uint64_t, 5>(nup, irrep));
+        cached<spinhalf::BasisSublattice<uint64_t, 5>>(header, nup, irrep,
+                                                       dense, spinflip));
   } else {
     XDIAG_THROW(fmt::format("Unknown backend: \"{}\"", backend));
   }
@@ -212,7 +239,8 @@ int64_t Spinhalf::size() const { return size_; }
 
 bool Spinhalf::operator==(Spinhalf const &rhs) const {
   return (nsites_ == rhs.nsites_) && (nup_ == rhs.nup_) &&
-         (irrep_ == rhs.irrep_) && (*basis_ == *rhs.basis_);
+         (irrep_ == rhs.irrep_) && (spinflip_ == rhs.spinflip_) &&
+         (*basis_ == *rhs.basis_);
 }
 
 bool Spinhalf::operator!=(Spinhalf const &rhs) const {
@@ -223,6 +251,7 @@ int64_t Spinhalf::nsites() const { return nsites_; }
 std::string Spinhalf::backend() const { return backend_; }
 std::optional<int64_t> Spinhalf::nup() const { return nup_; }
 std::optional<Representation> const &Spinhalf::irrep() const { return irrep_; }
+std::optional<int64_t> Spinhalf::spinflip() const { return spinflip_; }
 bool Spinhalf::isreal() const { return irrep_ ? irrep_->isreal() : true; }
 Spinhalf::basis_t const &Spinhalf::basis() const { return *basis_; }
 
@@ -246,6 +275,9 @@ std::ostream &operator<<(std::ostream &out, Spinhalf const &block) {
     out << "  irrep    : defined with ID " << std::hex
         << random::hash(*block.irrep()) << std::dec << "\n";
   }
+  if (block.spinflip()) {
+    out << "  spinflip : " << *block.spinflip() << "\n";
+  }
   std::stringstream ss;
   ss.imbue(std::locale("en_US.UTF-8"));
   ss << block.size();
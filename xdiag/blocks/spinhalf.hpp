@@ -29,6 +29,11 @@ public:
   XDIAG_API Spinhalf(int64_t nsites, int64_t nup, Representation const &irrep,
                      std::string backend = "auto");
 
+  // Additionally symmetrized with respect to the global spin flip, where
+  // spinflip = +1 or -1 is the parity. Requires nup = nsites / 2.
+  XDIAG_API Spinhalf(int64_t nsites, int64_t nup, Representation const &irrep,
+                     int64_t spinflip, std::string backend = "auto");
+
   XDIAG_API iterator_t begin() const;
   XDIAG_API iterator_t end() const;
   XDIAG_API int64_t index(ProductState const &pstate) const;
@@ -44,12 +49,14 @@ public:
   std::string backend() const;
   std::optional<int64_t> nup() const;
   std::optional<Representation> const &irrep() const;
+  std::optional<int64_t> spinflip() const;
   basis_t const &basis() const;
 private:
   int64_t nsites_;
   std::string backend_;
   std::optional<int64_t> nup_;
   std::optional<Representation> irrep_;
+  std::optional<int64_t> spinflip_;
   std::shared_ptr<basis_t> basis_;
   int64_t size_;
 };
@@ -8,8 +8,10 @@
 namespace xdiag {
 
 SpinhalfDistributed::SpinhalfDistributed(int64_t nsites, int64_t nup,
-                                         std::string backend) try
-    : nsites_(nsites), backend_(backend), nup_(nup) {
+                                         std::string backend,
+                                         std::string partition) try
+    : nsites_(nsites), backend_(backend), partition_(partition), nup_(nup),
+      irrep_(std::nullopt) {
   using namespace basis::spinhalf_distributed;
   using combinatorics::binomial;
 
@@ -24,16 +26,20 @@ SpinhalfDistributed::SpinhalfDistributed(int64_t nsites, int64_t nup,
   // Choose basis implementation
   if (backend == "auto") {
     if (nsites < 32) {
-      basis_ = std::make_shared<basis_t>(BasisSz<uint32_t>(nsites, nup));
+      basis_ = std::make_shared<basis_t>(
+          BasisSz<uint32_t>(nsites, nup, partition));
     } else if (nsites < 64) {
-      basis_ = std::make_shared<basis_t>(BasisSz<uint64_t>(nsites, nup));
+      basis_ = std::make_shared<basis_t>(
+          BasisSz<uint64_t>(nsites, nup, partition));
     } else {
       XDIAG_THROW("Blocks with more than 64 sites currently not implemented");
     }
   } else if (backend == "32bit") {
-    basis_ = std::make_shared<basis_t>(BasisSz<uint32_t>(nsites, nup));
+    basis_ = std::make_shared<basis_t>(
+        BasisSz<uint32_t>(nsites, nup, partition));
   } else if (backend == "64bit") {
-    basis_ = std::make_shared<basis_t>(BasisSz<uint64_t>(nsites, nup));
+    basis_ = std::make_shared<basis_t>(
+        BasisSz<uint64_t>(nsites, nup, partition));
   } else {
     XDIAG_THROW(fmt::format("Unknown backend: \"{}\"", backend));
   }
@@ -46,9 +52,79 @@ SpinhalfDistributed::SpinhalfDistributed(int64_t nsites, int64_t nup,
   XDIAG_RETHROW(e);
 }
 
+SpinhalfDistributed::SpinhalfDistributed(int64_t nsites, int64_t nup,
+                                         Representation const &irrep,
+                                         std::string backend) try
+    : nsites_(nsites), backend_(backend), partition_("hash"), nup_(nup),
+      irrep_(irrep) {
+  using namespace basis::spinhalf_distributed;
+
+  // Safety checks
+  if (nsites < 0) {
+    XDIAG_THROW("nsites < 0");
+  } else if (nup < 0) {
+    XDIAG_THROW("nup < 0");
+  } else if (nup > nsites) {
+    XDIAG_THROW("nup > nsites");
+  } else if (nsites != irrep.group().nsites()) {
+    XDIAG_THROW("nsites does not match the nsites in PermutationGroup");
+  }
+
+  // Choose basis implementation
+  if (backend == "auto") {
+    if (nsites < 32) {
+      basis_ = std::make_shared<basis_t>(
+          BasisSymmetricSz<uint32_t, GroupActionLookup<uint32_t>>(nup, irrep));
+    } else if (nsites < 64) {
+      basis_ = std::make_shared<basis_t>(
+          BasisSymmetricSz<uint64_t, GroupActionLookup<uint64_t>>(nup, irrep));
+    } else {
+      XDIAG_THROW("Blocks with more than 64 sites currently not implemented");
+    }
+  } else if (backend == "32bit") {
+    basis_ = std::make_shared<basis_t>(
+        BasisSymmetricSz<uint32_t, GroupActionLookup<uint32_t>>(nup, irrep));
+  } else if (backend == "64bit") {
+    basis_ = std::make_shared<basis_t>(
+        BasisSymmetricSz<uint64_t, GroupActionLookup<uint64_t>>(nup, irrep));
+  } else if (backend == "1sublattice") {
+    basis_ = std::make_shared<basis_t>(
+        BasisSymmetricSz<uint64_t, GroupActionSublattice<uint64_t, 1>>(nup,
+                                                                       irrep));
+  } else if (backend == "2sublattice") {
+    basis_ = std::make_shared<basis_t>(
+        BasisSymmetricSz<uint64_t, GroupActionSublattice<uint64_t, 2>>(nup,
+                                                                       irrep));
+  } else if (backend == "3sublattice") {
+    basis_ = std::make_shared<basis_t>(
+        BasisSymmetricSz<uint64_t, GroupActionSublattice<uint64_t, 3>>(nup,
+                                                                       irrep));
+  } else if (backend == "4sublattice") {
+    basis_ = std::make_shared<basis_t>(
+        BasisSymmetricSz<uint64_t, GroupActionSublattice<uint64_t, 4>>(nup,
+                                                                       irrep));
+  } else if (backend == "5sublattice") {
+    basis_ = std::make_shared<basis_t>(
+        BasisSymmetricSz<uint64_t, GroupActionSublattice<uint64_t, 5>>(nup,
+                                                                       irrep));
+  } else {
+    XDIAG_THROW(fmt::format("Unknown backend: \"{}\"", backend));
+  }
+
+  dim_ = basis::dim(*basis_);
+  size_ = basis::size(*basis_);
+  check_dimension_works_with_blas_int_size(size_);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
 int64_t SpinhalfDistributed::nsites() const { return nsites_; }
 std::string SpinhalfDistributed::backend() const { return backend_; }
+std::string SpinhalfDistributed::partition() const { return partition_; }
 std::optional<int64_t> SpinhalfDistributed::nup() const { return nup_; }
+std::optional<Representation> const &SpinhalfDistributed::irrep() const {
+  return irrep_;
+}
 
 int64_t SpinhalfDistributed::dim() const { return dim_; }
 int64_t SpinhalfDistributed::size() const { return size_; }
@@ -76,12 +152,13 @@ int64_t SpinhalfDistributed::index(ProductState const &pstate) const try {
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
-bool SpinhalfDistributed::isreal(double precision) const {
-  return true; // would only be nontrivial with space group irreps
+bool SpinhalfDistributed::isreal() const {
+  return irrep_ ? irrep_->isreal() : true;
 }
 
 bool SpinhalfDistributed::operator==(SpinhalfDistributed const &rhs) const {
-  return (nsites_ == rhs.nsites_) && (nup_ == rhs.nup_);
+  return (nsites_ == rhs.nsites_) && (nup_ == rhs.nup_) &&
+         (irrep_ == rhs.irrep_) && (partition_ == rhs.partition_);
 }
 bool SpinhalfDistributed::operator!=(SpinhalfDistributed const &rhs) const {
   return !operator==(rhs);
@@ -109,6 +186,10 @@ std::ostream &operator<<(std::ostream &out, SpinhalfDistributed const &block) {
   } else {
     out << "  nup      : not conserved\n";
   }
+  if (block.irrep()) {
+    out << "  irrep    : defined with ID " << std::hex
+        << random::hash(*block.irrep()) << std::dec << "\n";
+  }
 
   std::stringstream ss;
   ss.imbue(std::locale("en_US.UTF-8"));
@@ -130,6 +211,7 @@ std::ostream &operator<<(std::ostream &out, SpinhalfDistributed const &block) {
   out << "  size (max local): " << ssmax.str() << "\n";
   out << "  size (min local): " << ssmin.str() << "\n";
   out << "  size (avg local): " << ssavg.str() << "\n";
+  out << "  partition       : " << block.partition() << "\n";
   out << "  ID              : " << std::hex << random::hash(block) << std::dec
       << "\n";
   return out;
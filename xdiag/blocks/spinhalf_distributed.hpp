@@ -9,6 +9,7 @@
 #include <xdiag/basis/spinhalf_distributed/basis_spinhalf_distributed.hpp>
 #include <xdiag/common.hpp>
 #include <xdiag/states/product_state.hpp>
+#include <xdiag/symmetries/representation.hpp>
 
 namespace xdiag {
 
@@ -21,6 +22,10 @@ public:
 
   XDIAG_API SpinhalfDistributed() = default;
   XDIAG_API SpinhalfDistributed(int64_t nsites, int64_t nup,
+                                std::string backend = "auto",
+                                std::string partition = "hash");
+  XDIAG_API SpinhalfDistributed(int64_t nsites, int64_t nup,
+                                Representation const &irrep,
                                 std::string backend = "auto");
 
   XDIAG_API iterator_t begin() const;
@@ -35,16 +40,20 @@ public:
   XDIAG_API bool operator!=(SpinhalfDistributed const &rhs) const;
 
   XDIAG_API int64_t nsites() const;
-  XDIAG_API bool isreal(double precision = 1e-12) const;
+  XDIAG_API bool isreal() const;
 
   std::string backend() const;
+  std::string partition() const;
   std::optional<int64_t> nup() const;
+  std::optional<Representation> const &irrep() const;
   basis_t const &basis() const;
 
 private:
   int64_t nsites_;
   std::string backend_;
+  std::string partition_;
   std::optional<int64_t> nup_;
+  std::optional<Representation> irrep_;
   std::shared_ptr<basis_t> basis_;
   int64_t dim_;
   int64_t size_;
@@ -4,12 +4,46 @@
 
 #include "tj.hpp"
 
+#include <xdiag/basis/backend_selection.hpp>
 #include <xdiag/random/hash.hpp>
 
 namespace xdiag {
 
 using namespace basis;
 
+// Chooses the backend "auto" from estimates of memory and cost, and the bits
+// for "auto_fermi_lookup"
+static std::string symmetric_backend(std::string const &backend,
+                                     int64_t nsites, int64_t nup, int64_t ndn,
+                                     Representation const &irrep) try {
+  if ((backend != "auto") && (backend != "auto_fermi_lookup")) {
+    return backend;
+  }
+  if (nsites >= 64) {
+    XDIAG_THROW("blocks with more than 64 sites currently not implemented");
+  }
+  if (backend == "auto") {
+    return choose_backend(backend_estimates_tj(nsites, nup, ndn, irrep),
+                          memory_limit());
+  }
+  return (nsites < 32) ? "32bit_fermi_lookup" : "64bit_fermi_lookup";
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <typename bit_t>
+static std::shared_ptr<SpinflipProjection>
+spinflip_projection(tj::BasisSymmetricNp<bit_t> const &basis,
+                    int64_t spinflip) {
+  return std::make_shared<SpinflipProjection>(basis, spinflip);
+}
+
+template <class basis_t>
+static std::shared_ptr<SpinflipProjection>
+spinflip_projection(basis_t const &, int64_t) {
+  XDIAG_THROW("Spin flip symmetry is not implemented for this basis");
+}
+
 tJ::tJ(int64_t nsites, int64_t nup, int64_t ndn, std::string backend) try
     : nsites_(nsites), backend_(backend), nup_(nup), ndn_(ndn),
       irrep_(std::nullopt) {
@@ -48,7 +82,16 @@ tJ::tJ(int64_t nsites, int64_t nup, int64_t ndn, std::string backend) try
 
 tJ::tJ(int64_t nsites, int64_t nup, int64_t ndn, Representation const &irrep,
        std::string backend) try
-    : nsites_(nsites), backend_(backend), nup_(nup), ndn_(ndn), irrep_(irrep) {
+    : tJ(nsites, nup, ndn, irrep, 0, backend) {
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+tJ::tJ(int64_t nsites, int64_t nup, int64_t ndn, Representation const &irrep,
+       int64_t spinflip, std::string backend) try
+    : nsites_(nsites), backend_(backend), nup_(nup), ndn_(ndn), irrep_(irrep),
+      spinflip_(spinflip == 0 ? std::nullopt
+                              : std::optional<int64_t>(spinflip)) {
   // Safety checks
   if (nsites < 0) {
     XDIAG_THROW("Invalid argument: nsites < 0");
@@ -58,58 +101,49 @@ tJ::tJ(int64_t nsites, int64_t nup, int64_t ndn, Representation const &irrep,
     XDIAG_THROW("Invalid argument: nup + ndn > nsites");
   } else if (nsites != irrep.group().nsites()) {
     XDIAG_THROW("nsites does not match the nsites in PermutationGroup");
+  } else if ((spinflip != 0) && (spinflip != 1) && (spinflip != -1)) {
+    XDIAG_THROW(fmt::format(
+        "Invalid argument: spinflip must be +1 or -1, got {}", spinflip));
+  } else if ((spinflip != 0) && (nup != ndn)) {
+    XDIAG_THROW("Spin flip symmetry requires nup = ndn");
   }
 
-  // Choose basis implementation
-  if (backend == "auto") {
-    if (nsites < 32) {
-      if (irrep.isreal()) {
-        auto characters = irrep.characters().as<arma::vec>();
-        basis_ = std::make_shared<basis_t>(tj::BasisSymmetricNp<uint32_t>(
-            nsites, nup, ndn, irrep.group(), characters));
-      } else {
-        auto characters = irrep.characters().as<arma::cx_vec>();
-        basis_ = std::make_shared<basis_t>(tj::BasisSymmetricNp<uint32_t>(
-            nsites, nup, ndn, irrep.group(), characters));
-      }
-
-    } else if (nsites < 64) {
-      if (irrep.isreal()) {
-        auto characters = irrep.characters().as<arma::vec>();
-        basis_ = std::make_shared<basis_t>(tj::BasisSymmetricNp<uint64_t>(
-            nsites, nup, ndn, irrep.group(), characters));
-      } else {
-        auto characters = irrep.characters().as<arma::cx_vec>();
-        basis_ = std::make_shared<basis_t>(tj::BasisSymmetricNp<uint64_t>(
-            nsites, nup, ndn, irrep.group(), characters));
-      }
-    } else {
-      XDIAG_THROW("blocks with more than 64 sites currently not implemented");
-    }
-  } else if (backend == "32bit") {
+  // Choose basis implementation, "<backend>_fermi_lookup" evaluates fermi
+  // signs of symmetries on the fly
+  auto [base, fermi_lookup] = split_backend_suffix(
+      symmetric_backend(backend, nsites, nup, ndn, irrep), "_fermi_lookup");
+  if (base == "32bit") {
     if (irrep.isreal()) {
       auto characters = irrep.characters().as<arma::vec>();
       basis_ = std::make_shared<basis_t>(tj::BasisSymmetricNp<uint32_t>(
-          nsites, nup, ndn, irrep.group(), characters));
+          nsites, nup, ndn, irrep.group(), characters, fermi_lookup));
     } else {
       auto characters = irrep.characters().as<arma::cx_vec>();
       basis_ = std::make_shared<basis_t>(tj::BasisSymmetricNp<uint32_t>(
-          nsites, nup, ndn, irrep.group(), characters));
+          nsites, nup, ndn, irrep.group(), characters, fermi_lookup));
     }
-  } else if (backend == "64bit") {
+  } else if (base == "64bit") {
     if (irrep.isreal()) {
       auto characters = irrep.characters().as<arma::vec>();
       basis_ = std::make_shared<basis_t>(tj::BasisSymmetricNp<uint64_t>(
-          nsites, nup, ndn, irrep.group(), characters));
+          nsites, nup, ndn, irrep.group(), characters, fermi_lookup));
     } else {
       auto characters = irrep.characters().as<arma::cx_vec>();
       basis_ = std::make_shared<basis_t>(tj::BasisSymmetricNp<uint64_t>(
-          nsites, nup, ndn, irrep.group(), characters));
+          nsites, nup, ndn, irrep.group(), characters, fermi_lookup));
     }
   } else {
     XDIAG_THROW(fmt::format("Unknown backend: \"{}\"", backend));
   }
-  size_ = basis::size(*basis_);
+
+  if (spinflip_) {
+    projection_ = std::visit(
+        [&](auto const &basis) { return spinflip_projection(basis, spinflip); },
+        *basis_);
+    size_ = projection_->size();
+  } else {
+    size_ = basis::size(*basis_);
+  }
   check_dimension_works_with_blas_int_size(size_);
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
@@ -122,7 +156,8 @@ int64_t tJ::index(ProductState const &pstate) const try {
         using basis_t = typename std::decay<decltype(basis)>::type;
         using bit_t = typename basis_t::bit_t;
         auto [ups, dns] = to_bits_tj<bit_t>(pstate);
-        return basis.index(ups, dns);
+        int64_t idx = basis.index(ups, dns);
+        return projection_ ? projection_->index(idx) : idx;
       },
       *basis_);
 } catch (Error const &e) {
@@ -130,7 +165,7 @@ int64_t tJ::index(ProductState const &pstate) const try {
 }
 bool tJ::operator==(tJ const &rhs) const {
   return (nsites_ == rhs.nsites_) && (nup_ == rhs.nup_) && (ndn_ == rhs.ndn_) &&
-         (irrep_ == rhs.irrep_);
+         (irrep_ == rhs.irrep_) && (spinflip_ == rhs.spinflip_);
 }
 bool tJ::operator!=(tJ const &rhs) const { return !operator==(rhs); }
 int64_t tJ::dim() const { return size_; }
@@ -141,9 +176,18 @@ std::string tJ::backend() const { return backend_; }
 std::optional<int64_t> tJ::nup() const { return nup_; }
 std::optional<int64_t> tJ::ndn() const { return ndn_; }
 std::optional<Representation> const &tJ::irrep() const { return irrep_; }
+std::optional<int64_t> tJ::spinflip() const { return spinflip_; }
 
 bool tJ::isreal() const { return irrep_ ? irrep_->isreal() : true; }
 tJ::basis_t const &tJ::basis() const { return *basis_; }
+SpinflipProjection const &tJ::projection() const try {
+  if (!projection_) {
+    XDIAG_THROW("Block has no spin flip symmetry");
+  }
+  return *projection_;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
 
 int64_t index(tJ const &block, ProductState const &pstate) {
   return block.index(pstate);
@@ -171,6 +215,9 @@ std::ostream &operator<<(std::ostream &out, tJ const &block) {
     out << "  irrep    : defined with ID " << std::hex
         << random::hash(*block.irrep()) << std::dec << "\n";
   }
+  if (block.spinflip()) {
+    out << "  spinflip : " << *block.spinflip() << "\n";
+  }
   std::stringstream ss;
   ss.imbue(std::locale("en_US.UTF-8"));
   ss << block.size();
@@ -187,10 +234,29 @@ tJIterator::tJIterator(tJ const &block, bool begin)
             basis::BasistJIterator it = begin ? basis.begin() : basis.end();
             return it;
           },
-          block.basis())) {}
+          block.basis())),
+      projection_(block.spinflip() ? &block.projection() : nullptr),
+      idx_(0) {
+  // skip states which are not primary states of the spin flip projection
+  if (begin && projection_) {
+    while ((idx_ < projection_->size_unprojected()) &&
+           !projection_->primary(idx_)) {
+      std::visit([](auto &&it) { ++it; }, it_);
+      ++idx_;
+    }
+  }
+}
 
 tJIterator &tJIterator::operator++() {
   std::visit([](auto &&it) { ++it; }, it_);
+  ++idx_;
+  if (projection_) {
+    while ((idx_ < projection_->size_unprojected()) &&
+           !projection_->primary(idx_)) {
+      std::visit([](auto &&it) { ++it; }, it_);
+      ++idx_;
+    }
+  }
   return *this;
 }
 
@@ -8,6 +8,7 @@
 
 #include <xdiag/common.hpp>
 
+#include <xdiag/basis/spinflip_projection.hpp>
 #include <xdiag/basis/tj/basis_tj.hpp>
 #include <xdiag/states/product_state.hpp>
 #include <xdiag/symmetries/permutation_group.hpp>
@@ -28,6 +29,12 @@ public:
   XDIAG_API tJ(int64_t nsites, int64_t nup, int64_t ndn,
                Representation const &irrep, std::string backend = "auto");
 
+  // Additionally symmetrized with respect to the spin flip exchanging up and
+  // dn spins, where spinflip = +1 or -1 is the parity. Requires nup = ndn.
+  XDIAG_API tJ(int64_t nsites, int64_t nup, int64_t ndn,
+               Representation const &irrep, int64_t spinflip,
+               std::string backend = "auto");
+
   XDIAG_API iterator_t begin() const;
   XDIAG_API iterator_t end() const;
   XDIAG_API int64_t index(ProductState const &pstate) const;
@@ -44,7 +51,9 @@ public:
   std::optional<int64_t> nup() const;
   std::optional<int64_t> ndn() const;
   std::optional<Representation> const &irrep() const;
+  std::optional<int64_t> spinflip() const;
   basis_t const &basis() const;
+  basis::SpinflipProjection const &projection() const;
 
 private:
   int64_t nsites_;
@@ -52,7 +61,9 @@ private:
   std::optional<int64_t> nup_;
   std::optional<int64_t> ndn_;
   std::optional<Representation> irrep_;
+  std::optional<int64_t> spinflip_;
   std::shared_ptr<basis_t> basis_;
+  std::shared_ptr<basis::SpinflipProjection> projection_;
   int64_t size_;
 };
 
@@ -75,6 +86,8 @@ private:
   int64_t nsites_;
   mutable ProductState pstate_;
   basis::BasistJIterator it_;
+  basis::SpinflipProjection const *projection_;
+  int64_t idx_;
 };
 
 } // namespace xdiag
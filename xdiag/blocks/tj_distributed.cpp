@@ -10,8 +10,9 @@
 namespace xdiag {
 
 tJDistributed::tJDistributed(int64_t nsites, int64_t nup, int64_t ndn,
-                             std::string backend) try
-    : nsites_(nsites), backend_(backend), nup_(nup), ndn_(ndn) {
+                             std::string backend, std::string partition) try
+    : nsites_(nsites), backend_(backend), partition_(partition), nup_(nup),
+      ndn_(ndn) {
   using namespace basis::tj_distributed;
   using combinatorics::binomial;
 
@@ -26,16 +27,20 @@ tJDistributed::tJDistributed(int64_t nsites, int64_t nup, int64_t ndn,
   // Choose basis implementation
   if (backend == "auto") {
     if (nsites < 32) {
-      basis_ = std::make_shared<basis_t>(BasisNp<uint32_t>(nsites, nup, ndn));
+      basis_ = std::make_shared<basis_t>(
+          BasisNp<uint32_t>(nsites, nup, ndn, partition));
     } else if (nsites < 64) {
-      basis_ = std::make_shared<basis_t>(BasisNp<uint64_t>(nsites, nup, ndn));
+      basis_ = std::make_shared<basis_t>(
+          BasisNp<uint64_t>(nsites, nup, ndn, partition));
     } else {
       XDIAG_THROW("Blocks with more than 64 sites currently not implemented");
     }
   } else if (backend == "32bit") {
-    basis_ = std::make_shared<basis_t>(BasisNp<uint32_t>(nsites, nup, ndn));
+    basis_ = std::make_shared<basis_t>(
+        BasisNp<uint32_t>(nsites, nup, ndn, partition));
   } else if (backend == "64bit") {
-    basis_ = std::make_shared<basis_t>(BasisNp<uint64_t>(nsites, nup, ndn));
+    basis_ = std::make_shared<basis_t>(
+        BasisNp<uint64_t>(nsites, nup, ndn, partition));
   } else {
     XDIAG_THROW(fmt::format("Unknown backend: \"{}\"", backend));
   }
@@ -49,6 +54,7 @@ tJDistributed::tJDistributed(int64_t nsites, int64_t nup, int64_t ndn,
 
 int64_t tJDistributed::nsites() const { return nsites_; }
 std::string tJDistributed::backend() const { return backend_; }
+std::string tJDistributed::partition() const { return partition_; }
 std::optional<int64_t> tJDistributed::nup() const { return nup_; }
 std::optional<int64_t> tJDistributed::ndn() const { return ndn_; }
 
@@ -79,7 +85,8 @@ bool tJDistributed::isreal() const {
 }
 
 bool tJDistributed::operator==(tJDistributed const &rhs) const {
-  return (nsites_ == rhs.nsites_) && (nup_ == rhs.nup_) && (ndn_ == rhs.ndn_);
+  return (nsites_ == rhs.nsites_) && (nup_ == rhs.nup_) &&
+         (ndn_ == rhs.ndn_) && (partition_ == rhs.partition_);
 }
 bool tJDistributed::operator!=(tJDistributed const &rhs) const {
   return !operator==(rhs);
@@ -131,6 +138,7 @@ std::ostream &operator<<(std::ostream &out, tJDistributed const &block) {
   out << "  size (max local): " << ssmax.str() << "\n";
   out << "  size (min local): " << ssmin.str() << "\n";
   out << "  size (avg local): " << ssavg.str() << "\n";
+  out << "  partition       : " << block.partition() << "\n";
   out << "  ID              : " << std::hex << random::hash(block) << std::dec
       << "\n";
   return out;
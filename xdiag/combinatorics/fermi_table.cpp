@@ -4,6 +4,7 @@
 
 #include "fermi_table.hpp"
 
+#include <algorithm>
 #include <cassert>
 
 #include <xdiag/combinatorics/combinations.hpp>
@@ -119,6 +120,10 @@ bool FermiTableSubsets<bit_t>::operator!=(
   return !operator==(rhs);
 }
 
+template <typename bit_t> int64_t FermiTableSubsets<bit_t>::memory() const {
+  return table_.size() / 8;
+}
+
 template class FermiTableSubsets<uint16_t>;
 template class FermiTableSubsets<uint32_t>;
 template class FermiTableSubsets<uint64_t>;
@@ -143,8 +148,111 @@ bool FermiTableCombinations<bit_t>::operator!=(
   return !operator==(rhs);
 }
 
+template <typename bit_t>
+int64_t FermiTableCombinations<bit_t>::memory() const {
+  return table_.size() / 8;
+}
+
 template class FermiTableCombinations<uint16_t>;
 template class FermiTableCombinations<uint32_t>;
 template class FermiTableCombinations<uint64_t>;
 
+template <typename bit_t>
+FermiSignLookup<bit_t>::FermiSignLookup(PermutationGroup const &group) try
+    : nsites_(group.nsites()) {
+  int64_t n_bits = 8 * sizeof(bit_t);
+  n_postfix_bits_ = n_postfix_bits(nsites_);
+  n_prefix_bits_ = nsites_ - n_postfix_bits_;
+  parity_bit_ = n_bits - 1;
+  if (n_prefix_bits_ >= parity_bit_) {
+    XDIAG_THROW(fmt::format("Number of sites {} too large for fermi sign "
+                            "lookup with {} bits",
+                            nsites_, n_bits));
+  }
+  postfix_mask_ = ((bit_t)1 << n_postfix_bits_) - 1;
+
+  int64_t n_symmetries = group.size();
+  int64_t prefix_size = (int64_t)1 << n_prefix_bits_;
+  int64_t postfix_size = (int64_t)1 << n_postfix_bits_;
+  table_prefix_.resize((n_symmetries * prefix_size + 63) / 64, 0);
+  table_postfix_.resize(n_symmetries * postfix_size, 0);
+
+  std::vector<bit_t> masks(nsites_);
+  std::vector<bool> parities(prefix_size);
+  for (int64_t sym = 0; sym < n_symmetries; ++sym) {
+    auto const &perm = group[sym];
+
+    // masks[i] contains the sites j > i with perm(j) < perm(i)
+    for (int64_t i = 0; i < nsites_; ++i) {
+      masks[i] = 0;
+      for (int64_t j = i + 1; j < nsites_; ++j) {
+        if (perm[j] < perm[i]) {
+          masks[i] |= (bit_t)1 << j;
+        }
+      }
+    }
+
+    // Built by removing the lowest occupied site, whose pairs with all other
+    // sites are given by its mask
+    bit_t *postfix_table = table_postfix_.data() + sym * postfix_size;
+    for (int64_t postfix = 1; postfix < postfix_size; ++postfix) {
+      int64_t i = __builtin_ctzll(postfix);
+      int64_t rest = postfix & (postfix - 1);
+      bit_t entry = postfix_table[rest];
+      entry ^= (masks[i] >> n_postfix_bits_);
+      bit_t parity = bits::popcnt((bit_t)rest & masks[i]) & 1;
+      entry ^= parity << parity_bit_;
+      postfix_table[postfix] = entry;
+    }
+
+    parities[0] = false;
+    for (int64_t prefix = 1; prefix < prefix_size; ++prefix) {
+      int64_t i = __builtin_ctzll(prefix);
+      int64_t rest = prefix & (prefix - 1);
+      bit_t mask = masks[i + n_postfix_bits_] >> n_postfix_bits_;
+      parities[prefix] =
+          parities[rest] ^ (bool)(bits::popcnt((bit_t)rest & mask) & 1);
+    }
+    for (int64_t prefix = 0; prefix < prefix_size; ++prefix) {
+      if (parities[prefix]) {
+        int64_t idx = sym * prefix_size + prefix;
+        table_prefix_[idx >> 6] |= (uint64_t)1 << (idx & 63);
+      }
+    }
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <typename bit_t>
+int64_t FermiSignLookup<bit_t>::n_postfix_bits(int64_t nsites) {
+  // An entry of the postfix table has 8 * sizeof(bit_t) = 2^log_n_bits bits
+  int64_t log_n_bits = 0;
+  while (((int64_t)1 << log_n_bits) < (int64_t)(8 * sizeof(bit_t))) {
+    ++log_n_bits;
+  }
+  return std::max((int64_t)0, (nsites - log_n_bits) / 2);
+}
+
+template <typename bit_t> int64_t FermiSignLookup<bit_t>::memory() const {
+  return table_prefix_.size() * sizeof(uint64_t) +
+         table_postfix_.size() * sizeof(bit_t);
+}
+
+template <typename bit_t>
+bool FermiSignLookup<bit_t>::operator==(
+    FermiSignLookup<bit_t> const &rhs) const {
+  return (nsites_ == rhs.nsites_) && (table_prefix_ == rhs.table_prefix_) &&
+         (table_postfix_ == rhs.table_postfix_);
+}
+template <typename bit_t>
+bool FermiSignLookup<bit_t>::operator!=(
+    FermiSignLookup<bit_t> const &rhs) const {
+  return !operator==(rhs);
+}
+
+template class FermiSignLookup<uint16_t>;
+template class FermiSignLookup<uint32_t>;
+template class FermiSignLookup<uint64_t>;
+
 } // namespace xdiag::combinatorics
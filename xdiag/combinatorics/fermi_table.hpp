@@ -6,6 +6,7 @@
 
 #include <vector>
 
+#include <xdiag/bits/popcnt.hpp>
 #include <xdiag/combinatorics/combinations.hpp>
 #include <xdiag/combinatorics/lin_table.hpp>
 #include <xdiag/combinatorics/subsets.hpp>
@@ -21,6 +22,7 @@ public:
   inline bool sign(int64_t sym, bit_t state) const {
     return table_[(sym << nsites_) | (int64_t)state];
   }
+  int64_t memory() const;
   bool operator==(FermiTableSubsets const &rhs) const;
   bool operator!=(FermiTableSubsets const &rhs) const;
 
@@ -37,6 +39,7 @@ public:
   inline bool sign(int64_t sym, bit_t state) const {
     return table_[sym * raw_size_ + lin_table_.index(state)];
   }
+  int64_t memory() const;
   bool operator==(FermiTableCombinations const &rhs) const;
   bool operator!=(FermiTableCombinations const &rhs) const;
 
@@ -46,4 +49,44 @@ private:
   std::vector<bool> table_;
 };
 
+// Computes the fermi sign of a permutation acting on an arbitrary state
+// instead of tabulating it for every state. The sign is the parity of the
+// number of pairs of occupied sites i < j with perm(i) > perm(j). Splitting the
+// state into a prefix (high bits) and a postfix (low bits), the pairs within
+// the prefix and within the postfix are tabulated, while the pairs between a
+// postfix site i and prefix sites are counted by a popcount of the prefix
+// masked with the XOR of the corresponding masks of all occupied postfix
+// sites. The parity within the postfix is stored in the highest bit of this
+// mask. The memory is of order 2^(nsites / 2) per symmetry.
+template <typename bit_t> class FermiSignLookup {
+public:
+  FermiSignLookup() = default;
+  explicit FermiSignLookup(PermutationGroup const &group);
+  inline bool sign(int64_t sym, bit_t state) const {
+    bit_t prefix = state >> n_postfix_bits_;
+    bit_t postfix = state & postfix_mask_;
+    int64_t idx_prefix = (sym << n_prefix_bits_) | (int64_t)prefix;
+    bit_t entry = table_postfix_[(sym << n_postfix_bits_) | (int64_t)postfix];
+    return (bits::popcnt(prefix & entry) ^ (entry >> parity_bit_) ^
+            (table_prefix_[idx_prefix >> 6] >> (idx_prefix & 63))) &
+           1;
+  }
+  int64_t memory() const;
+
+  // Number of bits of the postfix, such that both tables have a similar size
+  static int64_t n_postfix_bits(int64_t nsites);
+
+  bool operator==(FermiSignLookup const &rhs) const;
+  bool operator!=(FermiSignLookup const &rhs) const;
+
+private:
+  int64_t nsites_ = 0;
+  int64_t n_prefix_bits_ = 0;
+  int64_t n_postfix_bits_ = 0;
+  int64_t parity_bit_ = 0;
+  bit_t postfix_mask_ = 0;
+  std::vector<uint64_t> table_prefix_;
+  std::vector<bit_t> table_postfix_;
+};
+
 } // namespace xdiag::combinatorics
@@ -10,6 +10,7 @@
 #include <xdiag/combinatorics/combinations.hpp>
 #include <xdiag/combinatorics/combinations_index.hpp>
 #include <xdiag/common.hpp>
+#include <xdiag/utils/prefetch.hpp>
 
 namespace xdiag::combinatorics {
 
@@ -26,6 +27,12 @@ public:
            right_indices_[bits::gbits(bits, 0, n_right_)];
   }
 
+  // Prefetch the table entries read by index
+  inline void prefetch(bit_t bits) const {
+    xdiag::prefetch(left_indices_.data() + (bits >> n_right_));
+    xdiag::prefetch(right_indices_.data() + bits::gbits(bits, 0, n_right_));
+  }
+
   inline combinatorics::Combinations<bit_t> states() const {
     return combinatorics::Combinations<bit_t>(n_, k_);
   }
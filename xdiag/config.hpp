@@ -0,0 +1,10 @@
+#pragma once
+
+#define XDIAG_VERSION "0.3.2"
+#define XDIAG_DIRECTORY "/root/repo"
+#define XDIAG_HOSTNAME "vm"
+#define XDIAG_COMPILEDBY "root"
+
+namespace xdiag {
+inline const char *git_hash() { return "1b4fd12e157dac1486577b775b48152a4fd75390"; }
+} // namespace xdiag
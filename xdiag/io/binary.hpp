@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <istream>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <xdiag/common.hpp>
+#include <xdiag/utils/error.hpp>
+
+namespace xdiag::io {
+
+// Raw binary I/O of scalars and vectors of trivially copyable types. The
+// data is written in native byte order, such that files can only be read
+// on machines of the same architecture.
+template <typename T> void write_binary(std::ostream &out, T const &value) {
+  static_assert(std::is_trivially_copyable<T>::value);
+  out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  if (!out) {
+    XDIAG_THROW("Unable to write binary data");
+  }
+}
+
+template <typename T, class allocator_t>
+void write_binary(std::ostream &out, std::vector<T, allocator_t> const &vec) {
+  static_assert(std::is_trivially_copyable<T>::value);
+  write_binary(out, (int64_t)vec.size());
+  out.write(reinterpret_cast<const char *>(vec.data()), vec.size() * sizeof(T));
+  if (!out) {
+    XDIAG_THROW("Unable to write binary data");
+  }
+}
+
+template <typename T> void read_binary(std::istream &in, T &value) {
+  static_assert(std::is_trivially_copyable<T>::value);
+  in.read(reinterpret_cast<char *>(&value), sizeof(T));
+  if (!in) {
+    XDIAG_THROW("Unable to read binary data");
+  }
+}
+
+template <typename T, class allocator_t>
+void read_binary(std::istream &in, std::vector<T, allocator_t> &vec) {
+  static_assert(std::is_trivially_copyable<T>::value);
+  int64_t size;
+  read_binary(in, size);
+  if (size < 0) {
+    XDIAG_THROW("Invalid size of vector in binary data");
+  }
+  vec.resize(size);
+  in.read(reinterpret_cast<char *>(vec.data()), size * sizeof(T));
+  if (!in) {
+    XDIAG_THROW("Unable to read binary data");
+  }
+}
+
+// Pairs of trivially copyable types are stored as their raw memory, which
+// avoids copying large vectors of pairs element by element
+template <typename T1, typename T2, class allocator_t>
+void write_binary(std::ostream &out,
+                  std::vector<std::pair<T1, T2>, allocator_t> const &vec) {
+  static_assert(std::is_trivially_copyable<T1>::value &&
+                std::is_trivially_copyable<T2>::value &&
+                (sizeof(std::pair<T1, T2>) == sizeof(T1) + sizeof(T2)));
+  write_binary(out, (int64_t)vec.size());
+  out.write(reinterpret_cast<const char *>(vec.data()),
+            vec.size() * sizeof(std::pair<T1, T2>));
+  if (!out) {
+    XDIAG_THROW("Unable to write binary data");
+  }
+}
+
+template <typename T1, typename T2, class allocator_t>
+void read_binary(std::istream &in,
+                 std::vector<std::pair<T1, T2>, allocator_t> &vec) {
+  static_assert(std::is_trivially_copyable<T1>::value &&
+                std::is_trivially_copyable<T2>::value &&
+                (sizeof(std::pair<T1, T2>) == sizeof(T1) + sizeof(T2)));
+  int64_t size;
+  read_binary(in, size);
+  if (size < 0) {
+    XDIAG_THROW("Invalid size of vector in binary data");
+  }
+  vec.resize(size);
+  in.read(reinterpret_cast<char *>(vec.data()),
+          size * sizeof(std::pair<T1, T2>));
+  if (!in) {
+    XDIAG_THROW("Unable to read binary data");
+  }
+}
+
+} // namespace xdiag::io
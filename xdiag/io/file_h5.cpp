@@ -6,6 +6,7 @@
 
 #include "file_h5.hpp"
 
+#include <xdiag/io/hdf5/read.hpp>
 #include <xdiag/utils/logger.hpp>
 
 namespace xdiag {
@@ -19,7 +20,6 @@ FileH5::FileH5(std::string filename, std::string iomode) try
   if (iomode == "r") {
     Log(2, "opening h5file in r mode.");
     file_id_ = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
-    XDIAG_THROW("Error in xdiag hdf5: read mode (r) currently not implemented");
     if (file_id_ == H5I_INVALID_HID) {
       XDIAG_THROW(fmt::format(
           "Cannot open file in read mode \"r\": {}\n Maybe it does not exist?",
@@ -83,6 +83,8 @@ hdf5::FileH5Handler FileH5::operator[](std::string key) {
   return hdf5::FileH5Handler(file_id_, key);
 }
 
+bool FileH5::has(std::string key) const { return hdf5::exists(file_id_, key); }
+
 bool FileH5::operator==(FileH5 const &other) const {
   return (filename_ == other.filename_) && (iomode_ == other.iomode_) &&
          (file_id_ == other.file_id_);
@@ -26,6 +26,7 @@ public:
   void close();
 
   XDIAG_API hdf5::FileH5Handler operator[](std::string key);
+  XDIAG_API bool has(std::string key) const;
   bool operator==(FileH5 const &other) const;
   bool operator!=(FileH5 const &other) const;
 
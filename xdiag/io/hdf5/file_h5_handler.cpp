@@ -8,6 +8,7 @@
 #include <complex>
 #include <vector>
 
+#include <xdiag/io/hdf5/read.hpp>
 #include <xdiag/io/hdf5/write.hpp>
 #include <xdiag/utils/logger.hpp>
 
@@ -18,6 +19,12 @@ using complex = std::complex<double>;
 FileH5Handler::FileH5Handler(hid_t file_id, std::string field)
     : file_id_(file_id), field_(field) {}
 
+template <class data_t> data_t FileH5Handler::as() const try {
+  return read<data_t>(file_id_, field_);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
 template <class data_t> void FileH5Handler::operator=(data_t const &data) try {
   write(file_id_, field_, data);
 } catch (Error const &e) {
@@ -36,6 +43,47 @@ hdf5::FileH5Subcube FileH5Handler::slice(int slice_number) try {
   XDIAG_RETHROW(e);
 }
 
+template XDIAG_API int8_t FileH5Handler::as<int8_t>() const;
+template XDIAG_API int16_t FileH5Handler::as<int16_t>() const;
+template XDIAG_API int32_t FileH5Handler::as<int32_t>() const;
+template XDIAG_API int64_t FileH5Handler::as<int64_t>() const;
+template XDIAG_API uint8_t FileH5Handler::as<uint8_t>() const;
+template XDIAG_API uint16_t FileH5Handler::as<uint16_t>() const;
+template XDIAG_API uint32_t FileH5Handler::as<uint32_t>() const;
+template XDIAG_API uint64_t FileH5Handler::as<uint64_t>() const;
+template XDIAG_API double FileH5Handler::as<double>() const;
+template XDIAG_API complex FileH5Handler::as<complex>() const;
+
+template XDIAG_API std::vector<int8_t>
+FileH5Handler::as<std::vector<int8_t>>() const;
+template XDIAG_API std::vector<int16_t>
+FileH5Handler::as<std::vector<int16_t>>() const;
+template XDIAG_API std::vector<int32_t>
+FileH5Handler::as<std::vector<int32_t>>() const;
+template XDIAG_API std::vector<int64_t>
+FileH5Handler::as<std::vector<int64_t>>() const;
+template XDIAG_API std::vector<uint8_t>
+FileH5Handler::as<std::vector<uint8_t>>() const;
+template XDIAG_API std::vector<uint16_t>
+FileH5Handler::as<std::vector<uint16_t>>() const;
+template XDIAG_API std::vector<uint32_t>
+FileH5Handler::as<std::vector<uint32_t>>() const;
+template XDIAG_API std::vector<uint64_t>
+FileH5Handler::as<std::vector<uint64_t>>() const;
+template XDIAG_API std::vector<double>
+FileH5Handler::as<std::vector<double>>() const;
+template XDIAG_API std::vector<complex>
+FileH5Handler::as<std::vector<complex>>() const;
+
+template XDIAG_API arma::ivec FileH5Handler::as<arma::ivec>() const;
+template XDIAG_API arma::uvec FileH5Handler::as<arma::uvec>() const;
+template XDIAG_API arma::vec FileH5Handler::as<arma::vec>() const;
+template XDIAG_API arma::cx_vec FileH5Handler::as<arma::cx_vec>() const;
+template XDIAG_API arma::imat FileH5Handler::as<arma::imat>() const;
+template XDIAG_API arma::umat FileH5Handler::as<arma::umat>() const;
+template XDIAG_API arma::mat FileH5Handler::as<arma::mat>() const;
+template XDIAG_API arma::cx_mat FileH5Handler::as<arma::cx_mat>() const;
+
 template XDIAG_API void FileH5Handler::operator=(int8_t const &);
 template XDIAG_API void FileH5Handler::operator=(int16_t const &);
 template XDIAG_API void FileH5Handler::operator=(int32_t const &);
@@ -20,6 +20,7 @@ public:
   FileH5Handler(FileH5Handler const &) = delete;
   FileH5Handler &operator=(FileH5Handler const &) = delete;
 
+  template <class data_t> XDIAG_API data_t as() const;
   template <class data_t> XDIAG_API void operator=(data_t const &data);
 
   hdf5::FileH5Submat col(int col_number);
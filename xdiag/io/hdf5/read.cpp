@@ -0,0 +1,341 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifdef XDIAG_USE_HDF5
+#include "read.hpp"
+
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+#include <xdiag/io/hdf5/types.hpp>
+#include <xdiag/utils/logger.hpp>
+
+namespace xdiag::hdf5 {
+
+using complex = std::complex<double>;
+
+bool exists(hid_t file_id, std::string field) {
+  // Every group on the path needs to be checked, as H5Lexists fails if an
+  // intermediate group is missing
+  std::size_t loc = 0;
+  while ((loc = field.find("/", loc + 1)) != std::string::npos) {
+    if (H5Lexists(file_id, field.substr(0, loc).c_str(), H5P_DEFAULT) <= 0) {
+      return false;
+    }
+  }
+  return H5Lexists(file_id, field.c_str(), H5P_DEFAULT) > 0;
+}
+
+// Opens the dataset of a field and checks that it has the expected rank.
+// The dimensions are returned in the (row-major) order used by HDF5.
+static hid_t open_dataset(hid_t file_id, std::string const &field, int rank,
+                          std::vector<hsize_t> &dims) try {
+  if (!exists(file_id, field)) {
+    XDIAG_THROW(fmt::format(
+        "Error in xdiag hdf5: field \"{}\" does not exist", field));
+  }
+  hid_t dataset = H5Dopen(file_id, field.c_str(), H5P_DEFAULT);
+  if (dataset == H5I_INVALID_HID) {
+    XDIAG_THROW(fmt::format(
+        "Error in xdiag hdf5: error opening dataset for field \"{}\"", field));
+  }
+  hid_t dataspace = H5Dget_space(dataset);
+  int rank_file = H5Sget_simple_extent_ndims(dataspace);
+  if (rank_file != rank) {
+    H5Sclose(dataspace);
+    H5Dclose(dataset);
+    XDIAG_THROW(fmt::format("Error in xdiag hdf5: dataset for field \"{}\" "
+                            "has rank {}, expected rank {}",
+                            field, rank_file, rank));
+  }
+  dims.resize(rank);
+  H5Sget_simple_extent_dims(dataspace, dims.data(), nullptr);
+  H5Sclose(dataspace);
+  return dataset;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+// Reads the full dataset into ptr and closes the dataset
+template <typename data_t>
+static void read_dataset(hid_t dataset, std::string const &field,
+                         data_t *ptr) try {
+  hid_t datatype = hdf5_datatype<data_t>();
+  herr_t status =
+      H5Dread(dataset, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, ptr);
+  if (hdf5_datatype_mutable<data_t>()) {
+    H5Tclose(datatype);
+  }
+  H5Dclose(dataset);
+  if (status < 0) {
+    XDIAG_THROW(fmt::format(
+        "Error in xdiag hdf5: could not read data for field \"{}\"", field));
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <typename data_t>
+data_t read_scalar(hid_t file_id, std::string field) try {
+  std::vector<hsize_t> dims;
+  hid_t dataset = open_dataset(file_id, field, 0, dims);
+  data_t data;
+  read_dataset(dataset, field, &data);
+  return data;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template int8_t read_scalar<int8_t>(hid_t, std::string);
+template int16_t read_scalar<int16_t>(hid_t, std::string);
+template int32_t read_scalar<int32_t>(hid_t, std::string);
+template int64_t read_scalar<int64_t>(hid_t, std::string);
+template uint8_t read_scalar<uint8_t>(hid_t, std::string);
+template uint16_t read_scalar<uint16_t>(hid_t, std::string);
+template uint32_t read_scalar<uint32_t>(hid_t, std::string);
+template uint64_t read_scalar<uint64_t>(hid_t, std::string);
+template double read_scalar<double>(hid_t, std::string);
+template complex read_scalar<complex>(hid_t, std::string);
+
+template <typename data_t>
+std::vector<data_t> read_std_vector(hid_t file_id, std::string field) try {
+  std::vector<hsize_t> dims;
+  hid_t dataset = open_dataset(file_id, field, 1, dims);
+  std::vector<data_t> data(dims[0]);
+  read_dataset(dataset, field, data.data());
+  return data;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template std::vector<int8_t> read_std_vector<int8_t>(hid_t, std::string);
+template std::vector<int16_t> read_std_vector<int16_t>(hid_t, std::string);
+template std::vector<int32_t> read_std_vector<int32_t>(hid_t, std::string);
+template std::vector<int64_t> read_std_vector<int64_t>(hid_t, std::string);
+template std::vector<uint8_t> read_std_vector<uint8_t>(hid_t, std::string);
+template std::vector<uint16_t> read_std_vector<uint16_t>(hid_t, std::string);
+template std::vector<uint32_t> read_std_vector<uint32_t>(hid_t, std::string);
+template std::vector<uint64_t> read_std_vector<uint64_t>(hid_t, std::string);
+template std::vector<double> read_std_vector<double>(hid_t, std::string);
+template std::vector<complex> read_std_vector<complex>(hid_t, std::string);
+
+template <typename data_t>
+arma::Col<data_t> read_arma_vector(hid_t file_id, std::string field) try {
+  std::vector<hsize_t> dims;
+  hid_t dataset = open_dataset(file_id, field, 1, dims);
+  arma::Col<data_t> data(dims[0]);
+  read_dataset(dataset, field, data.memptr());
+  return data;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template arma::Col<arma::sword>
+read_arma_vector<arma::sword>(hid_t, std::string);
+template arma::Col<arma::uword>
+read_arma_vector<arma::uword>(hid_t, std::string);
+template arma::Col<double> read_arma_vector<double>(hid_t, std::string);
+template arma::Col<complex> read_arma_vector<complex>(hid_t, std::string);
+
+template <typename data_t>
+arma::Mat<data_t> read_arma_matrix(hid_t file_id, std::string field) try {
+  std::vector<hsize_t> dims;
+  hid_t dataset = open_dataset(file_id, field, 2, dims);
+  arma::Mat<data_t> data(dims[1], dims[0]);
+  read_dataset(dataset, field, data.memptr());
+  return data;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template arma::Mat<arma::sword>
+read_arma_matrix<arma::sword>(hid_t, std::string);
+template arma::Mat<arma::uword>
+read_arma_matrix<arma::uword>(hid_t, std::string);
+template arma::Mat<double> read_arma_matrix<double>(hid_t, std::string);
+template arma::Mat<complex> read_arma_matrix<complex>(hid_t, std::string);
+
+template <> int8_t read<int8_t>(hid_t file_id, std::string field) try {
+  return read_scalar<int8_t>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <> int16_t read<int16_t>(hid_t file_id, std::string field) try {
+  return read_scalar<int16_t>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <> int32_t read<int32_t>(hid_t file_id, std::string field) try {
+  return read_scalar<int32_t>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <> int64_t read<int64_t>(hid_t file_id, std::string field) try {
+  return read_scalar<int64_t>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <> uint8_t read<uint8_t>(hid_t file_id, std::string field) try {
+  return read_scalar<uint8_t>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <> uint16_t read<uint16_t>(hid_t file_id, std::string field) try {
+  return read_scalar<uint16_t>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <> uint32_t read<uint32_t>(hid_t file_id, std::string field) try {
+  return read_scalar<uint32_t>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <> uint64_t read<uint64_t>(hid_t file_id, std::string field) try {
+  return read_scalar<uint64_t>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <> double read<double>(hid_t file_id, std::string field) try {
+  return read_scalar<double>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <> complex read<complex>(hid_t file_id, std::string field) try {
+  return read_scalar<complex>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <>
+std::vector<int8_t>
+read<std::vector<int8_t>>(hid_t file_id, std::string field) try {
+  return read_std_vector<int8_t>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <>
+std::vector<int16_t>
+read<std::vector<int16_t>>(hid_t file_id, std::string field) try {
+  return read_std_vector<int16_t>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <>
+std::vector<int32_t>
+read<std::vector<int32_t>>(hid_t file_id, std::string field) try {
+  return read_std_vector<int32_t>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <>
+std::vector<int64_t>
+read<std::vector<int64_t>>(hid_t file_id, std::string field) try {
+  return read_std_vector<int64_t>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <>
+std::vector<uint8_t>
+read<std::vector<uint8_t>>(hid_t file_id, std::string field) try {
+  return read_std_vector<uint8_t>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <>
+std::vector<uint16_t>
+read<std::vector<uint16_t>>(hid_t file_id, std::string field) try {
+  return read_std_vector<uint16_t>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <>
+std::vector<uint32_t>
+read<std::vector<uint32_t>>(hid_t file_id, std::string field) try {
+  return read_std_vector<uint32_t>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <>
+std::vector<uint64_t>
+read<std::vector<uint64_t>>(hid_t file_id, std::string field) try {
+  return read_std_vector<uint64_t>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <>
+std::vector<double>
+read<std::vector<double>>(hid_t file_id, std::string field) try {
+  return read_std_vector<double>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <>
+std::vector<complex>
+read<std::vector<complex>>(hid_t file_id, std::string field) try {
+  return read_std_vector<complex>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <>
+arma::Col<arma::sword>
+read<arma::Col<arma::sword>>(hid_t file_id, std::string field) try {
+  return read_arma_vector<arma::sword>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <>
+arma::Col<arma::uword>
+read<arma::Col<arma::uword>>(hid_t file_id, std::string field) try {
+  return read_arma_vector<arma::uword>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <>
+arma::Col<double>
+read<arma::Col<double>>(hid_t file_id, std::string field) try {
+  return read_arma_vector<double>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <>
+arma::Col<complex>
+read<arma::Col<complex>>(hid_t file_id, std::string field) try {
+  return read_arma_vector<complex>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <>
+arma::Mat<arma::sword>
+read<arma::Mat<arma::sword>>(hid_t file_id, std::string field) try {
+  return read_arma_matrix<arma::sword>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <>
+arma::Mat<arma::uword>
+read<arma::Mat<arma::uword>>(hid_t file_id, std::string field) try {
+  return read_arma_matrix<arma::uword>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <>
+arma::Mat<double>
+read<arma::Mat<double>>(hid_t file_id, std::string field) try {
+  return read_arma_matrix<double>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+template <>
+arma::Mat<complex>
+read<arma::Mat<complex>>(hid_t file_id, std::string field) try {
+  return read_arma_matrix<complex>(file_id, field);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+} // namespace xdiag::hdf5
+#endif
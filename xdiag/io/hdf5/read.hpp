@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifdef XDIAG_USE_HDF5
+
+#include <string>
+#include <vector>
+
+#include <hdf5.h>
+
+#include <xdiag/extern/armadillo/armadillo>
+
+namespace xdiag::hdf5 {
+
+bool exists(hid_t file_id, std::string field);
+
+template <typename data_t> data_t read_scalar(hid_t file_id, std::string field);
+
+template <typename data_t>
+std::vector<data_t> read_std_vector(hid_t file_id, std::string field);
+
+template <typename data_t>
+arma::Col<data_t> read_arma_vector(hid_t file_id, std::string field);
+
+template <typename data_t>
+arma::Mat<data_t> read_arma_matrix(hid_t file_id, std::string field);
+
+template <typename data_t> data_t read(hid_t file_id, std::string field);
+
+} // namespace xdiag::hdf5
+#endif
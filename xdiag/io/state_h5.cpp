@@ -0,0 +1,742 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifdef XDIAG_USE_HDF5
+#include "state_h5.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <fstream>
+#include <vector>
+
+#include <hdf5.h>
+
+#ifdef XDIAG_USE_MPI
+#include <mpi.h>
+#include <xdiag/parallel/mpi/communicator.hpp>
+#endif
+
+#include <xdiag/io/hdf5/read.hpp>
+#include <xdiag/io/hdf5/types.hpp>
+#include <xdiag/io/hdf5/utils.hpp>
+#include <xdiag/io/hdf5/write.hpp>
+#include <xdiag/random/hash.hpp>
+#include <xdiag/utils/logger.hpp>
+
+namespace xdiag {
+
+// Number of coefficients per chunk of a dataset
+static constexpr hsize_t chunk_size = 1 << 18;
+
+namespace {
+struct block_metadata_t {
+  std::string type;
+  int64_t nsites;
+  int64_t nup; // -1 if not conserved
+  int64_t ndn; // -1 if not conserved
+  bool symmetric;
+  int64_t dim;
+  bool distributed;
+  bool fermionic;
+  int64_t spinflip; // 0 without spin flip symmetry
+  std::optional<Representation> irrep;
+};
+} // namespace
+
+static block_metadata_t block_metadata(Block const &block) {
+  return std::visit(
+      overload{
+          [](Spinhalf const &b) {
+            return block_metadata_t{"Spinhalf",
+                                    b.nsites(),
+                                    b.nup().value_or(-1),
+                                    -1,
+                                    (bool)b.irrep(),
+                                    b.dim(),
+                                    false,
+                                    false,
+                                    b.spinflip().value_or(0),
+                                    b.irrep()};
+          },
+          [](tJ const &b) {
+            return block_metadata_t{"tJ",
+                                    b.nsites(),
+                                    b.nup().value_or(-1),
+                                    b.ndn().value_or(-1),
+                                    (bool)b.irrep(),
+                                    b.dim(),
+                                    false,
+                                    true,
+                                    0,
+                                    b.irrep()};
+          },
+          [](Electron const &b) {
+            return block_metadata_t{"Electron",
+                                    b.nsites(),
+                                    b.nup().value_or(-1),
+                                    b.ndn().value_or(-1),
+                                    (bool)b.irrep(),
+                                    b.dim(),
+                                    false,
+                                    true,
+                                    0,
+                                    b.irrep()};
+          },
+#ifdef XDIAG_USE_MPI
+          [](SpinhalfDistributed const &b) {
+            return block_metadata_t{"SpinhalfDistributed",
+                                    b.nsites(),
+                                    b.nup().value_or(-1),
+                                    -1,
+                                    (bool)b.irrep(),
+                                    b.dim(),
+                                    true,
+                                    false,
+                                    0,
+                                    b.irrep()};
+          },
+          [](tJDistributed const &b) {
+            return block_metadata_t{"tJDistributed",
+                                    b.nsites(),
+                                    b.nup().value_or(-1),
+                                    b.ndn().value_or(-1),
+                                    false,
+                                    b.dim(),
+                                    true,
+                                    true,
+                                    0,
+                                    std::nullopt};
+          },
+          [](ElectronDistributed const &b) {
+            return block_metadata_t{"ElectronDistributed",
+                                    b.nsites(),
+                                    b.nup().value_or(-1),
+                                    b.ndn().value_or(-1),
+                                    false,
+                                    b.dim(),
+                                    true,
+                                    true,
+                                    0,
+                                    std::nullopt};
+          },
+#endif
+      },
+      block);
+}
+
+static void write_metadata(hid_t file_id, std::string const &field,
+                           block_metadata_t const &meta, bool real,
+                           int64_t ncols) try {
+  hdf5::write_std_vector(file_id, field + "/block/type",
+                         std::vector<int8_t>(meta.type.begin(),
+                                             meta.type.end()));
+  hdf5::write_scalar(file_id, field + "/block/nsites", meta.nsites);
+  hdf5::write_scalar(file_id, field + "/block/nup", meta.nup);
+  hdf5::write_scalar(file_id, field + "/block/ndn", meta.ndn);
+  hdf5::write_scalar(file_id, field + "/block/symmetric",
+                     (int64_t)meta.symmetric);
+  hdf5::write_scalar(file_id, field + "/block/dim", meta.dim);
+  hdf5::write_scalar(file_id, field + "/block/spinflip", meta.spinflip);
+  if (meta.irrep) {
+    arma::cx_vec characters = meta.irrep->characters().as<arma::cx_vec>();
+    hdf5::write_std_vector(
+        file_id, field + "/block/characters",
+        std::vector<complex>(characters.begin(), characters.end()));
+    hdf5::write_scalar(file_id, field + "/block/group_hash",
+                       random::hash(meta.irrep->group()));
+  }
+  hdf5::write_scalar(file_id, field + "/real", (int64_t)real);
+  hdf5::write_scalar(file_id, field + "/ncols", ncols);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+static void check_metadata(hid_t file_id, std::string const &field,
+                           block_metadata_t const &meta) try {
+  auto chars = hdf5::read<std::vector<int8_t>>(file_id, field + "/block/type");
+  std::string type(chars.begin(), chars.end());
+  if (type != meta.type) {
+    XDIAG_THROW(fmt::format("State in field \"{}\" has been written on a "
+                            "block of type {}, but a block of type {} is given",
+                            field, type, meta.type));
+  }
+  int64_t nsites = hdf5::read<int64_t>(file_id, field + "/block/nsites");
+  int64_t nup = hdf5::read<int64_t>(file_id, field + "/block/nup");
+  int64_t ndn = hdf5::read<int64_t>(file_id, field + "/block/ndn");
+  bool symmetric =
+      (bool)hdf5::read<int64_t>(file_id, field + "/block/symmetric");
+  int64_t dim = hdf5::read<int64_t>(file_id, field + "/block/dim");
+  if ((nsites != meta.nsites) || (nup != meta.nup) || (ndn != meta.ndn) ||
+      (symmetric != meta.symmetric) || (dim != meta.dim)) {
+    XDIAG_THROW(fmt::format(
+        "Block of the State in field \"{}\" (nsites={}, nup={}, ndn={}, "
+        "symmetric={}, dim={}) does not agree with the given block (nsites={}, "
+        "nup={}, ndn={}, symmetric={}, dim={})",
+        field, nsites, nup, ndn, symmetric, dim, meta.nsites, meta.nup,
+        meta.ndn, meta.symmetric, meta.dim));
+  }
+
+  // Blocks of the same dimension can differ in the symmetry sector
+  int64_t spinflip = hdf5::read<int64_t>(file_id, field + "/block/spinflip");
+  if (spinflip != meta.spinflip) {
+    XDIAG_THROW(fmt::format("State in field \"{}\" has been written on a "
+                            "block with spin flip parity {}, but the given "
+                            "block has spin flip parity {}",
+                            field, spinflip, meta.spinflip));
+  }
+  if (meta.irrep) {
+    auto characters = hdf5::read_std_vector<complex>(
+        file_id, field + "/block/characters");
+    uint64_t group_hash =
+        hdf5::read<uint64_t>(file_id, field + "/block/group_hash");
+    arma::cx_vec characters_block =
+        meta.irrep->characters().as<arma::cx_vec>();
+    bool same = (group_hash == random::hash(meta.irrep->group())) &&
+                (characters.size() == characters_block.size());
+    for (int64_t i = 0; same && (i < (int64_t)characters.size()); ++i) {
+      same = std::abs(characters[i] - characters_block(i)) < 1e-12;
+    }
+    if (!same) {
+      XDIAG_THROW(fmt::format("State in field \"{}\" has been written on a "
+                              "block with a different symmetry group or "
+                              "irreducible representation",
+                              field));
+    }
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+// If collective is set and HDF5 has been built with parallel support, the
+// file is opened by all processes using MPI-IO
+static hid_t open_file(std::string const &filename, bool write,
+                       bool collective) try {
+  hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+#if defined(XDIAG_USE_MPI) && defined(H5_HAVE_PARALLEL)
+  if (collective) {
+    H5Pset_fapl_mpio(fapl, MPI_COMM_WORLD, MPI_INFO_NULL);
+  }
+#else
+  (void)collective;
+#endif
+  hid_t file_id;
+  if (!write) {
+    file_id = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, fapl);
+  } else if (std::ifstream(filename).good()) {
+    file_id = H5Fopen(filename.c_str(), H5F_ACC_RDWR, fapl);
+  } else {
+    file_id = H5Fcreate(filename.c_str(), H5F_ACC_EXCL, H5P_DEFAULT, fapl);
+  }
+  H5Pclose(fapl);
+  if (file_id == H5I_INVALID_HID) {
+    XDIAG_THROW(fmt::format("Unable to open HDF5 file \"{}\"", filename));
+  }
+  return file_id;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+  return H5I_INVALID_HID;
+}
+
+static bool field_exists(std::string const &filename,
+                         std::string const &field) {
+  if (!std::ifstream(filename).good()) {
+    return false;
+  }
+  hid_t file_id = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  if (file_id == H5I_INVALID_HID) {
+    return false;
+  }
+  bool exists = hdf5::exists(file_id, field);
+  H5Fclose(file_id);
+  return exists;
+}
+
+// Datasets are chunked along the dimension of the block, such that every
+// process writes and reads whole chunks for large blocks
+template <typename data_t>
+static void create_dataset(hid_t file_id, std::string const &field,
+                           std::vector<hsize_t> const &dims,
+                           int64_t compression) try {
+  std::vector<hid_t> groups = hdf5::create_groups(file_id, field);
+  hid_t group = (groups.size() == 0) ? file_id : groups[groups.size() - 1];
+  if (group == H5I_INVALID_HID) {
+    XDIAG_THROW(fmt::format(
+        "Error in xdiag hdf5: error creating groups for field \"{}\"", field));
+  }
+  hid_t datatype = hdf5::hdf5_datatype<data_t>();
+  hid_t dataspace = H5Screate_simple(dims.size(), dims.data(), nullptr);
+  hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+  if (dims.back() > 0) {
+    std::vector<hsize_t> chunk(dims.size(), 1);
+    chunk.back() = std::min(dims.back(), chunk_size);
+    H5Pset_chunk(dcpl, chunk.size(), chunk.data());
+    if (compression > 0) {
+      H5Pset_deflate(dcpl, compression);
+    }
+  }
+  std::string name = hdf5::dataset_name(field);
+  hid_t dataset = H5Dcreate(group, name.c_str(), datatype, dataspace,
+                            H5P_DEFAULT, dcpl, H5P_DEFAULT);
+  H5Pclose(dcpl);
+  H5Sclose(dataspace);
+  if (hdf5::hdf5_datatype_mutable<data_t>()) {
+    H5Tclose(datatype);
+  }
+  hdf5::close_groups(groups);
+  if (dataset == H5I_INVALID_HID) {
+    XDIAG_THROW(fmt::format(
+        "Error in xdiag hdf5: error creating dataset for field \"{}\"", field));
+  }
+  H5Dclose(dataset);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+// Writes or reads the hyperslab of a dataset given by start and count. Empty
+// hyperslabs are allowed, such that every process can take part in
+// collective transfers.
+template <typename data_t>
+static void transfer_hyperslab(hid_t file_id, std::string const &field,
+                               std::vector<hsize_t> const &start,
+                               std::vector<hsize_t> const &count, data_t *data,
+                               bool write, hid_t dxpl) try {
+  hid_t dataset = H5Dopen(file_id, field.c_str(), H5P_DEFAULT);
+  if (dataset == H5I_INVALID_HID) {
+    XDIAG_THROW(fmt::format(
+        "Error in xdiag hdf5: error opening dataset for field \"{}\"", field));
+  }
+  hid_t datatype = hdf5::hdf5_datatype<data_t>();
+  hid_t filespace = H5Dget_space(dataset);
+  hid_t memspace = H5Screate_simple(count.size(), count.data(), nullptr);
+  data_t empty;
+  if (std::find(count.begin(), count.end(), 0) != count.end()) {
+    H5Sselect_none(filespace);
+    H5Sselect_none(memspace);
+    data = &empty;
+  } else {
+    H5Sselect_hyperslab(filespace, H5S_SELECT_SET, start.data(), nullptr,
+                        count.data(), nullptr);
+  }
+  herr_t status =
+      write ? H5Dwrite(dataset, datatype, memspace, filespace, dxpl, data)
+            : H5Dread(dataset, datatype, memspace, filespace, dxpl, data);
+  H5Sclose(memspace);
+  H5Sclose(filespace);
+  if (hdf5::hdf5_datatype_mutable<data_t>()) {
+    H5Tclose(datatype);
+  }
+  H5Dclose(dataset);
+  if (status < 0) {
+    XDIAG_THROW(fmt::format(
+        "Error in xdiag hdf5: could not transfer data for field \"{}\"",
+        field));
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+// Creates the metadata and (empty) datasets of a State
+static void create_state(hid_t file_id, std::string const &field,
+                         block_metadata_t const &meta, State const &state,
+                         int64_t compression) try {
+  write_metadata(file_id, field, meta, state.isreal(), state.ncols());
+  std::vector<hsize_t> dims = {(hsize_t)state.ncols(), (hsize_t)meta.dim};
+  if (state.isreal()) {
+    create_dataset<double>(file_id, field + "/coefficients", dims,
+                           compression);
+  } else {
+    create_dataset<complex>(file_id, field + "/coefficients", dims,
+                            compression);
+  }
+  if (meta.distributed) {
+    create_dataset<uint64_t>(file_id, field + "/ups", {(hsize_t)meta.dim},
+                             compression);
+    if (meta.fermionic) {
+      create_dataset<uint64_t>(file_id, field + "/dns", {(hsize_t)meta.dim},
+                               compression);
+    }
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+// The coefficients are stored as a (ncols x dim) dataset, such that the
+// column major matrix of a State is written as a contiguous hyperslab
+static void transfer_coefficients(hid_t file_id, std::string const &field,
+                                  State const &state, int64_t offset,
+                                  bool write, hid_t dxpl) try {
+  std::vector<hsize_t> start = {0, (hsize_t)offset};
+  std::vector<hsize_t> count = {(hsize_t)state.ncols(),
+                                (hsize_t)state.nrows()};
+  if (state.isreal()) {
+    arma::mat coeffs = state.matrix(false);
+    transfer_hyperslab(file_id, field + "/coefficients", start, count,
+                       coeffs.memptr(), write, dxpl);
+  } else {
+    arma::cx_mat coeffs = state.matrixC(false);
+    transfer_hyperslab(file_id, field + "/coefficients", start, count,
+                       coeffs.memptr(), write, dxpl);
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+static void write_local(std::string const &filename, std::string const &field,
+                        State const &state, block_metadata_t const &meta,
+                        int64_t compression) try {
+  // Every process holds the full State, so only the first one writes
+  int mpi_rank = 0;
+#ifdef XDIAG_USE_MPI
+  MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+#endif
+  if (mpi_rank == 0) {
+    hid_t file_id = open_file(filename, true, false);
+    create_state(file_id, field, meta, state, compression);
+    transfer_coefficients(file_id, field, state, 0, true, H5P_DEFAULT);
+    H5Fclose(file_id);
+  }
+#ifdef XDIAG_USE_MPI
+  MPI_Barrier(MPI_COMM_WORLD);
+#endif
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+#ifdef XDIAG_USE_MPI
+
+static hid_t transfer_plist(bool collective) {
+  hid_t dxpl = H5Pcreate(H5P_DATASET_XFER);
+#ifdef H5_HAVE_PARALLEL
+  if (collective) {
+    H5Pset_dxpl_mpio(dxpl, H5FD_MPIO_COLLECTIVE);
+  }
+#else
+  (void)collective;
+#endif
+  return dxpl;
+}
+
+// Configurations of the local basis states in the order of the basis
+template <typename bit_t>
+static void configurations(basis::spinhalf_distributed::BasisSz<bit_t> const &b,
+                           std::vector<uint64_t> &ups,
+                           std::vector<uint64_t> &) {
+  for (bit_t spins : b) {
+    ups.push_back(spins);
+  }
+}
+
+template <typename bit_t, class group_action_t>
+static void configurations(
+    basis::spinhalf_distributed::BasisSymmetricSz<bit_t, group_action_t> const
+        &b,
+    std::vector<uint64_t> &ups, std::vector<uint64_t> &) {
+  for (bit_t rep : b) {
+    ups.push_back(rep);
+  }
+}
+
+template <typename bit_t>
+static void configurations(basis::tj_distributed::BasisNp<bit_t> const &b,
+                           std::vector<uint64_t> &ups,
+                           std::vector<uint64_t> &dns) {
+  for (auto [up, dn] : b) {
+    ups.push_back(up);
+    dns.push_back(dn);
+  }
+}
+
+template <typename bit_t>
+static void
+configurations(basis::electron_distributed::BasisNp<bit_t> const &b,
+               std::vector<uint64_t> &ups, std::vector<uint64_t> &dns) {
+  for (auto [up, dn] : b) {
+    ups.push_back(up);
+    dns.push_back(dn);
+  }
+}
+
+// MPI rank owning a configuration
+template <typename bit_t>
+static int owner(basis::spinhalf_distributed::BasisSz<bit_t> const &b,
+                 uint64_t ups, uint64_t) {
+  return b.rank((bit_t)ups >> b.n_postfix_bits());
+}
+
+template <typename bit_t, class group_action_t>
+static int owner(
+    basis::spinhalf_distributed::BasisSymmetricSz<bit_t, group_action_t> const
+        &b,
+    uint64_t ups, uint64_t) {
+  return b.rank((bit_t)ups);
+}
+
+template <typename bit_t>
+static int owner(basis::tj_distributed::BasisNp<bit_t> const &b, uint64_t ups,
+                 uint64_t) {
+  return b.rank((bit_t)ups);
+}
+
+template <typename bit_t>
+static int owner(basis::electron_distributed::BasisNp<bit_t> const &b,
+                 uint64_t ups, uint64_t) {
+  return b.rank((bit_t)ups);
+}
+
+// Local index of a configuration on its owning process
+template <typename bit_t>
+static int64_t local_index(basis::spinhalf_distributed::BasisSz<bit_t> const &b,
+                           uint64_t ups, uint64_t) {
+  return b.index((bit_t)ups);
+}
+
+template <typename bit_t, class group_action_t>
+static int64_t local_index(
+    basis::spinhalf_distributed::BasisSymmetricSz<bit_t, group_action_t> const
+        &b,
+    uint64_t ups, uint64_t) {
+  return b.index_of_representative((bit_t)ups);
+}
+
+template <typename bit_t>
+static int64_t local_index(basis::tj_distributed::BasisNp<bit_t> const &b,
+                           uint64_t ups, uint64_t dns) {
+  return b.index((bit_t)ups, (bit_t)dns);
+}
+
+template <typename bit_t>
+static int64_t
+local_index(basis::electron_distributed::BasisNp<bit_t> const &b,
+            uint64_t ups, uint64_t dns) {
+  return b.index((bit_t)ups, (bit_t)dns);
+}
+
+template <class function_t>
+static void visit_distributed_basis(Block const &block, function_t &&f) {
+  std::visit(
+      overload{
+          [&](SpinhalfDistributed const &b) { std::visit(f, b.basis()); },
+          [&](tJDistributed const &b) { std::visit(f, b.basis()); },
+          [&](ElectronDistributed const &b) { std::visit(f, b.basis()); },
+          [&](auto const &) {
+            XDIAG_THROW("Block is not a distributed block");
+          },
+      },
+      block);
+}
+
+template <class basis_t>
+static void write_distributed(std::string const &filename,
+                              std::string const &field, State const &state,
+                              basis_t const &basis,
+                              block_metadata_t const &meta,
+                              int64_t compression) try {
+  std::vector<uint64_t> ups;
+  std::vector<uint64_t> dns;
+  ups.reserve(basis.size());
+  if (meta.fermionic) {
+    dns.reserve(basis.size());
+  }
+  configurations(basis, ups, dns);
+
+  // Every process writes its states to a contiguous range of the datasets
+  int mpi_rank, mpi_size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+  int64_t size = ups.size();
+  int64_t offset = 0;
+  MPI_Exscan(&size, &offset, 1, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+  if (mpi_rank == 0) {
+    offset = 0;
+  }
+
+  auto write_slab = [&](hid_t file_id, hid_t dxpl) {
+    transfer_hyperslab(file_id, field + "/ups", {(hsize_t)offset},
+                       {(hsize_t)size}, ups.data(), true, dxpl);
+    if (meta.fermionic) {
+      transfer_hyperslab(file_id, field + "/dns", {(hsize_t)offset},
+                         {(hsize_t)size}, dns.data(), true, dxpl);
+    }
+    transfer_coefficients(file_id, field, state, offset, true, dxpl);
+  };
+
+#ifdef H5_HAVE_PARALLEL
+  hid_t file_id = open_file(filename, true, true);
+  create_state(file_id, field, meta, state, compression);
+  hid_t dxpl = transfer_plist(true);
+  write_slab(file_id, dxpl);
+  H5Pclose(dxpl);
+  H5Fclose(file_id);
+#else
+  // Without parallel HDF5 the processes write their parts one after another
+  if (mpi_rank == 0) {
+    hid_t file_id = open_file(filename, true, false);
+    create_state(file_id, field, meta, state, compression);
+    H5Fclose(file_id);
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+  for (int rank = 0; rank < mpi_size; ++rank) {
+    if (rank == mpi_rank) {
+      hid_t file_id = open_file(filename, true, false);
+      write_slab(file_id, H5P_DEFAULT);
+      H5Fclose(file_id);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+  }
+#endif
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+// Sends the values of every configuration to the process owning it
+template <typename data_t>
+static std::vector<data_t> exchange(mpi::Communicator &comm,
+                                    std::vector<int> const &owners,
+                                    data_t const *values) {
+  std::vector<data_t> send_buffer(comm.send_buffer_size());
+  std::vector<data_t> recv_buffer(comm.recv_buffer_size());
+  comm.flush();
+  for (int64_t idx = 0; idx < (int64_t)owners.size(); ++idx) {
+    comm.add_to_send_buffer(owners[idx], values[idx], send_buffer.data());
+  }
+  comm.all_to_all(send_buffer.data(), recv_buffer.data());
+  return recv_buffer;
+}
+
+// Every process reads an equally sized range of the datasets and sends the
+// coefficients to the processes owning the configurations. Hence, the State
+// can be read with a different number of processes than it was written with.
+template <typename coeff_t, class basis_t>
+static void read_distributed(hid_t file_id, std::string const &field,
+                             block_metadata_t const &meta,
+                             basis_t const &basis,
+                             arma::Mat<coeff_t> &coeffs) try {
+  int mpi_rank, mpi_size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+  int64_t begin = meta.dim * mpi_rank / mpi_size;
+  int64_t end = meta.dim * (mpi_rank + 1) / mpi_size;
+  int64_t size = end - begin;
+  int64_t ncols = coeffs.n_cols;
+
+  hid_t dxpl = transfer_plist(true);
+  std::vector<uint64_t> ups(size);
+  std::vector<uint64_t> dns(size, 0);
+  arma::Mat<coeff_t> coeffs_file(size, ncols);
+  transfer_hyperslab(file_id, field + "/ups", {(hsize_t)begin},
+                     {(hsize_t)size}, ups.data(), false, dxpl);
+  if (meta.fermionic) {
+    transfer_hyperslab(file_id, field + "/dns", {(hsize_t)begin},
+                       {(hsize_t)size}, dns.data(), false, dxpl);
+  }
+  transfer_hyperslab(file_id, field + "/coefficients", {0, (hsize_t)begin},
+                     {(hsize_t)ncols, (hsize_t)size}, coeffs_file.memptr(),
+                     false, dxpl);
+  H5Pclose(dxpl);
+
+  std::vector<int> owners(size);
+  std::vector<int64_t> n_values_i_send(mpi_size, 0);
+  for (int64_t idx = 0; idx < size; ++idx) {
+    owners[idx] = owner(basis, ups[idx], dns[idx]);
+    ++n_values_i_send[owners[idx]];
+  }
+  mpi::Communicator comm(n_values_i_send);
+
+  std::vector<uint64_t> ups_recv = exchange(comm, owners, ups.data());
+  std::vector<uint64_t> dns_recv = exchange(comm, owners, dns.data());
+  if ((int64_t)ups_recv.size() != (int64_t)coeffs.n_rows) {
+    XDIAG_THROW(fmt::format("Number of coefficients received ({}) does not "
+                            "match the local size of the block ({})",
+                            ups_recv.size(), coeffs.n_rows));
+  }
+  std::vector<int64_t> indices(ups_recv.size());
+  for (int64_t idx = 0; idx < (int64_t)ups_recv.size(); ++idx) {
+    indices[idx] = local_index(basis, ups_recv[idx], dns_recv[idx]);
+    if (indices[idx] == invalid_index) {
+      XDIAG_THROW("Configuration stored in file is not contained in block");
+    }
+  }
+  for (int64_t col = 0; col < ncols; ++col) {
+    std::vector<coeff_t> recv = exchange(comm, owners, coeffs_file.colptr(col));
+    for (int64_t idx = 0; idx < (int64_t)recv.size(); ++idx) {
+      coeffs(indices[idx], col) = recv[idx];
+    }
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+#endif
+
+void write_state_h5(std::string filename, std::string field,
+                    State const &state, int64_t compression) try {
+  if ((compression < 0) || (compression > 9)) {
+    XDIAG_THROW(fmt::format(
+        "Compression level must be between 0 and 9, got {}", compression));
+  }
+  if (field_exists(filename, field)) {
+    XDIAG_THROW(fmt::format("Field \"{}\" already exists in file \"{}\"",
+                            field, filename));
+  }
+#ifdef XDIAG_USE_MPI
+  // All processes need to close the file before it is opened for writing
+  MPI_Barrier(MPI_COMM_WORLD);
+#endif
+  Block block = state.block();
+  block_metadata_t meta = block_metadata(block);
+  if (meta.distributed) {
+#ifdef XDIAG_USE_MPI
+    visit_distributed_basis(block, [&](auto const &basis) {
+      write_distributed(filename, field, state, basis, meta, compression);
+    });
+#endif
+  } else {
+    write_local(filename, field, state, meta, compression);
+  }
+  Log(1, "Wrote State to field \"{}\" of file {}", field, filename);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+State read_state_h5(std::string filename, std::string field,
+                    Block const &block) try {
+  block_metadata_t meta = block_metadata(block);
+  hid_t file_id = open_file(filename, false, meta.distributed);
+  try {
+    if (!hdf5::exists(file_id, field + "/coefficients")) {
+      XDIAG_THROW(fmt::format("No State stored in field \"{}\" of file \"{}\"",
+                              field, filename));
+    }
+    check_metadata(file_id, field, meta);
+    bool real = (bool)hdf5::read<int64_t>(file_id, field + "/real");
+    int64_t ncols = hdf5::read<int64_t>(file_id, field + "/ncols");
+    State state(block, real, ncols);
+    if (meta.distributed) {
+#ifdef XDIAG_USE_MPI
+      visit_distributed_basis(block, [&](auto const &basis) {
+        if (real) {
+          arma::mat coeffs = state.matrix(false);
+          read_distributed(file_id, field, meta, basis, coeffs);
+        } else {
+          arma::cx_mat coeffs = state.matrixC(false);
+          read_distributed(file_id, field, meta, basis, coeffs);
+        }
+      });
+#endif
+    } else {
+      transfer_coefficients(file_id, field, state, 0, false, H5P_DEFAULT);
+    }
+    H5Fclose(file_id);
+    return state;
+  } catch (Error const &e) {
+    H5Fclose(file_id);
+    XDIAG_RETHROW(e);
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+  return State();
+}
+
+} // namespace xdiag
+#endif
@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifdef XDIAG_USE_HDF5
+
+#include <string>
+
+#include <xdiag/blocks/blocks.hpp>
+#include <xdiag/common.hpp>
+#include <xdiag/states/state.hpp>
+
+namespace xdiag {
+
+// Writes a State together with a description of its block to the group
+// "field" of an HDF5 file. The file is created if it does not exist, while
+// the field must not exist yet. States on distributed blocks are written by
+// all processes into a single dataset, where the configuration of every
+// coefficient is stored alongside. Hence, they can be read back with any
+// number of processes. A compression level between 1 and 9 enables deflate
+// compression of the (chunked) datasets.
+XDIAG_API void write_state_h5(std::string filename, std::string field,
+                              State const &state, int64_t compression = 0);
+
+// Reads a State written by write_state_h5 on the given block. The block
+// needs to agree with the block the State has been written on. States on
+// distributed blocks are redistributed to the current processes.
+XDIAG_API State read_state_h5(std::string filename, std::string field,
+                              Block const &block);
+
+} // namespace xdiag
+#endif
@@ -9,7 +9,9 @@
 
 namespace xdiag {
 
-Spinhalf block(OpSum const &ops, Spinhalf const &block) try {
+template <typename irrep_f>
+static Spinhalf block_spinhalf(OpSum const &ops, Spinhalf const &block,
+                               irrep_f irrep_out) try {
   int64_t nsites = block.nsites();
   std::string backend = block.backend();
   auto nupi = block.nup();
@@ -20,21 +22,45 @@ Spinhalf block(OpSum const &ops, Spinhalf const &block) try {
     auto nupr = nup(ops, block);
     return (nupi == nupr) ? block : Spinhalf(nsites, nupr, backend);
   } else if (!nupi && irrepi) {
-    auto irrepr = representation(ops, block);
+    auto irrepr = irrep_out();
     return isapprox(*irrepi, irrepr) ? block
                                      : Spinhalf(nsites, irrepr, backend);
-  } else { //(nup && irrep)
+  } else if (!block.spinflip()) { //(nup && irrep)
     auto nupr = nup(ops, block);
-    auto irrepr = representation(ops, block);
+    auto irrepr = irrep_out();
     return ((*nupi == nupr) && isapprox(*irrepi, irrepr))
                ? block
                : Spinhalf(nsites, nupr, irrepr, backend);
+  } else { //(nup && irrep && spinflip)
+    auto nupr = nup(ops, block);
+    auto irrepr = irrep_out();
+    auto spinflipr = spinflip_parity(ops, block);
+    return ((*nupi == nupr) && isapprox(*irrepi, irrepr) &&
+            (*block.spinflip() == spinflipr))
+               ? block
+               : Spinhalf(nsites, nupr, irrepr, spinflipr, backend);
   }
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
 
-tJ block(OpSum const &ops, tJ const &block) try {
+Spinhalf block(OpSum const &ops, Spinhalf const &block) try {
+  return block_spinhalf(ops, block,
+                        [&]() { return representation(ops, block); });
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+Spinhalf block(OpSum const &ops, Representation const &irrep_ops,
+               Spinhalf const &block) try {
+  return block_spinhalf(ops, block,
+                        [&]() { return irrep_ops * (*block.irrep()); });
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <typename irrep_f>
+static tJ block_tj(OpSum const &ops, tJ const &block, irrep_f irrep_out) try {
   int64_t nsites = block.nsites();
   std::string backend = block.backend();
   auto nupi = block.nup();
@@ -51,22 +77,47 @@ tJ block(OpSum const &ops, tJ const &block) try {
   }
   // // Not yet implemented
   // else if (!nup && irrep) {
-  //   auto irrepr = representation(ops, block);
+  //   auto irrepr = irrep_out();
   //   return isapprox(irrep, irrepr) ? block : tJ(nsites, *irrep, backend);
   // }
-  else { //(nup && irrep)
+  else if (!block.spinflip()) { //(nup && irrep)
     auto nupr = nup(ops, block);
     auto ndnr = ndn(ops, block);
-    auto irrepr = representation(ops, block);
+    auto irrepr = irrep_out();
     return ((*nupi == nupr) && (*ndni == ndnr) && isapprox(*irrepi, irrepr))
                ? block
                : tJ(nsites, nupr, ndnr, irrepr, backend);
+  } else { //(nup && irrep && spinflip)
+    auto nupr = nup(ops, block);
+    auto ndnr = ndn(ops, block);
+    auto irrepr = irrep_out();
+    auto spinflipr = spinflip_parity(ops, block);
+    return ((*nupi == nupr) && (*ndni == ndnr) && isapprox(*irrepi, irrepr) &&
+            (*block.spinflip() == spinflipr))
+               ? block
+               : tJ(nsites, nupr, ndnr, irrepr, spinflipr, backend);
   }
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
 
-Electron block(OpSum const &ops, Electron const &block) try {
+tJ block(OpSum const &ops, tJ const &block) try {
+  return block_tj(ops, block, [&]() { return representation(ops, block); });
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+tJ block(OpSum const &ops, Representation const &irrep_ops,
+         tJ const &block) try {
+  return block_tj(ops, block,
+                  [&]() { return irrep_ops * (*block.irrep()); });
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <typename irrep_f>
+static Electron block_electron(OpSum const &ops, Electron const &block,
+                               irrep_f irrep_out) try {
   int64_t nsites = block.nsites();
   std::string backend = block.backend();
   auto nupi = block.nup();
@@ -81,32 +132,70 @@ Electron block(OpSum const &ops, Electron const &block) try {
                ? block
                : Electron(nsites, nupr, ndnr, backend);
   } else if (!nupi && irrepi) {
-    auto irrepr = representation(ops, block);
+    auto irrepr = irrep_out();
     return isapprox(*irrepi, irrepr) ? block
                                      : Electron(nsites, irrepr, backend);
-  } else { //(nup && irrep)
+  } else if (!block.projected()) { //(nup && irrep)
     auto nupr = nup(ops, block);
     auto ndnr = ndn(ops, block);
-    auto irrepr = representation(ops, block);
+    auto irrepr = irrep_out();
     return ((*nupi == nupr) && (*ndni == ndnr) && isapprox(*irrepi, irrepr))
                ? block
                : Electron(nsites, nupr, ndnr, irrepr, backend);
+  } else { //(nup && irrep && (spinflip || particlehole))
+    auto nupr = nup(ops, block);
+    auto ndnr = ndn(ops, block);
+    auto irrepr = irrep_out();
+    int64_t spinflipr = block.spinflip() ? spinflip_parity(ops, block) : 0;
+    int64_t particleholer =
+        block.particlehole() ? particlehole_parity(ops, block) : 0;
+    return ((*nupi == nupr) && (*ndni == ndnr) && isapprox(*irrepi, irrepr) &&
+            (block.spinflip().value_or(0) == spinflipr) &&
+            (block.particlehole().value_or(0) == particleholer))
+               ? block
+               : Electron(nsites, nupr, ndnr, irrepr, spinflipr, particleholer,
+                          block.bipartition(), backend);
   }
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
 
+Electron block(OpSum const &ops, Electron const &block) try {
+  return block_electron(ops, block,
+                        [&]() { return representation(ops, block); });
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+Electron block(OpSum const &ops, Representation const &irrep_ops,
+               Electron const &block) try {
+  return block_electron(ops, block,
+                        [&]() { return irrep_ops * (*block.irrep()); });
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
 #ifdef XDIAG_USE_MPI
 SpinhalfDistributed block(OpSum const &ops,
                           SpinhalfDistributed const &block) try {
   int64_t nsites = block.nsites();
   std::string backend = block.backend();
+  std::string partition = block.partition();
   auto nupi = block.nup();
+  auto irrepi = block.irrep();
   if (!nupi) {
     return block;
+  } else if (!irrepi) {
+    auto nupr = nup(ops, block);
+    return (*nupi == nupr)
+               ? block
+               : SpinhalfDistributed(nsites, nupr, backend, partition);
   } else {
     auto nupr = nup(ops, block);
-    return (*nupi == nupr) ? block : SpinhalfDistributed(nsites, nupr, backend);
+    auto irrepr = representation(ops, block);
+    return ((*nupi == nupr) && isapprox(*irrepi, irrepr))
+               ? block
+               : SpinhalfDistributed(nsites, nupr, irrepr, backend);
   }
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
@@ -114,6 +203,7 @@ SpinhalfDistributed block(OpSum const &ops,
 tJDistributed block(OpSum const &ops, tJDistributed const &block) try {
   int64_t nsites = block.nsites();
   std::string backend = block.backend();
+  std::string partition = block.partition();
   auto nupi = block.nup();
   auto ndni = block.ndn();
   if (!nupi) {
@@ -123,7 +213,7 @@ tJDistributed block(OpSum const &ops, tJDistributed const &block) try {
     auto ndnr = ndn(ops, block);
     return ((*nupi == nupr) && (*ndni == ndnr))
                ? block
-               : tJDistributed(nsites, nupr, ndnr, backend);
+               : tJDistributed(nsites, nupr, ndnr, backend, partition);
   }
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
@@ -133,6 +223,7 @@ ElectronDistributed block(OpSum const &ops,
                           ElectronDistributed const &block) try {
   int64_t nsites = block.nsites();
   std::string backend = block.backend();
+  std::string partition = block.partition();
   auto nupi = block.nup();
   auto ndni = block.ndn();
   if (!nupi) {
@@ -142,7 +233,8 @@ ElectronDistributed block(OpSum const &ops,
     auto ndnr = ndn(ops, block);
     return ((*nupi == nupr) && (*ndni == ndnr))
                ? block
-               : ElectronDistributed(nsites, nupr, ndnr, backend);
+               : ElectronDistributed(nsites, nupr, ndnr, backend,
+                                     partition);
   }
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
@@ -155,6 +247,20 @@ Block block(OpSum const &ops, Block const &blocki) try {
   XDIAG_RETHROW(e);
 }
 
+Block block(OpSum const &ops, Representation const &irrep_ops,
+            Block const &blocki) try {
+  return std::visit(
+      overload{
+          [&](Spinhalf const &b) { return Block(block(ops, irrep_ops, b)); },
+          [&](tJ const &b) { return Block(block(ops, irrep_ops, b)); },
+          [&](Electron const &b) { return Block(block(ops, irrep_ops, b)); },
+          [&](auto const &b) { return Block(block(ops, b)); },
+      },
+      blocki);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
 bool blocks_match(OpSum const &ops, Block const &block1,
                   Block const &block2) try {
   return std::visit(
@@ -189,7 +295,10 @@ bool blocks_match(OpSum const &ops, Spinhalf const &b1,
   bool match_nup = b1.nup() ? nup(ops, b1) == *b2.nup() : !b2.nup();
   bool match_irrep =
       b1.irrep() ? isapprox(representation(ops, b1), *b2.irrep()) : !b2.irrep();
-  return match_nup && match_irrep;
+  bool match_spinflip = b1.spinflip()
+                            ? spinflip_parity(ops, b1) == *b2.spinflip()
+                            : !b2.spinflip();
+  return match_nup && match_irrep && match_spinflip;
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
@@ -199,7 +308,10 @@ bool blocks_match(OpSum const &ops, tJ const &b1, tJ const &b2) try {
   bool match_ndn = b1.ndn() ? ndn(ops, b1) == *b2.ndn() : !b2.ndn();
   bool match_irrep =
       b1.irrep() ? isapprox(representation(ops, b1), *b2.irrep()) : !b2.irrep();
-  return match_nup && match_ndn && match_irrep;
+  bool match_spinflip = b1.spinflip()
+                            ? spinflip_parity(ops, b1) == *b2.spinflip()
+                            : !b2.spinflip();
+  return match_nup && match_ndn && match_irrep && match_spinflip;
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
@@ -210,7 +322,16 @@ bool blocks_match(OpSum const &ops, Electron const &b1,
   bool match_ndn = b1.ndn() ? ndn(ops, b1) == *b2.ndn() : !b2.ndn();
   bool match_irrep =
       b1.irrep() ? isapprox(representation(ops, b1), *b2.irrep()) : !b2.irrep();
-  return match_nup && match_ndn && match_irrep;
+  bool match_spinflip = b1.spinflip()
+                            ? spinflip_parity(ops, b1) == *b2.spinflip()
+                            : !b2.spinflip();
+  bool match_particlehole =
+      b1.particlehole()
+          ? b2.particlehole() && (b1.bipartition() == b2.bipartition()) &&
+                (particlehole_parity(ops, b1) == *b2.particlehole())
+          : !b2.particlehole();
+  return match_nup && match_ndn && match_irrep && match_spinflip &&
+         match_particlehole;
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
@@ -219,7 +340,9 @@ bool blocks_match(OpSum const &ops, Electron const &b1,
 bool blocks_match(OpSum const &ops, SpinhalfDistributed const &b1,
                   SpinhalfDistributed const &b2) try {
   bool match_nup = b1.nup() ? nup(ops, b1) == *b2.nup() : !b2.nup();
-  return match_nup;
+  bool match_irrep =
+      b1.irrep() ? isapprox(representation(ops, b1), *b2.irrep()) : !b2.irrep();
+  return match_nup && match_irrep;
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
@@ -21,6 +21,17 @@ XDIAG_API ElectronDistributed block(OpSum const &ops,
                                     ElectronDistributed const &block);
 #endif
 
+// Block of ops times block, if ops is known to transform according to the
+// representation irrep_ops, e.g. after symmetrization. This avoids detecting
+// the representation of ops by permuting all its terms.
+Block block(OpSum const &ops, Representation const &irrep_ops,
+            Block const &block);
+Spinhalf block(OpSum const &ops, Representation const &irrep_ops,
+               Spinhalf const &block);
+tJ block(OpSum const &ops, Representation const &irrep_ops, tJ const &block);
+Electron block(OpSum const &ops, Representation const &irrep_ops,
+               Electron const &block);
+
 bool blocks_match(OpSum const &ops, Block const &b1, Block const &b2);
 bool blocks_match(OpSum const &ops, Spinhalf const &b1, Spinhalf const &b2);
 bool blocks_match(OpSum const &ops, tJ const &b1, tJ const &b2);
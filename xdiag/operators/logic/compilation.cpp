@@ -3,8 +3,13 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "compilation.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
 #include <xdiag/operators/logic/valid.hpp>
 #include <xdiag/operators/logic/order.hpp>
+#include <xdiag/random/hash.hpp>
 #include <xdiag/utils/scalar.hpp>
 
 #include <xdiag/blocks/electron.hpp>
@@ -31,6 +36,33 @@ OpSum clean_zeros(OpSum const &ops) try {
   XDIAG_RETHROW(e);
 }
 
+OpSum merge_terms(OpSum const &ops) try {
+  std::vector<std::pair<Scalar, Op>> terms;
+  std::unordered_map<uint64_t, std::vector<int64_t>> terms_of_hash;
+  for (auto const &[cpl, op] : ops.plain()) {
+    auto &candidates = terms_of_hash[random::hash(op)];
+    auto it =
+        std::find_if(candidates.begin(), candidates.end(),
+                     [&](int64_t idx) { return terms[idx].second == op; });
+    if (it == candidates.end()) {
+      candidates.push_back(terms.size());
+      terms.push_back({cpl.scalar(), op});
+    } else {
+      terms[*it].first += cpl.scalar();
+    }
+  }
+
+  OpSum ops_merged;
+  for (auto const &[cpl, op] : terms) {
+    if (cpl != zero(cpl)) {
+      ops_merged += cpl * op;
+    }
+  }
+  return ops_merged;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
 OpSum compile_spinhalf(OpSum const &ops) try {
   OpSum ops_clean = clean_zeros(order(ops));
   OpSum ops_compiled;
@@ -64,7 +96,7 @@ OpSum compile_spinhalf(OpSum const &ops) try {
     }
   }
 
-  return ops_double;
+  return merge_terms(ops_double);
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
@@ -133,7 +165,7 @@ OpSum compile_tj(OpSum const &ops) try {
       ops_final += cpl * op;
     }
   }
-  return ops_final;
+  return merge_terms(ops_final);
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
@@ -198,40 +230,40 @@ OpSum compile_electron(OpSum const &ops) try {
       ops_final += cpl * op;
     }
   }
-  return ops_final;
+  return merge_terms(ops_final);
 } catch (Error const &error) {
   XDIAG_RETHROW(error);
 }
 
 template <> OpSum compile<Spinhalf>(OpSum const &ops) try {
-  return compile_spinhalf(ops);
+  return ops.cached("compile_spinhalf", compile_spinhalf);
 } catch (Error const &error) {
   XDIAG_RETHROW(error);
 }
 template <> OpSum compile<tJ>(OpSum const &ops) try {
-  return compile_tj(ops);
+  return ops.cached("compile_tj", compile_tj);
 } catch (Error const &error) {
   XDIAG_RETHROW(error);
 }
 template <> OpSum compile<Electron>(OpSum const &ops) try {
-  return compile_electron(ops);
+  return ops.cached("compile_electron", compile_electron);
 } catch (Error const &error) {
   XDIAG_RETHROW(error);
 }
 
 #ifdef XDIAG_USE_MPI
 template <> OpSum compile<SpinhalfDistributed>(OpSum const &ops) try {
-  return compile_spinhalf(ops);
+  return ops.cached("compile_spinhalf", compile_spinhalf);
 } catch (Error const &error) {
   XDIAG_RETHROW(error);
 }
 template <> OpSum compile<tJDistributed>(OpSum const &ops) try {
-  return compile_tj(ops);
+  return ops.cached("compile_tj", compile_tj);
 } catch (Error const &error) {
   XDIAG_RETHROW(error);
 }
 template <> OpSum compile<ElectronDistributed>(OpSum const &ops) try {
-  return compile_electron(ops);
+  return ops.cached("compile_electron", compile_electron);
 } catch (Error const &error) {
   XDIAG_RETHROW(error);
 }
@@ -10,10 +10,15 @@ namespace xdiag::operators {
 
 OpSum clean_zeros(OpSum const &ops);
 
+// Sums the couplings of identical terms, which are found by hashing their
+// type, sites and matrix, and removes terms whose couplings cancel
+OpSum merge_terms(OpSum const &ops);
+
 OpSum compile_spinhalf(OpSum const &ops);
 OpSum compile_tj(OpSum const &ops);
 OpSum compile_electron(OpSum const &ops);
 
+// The compiled OpSum is cached in ops until it is modified
 template <typename block_t> OpSum compile(OpSum const &ops);
 
 } // namespace xdiag::operators
@@ -42,6 +42,7 @@ Op hc(Op const &op) try {
 
 OpSum hc(OpSum const &ops) try {
   OpSum ops_hc;
+  ops_hc.reserve(ops.size());
   for (auto [cpl, op] : ops.plain()) {
     std::string type = op.type();
     if ((type == "Exchange") || (type == "Hop") || (type == "Hopup") ||
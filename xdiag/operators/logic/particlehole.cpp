@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "particlehole.hpp"
+
+#include <xdiag/operators/logic/valid.hpp>
+
+namespace xdiag {
+
+// 1 - n_{i,up} - n_{i,dn}, the transformed density up to the constant 1
+static OpSum holes(Scalar const &cpl, int64_t site) {
+  return cpl * Op("Id") - cpl * Op("Nup", site) - cpl * Op("Ndn", site);
+}
+
+OpSum particlehole(OpSum const &ops,
+                   std::vector<int64_t> const &bipartition) try {
+  int64_t nsites = bipartition.size();
+
+  OpSum ops_ph;
+  for (auto const &[cpl, op] : ops.plain()) {
+    check_valid(op);
+    if (op.hassites()) {
+      for (int64_t site : op.sites()) {
+        if ((site < 0) || (site >= nsites)) {
+          XDIAG_THROW(fmt::format("Site {} of Op is not contained in the "
+                                  "bipartition of {} sites",
+                                  site, nsites));
+        }
+      }
+    }
+    std::string type = op.type();
+    Scalar c = cpl.scalar();
+    if ((type == "Id") || (type == "SdotS") || (type == "SzSz") ||
+        (type == "ScalarChirality")) {
+      ops_ph += c * op;
+    } else if ((type == "Hop") || (type == "Hopup") || (type == "Hopdn")) {
+      // c^dag_i c_j -> -e_i e_j c^dag_j c_i
+      Scalar cc = conj(c);
+      bool same = bipartition[op[0]] == bipartition[op[1]];
+      ops_ph += (same ? -cc : cc) * op;
+    } else if (type == "Exchange") {
+      ops_ph += conj(c) * op;
+    } else if (type == "Sz") {
+      ops_ph += -c * op;
+    } else if (type == "S+") {
+      ops_ph += -c * Op("S-", op.sites());
+    } else if (type == "S-") {
+      ops_ph += -c * Op("S+", op.sites());
+    } else if ((type == "Nup") || (type == "Ndn")) {
+      ops_ph += c * Op("Id") - c * op;
+    } else if (type == "Ntot") {
+      ops_ph += c * Op("Id") + holes(c, op[0]);
+    } else if (type == "Nupdn") {
+      ops_ph += holes(c, op[0]) + c * op;
+    } else if (type == "HubbardU") {
+      ops_ph += c * op;
+      for (int64_t site = 0; site < nsites; ++site) {
+        ops_ph += holes(c, site);
+      }
+    } else if (type == "NtotNtot") {
+      // (2 - n_i)(2 - n_j) = 4 - 2 n_i - 2 n_j + n_i n_j
+      Scalar c2 = Scalar(2.0) * c;
+      ops_ph += holes(c2, op[0]) + holes(c2, op[1]) + c * op;
+    } else {
+      XDIAG_THROW(fmt::format(
+          "Cannot apply particle-hole transformation to Op of type \"{}\"",
+          type));
+    }
+  }
+  return ops_ph;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+} // namespace xdiag
@@ -0,0 +1,19 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <vector>
+
+#include <xdiag/operators/opsum.hpp>
+
+namespace xdiag {
+
+// Transforms the electron operators by the particle-hole transformation
+// c_{i,s} -> e_i c^dag_{i,s}, where e_i = +1 (-1) on the sites with label 0
+// (1) of the bipartition. Densities n_{i,s} are mapped to 1 - n_{i,s}, and
+// Ntot is expressed in terms of Nup and Ndn.
+OpSum particlehole(OpSum const &ops, std::vector<int64_t> const &bipartition);
+
+} // namespace xdiag
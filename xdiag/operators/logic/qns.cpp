@@ -10,6 +10,8 @@
 #include <xdiag/operators/logic/isapprox.hpp>
 #include <xdiag/operators/logic/permute.hpp>
 #include <xdiag/operators/logic/order.hpp>
+#include <xdiag/operators/logic/particlehole.hpp>
+#include <xdiag/operators/logic/spinflip.hpp>
 #include <xdiag/operators/logic/valid.hpp>
 #include <xdiag/utils/scalar.hpp>
 
@@ -36,15 +38,6 @@ Representation representation(OpSum const &ops, block_t const &block) try {
 }
 
 #ifdef XDIAG_USE_MPI
-template <>
-Representation representation(OpSum const &ops,
-                              SpinhalfDistributed const &block) try {
-  XDIAG_THROW("Block of type SpinhalfDistributed does not have irreducible "
-              "representation defined");
-} catch (Error const &e) {
-  XDIAG_RETHROW(e);
-}
-
 template <>
 Representation representation(OpSum const &ops,
                               tJDistributed const &block) try {
@@ -67,6 +60,10 @@ Representation representation(OpSum const &ops,
 template Representation representation(OpSum const &, Spinhalf const &);
 template Representation representation(OpSum const &, tJ const &);
 template Representation representation(OpSum const &, Electron const &);
+#ifdef XDIAG_USE_MPI
+template Representation representation(OpSum const &,
+                                       SpinhalfDistributed const &);
+#endif
 
 Representation representation(OpSum const &ops, Block const &block) try {
   return std::visit([&](auto const &b) { return representation(ops, b); },
@@ -81,6 +78,48 @@ Representation representation(OpSum const &ops, State const &v) try {
   XDIAG_RETHROW(e);
 }
 
+template <typename block_t>
+int64_t spinflip_parity(OpSum const &ops, block_t const &block) try {
+  auto parity_block = block.spinflip();
+  if (!parity_block) {
+    XDIAG_THROW("Block has no spin flip symmetry defined. Hence, the spin "
+                "flip parity of an OpSum times the block cannot be determined");
+  } else {
+    auto parity_ops = spinflip_parity(ops);
+    if (parity_ops) {
+      return (*parity_ops) * (*parity_block);
+    } else {
+      XDIAG_THROW("OpSum is neither symmetric nor antisymmetric under the "
+                  "spin flip of the block");
+    }
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template int64_t spinflip_parity(OpSum const &ops, Spinhalf const &block);
+template int64_t spinflip_parity(OpSum const &ops, tJ const &block);
+template int64_t spinflip_parity(OpSum const &ops, Electron const &block);
+
+int64_t particlehole_parity(OpSum const &ops, Electron const &block) try {
+  auto parity_block = block.particlehole();
+  if (!parity_block) {
+    XDIAG_THROW("Block has no particle-hole symmetry defined. Hence, the "
+                "particle-hole parity of an OpSum times the block cannot be "
+                "determined");
+  } else {
+    auto parity_ops = particlehole_parity(ops, block.bipartition());
+    if (parity_ops) {
+      return (*parity_ops) * (*parity_block);
+    } else {
+      XDIAG_THROW("OpSum is neither symmetric nor antisymmetric under the "
+                  "particle-hole transformation of the block");
+    }
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
 template <typename block_t>
 int64_t nup(OpSum const &ops, block_t const &block) try {
   auto nup_block = block.nup();
@@ -300,4 +339,85 @@ representation(OpSum const &ops, PermutationGroup const &group) try {
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
+
+std::optional<int64_t> spinflip_parity(OpSum const &ops) try {
+  OpSum opso = order(ops);
+  check_valid(opso);
+  OpSum opsf = order(spinflip(opso));
+  std::optional<Scalar> factor = isapprox_multiple(opsf, opso);
+  if (factor && isapprox(*factor, Scalar(1.0))) {
+    return 1;
+  } else if (factor && isapprox(*factor, Scalar(-1.0))) {
+    return -1;
+  } else {
+    return std::nullopt;
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+// Ntot is written as Nup + Ndn, such that an OpSum can be compared to its
+// particle-hole transformation
+static OpSum expand_ntot(OpSum const &ops) {
+  OpSum ops_expanded;
+  for (auto const &[cpl, op] : ops.plain()) {
+    if (op.type() == "Ntot") {
+      ops_expanded += cpl.scalar() * Op("Nup", op[0]);
+      ops_expanded += cpl.scalar() * Op("Ndn", op[0]);
+    } else {
+      ops_expanded += cpl.scalar() * op;
+    }
+  }
+  return ops_expanded;
+}
+
+// Whether an ordered OpSum vanishes at half filling, i.e. it is of the form
+// a (sum_i n_{i,up} + n_{i,dn} - nsites)
+static bool vanishes_at_half_filling(OpSum const &ops, int64_t nsites) {
+  Scalar zero(0.0);
+  Scalar id(0.0);
+  std::optional<Scalar> density;
+  int64_t ndensities = 0;
+  for (auto const &[cpl, op] : ops.plain()) {
+    Scalar c = cpl.scalar();
+    std::string type = op.type();
+    if (type == "Id") {
+      id += c;
+    } else if ((type == "Nup") || (type == "Ndn")) {
+      if (!density) {
+        density = c;
+      } else if (!isapprox(c, *density)) {
+        return false;
+      }
+      ++ndensities;
+    } else if (!isapprox(c, zero)) {
+      return false;
+    }
+  }
+  if (!density || isapprox(*density, zero)) {
+    return isapprox(id, zero);
+  } else {
+    return (ndensities == 2 * nsites) &&
+           isapprox(id, -Scalar((double)nsites) * (*density));
+  }
+}
+
+std::optional<int64_t>
+particlehole_parity(OpSum const &ops,
+                    std::vector<int64_t> const &bipartition) try {
+  OpSum opso = expand_ntot(order(ops));
+  check_valid(opso);
+  OpSum opsp = particlehole(opso, bipartition);
+  int64_t nsites = bipartition.size();
+  if (vanishes_at_half_filling(order(opsp - opso), nsites)) {
+    return 1;
+  } else if (vanishes_at_half_filling(order(opsp + opso), nsites)) {
+    return -1;
+  } else {
+    return std::nullopt;
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
 } // namespace xdiag
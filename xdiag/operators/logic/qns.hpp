@@ -5,6 +5,7 @@
 #pragma once
 
 #include <optional>
+#include <vector>
 
 #include <xdiag/blocks/blocks.hpp>
 #include <xdiag/operators/opsum.hpp>
@@ -32,11 +33,21 @@ XDIAG_API int64_t ndn(OpSum const &ops, block_t const &block);
 XDIAG_API int64_t ndn(OpSum const &ops, Block const &block);
 XDIAG_API int64_t ndn(OpSum const &ops, State const &v);
 
+// Spin flip parity of an OpSum times a block with spin flip symmetry
+template <typename block_t>
+int64_t spinflip_parity(OpSum const &ops, block_t const &block);
+
+// Particle-hole parity of an OpSum times a block with particle-hole symmetry
+int64_t particlehole_parity(OpSum const &ops, Electron const &block);
+
 std::optional<int64_t> nup(Op const &op);
 std::optional<int64_t> nup(OpSum const &ops);
 std::optional<int64_t> ndn(Op const &op);
 std::optional<int64_t> ndn(OpSum const &ops);
 std::optional<Representation> representation(OpSum const &ops,
                                              PermutationGroup const &group);
+std::optional<int64_t> spinflip_parity(OpSum const &ops);
+std::optional<int64_t>
+particlehole_parity(OpSum const &ops, std::vector<int64_t> const &bipartition);
 
 } // namespace xdiag
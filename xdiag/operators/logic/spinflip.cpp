@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "spinflip.hpp"
+
+#include <map>
+
+#include <xdiag/operators/logic/valid.hpp>
+
+namespace xdiag {
+
+// Matrix in the basis of the flipped local configurations
+template <typename mat_t> static mat_t spinflip(mat_t const &mat) {
+  arma::uword dim = mat.n_rows;
+  arma::uvec flipped(dim);
+  for (arma::uword i = 0; i < dim; ++i) {
+    flipped(i) = i ^ (dim - 1);
+  }
+  return mat.submat(flipped, flipped);
+}
+
+OpSum spinflip(OpSum const &ops) try {
+  // fermionic operators exchanging the spin species
+  static const std::map<std::string, std::string> swapped = {
+      {"Hopup", "Hopdn"},   {"Hopdn", "Hopup"}, {"Cdagup", "Cdagdn"},
+      {"Cdagdn", "Cdagup"}, {"Cup", "Cdn"},     {"Cdn", "Cup"},
+      {"Nup", "Ndn"},       {"Ndn", "Nup"}};
+
+  OpSum ops_flipped;
+  for (auto const &[cpl, op] : ops.plain()) {
+    check_valid(op);
+    std::string type = op.type();
+    if ((type == "Id") || (type == "SdotS") || (type == "SzSz") ||
+        (type == "ScalarChirality") || (type == "Hop") ||
+        (type == "HubbardU") || (type == "Ntot") || (type == "Nupdn") ||
+        (type == "NtotNtot") || (type == "NupdnNupdn") ||
+        (type == "tJSzSz") || (type == "tJSdotS")) {
+      ops_flipped += cpl * op;
+    } else if (type == "Exchange") {
+      ops_flipped += conj(cpl.scalar()) * op;
+    } else if (type == "Sz") {
+      ops_flipped += -cpl.scalar() * op;
+    } else if (type == "S+") {
+      ops_flipped += cpl * Op("S-", op.sites());
+    } else if (type == "S-") {
+      ops_flipped += cpl * Op("S+", op.sites());
+    } else if (swapped.count(type)) {
+      ops_flipped += cpl * Op(swapped.at(type), op.sites());
+    } else if (type == "Matrix") {
+      Matrix const &mat = op.matrix();
+      if (mat.isreal()) {
+        arma::mat m = spinflip(mat.as<arma::mat>());
+        ops_flipped += cpl * Op(type, op.sites(), m);
+      } else {
+        arma::cx_mat m = spinflip(mat.as<arma::cx_mat>());
+        ops_flipped += cpl * Op(type, op.sites(), m);
+      }
+    } else {
+      XDIAG_THROW(fmt::format(
+          "Cannot apply spin flip to Op of type \"{}\"", type));
+    }
+  }
+  return ops_flipped;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+} // namespace xdiag
@@ -0,0 +1,16 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <xdiag/operators/opsum.hpp>
+
+namespace xdiag {
+
+// Transforms the spin operators by the global spin flip, i.e. the rotation
+// by pi around the x-axis, mapping Sz -> -Sz and S+ <-> S-. Fermionic
+// operators are transformed by exchanging the up and dn spin species.
+OpSum spinflip(OpSum const &ops);
+
+} // namespace xdiag
@@ -22,6 +22,11 @@ bool is_cplx_type(std::string type) {
          cplx_types.end();
 }
 
+bool is_diagonal_type(std::string type) {
+  return std::find(diagonal_types.begin(), diagonal_types.end(), type) !=
+         diagonal_types.end();
+}
+
 int64_t nsites_of_type(std::string type) try {
   auto it = _nsites_of_type.find(type);
   if (it != _nsites_of_type.end()) {
@@ -24,6 +24,11 @@ inline const std::vector<std::string> real_types = {
     "Nupdn",  "NtotNtot", "NupdnNupdn", "tJSzSz", "tJSdotS"};
 inline const std::vector<std::string> cplx_types = {"ScalarChirality"};
 
+// Types which map every configuration onto itself
+inline const std::vector<std::string> diagonal_types = {
+    "Id",  "SzSz",  "Sz",       "HubbardU",   "Ntot",  "Nup",
+    "Ndn", "Nupdn", "NtotNtot", "NupdnNupdn", "tJSzSz"};
+
 inline const std::map<std::string, int64_t> _nsites_of_type = {
     {"Id", undefined},
     {"SdotS", 2},
@@ -54,6 +59,7 @@ inline const std::map<std::string, int64_t> _nsites_of_type = {
 bool is_known_type(std::string type);
 bool is_real_type(std::string type);
 bool is_cplx_type(std::string type);
+bool is_diagonal_type(std::string type);
 int64_t nsites_of_type(std::string type);
 
 std::string known_types_string();
@@ -17,6 +17,7 @@ OpSum::OpSum(complex cpl, Op const &op) : OpSum(Coupling(cpl), op) {}
 OpSum &OpSum::operator=(Op const &op) {
   terms_ = std::vector<std::pair<Coupling, Op>>{{Coupling(1.0), op}};
   constants_.clear();
+  clear_cache();
   return *this;
 }
 
@@ -47,6 +48,7 @@ OpSum &OpSum::operator*=(Scalar const &cpl) try {
       }
     }
   }
+  clear_cache();
   return *this;
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
@@ -71,49 +73,25 @@ OpSum &OpSum::operator/=(Scalar const &cpl) try {
 }
 
 OpSum &OpSum::operator+=(OpSum const &ops) try {
-  terms_.insert(terms_.end(), ops.terms_.begin(), ops.terms_.end());
-
   // Check common constants have the same numerical value
-  std::map<std::string, Scalar> new_constants;
-  std::map<std::string, Scalar> const &cs1 = constants_;
-  std::map<std::string, Scalar> const &cs2 = ops.constants_;
-
-  // Add keys from cs1 and common keys
-  for (auto &entry : cs1) {
-    std::string key = entry.first;
-    Scalar value1 = entry.second;
-
-    // key not a member of cs2
-    if (cs2.find(key) == cs2.end()) {
-      new_constants[key] = value1;
-    } else { // key is shared
-      Scalar value2 = cs2.at(key);
-      if (value1 != value2) {
-        XDIAG_THROW("Conflicting values for coupling constant \"{}\"");
-      } else {
-        new_constants[key] = value1;
-      }
-    }
-  }
-
-  // Add keys from cs2 exclusively
-  for (auto &entry : cs2) {
-    std::string key = entry.first;
-    Scalar value = entry.second;
-
-    // key not a member of cs2
-    if (cs1.find(key) == cs1.end()) {
-      new_constants[key] = value;
+  for (auto const &[key, value] : ops.constants_) {
+    auto [it, inserted] = constants_.insert({key, value});
+    if (!inserted && (it->second != value)) {
+      XDIAG_THROW(fmt::format(
+          "Conflicting values for coupling constant \"{}\"", key));
     }
   }
-  constants_ = new_constants;
+  terms_.insert(terms_.end(), ops.terms_.begin(), ops.terms_.end());
+  clear_cache();
   return *this;
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
 
 OpSum &OpSum::operator+=(Op const &op) try {
-  return operator+=(OpSum(op));
+  terms_.emplace_back(Coupling(1.0), op);
+  clear_cache();
+  return *this;
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
@@ -158,6 +136,7 @@ OpSum OpSum::operator-(Op const &op) const try {
 }
 
 int64_t OpSum::size() const { return terms_.size(); }
+void OpSum::reserve(int64_t size) { terms_.reserve(size); }
 
 std::vector<std::pair<Coupling, Op>> const &OpSum::terms() const {
   return terms_;
@@ -176,27 +155,64 @@ Scalar const &OpSum::operator[](std::string name) const {
 }
 
 OpSum OpSum::plain() const try {
-  OpSum ops;
-  for (auto const &[cpl, op] : terms_) {
-    if (cpl.isscalar()) {
-      ops += cpl * op;
-    } else {
-      auto it = constants_.find(cpl.string());
-      if (it != constants_.end()) {
-        ops += Coupling(it->second) * op;
+  return cached("plain", [](OpSum const &ops) {
+    OpSum ops_plain;
+    ops_plain.terms_.reserve(ops.terms_.size());
+    for (auto const &[cpl, op] : ops.terms_) {
+      if (cpl.isscalar()) {
+        ops_plain.terms_.emplace_back(cpl, op);
       } else {
-        XDIAG_THROW(fmt::format("Cannot make OpSum plain, i.e. replace string "
-                                "couplings with scalars. Coupling given by "
-                                "string \"{}\" has not been defined",
-                                cpl.string()));
+        auto it = ops.constants_.find(cpl.string());
+        if (it != ops.constants_.end()) {
+          ops_plain.terms_.emplace_back(Coupling(it->second), op);
+        } else {
+          XDIAG_THROW(fmt::format(
+              "Cannot make OpSum plain, i.e. replace string couplings with "
+              "scalars. Coupling given by string \"{}\" has not been "
+              "defined",
+              cpl.string()));
+        }
       }
     }
+    return ops_plain;
+  });
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+struct OpSum::Cache {
+  std::map<std::string, Scalar> constants;
+  std::map<std::string, std::shared_ptr<OpSum const>> entries;
+};
+
+OpSum OpSum::cached(std::string const &key,
+                    OpSum (*f)(OpSum const &)) const try {
+  // The cache is replaced as a whole, such that concurrent readers always
+  // see a consistent state
+  std::shared_ptr<Cache const> cache = std::atomic_load(&cache_);
+  if (cache && (cache->constants == constants_)) {
+    auto it = cache->entries.find(key);
+    if (it != cache->entries.end()) {
+      return *it->second;
+    }
+  }
+  auto entry = std::make_shared<OpSum const>(f(*this));
+  auto new_cache = std::make_shared<Cache>();
+  if (cache && (cache->constants == constants_)) {
+    new_cache->entries = cache->entries;
   }
-  return ops;
+  new_cache->constants = constants_;
+  new_cache->entries[key] = entry;
+  std::atomic_store(&cache_, std::shared_ptr<Cache const>(new_cache));
+  return *entry;
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
 
+void OpSum::clear_cache() {
+  std::atomic_store(&cache_, std::shared_ptr<Cache const>());
+}
+
 bool OpSum::operator==(OpSum const &rhs) const {
   return (terms_ == rhs.terms_) && (constants_ == rhs.constants_);
 }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 #include <xdiag/operators/coupling.hpp>
@@ -56,12 +57,20 @@ public:
   std::vector<std::string> constants() const;
   XDIAG_API OpSum plain() const;
   XDIAG_API int64_t size() const;
+  XDIAG_API void reserve(int64_t size);
   iterator_t begin() const;
   iterator_t end() const;
 
+  // Returns f(*this), which is computed once and cached under the given key
+  // until the terms or the values of the constants change
+  OpSum cached(std::string const &key, OpSum (*f)(OpSum const &)) const;
+
 private:
+  struct Cache;
   std::vector<std::pair<Coupling, Op>> terms_;
   std::map<std::string, Scalar> constants_;
+  mutable std::shared_ptr<Cache const> cache_;
+  void clear_cache();
 };
 
 XDIAG_API std::vector<std::string> constants(OpSum const &ops);
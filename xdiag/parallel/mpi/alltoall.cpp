@@ -136,4 +136,74 @@ int Alltoallv<complex>(complex *sendbuf, int *sendcounts, int *sdispls,
                        rdispls_2.data(), MPI_DOUBLE, comm);
 }
 
+///////////////////////////////////////////
+// Neighbor_alltoallv
+template <class coeff_t>
+int Neighbor_alltoallv(coeff_t *sendbuf, int *sendcounts, int *sdispls,
+                       coeff_t *recvbuf, int *recvcounts, int *rdispls,
+                       MPI_Comm comm) {
+  MPI_Datatype type = mpi::datatype<coeff_t>();
+  return MPI_Neighbor_alltoallv(sendbuf, sendcounts, sdispls, type, recvbuf,
+                                recvcounts, rdispls, type, comm);
+}
+
+template int Neighbor_alltoallv<char>(char *, int *, int *, char *,
+                                      int *, int *, MPI_Comm);
+template int Neighbor_alltoallv<short>(short *, int *, int *, short *,
+                                       int *, int *, MPI_Comm);
+template int Neighbor_alltoallv<int>(int *, int *, int *, int *,
+                                     int *, int *, MPI_Comm);
+template int Neighbor_alltoallv<long>(long *, int *, int *, long *,
+                                      int *, int *, MPI_Comm);
+template int
+Neighbor_alltoallv<long long>(long long *, int *, int *,
+                              long long *, int *, int *,
+                              MPI_Comm);
+template int
+Neighbor_alltoallv<unsigned char>(unsigned char *, int *, int *,
+                                  unsigned char *, int *, int *,
+                                  MPI_Comm);
+template int
+Neighbor_alltoallv<unsigned short>(unsigned short *, int *, int *,
+                                   unsigned short *, int *, int *,
+                                   MPI_Comm);
+template int
+Neighbor_alltoallv<unsigned int>(unsigned int *, int *, int *,
+                                 unsigned int *, int *, int *,
+                                 MPI_Comm);
+template int
+Neighbor_alltoallv<unsigned long>(unsigned long *, int *, int *,
+                                  unsigned long *, int *, int *,
+                                  MPI_Comm);
+template int
+Neighbor_alltoallv<unsigned long long>(unsigned long long *, int *, int *,
+                                       unsigned long long *, int *, int *,
+                                       MPI_Comm);
+template int Neighbor_alltoallv<double>(double *, int *, int *, double *,
+                                        int *, int *, MPI_Comm);
+
+// Special implementation for complex numbers
+template <>
+int Neighbor_alltoallv<complex>(complex *sendbuf, int *sendcounts,
+                                int *sdispls, complex *recvbuf,
+                                int *recvcounts, int *rdispls, MPI_Comm comm) {
+  int n_sources, n_destinations, weighted;
+  MPI_Dist_graph_neighbors_count(comm, &n_sources, &n_destinations, &weighted);
+  std::vector<int> sendcounts_2(n_destinations, 0);
+  std::vector<int> sdispls_2(n_destinations, 0);
+  std::vector<int> recvcounts_2(n_sources, 0);
+  std::vector<int> rdispls_2(n_sources, 0);
+  for (int i = 0; i < n_destinations; ++i) {
+    sendcounts_2[i] = sendcounts[i] * 2;
+    sdispls_2[i] = sdispls[i] * 2;
+  }
+  for (int i = 0; i < n_sources; ++i) {
+    recvcounts_2[i] = recvcounts[i] * 2;
+    rdispls_2[i] = rdispls[i] * 2;
+  }
+  return MPI_Neighbor_alltoallv(sendbuf, sendcounts_2.data(), sdispls_2.data(),
+                                MPI_DOUBLE, recvbuf, recvcounts_2.data(),
+                                rdispls_2.data(), MPI_DOUBLE, comm);
+}
+
 } // namespace xdiag::mpi
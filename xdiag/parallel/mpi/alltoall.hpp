@@ -16,5 +16,12 @@ template <class coeff_t>
 int Alltoallv(coeff_t *sendbuf, int *sendcounts, int *sdispls, coeff_t *recvbuf,
               int *recvcounts, int *rdispls, MPI_Comm comm);
 
+// Alltoallv on a distributed graph communicator, where the counts and
+// displacements refer to the sources and destinations of the graph
+template <class coeff_t>
+int Neighbor_alltoallv(coeff_t *sendbuf, int *sendcounts, int *sdispls,
+                       coeff_t *recvbuf, int *recvcounts, int *rdispls,
+                       MPI_Comm comm);
+
 } // namespace xdiag::mpi
 #endif
@@ -9,9 +9,21 @@
 
 #include <mpi.h>
 
+#include <xdiag/parallel/mpi/allreduce.hpp>
+
 namespace xdiag::mpi {
 
-Communicator::Communicator(std::vector<int64_t> const &n_values_i_send)
+static void free_comm(MPI_Comm *comm) {
+  int finalized;
+  MPI_Finalized(&finalized);
+  if (!finalized) {
+    MPI_Comm_free(comm);
+  }
+  delete comm;
+}
+
+Communicator::Communicator(std::vector<int64_t> const &n_values_i_send,
+                           bool neighborhood)
     : n_values_prepared_(n_values_i_send.size(), 0),
       n_values_i_recv_(n_values_i_send.size(), 0),
       n_values_i_send_offsets_(n_values_i_send.size(), 0),
@@ -37,6 +49,39 @@ Communicator::Communicator(std::vector<int64_t> const &n_values_i_send)
       std::accumulate(n_values_i_send_.begin(), n_values_i_send_.end(), 0);
   recv_buffer_size_ =
       std::accumulate(n_values_i_recv_.begin(), n_values_i_recv_.end(), 0);
+
+  if (!neighborhood) {
+    return;
+  }
+
+  // Determine the processes values are exchanged with
+  std::vector<int> sources;
+  std::vector<int> destinations;
+  for (int i = 0; i < mpi_size_; ++i) {
+    if (n_values_i_recv_[i] > 0) {
+      sources.push_back(i);
+      neighbor_recv_.push_back(n_values_i_recv_[i]);
+      neighbor_recv_offsets_.push_back(n_values_i_recv_offsets_[i]);
+    }
+    if (n_values_i_send_[i] > 0) {
+      destinations.push_back(i);
+      neighbor_send_.push_back(n_values_i_send_[i]);
+      neighbor_send_offsets_.push_back(n_values_i_send_offsets_[i]);
+    }
+  }
+  int64_t n_neighbors = std::max(sources.size(), destinations.size());
+  int64_t n_neighbors_max;
+  mpi::Allreduce(&n_neighbors, &n_neighbors_max, 1, MPI_MAX, MPI_COMM_WORLD);
+
+  // Neighborhood collectives only pay off if the pattern is sparse
+  if (2 * n_neighbors_max <= mpi_size_) {
+    MPI_Comm *comm = new MPI_Comm;
+    MPI_Dist_graph_create_adjacent(
+        MPI_COMM_WORLD, sources.size(), sources.data(), MPI_UNWEIGHTED,
+        destinations.size(), destinations.data(), MPI_UNWEIGHTED,
+        MPI_INFO_NULL, 0, comm);
+    neighbor_comm_ = std::shared_ptr<MPI_Comm>(comm, free_comm);
+  }
 }
 
 int64_t Communicator::n_values_i_send(int mpi_rank) const {
@@ -60,6 +105,8 @@ int64_t Communicator::n_values_prepared(int mpi_rank) const {
   return n_values_prepared_[mpi_rank];
 }
 
+bool Communicator::neighborhood() const { return (bool)neighbor_comm_; }
+
 void Communicator::flush() {
   std::fill(n_values_prepared_.begin(), n_values_prepared_.end(), 0);
 }
@@ -5,18 +5,24 @@
 #pragma once
 #ifdef XDIAG_USE_MPI
 
+#include <memory>
 #include <mpi.h>
 
 #include <xdiag/common.hpp>
 #include <xdiag/parallel/mpi/alltoall.hpp>
 #include <xdiag/parallel/mpi/buffer.hpp>
+#include <xdiag/utils/profile.hpp>
 
 namespace xdiag::mpi {
 
 class Communicator {
 public:
   Communicator() = default;
-  Communicator(std::vector<int64_t> const &n_values_i_send);
+  // If neighborhood is set, a distributed graph communicator is created and
+  // neighborhood collectives are used in case every process exchanges values
+  // with at most half of the processes.
+  Communicator(std::vector<int64_t> const &n_values_i_send,
+               bool neighborhood = false);
 
   int64_t n_values_i_send(int mpi_rank) const;
   int64_t n_values_i_recv(int mpi_rank) const;
@@ -28,6 +34,7 @@ public:
   int64_t recv_buffer_size() const;
 
   int64_t n_values_prepared(int mpi_rank) const;
+  bool neighborhood() const;
 
   void flush();
 
@@ -41,6 +48,17 @@ public:
 
   template <class T>
   inline void all_to_all(const T *send_buffer, T *recv_buffer) const {
+    profile::count_bytes(send_buffer_size_ * sizeof(T));
+    if (neighbor_comm_) {
+      Neighbor_alltoallv<T>(const_cast<T *>(send_buffer),
+                            const_cast<int *>(neighbor_send_.data()),
+                            const_cast<int *>(neighbor_send_offsets_.data()),
+                            const_cast<T *>(recv_buffer),
+                            const_cast<int *>(neighbor_recv_.data()),
+                            const_cast<int *>(neighbor_recv_offsets_.data()),
+                            *neighbor_comm_);
+      return;
+    }
     Alltoallv<T>(const_cast<T *>(send_buffer),
                  const_cast<int *>(n_values_i_send_.data()),
                  const_cast<int *>(n_values_i_send_offsets_.data()),
@@ -63,6 +81,12 @@ private:
 
   int64_t send_buffer_size_;
   int64_t recv_buffer_size_;
+
+  std::shared_ptr<MPI_Comm> neighbor_comm_;
+  std::vector<int> neighbor_send_;
+  std::vector<int> neighbor_recv_;
+  std::vector<int> neighbor_send_offsets_;
+  std::vector<int> neighbor_recv_offsets_;
 };
 
 } // namespace xdiag::mpi
@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "partition.hpp"
+
+#include <mpi.h>
+
+#include <xdiag/combinatorics/binomial.hpp>
+
+namespace xdiag::mpi {
+
+template <typename bit_t>
+Partition<bit_t>::Partition(int64_t nbits,
+                            std::vector<int64_t> const &popcounts,
+                            std::string type) try
+    : nbits_(nbits), type_(type), balanced_(type == "balanced") {
+  MPI_Comm_size(MPI_COMM_WORLD, &mpi_size_);
+
+  if ((type != "hash") && (type != "balanced")) {
+    XDIAG_THROW(fmt::format("Unknown partition type: \"{}\". Available types "
+                            "are \"hash\" and \"balanced\"",
+                            type));
+  }
+
+  if (balanced_) {
+    // Offsets enumerate all configurations ordered by number of set bits,
+    // independent of which popcounts are actually used
+    offsets_.resize(nbits + 1, 0);
+    for (int64_t k = 1; k <= nbits; ++k) {
+      offsets_[k] = offsets_[k - 1] + combinatorics::binomial(nbits, k - 1);
+    }
+
+    // Lookup tables are only created for the popcounts which can occur and
+    // their neighbors, since the apply kernels determine the owner of a
+    // configuration after flipping a single bit
+    lintables_.resize(nbits + 1);
+    std::vector<bool> created(nbits + 1, false);
+    for (int64_t k : popcounts) {
+      for (int64_t kk = k - 1; kk <= k + 1; ++kk) {
+        if ((kk >= 0) && (kk <= nbits) && !created[kk]) {
+          lintables_[kk] = combinatorics::LinTable<bit_t>(nbits, kk);
+          created[kk] = true;
+        }
+      }
+    }
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+template <typename bit_t> int64_t Partition<bit_t>::nbits() const {
+  return nbits_;
+}
+
+template <typename bit_t> std::string Partition<bit_t>::type() const {
+  return type_;
+}
+
+template <typename bit_t>
+bool Partition<bit_t>::operator==(Partition const &rhs) const {
+  return (nbits_ == rhs.nbits_) && (type_ == rhs.type_);
+}
+
+template <typename bit_t>
+bool Partition<bit_t>::operator!=(Partition const &rhs) const {
+  return !operator==(rhs);
+}
+
+template class Partition<uint16_t>;
+template class Partition<uint32_t>;
+template class Partition<uint64_t>;
+
+double imbalance_factor(int64_t size_max, int64_t dim) {
+  int mpi_size;
+  MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+  return (dim == 0) ? 1.0 : (double)size_max * mpi_size / (double)dim;
+}
+
+} // namespace xdiag::mpi
@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifdef XDIAG_USE_MPI
+
+#include <string>
+#include <vector>
+
+#include <xdiag/bits/bitops.hpp>
+#include <xdiag/combinatorics/lin_table.hpp>
+#include <xdiag/common.hpp>
+#include <xdiag/random/hash_functions.hpp>
+
+namespace xdiag::mpi {
+
+// Assigns bit configurations of "nbits" bits to MPI processes
+//
+// "hash"    : the process is determined by a hash of the configuration
+// "balanced": configurations are enumerated by their number of set bits and
+//             their combinatorial index and distributed round-robin. Hence,
+//             all configurations with the same number of set bits are split
+//             evenly (up to one) among the processes. The assignment does not
+//             depend on the particle number of a block, such that e.g. S+/S-
+//             operators can map between blocks without changing the owner.
+template <typename bit_t> class Partition {
+public:
+  Partition() = default;
+  Partition(int64_t nbits, std::vector<int64_t> const &popcounts,
+            std::string type = "hash");
+
+  inline int rank(bit_t bits) const {
+    if (balanced_) {
+      int64_t k = bits::popcnt(bits);
+      return (int)((offsets_[k] + lintables_[k].index(bits)) % mpi_size_);
+    } else {
+      return (int)(random::hash_div3(bits) % mpi_size_);
+    }
+  }
+
+  int64_t nbits() const;
+  std::string type() const;
+
+  bool operator==(Partition const &rhs) const;
+  bool operator!=(Partition const &rhs) const;
+
+private:
+  int64_t nbits_;
+  std::string type_;
+  bool balanced_;
+  int mpi_size_;
+  std::vector<int64_t> offsets_;
+  std::vector<combinatorics::LinTable<bit_t>> lintables_;
+};
+
+// Ratio of the largest local size to the average local size
+double imbalance_factor(int64_t size_max, int64_t dim);
+
+} // namespace xdiag::mpi
+#endif
@@ -28,15 +28,15 @@ inline gsl::span<T> get_omp_span(std::vector<T> const &vec) {
   return gsl::span<T>(vec.data() + start, end - start);
 }
 
-template <typename T>
-inline std::vector<T>
+template <typename T, class allocator_t = std::allocator<T>>
+inline std::vector<T, allocator_t>
 combine_vectors(std::vector<std::vector<T>> const &vec_of_vec) {
   int64_t size = 0;
   for (auto const &vec : vec_of_vec) {
     size += vec.size();
   }
 
-  std::vector<T> total_vec(size);
+  std::vector<T, allocator_t> total_vec(size);
   int64_t offset = 0;
 
   for (auto const &vec : vec_of_vec) {
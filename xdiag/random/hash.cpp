@@ -5,6 +5,9 @@
 #include "hash.hpp"
 
 #include <complex>
+#include <cstring>
+#include <functional>
+#include <type_traits>
 #include <variant>
 
 #include <xdiag/random/hash_functions.hpp>
@@ -40,6 +43,37 @@ uint64_t hash(Representation const &irrep) {
   return hash_combine(h, hash(irrep.group()));
 }
 
+template <typename T> static uint64_t hash(arma::Mat<T> const &mat) {
+  uint64_t h = hash_fnv1((uint64_t)mat.n_rows);
+  h = hash_combine(h, hash_fnv1((uint64_t)mat.n_cols));
+  double const *ptr = reinterpret_cast<double const *>(mat.memptr());
+  int64_t size = std::is_same<T, double>::value ? mat.n_elem : 2 * mat.n_elem;
+  for (int64_t i = 0; i < size; ++i) {
+    uint64_t bits;
+    std::memcpy(&bits, ptr + i, sizeof(bits));
+    h = hash_combine(h, hash_fnv1(bits));
+  }
+  return h;
+}
+
+uint64_t hash(Op const &op) {
+  uint64_t h = hash_fnv1((uint64_t)std::hash<std::string>()(op.type()));
+  if (op.hassites()) {
+    for (int64_t site : op.sites()) {
+      h = hash_combine(h, hash_fnv1((uint64_t)site));
+    }
+  }
+  if (op.hasmatrix()) {
+    Matrix const &mat = op.matrix();
+    if (mat.isreal()) {
+      h = hash_combine(h, hash(mat.as<arma::mat>()));
+    } else {
+      h = hash_combine(h, hash(mat.as<arma::cx_mat>()));
+    }
+  }
+  return h;
+}
+
 uint64_t hash(Block const &block) {
   return std::visit([](auto &&block) { return hash(block); }, block);
 }
@@ -52,6 +86,9 @@ uint64_t hash(Spinhalf const &block) {
   if (block.irrep()) {
     h = hash_combine(h, hash(*block.irrep()));
   }
+  if (block.spinflip()) {
+    h = hash_combine(h, hash_fnv1((uint64_t)(*block.spinflip() + 2)));
+  }
   return h;
 }
 
@@ -66,6 +103,9 @@ uint64_t hash(tJ const &block) {
   if (block.irrep()) {
     h = hash_combine(h, hash(*block.irrep()));
   }
+  if (block.spinflip()) {
+    h = hash_combine(h, hash_fnv1((uint64_t)(*block.spinflip() + 2)));
+  }
   return h;
 }
 
@@ -80,6 +120,15 @@ uint64_t hash(Electron const &block) {
   if (block.irrep()) {
     h = hash_combine(h, hash(*block.irrep()));
   }
+  if (block.spinflip()) {
+    h = hash_combine(h, hash_fnv1((uint64_t)(*block.spinflip() + 2)));
+  }
+  if (block.particlehole()) {
+    h = hash_combine(h, hash_fnv1((uint64_t)(*block.particlehole() + 4)));
+    for (int64_t label : block.bipartition()) {
+      h = hash_combine(h, hash_fnv1((uint64_t)label));
+    }
+  }
   return h;
 }
 
@@ -90,6 +139,12 @@ uint64_t hash(SpinhalfDistributed const &block) {
   if (block.nup() != undefined) {
     h = hash_combine(h, hash_fnv1((uint64_t)*block.nup()));
   }
+  if (block.irrep()) {
+    h = hash_combine(h, hash(*block.irrep()));
+  }
+  if (block.partition() == "balanced") {
+    h = hash_combine(h, hash_fnv1((uint64_t)1));
+  }
   int mpi_rank;
   MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
   h = hash_combine(h, hash_fnv1((uint64_t)mpi_rank));
@@ -105,6 +160,9 @@ uint64_t hash(tJDistributed const &block) {
     h = hash_combine(h, hash_fnv1((uint64_t)*block.ndn()));
   }
 
+  if (block.partition() == "balanced") {
+    h = hash_combine(h, hash_fnv1((uint64_t)1));
+  }
   int mpi_rank;
   MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
   h = hash_combine(h, hash_fnv1((uint64_t)mpi_rank));
@@ -120,6 +178,9 @@ uint64_t hash(ElectronDistributed const &block) {
     h = hash_combine(h, hash_fnv1((uint64_t)*block.ndn()));
   }
 
+  if (block.partition() == "balanced") {
+    h = hash_combine(h, hash_fnv1((uint64_t)1));
+  }
   int mpi_rank;
   MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
   h = hash_combine(h, hash_fnv1((uint64_t)mpi_rank));
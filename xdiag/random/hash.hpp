@@ -25,6 +25,7 @@ namespace xdiag::random {
 uint64_t hash(Permutation const &perm);
 uint64_t hash(PermutationGroup const &group);
 uint64_t hash(Representation const &irrep);
+uint64_t hash(Op const &op);
 
 uint64_t hash(Block const &block);
 
@@ -0,0 +1,310 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sparse_state.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+#include <xdiag/states/fill.hpp>
+
+namespace xdiag {
+
+static void check_block(Block const &block, double max_density) try {
+  if (isdistributed(block)) {
+    XDIAG_THROW("SparseState is not available for distributed blocks");
+  }
+  if ((max_density < 0.) || (max_density > 1.)) {
+    XDIAG_THROW(fmt::format("Maximal density of a SparseState must be "
+                            "between 0 and 1, got {}",
+                            max_density));
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+SparseState::SparseState(Block const &block, bool real,
+                         double max_density) try
+    : valid_(true), block_(block), real_(real), max_density_(max_density) {
+  check_block(block, max_density);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+SparseState::SparseState(Block const &block,
+                         std::vector<int64_t> const &indices,
+                         std::vector<double> const &values,
+                         double max_density) try
+    : valid_(true), block_(block), real_(true), max_density_(max_density) {
+  check_block(block, max_density);
+  init(indices, values);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+SparseState::SparseState(Block const &block,
+                         std::vector<int64_t> const &indices,
+                         std::vector<complex> const &values,
+                         double max_density) try
+    : valid_(true), block_(block), real_(false), max_density_(max_density) {
+  check_block(block, max_density);
+  init(indices, values);
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+SparseState::SparseState(State const &state, double max_density) try
+    : valid_(state.isvalid()), real_(state.isreal()),
+      max_density_(max_density) {
+  if (!valid_) {
+    return;
+  }
+  block_ = state.block();
+  check_block(block_, max_density);
+  if (state.ncols() != 1) {
+    XDIAG_THROW("SparseState can only be created from a State with a single "
+                "column");
+  }
+  if (real_) {
+    arma::vec v = state.vector(0, false);
+    arma::uvec nonzero = arma::find(v);
+    init(arma::conv_to<std::vector<int64_t>>::from(nonzero),
+         arma::conv_to<std::vector<double>>::from(v.elem(nonzero)));
+  } else {
+    arma::cx_vec v = state.vectorC(0, false);
+    arma::uvec nonzero = arma::find(v);
+    arma::cx_vec values = v.elem(nonzero);
+    init(arma::conv_to<std::vector<int64_t>>::from(nonzero),
+         std::vector<complex>(values.begin(), values.end()));
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+// Sorts the indices, adds up the values of repeated indices and removes
+// zeros
+template <typename coeff_t>
+void SparseState::init(std::vector<int64_t> const &indices,
+                       std::vector<coeff_t> const &values) try {
+  if (indices.size() != values.size()) {
+    XDIAG_THROW(fmt::format("Number of indices ({}) and values ({}) of "
+                            "SparseState do not agree",
+                            indices.size(), values.size()));
+  }
+  int64_t d = dim();
+  std::vector<int64_t> perm(indices.size());
+  std::iota(perm.begin(), perm.end(), 0);
+  std::sort(perm.begin(), perm.end(), [&](int64_t i, int64_t j) {
+    return indices[i] < indices[j];
+  });
+
+  std::vector<int64_t> indices_sorted;
+  std::vector<coeff_t> values_sorted;
+  indices_sorted.reserve(indices.size());
+  values_sorted.reserve(indices.size());
+  for (int64_t i : perm) {
+    int64_t idx = indices[i];
+    if ((idx < 0) || (idx >= d)) {
+      XDIAG_THROW(fmt::format(
+          "Index {} of SparseState out of range for block of dimension {}",
+          idx, d));
+    }
+    if (!indices_sorted.empty() && (indices_sorted.back() == idx)) {
+      values_sorted.back() += values[i];
+    } else {
+      indices_sorted.push_back(idx);
+      values_sorted.push_back(values[i]);
+    }
+  }
+
+  indices_.clear();
+  std::vector<coeff_t> vals;
+  for (int64_t i = 0; i < (int64_t)indices_sorted.size(); ++i) {
+    if (values_sorted[i] != (coeff_t)0.) {
+      indices_.push_back(indices_sorted[i]);
+      vals.push_back(values_sorted[i]);
+    }
+  }
+  if constexpr (std::is_same<coeff_t, double>::value) {
+    values_ = std::move(vals);
+  } else {
+    valuesC_ = std::move(vals);
+  }
+  densify_if_full();
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+void SparseState::densify_if_full() try {
+  if (sparse_ && ((double)nnz() > max_density_ * (double)dim())) {
+    state_ = dense();
+    sparse_ = false;
+    indices_ = std::vector<int64_t>();
+    values_ = std::vector<double>();
+    valuesC_ = std::vector<complex>();
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+bool SparseState::isvalid() const { return valid_; }
+bool SparseState::isreal() const { return real_; }
+bool SparseState::issparse() const { return sparse_; }
+int64_t SparseState::nsites() const { return xdiag::nsites(block_); }
+int64_t SparseState::dim() const { return xdiag::dim(block_); }
+int64_t SparseState::nnz() const try {
+  if (sparse_) {
+    return indices_.size();
+  } else if (real_) {
+    return arma::find(state_.vector(0, false)).eval().n_elem;
+  } else {
+    return arma::find(state_.vectorC(0, false)).eval().n_elem;
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+  return 0;
+}
+double SparseState::density() const {
+  return (dim() == 0) ? 0. : (double)nnz() / (double)dim();
+}
+double SparseState::max_density() const { return max_density_; }
+
+void SparseState::make_complex() try {
+  if (!real_) {
+    return;
+  }
+  if (sparse_) {
+    valuesC_ = std::vector<complex>(values_.begin(), values_.end());
+    values_ = std::vector<double>();
+  } else {
+    state_.make_complex();
+  }
+  real_ = false;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+std::vector<int64_t> const &SparseState::indices() const try {
+  if (!sparse_) {
+    XDIAG_THROW("SparseState is stored densely, no indices available");
+  }
+  return indices_;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+  return indices_;
+}
+
+std::vector<double> const &SparseState::values() const try {
+  if (!sparse_) {
+    XDIAG_THROW("SparseState is stored densely, no values available");
+  } else if (!real_) {
+    XDIAG_THROW("Cannot return real values of a complex SparseState (maybe "
+                "use valuesC() instead)");
+  }
+  return values_;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+  return values_;
+}
+
+std::vector<complex> const &SparseState::valuesC() const try {
+  if (!sparse_) {
+    XDIAG_THROW("SparseState is stored densely, no values available");
+  } else if (real_) {
+    XDIAG_THROW("Cannot return complex values of a real SparseState (maybe "
+                "use values() instead)");
+  }
+  return valuesC_;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+  return valuesC_;
+}
+
+State SparseState::dense() const try {
+  if (!valid_) {
+    return State();
+  } else if (!sparse_) {
+    return state_;
+  }
+  State state(block_, real_);
+  if (real_) {
+    arma::vec v = state.vector(0, false);
+    for (int64_t i = 0; i < (int64_t)indices_.size(); ++i) {
+      v(indices_[i]) = values_[i];
+    }
+  } else {
+    arma::cx_vec v = state.vectorC(0, false);
+    for (int64_t i = 0; i < (int64_t)indices_.size(); ++i) {
+      v(indices_[i]) = valuesC_[i];
+    }
+  }
+  return state;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+  return State();
+}
+
+Block SparseState::block() const { return block_; }
+
+SparseState sparse_product_state(Block const &block,
+                                 std::vector<std::string> const &local_state,
+                                 bool real, double max_density) try {
+  auto pstate = ProductState(local_state);
+  if (nsites(block) != pstate.size()) {
+    XDIAG_THROW("Block and ProductState do not have the same number of sites");
+  }
+  int64_t idx = std::visit(
+      overload{[&](Spinhalf const &b) { return b.index(pstate); },
+               [&](tJ const &b) { return b.index(pstate); },
+               [&](Electron const &b) { return b.index(pstate); },
+               [&](auto const &) -> int64_t {
+                 XDIAG_THROW(
+                     "SparseState is not available for distributed blocks");
+               }},
+      block);
+  if (idx == invalid_index) {
+    XDIAG_THROW("Index of product state cannot be determined");
+  }
+  if (real) {
+    return SparseState(block, {idx}, std::vector<double>{1.0}, max_density);
+  } else {
+    return SparseState(block, {idx}, std::vector<complex>{1.0}, max_density);
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+  return SparseState();
+}
+
+bool isvalid(SparseState const &s) { return s.isvalid(); }
+bool isreal(SparseState const &s) { return s.isreal(); }
+bool issparse(SparseState const &s) { return s.issparse(); }
+int64_t nsites(SparseState const &s) { return s.nsites(); }
+int64_t dim(SparseState const &s) { return s.dim(); }
+int64_t nnz(SparseState const &s) { return s.nnz(); }
+double density(SparseState const &s) { return s.density(); }
+void make_complex(SparseState &s) { s.make_complex(); }
+State dense(SparseState const &s) { return s.dense(); }
+
+std::ostream &operator<<(std::ostream &out, SparseState const &s) {
+  if (s.isvalid()) {
+    if (s.isreal()) {
+      out << "REAL SparseState\n";
+    } else {
+      out << "COMPLEX SparseState\n";
+    }
+    if (s.issparse()) {
+      out << "Nonzero coefficients: " << s.nnz() << "\n";
+    } else {
+      out << "Stored densely\n";
+    }
+    out << "Block:\n";
+    out << s.block();
+  } else {
+    out << "INVALID SparseState\n";
+  }
+  return out;
+}
+std::string to_string(SparseState const &s) { return to_string_generic(s); }
+
+} // namespace xdiag
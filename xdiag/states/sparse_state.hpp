@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <vector>
+
+#include <xdiag/blocks/blocks.hpp>
+#include <xdiag/common.hpp>
+#include <xdiag/states/product_state.hpp>
+#include <xdiag/states/state.hpp>
+
+namespace xdiag {
+
+// A vector on a block which stores only its nonzero coefficients, as sorted
+// arrays of indices and values. Once the fraction of nonzero coefficients
+// exceeds max_density, the coefficients are stored densely in a State
+// instead. Hence, states with few nonzero coefficients like product states
+// and their first images under an operator are represented at a cost
+// independent of the dimension of the block.
+class SparseState {
+public:
+  XDIAG_API SparseState() = default;
+  XDIAG_API explicit SparseState(Block const &block, bool real = true,
+                                 double max_density = 0.1);
+  XDIAG_API SparseState(Block const &block,
+                        std::vector<int64_t> const &indices,
+                        std::vector<double> const &values,
+                        double max_density = 0.1);
+  XDIAG_API SparseState(Block const &block,
+                        std::vector<int64_t> const &indices,
+                        std::vector<complex> const &values,
+                        double max_density = 0.1);
+  XDIAG_API explicit SparseState(State const &state, double max_density = 0.1);
+
+  XDIAG_API bool isvalid() const;
+  XDIAG_API bool isreal() const;
+  XDIAG_API bool issparse() const;
+  XDIAG_API int64_t nsites() const;
+  XDIAG_API int64_t dim() const;
+  XDIAG_API int64_t nnz() const;
+  XDIAG_API double density() const;
+  XDIAG_API double max_density() const;
+  XDIAG_API void make_complex();
+
+  // Sparse storage, only available if issparse()
+  XDIAG_API std::vector<int64_t> const &indices() const;
+  XDIAG_API std::vector<double> const &values() const;
+  XDIAG_API std::vector<complex> const &valuesC() const;
+
+  XDIAG_API State dense() const;
+  Block block() const;
+
+private:
+  bool valid_ = false;
+  Block block_;
+  bool real_ = true;
+  double max_density_ = 0.1;
+  bool sparse_ = true;
+  std::vector<int64_t> indices_;
+  std::vector<double> values_;
+  std::vector<complex> valuesC_;
+  State state_;
+
+  template <typename coeff_t>
+  void init(std::vector<int64_t> const &indices,
+            std::vector<coeff_t> const &values);
+  void densify_if_full();
+};
+
+XDIAG_API SparseState sparse_product_state(
+    Block const &block, std::vector<std::string> const &local_state,
+    bool real = true, double max_density = 0.1);
+
+XDIAG_API bool isvalid(SparseState const &s);
+XDIAG_API bool isreal(SparseState const &s);
+XDIAG_API bool issparse(SparseState const &s);
+XDIAG_API int64_t nsites(SparseState const &s);
+XDIAG_API int64_t dim(SparseState const &s);
+XDIAG_API int64_t nnz(SparseState const &s);
+XDIAG_API double density(SparseState const &s);
+XDIAG_API void make_complex(SparseState &s);
+XDIAG_API State dense(SparseState const &s);
+XDIAG_API std::ostream &operator<<(std::ostream &out, SparseState const &s);
+XDIAG_API std::string to_string(SparseState const &s);
+
+} // namespace xdiag
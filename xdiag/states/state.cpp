@@ -8,8 +8,18 @@
 
 namespace xdiag {
 
-static void safe_resize(std::vector<double> &vec, int64_t size) try {
-  vec.resize(size, 0);
+// Allocates fresh memory and sets it to zero with the same static schedule
+// as the first touch in numa_allocate
+static void safe_resize(numa_vector_uninit<double> &vec, int64_t size) try {
+  vec = numa_vector_uninit<double>();
+  vec.resize(size);
+  double *data = vec.data();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (int64_t i = 0; i < size; ++i) {
+    data[i] = 0.;
+  }
 } catch (...) {
   XDIAG_THROW("Unable to resize vector");
 }
@@ -35,7 +45,7 @@ void State::initcopy(const double *ptr, int64_t nrows, int64_t ncols,
                      int64_t stride) try {
   init0(true, nrows, ncols);
   if (stride == 1) {
-    std::copy(ptr, ptr + size(), storage_.data());
+    std::copy(ptr, ptr + size(), data());
   } else if (stride == 2) {
     for (int64_t i = 0, is = 0; i < size(); ++i, is += 2) {
       storage_[i] = ptr[is];
@@ -50,7 +60,7 @@ void State::initcopy(const double *ptr, int64_t nrows, int64_t ncols,
 // This initialization copies the memory (complex)
 void State::initcopy(const complex *ptr, int64_t nrows, int64_t ncols) try {
   init0(false, nrows, ncols);
-  std::copy(ptr, ptr + size(), reinterpret_cast<complex *>(storage_.data()));
+  std::copy(ptr, ptr + size(), reinterpret_cast<complex *>(data()));
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
@@ -119,7 +129,108 @@ State::State(Block const &block, complex const *ptr, int64_t ncols) try
   XDIAG_RETHROW(e);
 }
 
+State::State(State const &other)
+    : valid_(other.valid_), block_(other.block_), real_(other.real_),
+      nrows_(other.nrows_), ncols_(other.ncols_) {
+  // Copies of a view own their memory
+  if (other.view_) {
+    int64_t n = real_ ? size() : 2 * size();
+    storage_.assign(other.view_ptr_, other.view_ptr_ + n);
+  } else {
+    storage_ = other.storage_;
+  }
+}
+
+State::State(State &&other) noexcept = default;
+
+// Assigning to a valid view copies the coefficients into the external memory
+static void assign_view(State &view, State const &other) try {
+  if (view.block() != other.block()) {
+    XDIAG_THROW("Cannot assign a State to a State view on a different block");
+  } else if (view.ncols() != other.ncols()) {
+    XDIAG_THROW("Cannot assign a State to a State view with a different "
+                "number of columns");
+  }
+  if (isreal(view) && isreal(other)) {
+    view.matrix(false) = other.matrix(false);
+  } else if (!isreal(view) && isreal(other)) {
+    view.matrixC(false).set_real(other.matrix(false));
+    view.matrixC(false).set_imag(arma::zeros(view.nrows(), view.ncols()));
+  } else if (!isreal(view) && !isreal(other)) {
+    view.matrixC(false) = other.matrixC(false);
+  } else {
+    XDIAG_THROW("Cannot assign a complex State to a real State view");
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+State &State::operator=(State const &other) try {
+  if (this == &other) {
+    return *this;
+  }
+  if (view_ && other.valid_) {
+    assign_view(*this, other);
+  } else {
+    *this = State(other);
+  }
+  return *this;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+State &State::operator=(State &&other) try {
+  if (this == &other) {
+    return *this;
+  }
+  if (view_ && other.valid_) {
+    assign_view(*this, other);
+  } else {
+    valid_ = other.valid_;
+    block_ = std::move(other.block_);
+    real_ = other.real_;
+    nrows_ = other.nrows_;
+    ncols_ = other.ncols_;
+    storage_ = std::move(other.storage_);
+    view_ = other.view_;
+    view_ptr_ = other.view_ptr_;
+  }
+  return *this;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+State state_view(Block const &block, double *ptr, int64_t ncols) try {
+  if (ncols < 1) {
+    XDIAG_THROW("Number of columns of a State view must be at least one");
+  }
+  State state;
+  state.valid_ = true;
+  state.block_ = block;
+  state.real_ = true;
+  state.nrows_ = xdiag::size(block);
+  state.ncols_ = ncols;
+  state.view_ = true;
+  state.view_ptr_ = ptr;
+  return state;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+State state_view(Block const &block, complex *ptr, int64_t ncols) try {
+  auto state = state_view(block, reinterpret_cast<double *>(ptr), ncols);
+  state.real_ = false;
+  return state;
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+double *State::data() const {
+  return view_ ? view_ptr_ : storage_.data();
+}
+
 bool State::isvalid() const { return valid_; }
+bool State::isview() const { return view_; }
 int64_t State::nsites() const { return xdiag::nsites(block_); }
 bool State::isreal() const { return real_; }
 
@@ -127,7 +238,7 @@ State State::real() const try {
   if (isreal()) {
     return (*this);
   } else {
-    double *ptr = storage_.data();
+    double *ptr = data();
     return std::visit(
         [&](auto &&block) { return State(block, ptr, ncols_, 2); }, block_);
   }
@@ -140,7 +251,7 @@ State State::imag() const try { // TODO: DOES THIS DO WHAT IT"S SUPPOSED TO?
   if (isreal()) {
     return State(block_, true, ncols_);
   } else {
-    double *ptr = storage_.data();
+    double *ptr = data();
     return std::visit(
         [&](auto &&block) { return State(block, ptr + 1, ncols_, 2); }, block_);
   }
@@ -151,14 +262,22 @@ State State::imag() const try { // TODO: DOES THIS DO WHAT IT"S SUPPOSED TO?
 
 void State::make_complex() try {
   if (isreal()) {
+    if (view_) {
+      XDIAG_THROW("Cannot make a real State view complex, since its memory is "
+                  "not owned by the State");
+    }
     real_ = false;
 
-    safe_resize(storage_, 2 * size());
-
-    double *ptr = storage_.data();
-    for (int64_t i = size() - 1; i >= 0; --i) {
-      std::swap(ptr[i << 1], ptr[i]);
+    numa_vector_uninit<double> storage;
+    safe_resize(storage, 2 * size());
+    int64_t n = size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t i = 0; i < n; ++i) {
+      storage[i << 1] = storage_[i];
     }
+    storage_ = std::move(storage);
   }
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
@@ -196,7 +315,7 @@ arma::vec State::vector(int64_t n, bool copy) const try {
   } else if (n < 0) {
     XDIAG_THROW("Negative column index");
   }
-  return arma::vec(storage_.data() + n * nrows_, nrows_, copy, !copy);
+  return arma::vec(data() + n * nrows_, nrows_, copy, !copy);
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
   return arma::vec();
@@ -207,7 +326,7 @@ arma::mat State::matrix(bool copy) const try {
     XDIAG_THROW("Cannot return a real armadillo matrix from a "
                 "complex state (maybe use matrixC(...) instead)");
   }
-  return arma::mat(storage_.data(), nrows_, ncols_, copy, !copy);
+  return arma::mat(data(), nrows_, ncols_, copy, !copy);
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
   return arma::mat();
@@ -222,7 +341,7 @@ arma::cx_vec State::vectorC(int64_t n, bool copy) const try {
   } else if (n < 0) {
     XDIAG_THROW("Negative column index");
   }
-  return arma::cx_vec(reinterpret_cast<complex *>(storage_.data()) + n * nrows_,
+  return arma::cx_vec(reinterpret_cast<complex *>(data()) + n * nrows_,
                       nrows_, copy, !copy);
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
@@ -234,16 +353,16 @@ arma::cx_mat State::matrixC(bool copy) const try {
     XDIAG_THROW("Cannot return a complex armadillo matrix from a "
                 "real state (maybe use matrix(...) instead)");
   }
-  return arma::cx_mat(reinterpret_cast<complex *>(storage_.data()), nrows_,
+  return arma::cx_mat(reinterpret_cast<complex *>(data()), nrows_,
                       ncols_, copy, !copy);
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
   return arma::cx_mat();
 }
 
-double *State::memptr() { return storage_.data(); }
+double *State::memptr() { return data(); }
 complex *State::memptrC() {
-  return reinterpret_cast<complex *>(storage_.data());
+  return reinterpret_cast<complex *>(data());
 }
 double *State::colptr(int64_t col) {
   if ((col < 0) || (col >= ncols_)) {
@@ -259,6 +378,7 @@ complex *State::colptrC(int64_t col) {
 }
 
 bool isvalid(State const &s) { return s.isvalid(); }
+bool isview(State const &s) { return s.isview(); }
 int64_t nsites(State const &s) { return s.nsites(); }
 bool isapprox(State const &v, State const &w, double rtol, double atol) try {
   if (v.block() == w.block()) {
@@ -304,6 +424,9 @@ std::ostream &operator<<(std::ostream &out, State const &state) {
     } else {
       out << "COMPLEX State\n";
     }
+    if (state.isview()) {
+      out << "View of external memory\n";
+    }
     out << "Block:\n";
     out << state.block();
   } else {
@@ -7,6 +7,7 @@
 #include <xdiag/blocks/blocks.hpp>
 #include <xdiag/common.hpp>
 #include <xdiag/extern/armadillo/armadillo>
+#include <xdiag/utils/allocator.hpp>
 
 namespace xdiag {
 
@@ -20,7 +21,13 @@ public:
   XDIAG_API State(Block const &block, arma::mat const &matrix);
   XDIAG_API State(Block const &block, arma::cx_mat const &matrix);
 
+  XDIAG_API State(State const &other);
+  XDIAG_API State(State &&other) noexcept;
+  XDIAG_API State &operator=(State const &other);
+  XDIAG_API State &operator=(State &&other);
+
   XDIAG_API bool isvalid() const;
+  XDIAG_API bool isview() const;
   XDIAG_API int64_t nsites() const;
   XDIAG_API bool isreal() const;
   XDIAG_API State real() const;
@@ -47,13 +54,23 @@ public:
   XDIAG_API complex *colptrC(int64_t col);
   Block block() const;
 
+  // Non-owning State using external memory, see state_view(...)
+  friend State state_view(Block const &block, double *ptr, int64_t ncols);
+  friend State state_view(Block const &block, complex *ptr, int64_t ncols);
+
 private:
-  bool valid_;
+  bool valid_ = false;
   Block block_;
-  bool real_;
-  int64_t nrows_;
-  int64_t ncols_;
-  mutable std::vector<double> storage_;
+  bool real_ = true;
+  int64_t nrows_ = 0;
+  int64_t ncols_ = 0;
+  mutable numa_vector_uninit<double> storage_;
+
+  // If view_ is set, the coefficients are stored in external memory at
+  // view_ptr_ which is neither owned nor ever reallocated by the State
+  bool view_ = false;
+  double *view_ptr_ = nullptr;
+  double *data() const;
 
   void init0(bool real, int64_t nrows, int64_t ncols);
   void initcopy(const double *ptr, int64_t nrows, int64_t ncols,
@@ -61,7 +78,15 @@ private:
   void initcopy(const complex *ptr, int64_t nrows, int64_t ncols);
 };
 
+// Creates a State which uses the memory at ptr to store its coefficients,
+// without copying. The memory must hold size(block) * ncols coefficients in
+// column-major order and must outlive the State and all views created from it.
+XDIAG_API State state_view(Block const &block, double *ptr, int64_t ncols = 1);
+XDIAG_API State state_view(Block const &block, complex *ptr,
+                           int64_t ncols = 1);
+
 XDIAG_API bool isvalid(State const &s);
+XDIAG_API bool isview(State const &s);
 XDIAG_API int64_t nsites(State const &s);
 XDIAG_API bool isapprox(State const &v, State const &w, double rtol = 1e-12,
                         double atol = 1e-12);
@@ -12,11 +12,11 @@ namespace xdiag {
 
 template <typename bit_t>
 GroupActionLookup<bit_t>::GroupActionLookup(
-    PermutationGroup const &permutation_group)
+    PermutationGroup const &permutation_group, bool spinflip)
     : nsites_(permutation_group.nsites()),
-      n_symmetries_(permutation_group.size()),
-      permutation_group_(permutation_group), n_prefix_bits_(nsites_ / 2),
-      n_postfix_bits_(nsites_ - n_prefix_bits_),
+      n_symmetries_((spinflip ? 2 : 1) * permutation_group.size()),
+      spinflip_(spinflip), permutation_group_(permutation_group),
+      n_prefix_bits_(nsites_ / 2), n_postfix_bits_(nsites_ - n_prefix_bits_),
       postfix_mask_(((bit_t)1 << n_postfix_bits_) - 1),
       prefix_size_((int64_t)1 << n_prefix_bits_),
       postfix_size_((int64_t)1 << n_postfix_bits_),
@@ -24,13 +24,19 @@ GroupActionLookup<bit_t>::GroupActionLookup(
       table_postfix_(n_symmetries_ * postfix_size_, 0) {
 
   auto action = GroupAction(permutation_group);
+  int64_t n_perms = permutation_group.size();
+
+  // The spin flipped symmetries act on the complement of the prefix and
+  // postfix states, respectively
+  bit_t prefix_mask = (bit_t)(prefix_size_ - 1);
 
   int64_t idx = 0;
   // Fill prefix table with translated prefix states
   for (int sym = 0; sym < n_symmetries_; ++sym) {
     for (bit_t state = 0; state < (bit_t)prefix_size_; ++state) {
+      bit_t prefix = (sym < n_perms) ? state : (state ^ prefix_mask);
       table_prefix_[idx++] =
-          action.apply(sym, (bit_t)(state << n_postfix_bits_));
+          action.apply(sym % n_perms, (bit_t)(prefix << n_postfix_bits_));
     }
   }
   assert(idx == (int64_t)table_prefix_.size());
@@ -39,7 +45,8 @@ GroupActionLookup<bit_t>::GroupActionLookup(
   idx = 0;
   for (int sym = 0; sym < n_symmetries_; ++sym) {
     for (bit_t state = 0; state < (bit_t)postfix_size_; ++state) {
-      table_postfix_[idx++] = action.apply(sym, state);
+      bit_t postfix = (sym < n_perms) ? state : (state ^ postfix_mask_);
+      table_postfix_[idx++] = action.apply(sym % n_perms, postfix);
     }
   }
 
@@ -49,6 +56,7 @@ GroupActionLookup<bit_t>::GroupActionLookup(
 template <typename bit_t>
 bool GroupActionLookup<bit_t>::operator==(GroupActionLookup const &rhs) const {
   return (nsites_ == rhs.nsites_) && (n_symmetries_ == rhs.n_symmetries_) &&
+         (spinflip_ == rhs.spinflip_) &&
          (permutation_group_ == rhs.permutation_group_);
 }
 template <typename bit_t>
@@ -10,17 +10,30 @@
 
 namespace xdiag {
 
+// If spinflip is true, the action of the product of the permutation group
+// with the global spin flip is tabulated. The symmetries
+// n <= sym < 2n, where n is the size of the permutation group, then denote
+// the permutation sym - n followed by flipping all bits.
 template <class bit_t> class GroupActionLookup {
 public:
   GroupActionLookup() = default;
-  explicit GroupActionLookup(PermutationGroup const &permutation_group);
+  explicit GroupActionLookup(PermutationGroup const &permutation_group,
+                             bool spinflip = false);
 
   inline int64_t nsites() const { return nsites_; }
   inline int64_t n_symmetries() const { return n_symmetries_; }
+  inline bool spinflip() const { return spinflip_; }
   inline PermutationGroup const &permutation_group() const {
     return permutation_group_;
   }
 
+  // Inverse of a symmetry, including the spin flip
+  inline int64_t inv(int64_t sym) const {
+    int64_t n_perms = permutation_group_.size();
+    return (sym < n_perms) ? permutation_group_.inv(sym)
+                           : permutation_group_.inv(sym - n_perms) + n_perms;
+  }
+
   inline bit_t apply(int64_t sym, bit_t state) const {
     // return table_prefix_[sym * prefix_size_ + (state >> n_postfix_bits_)] |
     //        table_postfix_[sym * postfix_size_ + (state & postfix_mask_)];
@@ -34,6 +47,7 @@ public:
 private:
   int64_t nsites_;
   int64_t n_symmetries_;
+  bool spinflip_;
   PermutationGroup permutation_group_;
 
   int64_t n_prefix_bits_;
@@ -12,6 +12,7 @@
 #include <xdiag/extern/gsl/span>
 #include <xdiag/symmetries/operations/group_action_operations.hpp>
 #include <xdiag/symmetries/operations/symmetry_operations.hpp>
+#include <xdiag/utils/allocator.hpp>
 #include <xdiag/utils/logger.hpp>
 
 namespace xdiag::symmetries {
@@ -20,14 +21,14 @@ using span_size_t = gsl::span<int64_t const>::size_type;
 
 template <typename bit_t, typename T, class StatesIndexing, class GroupAction>
 inline std::tuple<
-    std::vector<bit_t>, std::vector<int64_t>, std::vector<int64_t>,
-    std::vector<std::pair<span_size_t, span_size_t>>, std::vector<double>>
+    numa_vector<bit_t>, numa_vector<int64_t>, std::vector<int64_t>,
+    std::vector<std::pair<span_size_t, span_size_t>>, numa_vector<double>>
 representatives_indices_symmetries_limits_norms(
     StatesIndexing &&states_indexing, GroupAction &&group_action,
     arma::Col<T> const &characters) try {
   int64_t size = states_indexing.size();
 
-  std::vector<int64_t> idces;
+  numa_vector<int64_t> idces;
   try {
     idces.resize(size, invalid_index);
   } catch (...) {
@@ -35,8 +36,8 @@ representatives_indices_symmetries_limits_norms(
   }
 
   // Compute all representatives
-  std::vector<bit_t> reps;
-  std::vector<double> norms;
+  numa_vector<bit_t> reps;
+  numa_vector<double> norms;
 
   try {
     for (auto [state, idx] : states_indexing.states_indices()) {
@@ -116,7 +117,6 @@ representatives_indices_symmetries_limits_norms(
   std::fill(n_syms_for_state.begin(), n_syms_for_state.end(), 0);
 
   // calculate the symmetries yielding the representative
-  auto const &group = group_action.permutation_group();
   for (int64_t rep_idx = 0; rep_idx < n_reps; ++rep_idx) {
     bit_t rep = reps[rep_idx];
 
@@ -124,7 +124,7 @@ representatives_indices_symmetries_limits_norms(
       bit_t state = group_action.apply(sym, rep);
       int64_t idx = states_indexing.index(state);
 
-      int64_t sym_inv = group.inv(sym);
+      int64_t sym_inv = group_action.inv(sym);
       int64_t idx_sym = n_syms_for_state_offset[idx] + n_syms_for_state[idx]++;
       syms[idx_sym] = sym_inv;
     }
@@ -136,7 +136,7 @@ representatives_indices_symmetries_limits_norms(
 }
 
 template <typename bit_t, class StatesIndexing, class GroupAction>
-inline std::tuple<std::vector<bit_t>, std::vector<int64_t>,
+inline std::tuple<numa_vector<bit_t>, numa_vector<int64_t>,
                   std::vector<int64_t>,
                   std::vector<std::pair<span_size_t, span_size_t>>>
 representatives_indices_symmetries_limits(StatesIndexing &&states_indexing,
@@ -146,22 +146,23 @@ representatives_indices_symmetries_limits(StatesIndexing &&states_indexing,
       representatives_indices_symmetries_limits_norms<bit_t>(
           states_indexing, group_action, characters);
   (void)norms;
-  return {reps, idces, syms, sym_limits};
+  return {std::move(reps), std::move(idces), std::move(syms),
+          std::move(sym_limits)};
 } catch (Error const &e) {
   XDIAG_RETHROW(e);
 }
 
 template <typename bit_t, typename T, class States, class GroupAction>
-inline std::tuple<std::vector<bit_t>, std::vector<double>,
+inline std::tuple<numa_vector<bit_t>, numa_vector<double>,
                   std::vector<std::pair<span_size_t, span_size_t>>,
                   std::vector<int64_t>, int64_t>
-electrondns_norms_limits_offset_size(std::vector<bit_t> const &reps_up,
+electrondns_norms_limits_offset_size(numa_vector<bit_t> const &reps_up,
                                       States &&states_dns,
                                       GroupAction &&group_action,
                                       arma::Col<T> const &characters) try {
 
-  std::vector<bit_t> dns_storage;
-  std::vector<double> norms_storage;
+  numa_vector<bit_t> dns_storage;
+  numa_vector<double> norms_storage;
   std::vector<std::pair<span_size_t, span_size_t>> dns_limits(reps_up.size());
   std::vector<int64_t> ups_offset((reps_up.size()));
 
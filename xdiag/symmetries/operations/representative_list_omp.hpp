@@ -15,6 +15,7 @@
 #include <xdiag/symmetries/group_action/group_action.hpp>
 #include <xdiag/symmetries/group_action/group_action_lookup.hpp>
 #include <xdiag/symmetries/operations/symmetry_operations.hpp>
+#include <xdiag/utils/allocator.hpp>
 #include <xdiag/utils/timing.hpp>
 
 namespace xdiag::symmetries {
@@ -23,19 +24,23 @@ using span_size_t = gsl::span<int64_t const>::size_type;
 
 template <typename bit_t, typename T, class StatesIndexing, class GroupAction>
 inline std::tuple<
-    std::vector<bit_t>, std::vector<int64_t>, std::vector<int64_t>,
-    std::vector<std::pair<span_size_t, span_size_t>>, std::vector<double>>
+    numa_vector<bit_t>, numa_vector<int64_t>, std::vector<int64_t>,
+    std::vector<std::pair<span_size_t, span_size_t>>, numa_vector<double>>
 representatives_indices_symmetries_limits_norms_omp(
     StatesIndexing &&states_indexing, GroupAction &&group_action,
     arma::Col<T> const &characters) try {
 
   int64_t size = states_indexing.size();
-  std::vector<int64_t> idces;
+  numa_vector<int64_t> idces;
   try {
-    idces.resize(size, invalid_index);
+    idces.resize(size);
   } catch (...) {
     XDIAG_THROW("Cannot allocate memory for index array");
   }
+#pragma omp parallel for schedule(static)
+  for (int64_t idx = 0; idx < size; ++idx) {
+    idces[idx] = invalid_index;
+  }
 
   // Compute all representatives
   std::vector<std::vector<bit_t>> reps_thread;
@@ -104,8 +109,10 @@ representatives_indices_symmetries_limits_norms_omp(
     }
 
   } // pragma omp parallel
-  std::vector<bit_t> reps = omp::combine_vectors(reps_thread);
-  std::vector<double> norms = omp::combine_vectors(norms_thread);
+  auto reps =
+      omp::combine_vectors<bit_t, NumaAllocator<bit_t>>(reps_thread);
+  auto norms =
+      omp::combine_vectors<double, NumaAllocator<double>>(norms_thread);
 
   // Determine the number of syms yielding the representative for each state
   std::vector<int64_t> n_syms_for_state;
@@ -166,7 +173,6 @@ representatives_indices_symmetries_limits_norms_omp(
   std::fill(n_syms_for_state.begin(), n_syms_for_state.end(), 0);
 
   // calculate the symmetries yielding the representative
-  auto const &group = group_action.permutation_group();
 
 #pragma omp parallel for
   for (int64_t rep_idx = 0; rep_idx < n_reps; ++rep_idx) {
@@ -176,7 +182,7 @@ representatives_indices_symmetries_limits_norms_omp(
       bit_t state = group_action.apply(sym, rep);
       int64_t idx = states_indexing.index(state);
 
-      int64_t sym_inv = group.inv(sym);
+      int64_t sym_inv = group_action.inv(sym);
       int64_t idx_sym = n_syms_for_state_offset[idx] + n_syms_for_state[idx]++;
       syms[idx_sym] = sym_inv;
     }
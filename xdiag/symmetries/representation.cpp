@@ -148,6 +148,22 @@ Representation operator*(Representation const &r1,
   XDIAG_RETHROW(e);
 }
 
+Vector characters_z2(Representation const &irrep, int64_t parity) try {
+  if ((parity != 1) && (parity != -1)) {
+    XDIAG_THROW(fmt::format(
+        "Parity of a Z2 symmetry must be either +1 or -1, got {}", parity));
+  }
+  if (isreal(irrep)) {
+    auto c = irrep.characters().as<arma::vec>();
+    return Vector(arma::vec(arma::join_cols(c, (double)parity * c)));
+  } else {
+    auto c = irrep.characters().as<arma::cx_vec>();
+    return Vector(arma::cx_vec(arma::join_cols(c, (double)parity * c)));
+  }
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
 std::ostream &operator<<(std::ostream &out, Representation const &irrep) {
   out << "size      : " << irrep.size() << "\n";
   out << "characters:\n";
@@ -53,6 +53,11 @@ XDIAG_API Representation multiply(Representation const &r1,
 XDIAG_API Representation operator*(Representation const &r1,
                                    Representation const &r2);
 
+// Characters of the product of the group of irrep with a Z2 symmetry of
+// parity +1 or -1. The first half are the characters of irrep, the second
+// half the characters of the group elements combined with the Z2 symmetry.
+Vector characters_z2(Representation const &irrep, int64_t parity);
+
 XDIAG_API std::ostream &operator<<(std::ostream &out,
                                    Representation const &irrep);
 XDIAG_API std::string to_string(Representation const &irrep);
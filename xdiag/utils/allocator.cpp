@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "allocator.hpp"
+
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#ifdef _OPENMP
+#include <xdiag/parallel/omp/omp_utils.hpp>
+#endif
+
+namespace xdiag {
+
+static constexpr std::size_t cache_line_size = 64;
+static constexpr std::size_t huge_page_size = (std::size_t)1 << 21;
+
+// Below this size, first touch is not worth a parallel region
+static constexpr std::size_t parallel_first_touch_size = (std::size_t)1 << 20;
+static constexpr std::size_t page_size = 4096;
+
+// Writes one byte per page, such that the operating system places the page
+// on the NUMA node of the touching thread. The apply kernels use a guided
+// schedule, which cannot be reproduced here since its chunks are assigned
+// dynamically. Its first and largest chunks are however contiguous blocks of
+// similar size as the static ones, so most pages end up local.
+static void first_touch(char *ptr, std::size_t bytes) {
+#ifdef _OPENMP
+  if (bytes >= parallel_first_touch_size) {
+    int64_t n_pages = (int64_t)((bytes + page_size - 1) / page_size);
+#pragma omp parallel
+    {
+      auto [start, end] = omp::get_omp_start_end(n_pages);
+      for (int64_t page = start; page < end; ++page) {
+        ptr[page * page_size] = 0;
+      }
+    }
+    return;
+  }
+#endif
+  for (std::size_t offset = 0; offset < bytes; offset += page_size) {
+    ptr[offset] = 0;
+  }
+}
+
+void *numa_allocate(std::size_t bytes) {
+  if (bytes == 0) {
+    return nullptr;
+  }
+  bool huge = bytes >= huge_page_size;
+  std::size_t alignment = huge ? huge_page_size : cache_line_size;
+  bytes = ((bytes + alignment - 1) / alignment) * alignment;
+
+  void *ptr = nullptr;
+#if defined(_WIN32)
+  ptr = _aligned_malloc(bytes, alignment);
+#else
+  if (posix_memalign(&ptr, alignment, bytes) != 0) {
+    ptr = nullptr;
+  }
+#endif
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE) &&                           \
+    !defined(XDIAG_DISABLE_HUGEPAGES)
+  if (huge) {
+    madvise(ptr, bytes, MADV_HUGEPAGE);
+  }
+#endif
+
+  first_touch(static_cast<char *>(ptr), bytes);
+  return ptr;
+}
+
+void numa_deallocate(void *ptr) noexcept {
+#if defined(_WIN32)
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+
+} // namespace xdiag
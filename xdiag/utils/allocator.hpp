@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <xdiag/common.hpp>
+
+namespace xdiag {
+
+// Allocates memory aligned to a cache line. Large blocks are aligned to a
+// huge page and marked for transparent huge pages. The memory is not
+// initialized, but with OpenMP every page is first touched in parallel by
+// contiguous chunks, as in a static schedule, such that pages are placed on
+// the NUMA node of the thread which later works on them.
+XDIAG_API void *numa_allocate(std::size_t bytes);
+XDIAG_API void numa_deallocate(void *ptr) noexcept;
+
+// Allocator for large arrays using numa_allocate. Elements are
+// value-initialized like with std::allocator, unless value_init is false.
+// Then elements without constructor arguments are left uninitialized, which
+// avoids a serial pass over the memory if the caller fills it anyway.
+template <typename T, bool value_init = true> class NumaAllocator {
+public:
+  using value_type = T;
+  template <typename U> struct rebind {
+    using other = NumaAllocator<U, value_init>;
+  };
+
+  NumaAllocator() = default;
+  template <typename U>
+  NumaAllocator(NumaAllocator<U, value_init> const &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    return static_cast<T *>(numa_allocate(n * sizeof(T)));
+  }
+  void deallocate(T *ptr, std::size_t) noexcept { numa_deallocate(ptr); }
+
+  template <typename U> void construct(U *ptr) {
+    if constexpr (value_init) {
+      ::new (static_cast<void *>(ptr)) U();
+    } else {
+      ::new (static_cast<void *>(ptr)) U;
+    }
+  }
+  template <typename U, typename... Args>
+  void construct(U *ptr, Args &&...args) {
+    ::new (static_cast<void *>(ptr)) U(std::forward<Args>(args)...);
+  }
+};
+
+template <typename T, typename U, bool value_init>
+inline bool operator==(NumaAllocator<T, value_init> const &,
+                       NumaAllocator<U, value_init> const &) {
+  return true;
+}
+template <typename T, typename U, bool value_init>
+inline bool operator!=(NumaAllocator<T, value_init> const &,
+                       NumaAllocator<U, value_init> const &) {
+  return false;
+}
+
+template <typename T> using numa_vector = std::vector<T, NumaAllocator<T>>;
+
+// Vector whose elements are uninitialized after resizing, for work arrays
+// which are explicitly filled before being read
+template <typename T>
+using numa_vector_uninit = std::vector<T, NumaAllocator<T, false>>;
+
+} // namespace xdiag
@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+
+namespace xdiag {
+
+// Number of input states processed together by the staged apply kernels.
+// All table lookups of a tile are prefetched before the first of them is
+// resolved, such that up to this many cache misses are in flight at once.
+constexpr int64_t prefetch_tile_size = 32;
+
+// Hint to load the cache line containing ptr for reading. This is a no-op
+// on compilers without the builtin.
+template <typename T> inline void prefetch(T const *ptr) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(static_cast<void const *>(ptr), 0, 1);
+#else
+  (void)ptr;
+#endif
+}
+
+// Hint to load the cache line containing ptr for writing
+template <typename T> inline void prefetch_write(T *ptr) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(static_cast<void *>(ptr), 1, 1);
+#else
+  (void)ptr;
+#endif
+}
+
+} // namespace xdiag
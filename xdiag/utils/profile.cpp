@@ -0,0 +1,227 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "profile.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+#ifdef XDIAG_USE_MPI
+#include <mpi.h>
+#endif
+
+#include <xdiag/utils/error.hpp>
+
+namespace xdiag {
+
+static std::map<std::string, ProfileEntry> profile_registry;
+static std::mutex profile_mutex;
+
+namespace profile {
+
+#ifdef XDIAG_USE_PROFILING
+
+static std::atomic<int64_t> nbytes_pending(0);
+
+void count_bytes(int64_t n) { nbytes_pending += n; }
+
+static std::mutex counters_mutex;
+static std::set<ThreadCounters *> counters_threads;
+static Counters counters_finished; // left behind by threads which ended
+static int scope_depth = 0;
+
+ThreadCounters::ThreadCounters() {
+  std::lock_guard<std::mutex> lock(counters_mutex);
+  counters_threads.insert(this);
+}
+
+ThreadCounters::~ThreadCounters() {
+  std::lock_guard<std::mutex> lock(counters_mutex);
+  counters_finished.nelements += counters.nelements;
+  counters_finished.ninvalid += counters.ninvalid;
+  counters_finished.natomics += counters.natomics;
+  counters_threads.erase(this);
+}
+
+// Sums and resets the counters of all threads. Outside of parallel regions
+// no other thread is counting, so the counters can be read directly.
+static Counters collect_counters() {
+  std::lock_guard<std::mutex> lock(counters_mutex);
+  Counters sum = counters_finished;
+  counters_finished = Counters();
+  for (auto thread_counters : counters_threads) {
+    sum.nelements += thread_counters->counters.nelements;
+    sum.ninvalid += thread_counters->counters.ninvalid;
+    sum.natomics += thread_counters->counters.natomics;
+    thread_counters->counters = Counters();
+  }
+  return sum;
+}
+
+Scope::Scope(const char *block, std::string const &type)
+    : outermost_(scope_depth == 0) {
+  ++scope_depth;
+  if (outermost_) {
+    name_ = std::string(block) + "/" + type;
+    collect_counters();
+    nbytes_pending = 0;
+    t0_ = std::chrono::steady_clock::now();
+  }
+}
+
+Scope::~Scope() {
+  --scope_depth;
+  if (!outermost_) {
+    return;
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  Counters counters = collect_counters();
+  int64_t nbytes = nbytes_pending.exchange(0);
+  std::lock_guard<std::mutex> lock(profile_mutex);
+  auto &entry = profile_registry[name_];
+  entry.name = name_;
+  ++entry.ncalls;
+  entry.time += std::chrono::duration<double>(t1 - t0_).count();
+  entry.nelements += counters.nelements;
+  entry.ninvalid += counters.ninvalid;
+  entry.natomics += counters.natomics;
+  entry.nbytes += nbytes;
+}
+
+#endif
+
+} // namespace profile
+
+bool profile_enabled() {
+#ifdef XDIAG_USE_PROFILING
+  return true;
+#else
+  return false;
+#endif
+}
+
+#ifdef XDIAG_USE_MPI
+// All processes agree on the union of the names in the registry
+static std::vector<std::string>
+all_names(std::vector<std::string> const &names_local) {
+  std::string joined;
+  for (auto const &name : names_local) {
+    joined += name + '\n';
+  }
+  int mpi_size;
+  MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+  int length = joined.size();
+  std::vector<int> lengths(mpi_size);
+  MPI_Allgather(&length, 1, MPI_INT, lengths.data(), 1, MPI_INT,
+                MPI_COMM_WORLD);
+  std::vector<int> offsets(mpi_size, 0);
+  for (int r = 1; r < mpi_size; ++r) {
+    offsets[r] = offsets[r - 1] + lengths[r - 1];
+  }
+  std::string all(offsets[mpi_size - 1] + lengths[mpi_size - 1], ' ');
+  MPI_Allgatherv(joined.data(), length, MPI_CHAR, all.data(), lengths.data(),
+                 offsets.data(), MPI_CHAR, MPI_COMM_WORLD);
+  std::set<std::string> names;
+  std::stringstream ss(all);
+  std::string name;
+  while (std::getline(ss, name)) {
+    names.insert(name);
+  }
+  return std::vector<std::string>(names.begin(), names.end());
+}
+#endif
+
+std::vector<ProfileEntry> profile_entries() try {
+  std::vector<ProfileEntry> entries;
+  {
+    std::lock_guard<std::mutex> lock(profile_mutex);
+    for (auto const &[name, entry] : profile_registry) {
+      entries.push_back(entry);
+    }
+  }
+#ifdef XDIAG_USE_MPI
+  std::vector<std::string> names_local;
+  for (auto const &entry : entries) {
+    names_local.push_back(entry.name);
+  }
+  std::vector<ProfileEntry> entries_all;
+  for (auto const &name : all_names(names_local)) {
+    auto it =
+        std::find_if(entries.begin(), entries.end(),
+                     [&](ProfileEntry const &e) { return e.name == name; });
+    ProfileEntry local{name, 0, 0., 0, 0, 0, 0};
+    if (it != entries.end()) {
+      local = *it;
+    }
+    ProfileEntry entry{name, 0, 0., 0, 0, 0, 0};
+    MPI_Allreduce(&local.ncalls, &entry.ncalls, 1, MPI_INT64_T, MPI_MAX,
+                  MPI_COMM_WORLD);
+    MPI_Allreduce(&local.time, &entry.time, 1, MPI_DOUBLE, MPI_MAX,
+                  MPI_COMM_WORLD);
+    int64_t counts_local[4] = {local.nelements, local.ninvalid, local.natomics,
+                               local.nbytes};
+    int64_t counts[4];
+    MPI_Allreduce(counts_local, counts, 4, MPI_INT64_T, MPI_SUM,
+                  MPI_COMM_WORLD);
+    entry.nelements = counts[0];
+    entry.ninvalid = counts[1];
+    entry.natomics = counts[2];
+    entry.nbytes = counts[3];
+    entries_all.push_back(entry);
+  }
+  return entries_all;
+#else
+  return entries;
+#endif
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+std::string profile_table() try {
+  std::stringstream ss;
+  ss << fmt::format("{:<32} {:>8} {:>12} {:>14} {:>12} {:>14} {:>14}\n", "term",
+                    "calls", "time [s]", "elements", "invalid", "atomics",
+                    "bytes");
+  double time_total = 0.;
+  for (auto const &e : profile_entries()) {
+    ss << fmt::format("{:<32} {:>8} {:>12.6f} {:>14} {:>12} {:>14} {:>14}\n",
+                      e.name, e.ncalls, e.time, e.nelements, e.ninvalid,
+                      e.natomics, e.nbytes);
+    time_total += e.time;
+  }
+  ss << fmt::format("{:<32} {:>8} {:>12.6f}\n", "total", "", time_total);
+  return ss.str();
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+std::string profile_json() try {
+  std::stringstream ss;
+  ss << "[";
+  auto entries = profile_entries();
+  for (int64_t i = 0; i < (int64_t)entries.size(); ++i) {
+    auto const &e = entries[i];
+    ss << (i == 0 ? "\n" : ",\n");
+    ss << fmt::format("  {{\"name\": \"{}\", \"ncalls\": {}, \"time\": {:.6e}, "
+                      "\"nelements\": {}, \"ninvalid\": {}, \"natomics\": {}, "
+                      "\"nbytes\": {}}}",
+                      e.name, e.ncalls, e.time, e.nelements, e.ninvalid,
+                      e.natomics, e.nbytes);
+  }
+  ss << "\n]\n";
+  return ss.str();
+} catch (Error const &e) {
+  XDIAG_RETHROW(e);
+}
+
+void profile_reset() {
+  std::lock_guard<std::mutex> lock(profile_mutex);
+  profile_registry.clear();
+}
+
+} // namespace xdiag
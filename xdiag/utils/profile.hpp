@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: 2025 Alexander Wietek <awietek@pks.mpg.de>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <xdiag/common.hpp>
+
+namespace xdiag {
+
+// Accumulated cost of all terms of one Op type on one type of block, e.g.
+// "Spinhalf/Exchange". The time is the wall time, maximized over MPI
+// processes, all other counters are summed over threads and processes.
+struct ProfileEntry {
+  std::string name;
+  int64_t ncalls = 0;
+  double time = 0.;
+  int64_t nelements = 0;
+  int64_t ninvalid = 0;
+  int64_t natomics = 0;
+  int64_t nbytes = 0;
+};
+
+// Returns true if XDiag has been compiled with XDIAG_ENABLE_PROFILING
+XDIAG_API bool profile_enabled();
+
+// Entries of the profile, sorted by name. With MPI these functions have to
+// be called by all processes.
+XDIAG_API std::vector<ProfileEntry> profile_entries();
+XDIAG_API std::string profile_table();
+XDIAG_API std::string profile_json();
+
+XDIAG_API void profile_reset();
+
+namespace profile {
+
+#ifdef XDIAG_USE_PROFILING
+
+struct Counters {
+  int64_t nelements = 0;
+  int64_t ninvalid = 0;
+  int64_t natomics = 0;
+};
+
+// Counters of the calling thread. Every thread registers its counters on
+// first use, such that a Scope collects them from all threads which ever
+// counted, independent of whether OpenMP reuses its threads.
+struct ThreadCounters {
+  XDIAG_API ThreadCounters();
+  XDIAG_API ~ThreadCounters();
+  Counters counters;
+};
+inline thread_local ThreadCounters counters_local;
+
+inline void count_element() { ++counters_local.counters.nelements; }
+inline void count_invalid() { ++counters_local.counters.ninvalid; }
+inline void count_atomics(int64_t n) { counters_local.counters.natomics += n; }
+XDIAG_API void count_bytes(int64_t n);
+
+// Records the time and counters of the application of a single term. A
+// Scope has to be created and destroyed outside of parallel regions. A
+// Scope nested in another one records nothing, its cost is attributed to
+// the outermost Scope.
+class Scope {
+public:
+  XDIAG_API Scope(const char *block, std::string const &type);
+  XDIAG_API ~Scope();
+
+private:
+  bool outermost_;
+  std::string name_;
+  std::chrono::steady_clock::time_point t0_;
+};
+
+#else
+
+inline void count_element() {}
+inline void count_invalid() {}
+inline void count_atomics(int64_t) {}
+inline void count_bytes(int64_t) {}
+
+class Scope {
+public:
+  Scope(const char *, std::string const &) {}
+};
+
+#endif
+
+} // namespace profile
+} // namespace xdiag